@@ -241,6 +241,8 @@ public:
   bool isRecordingHistoryForChild() { return m_recordHistoryForChild; }
   void setAlwaysStoreInADS(const bool doStore) override;
   void setRethrows(const bool rethrow) override;
+  void setNumThreads(const int numThreads) override;
+  int getNumThreads() const override;
 
   /** @name Asynchronous Execution */
   Poco::ActiveResult<bool> executeAsync() override;
@@ -459,6 +461,7 @@ private:
   bool m_runningAsync;     ///< Algorithm is running asynchronously
   std::atomic<bool> m_running; ///< Algorithm is running
   bool m_rethrow; ///< Algorithm should rethrow exceptions while executing
+  int m_numThreads = 0; ///< Limit on the number of threads, 0 for none
   bool m_isAlgStartupLoggingEnabled; /// Whether to log alg startup and
                                      /// closedown messages from the base class
                                      /// (default = true)
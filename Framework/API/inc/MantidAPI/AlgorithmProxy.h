@@ -113,6 +113,8 @@ public:
   /// Proxies only manage parent algorithms
   void enableHistoryRecordingForChild(const bool) override{};
   void setRethrows(const bool rethrow) override;
+  void setNumThreads(const int numThreads) override;
+  int getNumThreads() const override { return m_numThreads; }
 
   const std::string workspaceMethodName() const override;
   const std::vector<std::string> workspaceMethodOn() const override;
@@ -192,6 +194,7 @@ private:
                                      /// closedown messages from the base class
                                      /// (default = true)
   bool m_rethrow;                    ///< Whether or not to rethrow exceptions.
+  int m_numThreads;                  ///< Limit on the number of threads
   bool m_isChild;                    ///< Is this a child algo
 
   /// Temporary holder of external observers wishing to subscribe
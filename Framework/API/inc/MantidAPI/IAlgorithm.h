@@ -153,6 +153,12 @@ public:
   /// To query whether an algorithm should rethrow exceptions when executing.
   virtual void setRethrows(const bool rethrow) = 0;
 
+  /// Limit the number of threads used while the algorithm executes
+  virtual void setNumThreads(const int numThreads) = 0;
+
+  /// Get the limit on the number of threads, 0 if there is none
+  virtual int getNumThreads() const = 0;
+
   /// Add an observer for a notification
   virtual void addObserver(const Poco::AbstractObserver &observer) const = 0;
 
@@ -67,6 +67,10 @@ public:
   virtual void loadBlock(std::vector<double> & /* Block */,
                          const uint64_t /*blockPosition*/,
                          const size_t /*BlockSize*/) const = 0;
+  /** hint that a data block will be loaded soon, so that it can be read
+   * ahead. Does nothing by default. */
+  virtual void prefetchBlock(const uint64_t /*blockPosition*/,
+                             const size_t /*BlockSize*/) const {}
 
   /** flush the IO buffers */
   virtual void flushData() const = 0;
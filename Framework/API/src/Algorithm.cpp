@@ -13,6 +13,7 @@
 #include "MantidKernel/EmptyValues.h"
 #include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/Strings.h"
+#include "MantidKernel/TaskRuntime.h"
 #include "MantidKernel/Timer.h"
 #include "MantidKernel/UsageService.h"
 
@@ -165,6 +166,17 @@ void Algorithm::setAlwaysStoreInADS(const bool doStore) {
  */
 void Algorithm::setRethrows(const bool rethrow) { this->m_rethrow = rethrow; }
 
+/** Limit the number of threads used by the algorithm while it executes. Child
+ * algorithms it runs are limited as well.
+ * @param numThreads :: the limit, 0 for the limit of the caller
+ */
+void Algorithm::setNumThreads(const int numThreads) {
+  m_numThreads = numThreads > 0 ? numThreads : 0;
+}
+
+/// @return the limit on the number of threads, 0 if there is none
+int Algorithm::getNumThreads() const { return m_numThreads; }
+
 /// True if the algorithm is running.
 bool Algorithm::isRunning() const { return m_running; }
 
@@ -553,7 +565,10 @@ bool Algorithm::execute() {
       // Start a timer
       Timer timer;
       // Call the concrete algorithm's exec method
-      this->exec(getExecutionMode());
+      {
+        Kernel::TaskRuntime::ScopedLimit threadLimit(m_numThreads);
+        this->exec(getExecutionMode());
+      }
       registerFeatureUsage();
       // Check for a cancellation request in case the concrete algorithm doesn't
       interruption_point();
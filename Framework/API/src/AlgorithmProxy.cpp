@@ -22,7 +22,8 @@ AlgorithmProxy::AlgorithmProxy(Algorithm_sptr alg)
       m_categorySeparator(alg->categorySeparator()), m_alias(alg->alias()),
       m_summary(alg->summary()), m_version(alg->version()), m_alg(alg),
       m_isExecuted(), m_isLoggingEnabled(true), m_loggingOffset(0),
-      m_isAlgStartupLoggingEnabled(true), m_rethrow(false), m_isChild(false) {
+      m_isAlgStartupLoggingEnabled(true), m_rethrow(false), m_numThreads(0),
+      m_isChild(false) {
   if (!alg) {
     throw std::logic_error("Unable to create a proxy algorithm.");
   }
@@ -156,6 +157,15 @@ void AlgorithmProxy::setRethrows(const bool rethrow) {
     m_alg->setRethrows(rethrow);
 }
 
+/** Limit the number of threads used while the algorithm executes
+ * @param numThreads :: the limit, 0 for the limit of the caller
+ */
+void AlgorithmProxy::setNumThreads(const int numThreads) {
+  m_numThreads = numThreads > 0 ? numThreads : 0;
+  if (m_alg)
+    m_alg->setNumThreads(m_numThreads);
+}
+
 /**
  * @return A string giving the method name that should be attached to a
  * workspace
@@ -243,6 +253,7 @@ void AlgorithmProxy::createConcreteAlg(bool initOnly) {
     m_alg->initializeFromProxy(*this);
     if (!initOnly) {
       m_alg->setRethrows(this->m_rethrow);
+      m_alg->setNumThreads(m_numThreads);
       addObservers();
     }
   }
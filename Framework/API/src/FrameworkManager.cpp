@@ -9,6 +9,7 @@
 #include "MantidKernel/Memory.h"
 #include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/PropertyManagerDataService.h"
+#include "MantidKernel/TaskRuntime.h"
 #include "MantidKernel/UsageService.h"
 
 #include <nexus/NeXusFile.hpp>
@@ -246,7 +247,7 @@ void FrameworkManagerImpl::setNumOMPThreadsToConfigValue() {
  */
 void FrameworkManagerImpl::setNumOMPThreads(const int nthreads) {
   g_log.debug() << "Setting maximum number of threads to " << nthreads << "\n";
-  PARALLEL_SET_NUM_THREADS(nthreads);
+  Kernel::TaskRuntime::setMaxConcurrency(nthreads);
 }
 
 /**
@@ -112,8 +112,14 @@ void WorkspaceFactoryImpl::initializeFromParentWithoutLogs(
     child.m_masks = parent.m_masks;
   }
 
-  // Same number of histograms = copy over the spectra data
-  if (parent.getNumberHistograms() == child.getNumberHistograms()) {
+  // Same number of histograms = copy over the spectra data. A child that was
+  // given its own partitioning (e.g., a distributed child of a cloned parent)
+  // keeps its spectra, the equal size is a coincidence of the partitioning.
+  const bool ownPartitioning =
+      child.storageMode() != Parallel::StorageMode::Cloned &&
+      child.storageMode() != parent.storageMode();
+  if (!ownPartitioning &&
+      parent.getNumberHistograms() == child.getNumberHistograms()) {
     for (size_t i = 0; i < parent.getNumberHistograms(); ++i)
       child.getSpectrum(i).copyInfoFrom(parent.getSpectrum(i));
     // We use this variant without ISpectrum update to avoid costly rebuilds
@@ -247,6 +247,20 @@ public:
 
     TS_ASSERT_EQUALS(val, val2);
   }
+
+  void test_setNumThreads() {
+    IAlgorithm_sptr alg =
+        AlgorithmManager::Instance().create("ToyAlgorithmProxy");
+    TS_ASSERT_EQUALS(alg->getNumThreads(), 0);
+    alg->setNumThreads(2);
+    TS_ASSERT_EQUALS(alg->getNumThreads(), 2);
+    alg->setProperty("prop1", "stuff");
+    alg->setProperty("prop2", 17);
+    TS_ASSERT_THROWS_NOTHING(alg->execute());
+    TS_ASSERT(alg->isExecuted());
+    alg->setNumThreads(-1);
+    TS_ASSERT_EQUALS(alg->getNumThreads(), 0);
+  }
 };
 
 #endif /*ALGORITHMPROXYTEST_H_*/
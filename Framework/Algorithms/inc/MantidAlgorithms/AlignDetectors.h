@@ -86,6 +86,10 @@ private:
                    const std::string &filename);
   void getCalibrationWS(API::MatrixWorkspace_sptr inputWS);
 
+  Parallel::ExecutionMode getParallelExecutionMode(
+      const std::map<std::string, Parallel::StorageMode> &storageModes)
+      const override;
+
   Mantid::API::ITableWorkspace_sptr m_calibrationWS;
 
   /// number of spectra in input workspace
@@ -137,6 +137,10 @@ protected:
 
   void putBackBinWidth(const API::MatrixWorkspace_sptr outputWS);
 
+  Parallel::ExecutionMode getParallelExecutionMode(
+      const std::map<std::string, Parallel::StorageMode> &storageModes)
+      const override;
+
   std::size_t
       m_numberOfSpectra; ///< The number of spectra in the input workspace
   bool m_distribution;   ///< Whether input is a distribution. Only applies to
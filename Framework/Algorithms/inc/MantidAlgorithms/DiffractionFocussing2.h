@@ -94,6 +94,8 @@ public:
   const std::string category() const override {
     return "Diffraction\\Focussing";
   }
+  /// Cross-check properties with each other @see IAlgorithm::validateInputs
+  std::map<std::string, std::string> validateInputs() override;
 
 private:
   // Overridden Algorithm methods
@@ -111,6 +113,18 @@ private:
   /// The result is stored in group2params
   void determineRebinParameters();
   int validateSpectrumInGroup(size_t wi);
+  void getXMinMax(double &xmin, double &xmax) const;
+
+  /// Sum the groups of all ranks for distributed input workspaces
+  void sumGroupsOverRanks(API::MatrixWorkspace &out,
+                          std::vector<MantidVec> &groupWeights,
+                          std::vector<double> &groupSizes) const;
+  API::MatrixWorkspace_sptr
+  createMasterOnlyOutput(const API::MatrixWorkspace &out);
+
+  Parallel::ExecutionMode getParallelExecutionMode(
+      const std::map<std::string, Parallel::StorageMode> &storageModes)
+      const override;
 
   /// Shared pointer to the input workspace
   API::MatrixWorkspace_const_sptr m_matrixInputW;
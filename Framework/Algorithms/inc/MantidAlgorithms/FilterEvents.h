@@ -123,6 +123,12 @@ private:
   /// Filter events by splitters in format of vector
   void filterEventsByVectorSplitters(double progressamount);
 
+  /// Check the vector splitters when filtering by pulse time
+  void checkVectorSplittersForPulseTime() const;
+
+  /// Filter events into slices of one copy of the input
+  void filterEventsAsSlices(double progressamount);
+
   /// Examine workspace
   void examineAndSortEventWS();
 
@@ -235,6 +241,8 @@ private:
   Kernel::DateAndTime m_filterStartTime;
   // EventWorkspace (aka. run)'s starting time
   Kernel::DateAndTime m_runStartTime;
+  /// Flag to output slices of one copy of the input instead of copied events
+  bool m_outputSlices;
 };
 
 } // namespace Algorithms
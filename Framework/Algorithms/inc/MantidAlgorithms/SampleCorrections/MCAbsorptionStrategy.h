@@ -25,6 +25,10 @@ class IBeamProfile;
   The error on all points is defined to be \f$\frac{1}{\sqrt{N}}\f$, where N is
   the number of events generated.
 
+  The scatter points and incoming tracks of the events do not depend on the
+  final position of the neutron. generateScatterPaths() generates them once
+  so that calculate() can reuse them for every detector.
+
   Copyright &copy; 2016 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
   National Laboratory & European Spallation Source
 
@@ -54,6 +58,15 @@ public:
                                        const Kernel::V3D &finalPos,
                                        double lambdaBefore,
                                        double lambdaAfter) const;
+  void generateScatterPaths(Kernel::PseudoRandomNumberGenerator &rng,
+                            MCScatterPaths &paths) const;
+  std::tuple<double, double> calculate(const MCScatterPaths &paths,
+                                       size_t firstEvent,
+                                       const Kernel::V3D &finalPos,
+                                       double lambdaBefore,
+                                       double lambdaAfter) const;
+  /// @return the number of events simulated for each point
+  size_t nevents() const { return m_nevents; }
 
 private:
   const IBeamProfile &m_beamProfile;
@@ -3,6 +3,10 @@
 
 #include "MantidAlgorithms/DllConfig.h"
 #include "MantidGeometry/Objects/BoundingBox.h"
+#include "MantidKernel/Material.h"
+#include "MantidKernel/V3D.h"
+
+#include <vector>
 
 namespace Mantid {
 namespace API {
@@ -14,11 +18,38 @@ class SampleEnvironment;
 }
 namespace Kernel {
 class PseudoRandomNumberGenerator;
-class V3D;
 }
 namespace Algorithms {
 class IBeamProfile;
 
+/**
+  The scatter points of a batch of Monte Carlo events and the segments of the
+  tracks from the start of each event to its scatter point, stored as a
+  structure of arrays. None of this depends on where the neutron ends up, so
+  a single batch serves every detector.
+ */
+struct MANTID_ALGORITHMS_DLL MCScatterPaths {
+  /// Scatter point of each event
+  std::vector<Kernel::V3D> scatterPos;
+  /// Index of the first segment of each event, followed by the number of
+  /// segments
+  std::vector<size_t> firstSegment{0};
+  /// Length of each segment in metres
+  std::vector<double> segmentLength;
+  /// Index of the object crossed by each segment
+  std::vector<size_t> segmentObject;
+  /// Objects crossed by the segments
+  std::vector<const Geometry::Object *> objects;
+  /// Material of each object
+  std::vector<Kernel::Material> materials;
+
+  /// @return the number of events
+  size_t size() const { return scatterPos.size(); }
+  void clear();
+  size_t objectIndex(const Geometry::Object &object);
+  std::vector<double> attenuationCoefficients(double lambda) const;
+};
+
 /**
   Defines a volume where interactions of Tracks and Objects can take place.
   Given an initial Track, end point & wavelengths it calculates the absorption
@@ -59,6 +90,14 @@ public:
                              const Kernel::V3D &startPos,
                              const Kernel::V3D &endPos, double lambdaBefore,
                              double lambdaAfter) const;
+  bool generateScatterPath(Kernel::PseudoRandomNumberGenerator &rng,
+                           const Kernel::V3D &startPos,
+                           MCScatterPaths &paths) const;
+  double calculateAbsorption(const MCScatterPaths &paths, size_t event,
+                             const Kernel::V3D &endPos,
+                             const std::vector<double> &muBefore,
+                             const std::vector<double> &muAfter,
+                             double lambdaAfter) const;
 
 private:
   const Geometry::Object &m_sample;
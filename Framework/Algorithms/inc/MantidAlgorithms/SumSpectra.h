@@ -87,12 +87,17 @@ private:
   void init() override;
   std::map<std::string, std::string> validateInputs() override;
   void exec() override;
+  void execDistributed() override;
+  void determineIndices();
   void execEvent(DataObjects::EventWorkspace_const_sptr localworkspace,
                  std::set<int> &indices);
   specnum_t getOutputSpecNo(API::MatrixWorkspace_const_sptr localworkspace);
 
   API::MatrixWorkspace_sptr
   replaceSpecialValues(API::MatrixWorkspace_sptr inputWs);
+  Parallel::ExecutionMode getParallelExecutionMode(
+      const std::map<std::string, Parallel::StorageMode> &storageModes)
+      const override;
 
   /// The output spectrum number
   specnum_t m_outSpecNum;
@@ -318,5 +318,11 @@ void AlignDetectors::align(const ConversionFactors &converter,
   outputWS.clearMRU();
 }
 
+Parallel::ExecutionMode AlignDetectors::getParallelExecutionMode(
+    const std::map<std::string, Parallel::StorageMode> &storageModes) const {
+  return Parallel::getCorrespondingExecutionMode(
+      storageModes.at("InputWorkspace"));
+}
+
 } // namespace Algorithms
 } // namespace Mantid
@@ -13,8 +13,12 @@
 #include "MantidKernel/CompositeValidator.h"
 #include "MantidKernel/ListValidator.h"
 #include "MantidKernel/UnitFactory.h"
+#include "MantidKernel/make_cow.h"
+#include "MantidParallel/Communicator.h"
 
+#include <map>
 #include <numeric>
+#include <tuple>
 
 namespace Mantid {
 namespace Algorithms {
@@ -27,6 +31,77 @@ using namespace API;
 using namespace DataObjects;
 using namespace HistogramData;
 
+namespace {
+/// Conversion of the X values of a spectrum to TOF and on to the output unit
+struct ConversionKernel {
+  PowerLaw toTOF;
+  PowerLaw fromTOF;
+};
+
+auto coefficients(const PowerLaw &law) {
+  return std::tie(law.factor, law.scale, law.shift, law.power, law.offset,
+                  law.bounded, law.outOfRange, law.protectZero);
+}
+
+bool operator<(const ConversionKernel &lhs, const ConversionKernel &rhs) {
+  return std::make_tuple(coefficients(lhs.toTOF), coefficients(lhs.fromTOF)) <
+         std::make_tuple(coefficients(rhs.toTOF), coefficients(rhs.fromTOF));
+}
+
+/// Apply a kernel to all values. Two linear laws need no branches per value.
+void convert(const ConversionKernel &kernel, HistogramX &values) {
+  const auto &to = kernel.toTOF;
+  const auto &from = kernel.fromTOF;
+  if (to.isLinear() && from.isLinear()) {
+    for (auto &x : values) {
+      const double tof = to.factor * (to.scale * x + to.shift) + to.offset;
+      x = from.factor * (from.scale * tof + from.shift) + from.offset;
+    }
+  } else {
+    for (auto &x : values)
+      x = from(to(x));
+  }
+}
+
+/** Convert the X values of all spectra that have a kernel. Spectra sharing
+ * their X values and their kernel are converted once and share the result.
+ * @param ws :: the workspace to convert
+ * @param kernels :: conversion kernel for each spectrum
+ * @param hasKernel :: flags for the spectra to convert
+ */
+void convertXWithKernels(MatrixWorkspace &ws,
+                         const std::vector<ConversionKernel> &kernels,
+                         const std::vector<bool> &hasKernel) {
+  using Group = std::pair<const HistogramX *, ConversionKernel>;
+  std::map<Group, size_t> groupIndices;
+  std::vector<size_t> representatives;
+  std::vector<size_t> groupOfSpectrum(kernels.size());
+  for (size_t i = 0; i < kernels.size(); ++i) {
+    if (!hasKernel[i])
+      continue;
+    const Group group(&ws.x(i), kernels[i]);
+    const auto inserted = groupIndices.emplace(group, representatives.size());
+    if (inserted.second)
+      representatives.push_back(i);
+    groupOfSpectrum[i] = inserted.first->second;
+  }
+
+  std::vector<Kernel::cow_ptr<HistogramX>> converted(representatives.size());
+  const int64_t numGroups = static_cast<int64_t>(representatives.size());
+  PARALLEL_FOR_IF(Kernel::threadSafe(ws))
+  for (int64_t group = 0; group < numGroups; ++group) {
+    const size_t i = representatives[group];
+    auto x = Kernel::make_cow<HistogramX>(ws.x(i));
+    convert(kernels[i], x.access());
+    converted[group] = std::move(x);
+  }
+
+  for (size_t i = 0; i < kernels.size(); ++i)
+    if (hasKernel[i])
+      ws.setSharedX(i, converted[groupOfSpectrum[i]]);
+}
+} // namespace
+
 /// Default constructor
 ConvertUnits::ConvertUnits()
     : Algorithm(), m_numberOfSpectra(0), m_distribution(false),
@@ -232,6 +307,12 @@ ConvertUnits::executeUnitConversion(const API::MatrixWorkspace_sptr inputWS) {
 
   // Rebin the data to common bins if requested, and if necessary
   bool alignBins = getProperty("AlignBins");
+  // The bins would have to agree on all ranks
+  if (alignBins &&
+      outputWS->storageMode() == Parallel::StorageMode::Distributed &&
+      communicator().size() > 1)
+    throw std::runtime_error(
+        "ConvertUnits: AlignBins is not supported for distributed workspaces.");
   if (alignBins && !WorkspaceHelpers::commonBoundaries(*outputWS))
     outputWS = this->alignBins(outputWS);
 
@@ -542,6 +623,11 @@ ConvertUnits::convertViaTOF(Kernel::Unit_const_sptr fromUnit,
   assert(static_cast<bool>(eventWS) == m_inputEvents); // Sanity check
 
   auto &outSpectrumInfo = outputWS->mutableSpectrumInfo();
+  // Conversion kernel of each spectrum, set up from the geometry in a first
+  // serial pass. Spectra without a kernel are either masked or converted
+  // immediately through the virtual Unit interface.
+  std::vector<ConversionKernel> kernels(m_numberOfSpectra);
+  std::vector<bool> hasKernel(m_numberOfSpectra, false);
   // Loop over the histograms (detector spectra)
   for (int64_t i = 0; i < numberOfSpectra_i; ++i) {
     double efixed = efixedProp;
@@ -555,12 +641,20 @@ ConvertUnits::convertViaTOF(Kernel::Unit_const_sptr fromUnit,
       /// @todo Don't yet consider hold-off (delta)
       const double delta = 0.0;
 
-      // TODO toTOF and fromTOF need to be reimplemented outside of kernel
-      localFromUnit->toTOF(outputWS->dataX(i), emptyVec, l1, l2, twoTheta,
-                           emode, efixed, delta);
-      // Convert from time-of-flight to the desired unit
-      localOutputUnit->fromTOF(outputWS->dataX(i), emptyVec, l1, l2, twoTheta,
-                               emode, efixed, delta);
+      localFromUnit->initialize(l1, l2, twoTheta, emode, efixed, delta);
+      localOutputUnit->initialize(l1, l2, twoTheta, emode, efixed, delta);
+      auto &kernel = kernels[i];
+      if (localFromUnit->toTOFLaw(kernel.toTOF) &&
+          localOutputUnit->fromTOFLaw(kernel.fromTOF)) {
+        hasKernel[i] = true;
+      } else {
+        // TODO toTOF and fromTOF need to be reimplemented outside of kernel
+        localFromUnit->toTOF(outputWS->dataX(i), emptyVec, l1, l2, twoTheta,
+                             emode, efixed, delta);
+        // Convert from time-of-flight to the desired unit
+        localOutputUnit->fromTOF(outputWS->dataX(i), emptyVec, l1, l2,
+                                 twoTheta, emode, efixed, delta);
+      }
 
       // EventWorkspace part, modifying the EventLists.
       if (m_inputEvents) {
@@ -582,6 +676,8 @@ ConvertUnits::convertViaTOF(Kernel::Unit_const_sptr fromUnit,
     prog.report("Convert to " + m_outputUnit->unitID());
   } // loop over spectra
 
+  convertXWithKernels(*outputWS, kernels, hasKernel);
+
   if (failedDetectorCount != 0) {
     g_log.information() << "Unable to calculate sample-detector distance for "
                         << failedDetectorCount
@@ -798,5 +894,11 @@ void ConvertUnits::putBackBinWidth(const API::MatrixWorkspace_sptr outputWS) {
   }
 }
 
+Parallel::ExecutionMode ConvertUnits::getParallelExecutionMode(
+    const std::map<std::string, Parallel::StorageMode> &storageModes) const {
+  return Parallel::getCorrespondingExecutionMode(
+      storageModes.at("InputWorkspace"));
+}
+
 } // namespace Algorithm
 } // namespace Mantid
@@ -9,11 +9,18 @@
 #include "MantidAPI/WorkspaceFactory.h"
 #include "MantidDataObjects/EventWorkspace.h"
 #include "MantidDataObjects/GroupingWorkspace.h"
+#include "MantidDataObjects/Workspace2D.h"
 #include "MantidDataObjects/WorkspaceCreation.h"
 #include "MantidHistogramData/LogarithmicGenerator.h"
 #include "MantidIndexing/Group.h"
 #include "MantidIndexing/IndexInfo.h"
 #include "MantidKernel/VectorHelper.h"
+#include "MantidParallel/Collectives.h"
+#include "MantidParallel/Communicator.h"
+#include "MantidTypes/SpectrumDefinition.h"
+
+#include <boost/serialization/utility.hpp>
+#include <boost/serialization/vector.hpp>
 
 #include <cfloat>
 #include <iterator>
@@ -58,7 +65,23 @@ void DiffractionFocussing2::init() {
                   "Keep the output workspace as an EventWorkspace, if the "
                   "input has events (default).\n"
                   "If false, then the workspace gets converted to a "
-                  "Workspace2D histogram.");
+                  "Workspace2D histogram. Must be false for a distributed "
+                  "input workspace.");
+}
+
+std::map<std::string, std::string> DiffractionFocussing2::validateInputs() {
+  std::map<std::string, std::string> result;
+
+  MatrixWorkspace_const_sptr inputWS = getProperty("InputWorkspace");
+  const bool preserveEvents = getProperty("PreserveEvents");
+  if (preserveEvents &&
+      boost::dynamic_pointer_cast<const EventWorkspace>(inputWS) &&
+      inputWS->storageMode() == Parallel::StorageMode::Distributed)
+    result["PreserveEvents"] = "Events of a distributed workspace are "
+                               "focussed into histograms. Set "
+                               "PreserveEvents to false.";
+
+  return result;
 }
 
 //=============================================================================
@@ -149,7 +172,7 @@ void DiffractionFocussing2::exec() {
     } else {
       // get the full d-spacing range
       m_eventW->sortAll(DataObjects::TOF_SORT, nullptr);
-      m_matrixInputW->getXMinMax(eventXMin, eventXMax);
+      getXMinMax(eventXMin, eventXMax);
     }
   }
 
@@ -170,6 +193,11 @@ void DiffractionFocussing2::exec() {
   // Helgrind will show a race-condition but the data is completely unused so it
   // is irrelevant
   MantidVec weights_default(1, 1.0), emptyVec(1, 0.0), EOutDummy(nPoints);
+  // The summed weights and number of spectra of each group, kept for the
+  // normalisation once the groups are complete
+  std::vector<MantidVec> groupWeights(m_validGroups.size(),
+                                      MantidVec(nPoints, 0.0));
+  std::vector<double> groupSizes(m_validGroups.size(), 0.0);
 
   std::unique_ptr<Progress> prog = make_unique<API::Progress>(
       this, 0.2, 1.0, static_cast<int>(totalHistProcess) + nGroups);
@@ -198,13 +226,13 @@ void DiffractionFocussing2::exec() {
     auto &Yout = outSpec.dataY();
     auto &Eout = outSpec.dataE();
 
-    // Initialize the group's weight vector here and the dummy vector used for
-    // accumulating errors.
-    MantidVec groupWgt(nPoints, 0.0);
+    // The group's weight vector
+    MantidVec &groupWgt = groupWeights[outWorkspaceIndex];
 
     // loop through the contributing histograms
     const std::vector<size_t> &indices = m_wsIndices[outWorkspaceIndex];
     const size_t groupSize = indices.size();
+    groupSizes[outWorkspaceIndex] = static_cast<double>(groupSize);
     for (size_t i = 0; i < groupSize; i++) {
       size_t inWorkspaceIndex = indices[i];
       // This is the input spectrum
@@ -283,48 +311,152 @@ void DiffractionFocussing2::exec() {
       }
       prog->report();
     } // end of loop for input spectra
-
-    // Calculate the bin widths
-    std::vector<double> widths(Xout.size());
-    std::adjacent_difference(Xout.begin(), Xout.end(), widths.begin());
-
-    // Take the square root of the errors
-    std::transform(Eout.begin(), Eout.end(), Eout.begin(),
-                   static_cast<double (*)(double)>(sqrt));
-
-    // Multiply the data and errors by the bin widths because the rebin
-    // function, when used
-    // in the fashion above for the weights, doesn't put it back in
-    std::transform(Yout.begin(), Yout.end(), widths.begin() + 1, Yout.begin(),
-                   std::multiplies<double>());
-    std::transform(Eout.begin(), Eout.end(), widths.begin() + 1, Eout.begin(),
-                   std::multiplies<double>());
-
-    // Now need to normalise the data (and errors) by the weights
-    std::transform(Yout.begin(), Yout.end(), groupWgt.begin(), Yout.begin(),
-                   std::divides<double>());
-    std::transform(Eout.begin(), Eout.end(), groupWgt.begin(), Eout.begin(),
-                   std::divides<double>());
-    // Now multiply by the number of spectra in the group
-    std::transform(Yout.begin(), Yout.end(), Yout.begin(),
-                   std::bind2nd(std::multiplies<double>(), groupSize));
-    std::transform(Eout.begin(), Eout.end(), Eout.begin(),
-                   std::bind2nd(std::multiplies<double>(), groupSize));
-
-    prog->report();
     PARALLEL_END_INTERUPT_REGION
   } // end of loop for groups
   PARALLEL_CHECK_INTERUPT_REGION
 
-  out->setIndexInfo(Indexing::group(m_matrixInputW->indexInfo(),
-                                    std::move(m_validGroups),
-                                    std::move(m_wsIndices)));
+  // The groups of a distributed workspace are completed on rank 0
+  const bool distributed =
+      m_matrixInputW->storageMode() == Parallel::StorageMode::Distributed;
+  if (distributed)
+    sumGroupsOverRanks(*out, groupWeights, groupSizes);
+
+  if (!distributed || communicator().rank() == 0) {
+    PARALLEL_FOR_IF(Kernel::threadSafe(*out))
+    for (int outWorkspaceIndex = 0;
+         outWorkspaceIndex < static_cast<int>(m_validGroups.size());
+         outWorkspaceIndex++) {
+      PARALLEL_START_INTERUPT_REGION
+      auto &outSpec = out->getSpectrum(outWorkspaceIndex);
+      auto &Xout = outSpec.x();
+      auto &Yout = outSpec.dataY();
+      auto &Eout = outSpec.dataE();
+      const MantidVec &groupWgt = groupWeights[outWorkspaceIndex];
+      const double groupSize = groupSizes[outWorkspaceIndex];
+
+      // Calculate the bin widths
+      std::vector<double> widths(Xout.size());
+      std::adjacent_difference(Xout.begin(), Xout.end(), widths.begin());
+
+      // Take the square root of the errors
+      std::transform(Eout.begin(), Eout.end(), Eout.begin(),
+                     static_cast<double (*)(double)>(sqrt));
+
+      // Multiply the data and errors by the bin widths because the rebin
+      // function, when used
+      // in the fashion above for the weights, doesn't put it back in
+      std::transform(Yout.begin(), Yout.end(), widths.begin() + 1,
+                     Yout.begin(), std::multiplies<double>());
+      std::transform(Eout.begin(), Eout.end(), widths.begin() + 1,
+                     Eout.begin(), std::multiplies<double>());
+
+      // Now need to normalise the data (and errors) by the weights
+      std::transform(Yout.begin(), Yout.end(), groupWgt.begin(), Yout.begin(),
+                     std::divides<double>());
+      std::transform(Eout.begin(), Eout.end(), groupWgt.begin(), Eout.begin(),
+                     std::divides<double>());
+      // Now multiply by the number of spectra in the group
+      std::transform(Yout.begin(), Yout.end(), Yout.begin(),
+                     std::bind2nd(std::multiplies<double>(), groupSize));
+      std::transform(Eout.begin(), Eout.end(), Eout.begin(),
+                     std::bind2nd(std::multiplies<double>(), groupSize));
+
+      prog->report();
+      PARALLEL_END_INTERUPT_REGION
+    } // end of loop for groups
+    PARALLEL_CHECK_INTERUPT_REGION
+  }
 
-  setProperty("OutputWorkspace", out);
+  if (distributed) {
+    setProperty("OutputWorkspace", createMasterOnlyOutput(*out));
+  } else {
+    out->setIndexInfo(Indexing::group(m_matrixInputW->indexInfo(),
+                                      std::move(m_validGroups),
+                                      std::move(m_wsIndices)));
+    setProperty("OutputWorkspace", out);
+  }
 
   this->cleanup();
 }
 
+/** Adds up the partial groups of all ranks on rank 0. The data, the squared
+ * errors (the square root is not taken yet), the weights and the number of
+ * spectra of the groups are summed.
+ * @param out :: the workspace with the groups of this rank
+ * @param groupWeights :: the weights of the groups of this rank
+ * @param groupSizes :: the number of spectra of the groups of this rank
+ */
+void DiffractionFocussing2::sumGroupsOverRanks(
+    API::MatrixWorkspace &out, std::vector<MantidVec> &groupWeights,
+    std::vector<double> &groupSizes) const {
+  const size_t numGroups = groupSizes.size();
+  const size_t stride = 3 * nPoints + 1;
+  std::vector<double> partial(numGroups * stride);
+  for (size_t i = 0; i < numGroups; ++i) {
+    auto it = partial.begin() + i * stride;
+    it = std::copy(out.y(i).begin(), out.y(i).end(), it);
+    it = std::copy(out.e(i).begin(), out.e(i).end(), it);
+    it = std::copy(groupWeights[i].begin(), groupWeights[i].end(), it);
+    *it = groupSizes[i];
+  }
+  if (communicator().rank() != 0)
+    return Parallel::reduce(communicator(), partial.data(),
+                            static_cast<int>(partial.size()),
+                            std::plus<double>(), 0);
+  std::vector<double> total(partial.size());
+  Parallel::reduce(communicator(), partial.data(),
+                   static_cast<int>(partial.size()), total.data(),
+                   std::plus<double>(), 0);
+  for (size_t i = 0; i < numGroups; ++i) {
+    auto it = total.cbegin() + i * stride;
+    std::copy(it, it + nPoints, out.mutableY(i).begin());
+    it += nPoints;
+    std::copy(it, it + nPoints, out.mutableE(i).begin());
+    it += nPoints;
+    std::copy(it, it + nPoints, groupWeights[i].begin());
+    groupSizes[i] = *(it + nPoints);
+  }
+}
+
+/** Creates the output for a distributed input workspace. It holds the groups
+ * on rank 0, with the detectors of the grouped spectra of all ranks.
+ * @param out :: the focussed groups (on rank 0)
+ * @return the output workspace, empty on ranks other than 0
+ */
+API::MatrixWorkspace_sptr
+DiffractionFocussing2::createMasterOnlyOutput(const API::MatrixWorkspace &out) {
+  // Detector and time indices of the grouped spectra of this rank
+  const auto localGroups =
+      Indexing::group(m_matrixInputW->indexInfo(),
+                      std::vector<Indexing::SpectrumNumber>(m_validGroups),
+                      m_wsIndices);
+  const auto &localDefinitions = *localGroups.spectrumDefinitions();
+  std::vector<std::vector<std::pair<size_t, size_t>>> definitions;
+  for (const auto &definition : localDefinitions)
+    definitions.emplace_back(definition.begin(), definition.end());
+
+  const auto &comm = communicator();
+  if (comm.rank() != 0) {
+    Parallel::gather(comm, definitions, 0);
+    return Kernel::make_unique<Workspace2D>(Parallel::StorageMode::MasterOnly);
+  }
+  std::vector<std::vector<std::vector<std::pair<size_t, size_t>>>> all;
+  Parallel::gather(comm, definitions, all, 0);
+  std::vector<SpectrumDefinition> groups(m_validGroups.size());
+  for (const auto &rankDefinitions : all)
+    for (size_t i = 0; i < rankDefinitions.size(); ++i)
+      for (const auto &index : rankDefinitions[i])
+        groups[i].add(index.first, index.second);
+
+  Indexing::IndexInfo indexInfo(std::move(m_validGroups),
+                                Parallel::StorageMode::MasterOnly, comm);
+  indexInfo.setSpectrumDefinitions(std::move(groups));
+  auto focussed = create<MatrixWorkspace>(out, indexInfo, out.binEdges(0));
+  for (size_t i = 0; i < focussed->getNumberHistograms(); ++i)
+    focussed->setHistogram(i, out.histogram(i));
+  return std::move(focussed);
+}
+
 //=============================================================================
 /** Executes the algorithm in the case of an Event input workspace
  *
@@ -357,7 +489,7 @@ void DiffractionFocussing2::execEvent() {
 
     totalHistProcess += static_cast<int>(indices.size());
     for (auto index : indices) {
-      size_required[iGroup] += m_eventW->getSpectrum(index).getNumberEvents();
+      size_required[iGroup] += m_eventW->getNumberEvents(index);
     }
     prog->report(1, "Pre-counting");
   }
@@ -409,7 +541,7 @@ void DiffractionFocussing2::execEvent() {
       for (int i = wiChunk * chunkSize; i < max; i++) {
         // Accumulate the chunk
         size_t wi = indices[i];
-        chunkEL += m_eventW->getSpectrum(wi);
+        m_eventW->addEventsTo(wi, chunkEL);
       }
 
       // Rejoin the chunk with the rest.
@@ -430,7 +562,7 @@ void DiffractionFocussing2::execEvent() {
       const std::vector<size_t> &indices = this->m_wsIndices[iGroup];
       for (auto wi : indices) {
         // In workspace index iGroup, put what was in the OLD workspace index wi
-        out->getSpectrum(iGroup) += m_eventW->getSpectrum(wi);
+        m_eventW->addEventsTo(wi, out->getSpectrum(iGroup));
 
         prog->reportIncrement(1, "Appending Lists");
 
@@ -482,6 +614,31 @@ void DiffractionFocussing2::execEvent() {
   setProperty("OutputWorkspace", std::move(out));
 }
 
+//=============================================================================
+/** Range of the X values of the input workspace. For a distributed workspace
+ * this is the range of the spectra of all ranks.
+ * @param xmin :: set to the smallest X value
+ * @param xmax :: set to the largest X value
+ */
+void DiffractionFocussing2::getXMinMax(double &xmin, double &xmax) const {
+  if (m_matrixInputW->storageMode() != Parallel::StorageMode::Distributed)
+    return m_matrixInputW->getXMinMax(xmin, xmax);
+
+  double minimum = std::numeric_limits<double>::max();
+  double maximum = std::numeric_limits<double>::lowest();
+  for (size_t i = 0; i < m_matrixInputW->getNumberHistograms(); ++i) {
+    const auto &x = m_matrixInputW->x(i);
+    if (std::isfinite(x.front()) && std::isfinite(x.back())) {
+      minimum = std::min(minimum, x.front());
+      maximum = std::max(maximum, x.back());
+    }
+  }
+  Parallel::all_reduce(communicator(), minimum, xmin,
+                       [](double a, double b) { return std::min(a, b); });
+  Parallel::all_reduce(communicator(), maximum, xmax,
+                       [](double a, double b) { return std::max(a, b); });
+}
+
 //=============================================================================
 /** Verify that all the contributing detectors to a spectrum belongs to the same
  * group
@@ -584,6 +741,31 @@ void DiffractionFocussing2::determineRebinParameters() {
       (gpit->second).second = temp;
   }
 
+  // The ranges of a distributed workspace must cover the spectra of all
+  // ranks, and all ranks must agree on the groups
+  if (m_matrixInputW->storageMode() == Parallel::StorageMode::Distributed) {
+    // nGroups is still the largest group number
+    const size_t numGroupNumbers = static_cast<size_t>(nGroups) + 1;
+    std::vector<double> mins(numGroupNumbers, BIGGEST);
+    std::vector<double> maxs(numGroupNumbers, -1. * BIGGEST);
+    for (const auto &range : group2minmax) {
+      mins[range.first] = range.second.first;
+      maxs[range.first] = range.second.second;
+    }
+    std::vector<double> allMins(numGroupNumbers);
+    std::vector<double> allMaxs(numGroupNumbers);
+    const int n = static_cast<int>(numGroupNumbers);
+    Parallel::all_reduce(communicator(), mins.data(), n, allMins.data(),
+                         [](double a, double b) { return std::min(a, b); });
+    Parallel::all_reduce(communicator(), maxs.data(), n, allMaxs.data(),
+                         [](double a, double b) { return std::max(a, b); });
+    group2minmax.clear();
+    for (size_t group = 0; group < numGroupNumbers; ++group)
+      if (allMins[group] != BIGGEST)
+        group2minmax.emplace(static_cast<int>(group),
+                             std::make_pair(allMins[group], allMaxs[group]));
+  }
+
   nGroups = group2minmax.size(); // Number of unique groups
 
   double Xmin, Xmax, step;
@@ -651,23 +833,31 @@ size_t DiffractionFocussing2::setupGroupToWSIndices() {
     this->m_wsIndices[group].push_back(wi);
   }
 
-  // initialize a vector of the valid group numbers
+  // initialize a vector of the valid group numbers. These are the groups with
+  // X ranges, as a group of a distributed workspace may have no spectra on
+  // this rank.
   this->m_validGroups.reserve(nGroups);
+  std::vector<std::vector<size_t>> wsIndices;
+  wsIndices.reserve(nGroups);
   size_t totalHistProcess = 0;
-  for (size_t i = 0; i < this->m_wsIndices.size(); i++) {
-    if (!(this->m_wsIndices[i].empty())) {
-      this->m_validGroups.push_back(static_cast<int>(i));
-      totalHistProcess += this->m_wsIndices[i].size();
-    }
+  for (const auto &groupX : group2xvector) {
+    const auto group = static_cast<size_t>(groupX.first);
+    this->m_validGroups.push_back(groupX.first);
+    wsIndices.emplace_back();
+    if (group < this->m_wsIndices.size())
+      wsIndices.back().swap(this->m_wsIndices[group]);
+    totalHistProcess += wsIndices.back().size();
   }
-
-  m_wsIndices.erase(
-      std::remove_if(m_wsIndices.begin(), m_wsIndices.end(),
-                     [](const std::vector<size_t> &v) { return v.empty(); }),
-      m_wsIndices.end());
+  m_wsIndices.swap(wsIndices);
 
   return totalHistProcess;
 }
 
+Parallel::ExecutionMode DiffractionFocussing2::getParallelExecutionMode(
+    const std::map<std::string, Parallel::StorageMode> &storageModes) const {
+  return Parallel::getCorrespondingExecutionMode(
+      storageModes.at("InputWorkspace"));
+}
+
 } // namespace Algorithm
 } // namespace Mantid
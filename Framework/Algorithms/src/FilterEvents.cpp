@@ -60,7 +60,7 @@ FilterEvents::FilterEvents()
       m_vecSplitterTime(), m_vecSplitterGroup(), m_splitSampleLogs(false),
       m_useDBSpectrum(false), m_dbWSIndex(-1), m_tofCorrType(),
       m_specSkipType(), m_vecSkip(), m_isSplittersRelativeTime(false),
-      m_filterStartTime(0), m_runStartTime(0) {}
+      m_filterStartTime(0), m_runStartTime(0), m_outputSlices(false) {}
 
 /** Declare Inputs
  */
@@ -169,6 +169,13 @@ void FilterEvents::init() {
                   "If true, all the TimeSeriesProperty logs listed will be "
                   "excluded from duplicating. "
                   "Otherwise, only those specified logs will be split.");
+
+  declareProperty("OutputSlices", false,
+                  "If true, the output workspaces share the events of one "
+                  "sorted copy of the input workspace rather than holding "
+                  "copies of them. The events of a spectrum are copied when "
+                  "it is first accessed; Rebin, SumSpectra and "
+                  "DiffractionFocussing read the shared events directly.");
 }
 
 /** Execution body
@@ -221,11 +228,15 @@ void FilterEvents::exec() {
     progressamount = 0.7;
 
   std::vector<Kernel::TimeSeriesProperty<int> *> split_tsp_vector;
+  if (m_outputSlices)
+    filterEventsAsSlices(progressamount);
   if (m_useSplittersWorkspace) {
-    filterEventsBySplitters(progressamount);
+    if (!m_outputSlices)
+      filterEventsBySplitters(progressamount);
     generateSplitterTSPalpha(split_tsp_vector);
   } else {
-    filterEventsByVectorSplitters(progressamount);
+    if (!m_outputSlices)
+      filterEventsByVectorSplitters(progressamount);
     generateSplitterTSP(split_tsp_vector);
   }
 
@@ -359,6 +370,7 @@ void FilterEvents::processAlgorithmProperties() {
 
   m_outputWSNameBase = this->getPropertyValue("OutputWorkspaceBaseName");
   m_filterByPulseTime = this->getProperty("FilterByPulseTime");
+  m_outputSlices = this->getProperty("OutputSlices");
 
   m_toGroupWS = this->getProperty("GroupWorkspaces");
 
@@ -1599,23 +1611,7 @@ void FilterEvents::filterEventsByVectorSplitters(double progressamount) {
                     "input/source EventWorkspace = " << numberOfSpectra
                  << ".\n";
 
-  // check for option FilterByTime
-  if (m_filterByPulseTime) {
-    size_t num_proton_charges =
-        m_eventWS->run().getProperty("proton_charge")->size();
-    if (num_proton_charges < m_vecSplitterTime.size()) {
-      // throw an exception if there more splitters than proton charges
-      std::stringstream errmsg;
-      errmsg << "It is not proper to split fast event 'By PulseTime'', when "
-                "there are "
-                "more splitters (" << m_vecSplitterTime.size()
-             << ") than pulse time "
-                "log entries (" << num_proton_charges << ")";
-      throw runtime_error(errmsg.str());
-    } else
-      g_log.warning("User should understand the inaccurancy to filter events "
-                    "by pulse time.");
-  }
+  checkVectorSplittersForPulseTime();
 
   PARALLEL_FOR_NO_WSP_CHECK()
   for (int64_t iws = 0; iws < int64_t(numberOfSpectra); ++iws) {
@@ -1681,6 +1677,92 @@ void FilterEvents::filterEventsByVectorSplitters(double progressamount) {
   return;
 }
 
+/** Check that there are few enough vector splitters to filter by pulse time,
+ * if the events are filtered by pulse time
+ */
+void FilterEvents::checkVectorSplittersForPulseTime() const {
+  // check for option FilterByTime
+  if (m_filterByPulseTime) {
+    size_t num_proton_charges =
+        m_eventWS->run().getProperty("proton_charge")->size();
+    if (num_proton_charges < m_vecSplitterTime.size()) {
+      // throw an exception if there more splitters than proton charges
+      std::stringstream errmsg;
+      errmsg << "It is not proper to split fast event 'By PulseTime'', when "
+                "there are "
+                "more splitters (" << m_vecSplitterTime.size()
+             << ") than pulse time "
+                "log entries (" << num_proton_charges << ")";
+      throw runtime_error(errmsg.str());
+    } else
+      g_log.warning("User should understand the inaccurancy to filter events "
+                    "by pulse time.");
+  }
+}
+
+/** Split events into slices: the output workspaces refer to index ranges of
+ * the events of one sorted copy of the input instead of holding copies of the
+ * events. Works with splitters of either format.
+ */
+void FilterEvents::filterEventsAsSlices(double progressamount) {
+  if (!m_useSplittersWorkspace)
+    checkVectorSplittersForPulseTime();
+
+  // The outputs share a private copy of the sorted input, so that changes to
+  // the input after filtering do not change them
+  EventWorkspace_const_sptr parent(m_eventWS->clone().release());
+  const size_t numberOfSpectra = parent->getNumberHistograms();
+  g_log.debug() << "Slice events of " << numberOfSpectra << " spectra into "
+                << m_outputWorkspacesMap.size() << " output workspaces.\n";
+
+  // Index ranges of the events of each output, by workspace index
+  std::map<int, std::vector<EventIndexRanges>> slices;
+  for (const auto &ws : m_outputWorkspacesMap)
+    slices[ws.first].resize(numberOfSpectra);
+
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int64_t iws = 0; iws < int64_t(numberOfSpectra); ++iws) {
+    PARALLEL_START_INTERUPT_REGION
+
+    // Filter the non-skipped spectrum
+    if (!m_vecSkip[iws]) {
+      std::map<int, EventIndexRanges> ranges;
+      for (const auto &slice : slices)
+        ranges.emplace(slice.first, EventIndexRanges());
+
+      const DataObjects::EventList &input_el = parent->getSpectrum(iws);
+      const bool correct = m_tofCorrType != NoneCorrect;
+      const double factor = correct ? m_detTofFactors[iws] : 1.0;
+      const double shift = correct ? m_detTofOffsets[iws] : 0.0;
+      if (!m_useSplittersWorkspace) {
+        const std::string logmessage =
+            input_el.splitRangesByFullTimeMatrixSplitter(
+                m_vecSplitterTime, m_vecSplitterGroup, ranges, correct,
+                factor, shift);
+        if (m_useDBSpectrum && iws == static_cast<int64_t>(m_dbWSIndex))
+          g_log.notice(logmessage);
+      } else if (m_filterByPulseTime) {
+        input_el.splitRangesByPulseTime(m_splitters, ranges);
+      } else {
+        input_el.splitRangesByFullTime(m_splitters, ranges, correct, factor,
+                                       shift);
+      }
+
+      // Each thread writes its own spectrum, so no lock is needed
+      for (auto &range : ranges)
+        slices.at(range.first)[iws] = std::move(range.second);
+    }
+
+    PARALLEL_END_INTERUPT_REGION
+  } // END FOR i = 0
+  PARALLEL_CHECK_INTERUPT_REGION
+
+  for (auto &ws : m_outputWorkspacesMap)
+    ws.second->setSliceOf(parent, std::move(slices.at(ws.first)));
+
+  progress(0.1 + progressamount, "Splitting logs");
+}
+
 //----------------------------------------------------------------------------------------------
 /** Generate a vector of integer time series property for each splitter
  * corresponding to each target (in integer)
@@ -25,6 +25,8 @@
 #include "MantidKernel/PhysicalConstants.h"
 #include "MantidKernel/VectorHelper.h"
 
+#include <algorithm>
+
 using namespace Mantid::API;
 using namespace Mantid::Geometry;
 using namespace Mantid::Kernel;
@@ -42,6 +44,8 @@ constexpr int DEFAULT_NEVENTS = 300;
 constexpr int DEFAULT_SEED = 123456789;
 constexpr int DEFAULT_LATITUDINAL_DETS = 5;
 constexpr int DEFAULT_LONGITUDINAL_DETS = 10;
+/// Upper limit on the number of events whose paths are kept in memory
+constexpr size_t MAX_EVENTS_PER_BATCH = 1000000;
 
 /// Energy (meV) to wavelength (angstroms)
 inline double toWavelength(double energy) {
@@ -227,48 +231,89 @@ MatrixWorkspace_uptr MonteCarloAbsorption::doSimulation(
 
   const auto &spectrumInfo = simulationWS.spectrumInfo();
 
+  // Indices of the simulated wavelength points, ensuring we have the last
+  // point for the interpolation
+  std::vector<int> lambdaIndices;
+  for (int j = 0; j < nbins; j += lambdaStepSize) {
+    lambdaIndices.push_back(j);
+    if (lambdaStepSize > 1 && j + lambdaStepSize >= nbins && j + 1 != nbins) {
+      j = nbins - lambdaStepSize - 1;
+    }
+  }
+
+  // Per spectrum values
+  std::vector<double> lambdaFixed(static_cast<size_t>(nhists), 0.0);
   PARALLEL_FOR_IF(Kernel::threadSafe(simulationWS))
   for (int64_t i = 0; i < nhists; ++i) {
     PARALLEL_START_INTERUPT_REGION
-
-    auto &outE = simulationWS.mutableE(i);
     // The input was cloned so clear the errors out
-    outE = 0.0;
-    // Final detector position
-    if (!spectrumInfo.hasDetectors(i)) {
-      continue;
+    simulationWS.mutableE(i) = 0.0;
+    if (spectrumInfo.hasDetectors(i)) {
+      lambdaFixed[i] =
+          toWavelength(efixed.value(spectrumInfo.detector(i).getID()));
+    }
+    PARALLEL_END_INTERUPT_REGION
+  }
+  PARALLEL_CHECK_INTERUPT_REGION
+
+  // The scatter points and incoming tracks of the events do not depend on
+  // the detector. They are generated for a batch of wavelength points from a
+  // single random number stream, which gives every detector the same events
+  // as it would get from its own generator seeded with the same value, and
+  // then reused for all detectors.
+  MersenneTwister rng(seed);
+  MCScatterPaths paths;
+  const size_t pointsPerBatch =
+      std::max<size_t>(1, MAX_EVENTS_PER_BATCH / std::max<size_t>(1, nevents));
+  for (size_t batchStart = 0; batchStart < lambdaIndices.size();
+       batchStart += pointsPerBatch) {
+    const size_t batchEnd =
+        std::min(lambdaIndices.size(), batchStart + pointsPerBatch);
+    paths.clear();
+    for (size_t point = batchStart; point < batchEnd; ++point) {
+      strategy.generateScatterPaths(rng, paths);
     }
-    // Per spectrum values
-    const auto &detPos = spectrumInfo.position(i);
-    const double lambdaFixed =
-        toWavelength(efixed.value(spectrumInfo.detector(i).getID()));
-    MersenneTwister rng(seed);
-
-    auto &outY = simulationWS.mutableY(i);
-    const auto lambdas = simulationWS.points(i);
-    // Simulation for each requested wavelength point
-    for (int j = 0; j < nbins; j += lambdaStepSize) {
-      prog.report(reportMsg);
-      const double lambdaStep = lambdas[j];
-      double lambdaIn(lambdaStep), lambdaOut(lambdaStep);
-      if (efixed.emode() == DeltaEMode::Direct) {
-        lambdaIn = lambdaFixed;
-      } else if (efixed.emode() == DeltaEMode::Indirect) {
-        lambdaOut = lambdaFixed;
-      } else {
-        // elastic case already initialized
-      }
-      std::tie(outY[j], std::ignore) =
-          strategy.calculate(rng, detPos, lambdaIn, lambdaOut);
 
-      // Ensure we have the last point for the interpolation
-      if (lambdaStepSize > 1 && j + lambdaStepSize >= nbins && j + 1 != nbins) {
-        j = nbins - lambdaStepSize - 1;
+    PARALLEL_FOR_IF(Kernel::threadSafe(simulationWS))
+    for (int64_t i = 0; i < nhists; ++i) {
+      PARALLEL_START_INTERUPT_REGION
+      // Final detector position
+      if (!spectrumInfo.hasDetectors(i)) {
+        continue;
       }
+      const auto &detPos = spectrumInfo.position(i);
+      auto &outY = simulationWS.mutableY(i);
+      const auto lambdas = simulationWS.points(i);
+      // Simulation for each requested wavelength point
+      for (size_t point = batchStart; point < batchEnd; ++point) {
+        prog.report(reportMsg);
+        const int j = lambdaIndices[point];
+        const double lambdaStep = lambdas[j];
+        double lambdaIn(lambdaStep), lambdaOut(lambdaStep);
+        if (efixed.emode() == DeltaEMode::Direct) {
+          lambdaIn = lambdaFixed[i];
+        } else if (efixed.emode() == DeltaEMode::Indirect) {
+          lambdaOut = lambdaFixed[i];
+        } else {
+          // elastic case already initialized
+        }
+        std::tie(outY[j], std::ignore) =
+            strategy.calculate(paths, (point - batchStart) * nevents, detPos,
+                               lambdaIn, lambdaOut);
+      }
+      PARALLEL_END_INTERUPT_REGION
     }
+    PARALLEL_CHECK_INTERUPT_REGION
+  }
 
-    // Interpolate through points not simulated
-    if (!useSparseInstrument && lambdaStepSize > 1) {
+  // Interpolate through points not simulated
+  if (!useSparseInstrument && lambdaStepSize > 1) {
+    PARALLEL_FOR_IF(Kernel::threadSafe(simulationWS))
+    for (int64_t i = 0; i < nhists; ++i) {
+      PARALLEL_START_INTERUPT_REGION
+      if (!spectrumInfo.hasDetectors(i)) {
+        continue;
+      }
       auto histnew = simulationWS.histogram(i);
       if (lambdaStepSize < nbins) {
         interpolateOpt.applyInplace(histnew, lambdaStepSize);
@@ -278,11 +323,10 @@ MatrixWorkspace_uptr MonteCarloAbsorption::doSimulation(
       }
 
       outputWS->setHistogram(i, histnew);
+      PARALLEL_END_INTERUPT_REGION
     }
-
-    PARALLEL_END_INTERUPT_REGION
+    PARALLEL_CHECK_INTERUPT_REGION
   }
-  PARALLEL_CHECK_INTERUPT_REGION
 
   if (useSparseInstrument) {
     interpolateFromSparse(*outputWS, simulationWS, interpolateOpt, *detGrid);
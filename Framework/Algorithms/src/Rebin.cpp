@@ -5,7 +5,6 @@
 #include "MantidAPI/Axis.h"
 #include "MantidAPI/HistoWorkspace.h"
 #include "MantidDataObjects/Workspace2D.h"
-#include "MantidDataObjects/EventList.h"
 #include "MantidDataObjects/EventWorkspace.h"
 #include "MantidDataObjects/WorkspaceCreation.h"
 #include "MantidKernel/ArrayProperty.h"
@@ -25,7 +24,6 @@ using HistogramData::BinEdges;
 using HistogramData::Frequencies;
 using HistogramData::FrequencyStandardDeviations;
 using HistogramData::Exception::InvalidBinEdgesError;
-using DataObjects::EventList;
 using DataObjects::EventWorkspace;
 using DataObjects::EventWorkspace_sptr;
 using DataObjects::EventWorkspace_const_sptr;
@@ -183,11 +181,11 @@ void Rebin::exec() {
       PARALLEL_FOR_IF(Kernel::threadSafe(*inputWS, *outputWS))
       for (int i = 0; i < histnumber; ++i) {
         PARALLEL_START_INTERUPT_REGION
-        // Get a const event list reference. eventInputWS->dataY() doesn't work.
-        const EventList &el = eventInputWS->getSpectrum(i);
         MantidVec y_data, e_data;
-        // The EventList takes care of histogramming.
-        el.generateHistogram(XValues_new.rawData(), y_data, e_data);
+        // The EventList takes care of histogramming. The events of a slice
+        // are binned without being copied.
+        eventInputWS->generateHistogram(i, XValues_new.rawData(), y_data,
+                                        e_data);
 
         // Copy the data over.
         outputWS->mutableY(i) = std::move(y_data);
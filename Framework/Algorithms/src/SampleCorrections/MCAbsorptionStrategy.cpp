@@ -44,27 +44,59 @@ std::tuple<double, double>
 MCAbsorptionStrategy::calculate(Kernel::PseudoRandomNumberGenerator &rng,
                                 const Kernel::V3D &finalPos,
                                 double lambdaBefore, double lambdaAfter) const {
+  MCScatterPaths paths;
+  generateScatterPaths(rng, paths);
+  return calculate(paths, 0, finalPos, lambdaBefore, lambdaAfter);
+}
+
+/**
+ * Generate the scatter points and incoming tracks of the events of one
+ * point and append them to a batch
+ * @param rng A reference to a PseudoRandomNumberGenerator
+ * @param paths The batch to append the events to
+ */
+void MCAbsorptionStrategy::generateScatterPaths(
+    Kernel::PseudoRandomNumberGenerator &rng, MCScatterPaths &paths) const {
   const auto scatterBounds = m_scatterVol.getBoundingBox();
-  double factor(0.0);
   for (size_t i = 0; i < m_nevents; ++i) {
     size_t attempts(0);
     do {
       const auto neutron = m_beamProfile.generatePoint(rng, scatterBounds);
-
-      const double wgt = m_scatterVol.calculateAbsorption(
-          rng, neutron.startPos, finalPos, lambdaBefore, lambdaAfter);
-      if (wgt < 0.0) {
-        ++attempts;
-      } else {
-        factor += wgt;
+      if (m_scatterVol.generateScatterPath(rng, neutron.startPos, paths)) {
         break;
       }
+      ++attempts;
       if (attempts == MAX_EVENT_ATTEMPTS) {
         throw std::runtime_error("Unable to generate valid track through "
                                  "sample interaction volume.");
       }
     } while (true);
   }
+}
+
+/**
+ * Compute the correction for a final position of the neutron and wavelengths
+ * before and after scattering, from events generated by
+ * generateScatterPaths()
+ * @param paths The batch holding the events
+ * @param firstEvent Index of the first of the nevents events to use
+ * @param finalPos Defines the final position of the neutron, assumed to be
+ * where it is detected
+ * @param lambdaBefore Wavelength, in \f$\\A^-1\f$, before scattering
+ * @param lambdaAfter Wavelength, in \f$\\A^-1\f$, after scattering
+ * @return A tuple of the <correction factor, associated error>.
+ */
+std::tuple<double, double> MCAbsorptionStrategy::calculate(
+    const MCScatterPaths &paths, size_t firstEvent,
+    const Kernel::V3D &finalPos, double lambdaBefore,
+    double lambdaAfter) const {
+  const auto muBefore = paths.attenuationCoefficients(lambdaBefore);
+  const auto muAfter = paths.attenuationCoefficients(lambdaAfter);
+  double factor(0.0);
+  for (size_t i = firstEvent; i < firstEvent + m_nevents; ++i) {
+    factor += m_scatterVol.calculateAbsorption(paths, i, finalPos, muBefore,
+                                               muAfter, lambdaAfter);
+  }
   using std::make_tuple;
   return make_tuple(factor / static_cast<double>(m_nevents), m_error);
 }
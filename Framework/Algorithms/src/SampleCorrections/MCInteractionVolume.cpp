@@ -6,6 +6,8 @@
 #include "MantidKernel/Material.h"
 #include "MantidKernel/PseudoRandomNumberGenerator.h"
 
+#include <algorithm>
+
 namespace Mantid {
 using Geometry::Track;
 using Kernel::V3D;
@@ -18,15 +20,27 @@ namespace {
 constexpr size_t MAX_SCATTER_ATTEMPTS = 500;
 
 /**
- * Compute the attenuation factor for the given coefficients
- * @param rho Number density of the sample in \f$\\A^{-3}\f$
- * @param sigma Cross-section in barns
+ * Compute the attenuation coefficient of a material
+ * @param material The material
+ * @param lambda Wavelength, in \f$\\A^-1\f$
+ * @return The coefficient in \f$m^{-1}\f$
+ */
+double attenuationCoefficient(const Kernel::Material &material,
+                              double lambda) {
+  return 100 * material.numberDensity() *
+         (material.totalScatterXSection(lambda) +
+          material.absorbXSection(lambda));
+}
+
+/**
+ * Compute the attenuation factor for the given coefficient
+ * @param mu Attenuation coefficient in \f$m^{-1}\f$
  * @param length Path length in metres
  * @return The dimensionless attenuated fraction
  */
-double attenuation(double rho, double sigma, double length) {
+double attenuation(double mu, double length) {
   using std::exp;
-  return exp(-100 * rho * sigma * length);
+  return exp(-mu * length);
 }
 }
 
@@ -81,6 +95,29 @@ const Geometry::BoundingBox &MCInteractionVolume::getBoundingBox() const {
 double MCInteractionVolume::calculateAbsorption(
     Kernel::PseudoRandomNumberGenerator &rng, const Kernel::V3D &startPos,
     const Kernel::V3D &endPos, double lambdaBefore, double lambdaAfter) const {
+  MCScatterPaths paths;
+  if (!generateScatterPath(rng, startPos, paths)) {
+    return -1.0;
+  }
+  return calculateAbsorption(paths, 0, endPos,
+                             paths.attenuationCoefficients(lambdaBefore),
+                             paths.attenuationCoefficients(lambdaAfter),
+                             lambdaAfter);
+}
+
+/**
+ * Generate a scatter point and the track leading to it from a start point,
+ * and append them to a batch of paths.
+ * @param rng A reference to a PseudoRandomNumberGenerator producing
+ * random number between [0,1]
+ * @param startPos Origin of the initial track
+ * @param paths The batch to append to
+ * @return False if no valid track was found, in which case paths is not
+ * modified
+ */
+bool MCInteractionVolume::generateScatterPath(
+    Kernel::PseudoRandomNumberGenerator &rng, const Kernel::V3D &startPos,
+    MCScatterPaths &paths) const {
   // Generate scatter point. If there is an environment present then
   // first select whether the scattering occurs on the sample or the
   // environment. The attenuation for the path leading to the scatter point
@@ -105,25 +142,46 @@ double MCInteractionVolume::calculateAbsorption(
   // This should not happen but numerical precision means that it can
   // occasionally occur with tracks that are very close to the surface
   if (nlinks == 0) {
-    return -1.0;
+    return false;
   }
 
-  // Function to calculate total attenuation for a track
-  auto calculateAttenuation = [](const Track &path, double lambda) {
-    double factor(1.0);
-    for (const auto &segment : path) {
-      const double length = segment.distInsideObject;
-      const auto &segObj = *(segment.object);
-      const auto &segMat = segObj.material();
-      factor *= attenuation(segMat.numberDensity(),
-                            segMat.totalScatterXSection(lambda) +
-                                segMat.absorbXSection(lambda),
-                            length);
-    }
-    return factor;
-  };
+  paths.scatterPos.push_back(scatterPos);
+  for (const auto &segment : beforeScatter) {
+    paths.segmentLength.push_back(segment.distInsideObject);
+    paths.segmentObject.push_back(paths.objectIndex(*(segment.object)));
+  }
+  paths.firstSegment.push_back(paths.segmentLength.size());
+  return true;
+}
+
+/**
+ * Calculate the attenuation correction factor for an event of a batch of
+ * paths and an end point.
+ * @param paths The batch holding the scatter point and the incoming track
+ * @param event Index of the event in the batch
+ * @param endPos Final position of neutron after scattering (assumed to be
+ * outside of the "volume")
+ * @param muBefore Attenuation coefficients of the objects of the batch
+ * before scattering, from MCScatterPaths::attenuationCoefficients
+ * @param muAfter Attenuation coefficients of the objects of the batch after
+ * scattering
+ * @param lambdaAfter Wavelength, in \f$\\A^-1\f$, after scattering, used for
+ * objects that are not part of the batch
+ * @return The fraction of the beam that has been attenuated
+ */
+double MCInteractionVolume::calculateAbsorption(
+    const MCScatterPaths &paths, size_t event, const Kernel::V3D &endPos,
+    const std::vector<double> &muBefore, const std::vector<double> &muAfter,
+    double lambdaAfter) const {
+  double factor(1.0);
+  for (size_t i = paths.firstSegment[event]; i < paths.firstSegment[event + 1];
+       ++i) {
+    factor *= attenuation(muBefore[paths.segmentObject[i]],
+                          paths.segmentLength[i]);
+  }
 
   // Now track to final destination
+  const auto &scatterPos = paths.scatterPos[event];
   V3D scatteredDirec = endPos - scatterPos;
   scatteredDirec.normalize();
   Track afterScatter(scatterPos, scatteredDirec);
@@ -131,8 +189,59 @@ double MCInteractionVolume::calculateAbsorption(
   if (m_env) {
     m_env->interceptSurfaces(afterScatter);
   }
-  return calculateAttenuation(beforeScatter, lambdaBefore) *
-         calculateAttenuation(afterScatter, lambdaAfter);
+  const auto begin = paths.objects.cbegin();
+  const auto end = paths.objects.cend();
+  for (const auto &segment : afterScatter) {
+    const auto known = std::find(begin, end, segment.object);
+    double mu(0.0);
+    if (known != end) {
+      mu = muAfter[static_cast<size_t>(std::distance(begin, known))];
+    } else {
+      mu = attenuationCoefficient(segment.object->material(), lambdaAfter);
+    }
+    factor *= attenuation(mu, segment.distInsideObject);
+  }
+  return factor;
+}
+
+/// Remove all events and objects
+void MCScatterPaths::clear() {
+  scatterPos.clear();
+  firstSegment.assign(1, 0);
+  segmentLength.clear();
+  segmentObject.clear();
+  objects.clear();
+  materials.clear();
+}
+
+/**
+ * Find an object in the batch, adding it and its material if it is new.
+ * @param object An object crossed by a segment
+ * @return The index of the object
+ */
+size_t MCScatterPaths::objectIndex(const Geometry::Object &object) {
+  const auto known = std::find(objects.cbegin(), objects.cend(), &object);
+  if (known != objects.cend()) {
+    return static_cast<size_t>(std::distance(objects.cbegin(), known));
+  }
+  objects.push_back(&object);
+  materials.push_back(object.material());
+  return objects.size() - 1;
+}
+
+/**
+ * Compute the attenuation coefficients of the objects of the batch
+ * @param lambda Wavelength, in \f$\\A^-1\f$
+ * @return The coefficient of each object in \f$m^{-1}\f$
+ */
+std::vector<double>
+MCScatterPaths::attenuationCoefficients(double lambda) const {
+  std::vector<double> mu;
+  mu.reserve(materials.size());
+  for (const auto &material : materials) {
+    mu.push_back(attenuationCoefficient(material, lambda));
+  }
+  return mu;
 }
 
 } // namespace Algorithms
@@ -4,10 +4,21 @@
 #include "MantidAPI/SpectrumInfo.h"
 #include "MantidAPI/WorkspaceFactory.h"
 #include "MantidDataObjects/RebinnedOutput.h"
+#include "MantidDataObjects/Workspace2D.h"
 #include "MantidDataObjects/WorkspaceCreation.h"
 #include "MantidGeometry/IDetector.h"
+#include "MantidHistogramData/Collectives.h"
+#include "MantidIndexing/GlobalSpectrumIndex.h"
+#include "MantidIndexing/IndexInfo.h"
 #include "MantidKernel/ArrayProperty.h"
 #include "MantidKernel/BoundedValidator.h"
+#include "MantidParallel/Collectives.h"
+#include "MantidParallel/Communicator.h"
+#include "MantidTypes/SpectrumDefinition.h"
+
+#include <boost/serialization/vector.hpp>
+
+#include <limits>
 
 namespace Mantid {
 namespace Algorithms {
@@ -86,7 +97,9 @@ std::map<std::string, std::string> SumSpectra::validateInputs() {
   std::map<std::string, std::string> validationOutput;
 
   MatrixWorkspace_const_sptr localworkspace = getProperty("InputWorkspace");
-  m_numberOfSpectra = static_cast<int>(localworkspace->getNumberHistograms());
+  // The indices refer to all spectra, also those on other ranks
+  m_numberOfSpectra =
+      static_cast<int>(localworkspace->indexInfo().globalSize());
   const int minIndex = getProperty("StartWorkspaceIndex");
   const int maxIndex = getProperty("EndWorkspaceIndex");
 
@@ -132,11 +145,6 @@ std::map<std::string, std::string> SumSpectra::validateInputs() {
  *
  */
 void SumSpectra::exec() {
-  // Try and retrieve the optional properties
-  m_minWsInd = getProperty("StartWorkspaceIndex");
-  m_maxWsInd = getProperty("EndWorkspaceIndex");
-  const std::vector<int> indices_list = getProperty("ListOfWorkspaceIndices");
-
   m_keepMonitors = getProperty("IncludeMonitors");
   m_replaceSpecialValues = getProperty("RemoveSpecialValues");
 
@@ -146,33 +154,7 @@ void SumSpectra::exec() {
   m_numberOfSpectra = static_cast<int>(localworkspace->getNumberHistograms());
   m_yLength = static_cast<int>(localworkspace->blocksize());
 
-  // Check 'StartSpectrum' is in range 0-m_numberOfSpectra
-  if (m_minWsInd >= m_numberOfSpectra) {
-    g_log.warning("StartWorkspaceIndex out of range! Set to 0.");
-    m_minWsInd = 0;
-  }
-
-  if (indices_list.empty()) {
-    // If no list was given and no max, just do all.
-    if (isEmpty(m_maxWsInd))
-      m_maxWsInd = m_numberOfSpectra - 1;
-  }
-
-  // Something for m_maxWsIndex was given but it is out of range?
-  if (!isEmpty(m_maxWsInd) &&
-      (m_maxWsInd > m_numberOfSpectra - 1 || m_maxWsInd < m_minWsInd)) {
-    g_log.warning("EndWorkspaceIndex out of range! Set to max Workspace Index");
-    m_maxWsInd = m_numberOfSpectra - 1;
-  }
-
-  // Make the set of indices to sum up from the list
-  m_indices.insert(indices_list.begin(), indices_list.end());
-
-  // And add the range too, if any
-  if (!isEmpty(m_maxWsInd)) {
-    for (int i = m_minWsInd; i <= m_maxWsInd; i++)
-      m_indices.insert(i);
-  }
+  determineIndices();
 
   // determine the output spectrum number
   m_outSpecNum = getOutputSpecNo(localworkspace);
@@ -241,6 +223,182 @@ void SumSpectra::exec() {
   }
 }
 
+/** Sums the spectra of a distributed workspace. Each rank sums its own
+ * spectra and the partial sums are added up on rank 0, which holds the
+ * output. Events are summed as histograms.
+ */
+void SumSpectra::execDistributed() {
+  m_keepMonitors = getProperty("IncludeMonitors");
+  m_replaceSpecialValues = getProperty("RemoveSpecialValues");
+  m_calculateWeightedSum = false;
+
+  MatrixWorkspace_const_sptr localworkspace = getProperty("InputWorkspace");
+  const bool isEvents = localworkspace->id() == "EventWorkspace";
+  if (localworkspace->id() == "RebinnedOutput")
+    throw std::runtime_error("SumSpectra: RebinnedOutput workspaces cannot be "
+                             "summed over ranks.");
+  const bool weightedSum = getProperty("WeightedSum");
+  if (weightedSum && !isEvents)
+    throw std::runtime_error(
+        "SumSpectra: WeightedSum is not supported for distributed workspaces.");
+
+  // The indices are global, select those on this rank
+  const auto &indexInfo = localworkspace->indexInfo();
+  m_numberOfSpectra = static_cast<int>(indexInfo.globalSize());
+  determineIndices();
+  const std::vector<Indexing::GlobalSpectrumIndex> globalIndices(
+      m_indices.begin(), m_indices.end());
+  m_indices.clear();
+  for (const auto index : indexInfo.makeIndexSet(globalIndices))
+    m_indices.insert(static_cast<int>(index));
+  m_numberOfSpectra = static_cast<int>(localworkspace->getNumberHistograms());
+  // A rank may hold no spectra, take the bin count from the others
+  const auto &comm = communicator();
+  const int localYLength =
+      m_numberOfSpectra > 0 ? static_cast<int>(localworkspace->blocksize()) : 0;
+  Parallel::all_reduce(comm, localYLength, m_yLength,
+                       [](int a, int b) { return std::max(a, b); });
+  // The bin edges come from the first rank holding selected spectra, or
+  // else any spectra, which need not be the root
+  const int size = comm.size();
+  const int localSource =
+      !m_indices.empty() ? comm.rank()
+                         : (m_numberOfSpectra > 0 ? size + comm.rank()
+                                                  : 2 * size);
+  int source(0);
+  Parallel::all_reduce(comm, localSource, source,
+                       [](int a, int b) { return std::min(a, b); });
+  if (source == 2 * size)
+    throw std::runtime_error("SumSpectra: the workspace has no spectra.");
+  std::vector<double> binEdges(static_cast<size_t>(m_yLength) + 1);
+  if (comm.rank() == source % size) {
+    const auto &edges = localworkspace->binEdges(
+        m_indices.empty() ? 0 : static_cast<size_t>(*m_indices.begin()));
+    std::copy(edges.cbegin(), edges.cend(), binEdges.begin());
+  }
+  Parallel::broadcast(comm, binEdges.data(),
+                      static_cast<int>(binEdges.size()), source % size);
+
+  // Sum of this rank: the data and the squared errors. Ranks without selected
+  // spectra contribute zeros.
+  HistogramData::HistogramY partialY(static_cast<size_t>(m_yLength), 0.0);
+  HistogramData::HistogramE partialE(static_cast<size_t>(m_yLength), 0.0);
+  std::vector<detid_t> detectorIDs;
+  size_t numSpectra(0);
+  size_t numMasked(0);
+  size_t numZeros(0);
+  specnum_t specNo = std::numeric_limits<specnum_t>::max();
+  if (!m_indices.empty()) {
+    auto sum = create<HistoWorkspace>(
+        *localworkspace, 1, localworkspace->binEdges(*m_indices.begin()));
+    auto &outSpec = sum->getSpectrum(0);
+    outSpec.clearDetectorIDs();
+    Progress progress(this, 0.0, 1.0, m_indices.size());
+    doWorkspace2D(outSpec, progress, numSpectra, numMasked, numZeros);
+    partialY = outSpec.y();
+    partialE = outSpec.e();
+    detectorIDs.assign(outSpec.getDetectorIDs().begin(),
+                       outSpec.getDetectorIDs().end());
+    specNo = getOutputSpecNo(localworkspace);
+  }
+  const std::vector<int64_t> counts{static_cast<int64_t>(numSpectra),
+                                    static_cast<int64_t>(numMasked),
+                                    static_cast<int64_t>(numZeros)};
+  const auto minSpecNo = [](specnum_t a, specnum_t b) { return std::min(a, b); };
+
+  // All ranks run the collectives below in the same order
+  if (comm.rank() != 0) {
+    Parallel::reduce(comm, partialY, std::plus<double>(), 0);
+    Parallel::reduce(comm, partialE, std::plus<double>(), 0);
+    Parallel::reduce(comm, counts.data(), 3, std::plus<int64_t>(), 0);
+    Parallel::reduce(comm, specNo, minSpecNo, 0);
+    Parallel::gather(comm, detectorIDs, 0);
+    setProperty("OutputWorkspace", Kernel::make_unique<Workspace2D>(
+                                       Parallel::StorageMode::MasterOnly));
+    return;
+  }
+
+  HistogramData::HistogramY totalY(static_cast<size_t>(m_yLength));
+  HistogramData::HistogramE totalE(static_cast<size_t>(m_yLength));
+  std::vector<int64_t> totalCounts(3);
+  Parallel::reduce(comm, partialY, totalY, std::plus<double>(), 0);
+  Parallel::reduce(comm, partialE, totalE, std::plus<double>(), 0);
+  Parallel::reduce(comm, counts.data(), 3, totalCounts.data(),
+                   std::plus<int64_t>(), 0);
+  Parallel::reduce(comm, specNo, m_outSpecNum, minSpecNo, 0);
+  std::vector<std::vector<detid_t>> allDetectorIDs;
+  Parallel::gather(comm, detectorIDs, allDetectorIDs, 0);
+  g_log.information()
+      << "Spectra remapping gives single spectra with spectra number: "
+      << m_outSpecNum << "\n";
+
+  Indexing::IndexInfo outputIndexInfo(
+      std::vector<Indexing::SpectrumNumber>{m_outSpecNum},
+      Parallel::StorageMode::MasterOnly, comm);
+  outputIndexInfo.setSpectrumDefinitions(std::vector<SpectrumDefinition>(1));
+  auto outputWorkspace = create<HistoWorkspace>(
+      *localworkspace, outputIndexInfo,
+      HistogramData::BinEdges(std::move(binEdges)));
+  auto &outSpec = outputWorkspace->getSpectrum(0);
+  outSpec.mutableY() = std::move(totalY);
+  outSpec.mutableE() = std::move(totalE);
+  // take the square root of all the accumulated squared errors - Assumes
+  // Gaussian errors
+  auto &outE = outSpec.mutableE();
+  std::transform(outE.begin(), outE.end(), outE.begin(),
+                 static_cast<double (*)(double)>(std::sqrt));
+  for (const auto &ids : allDetectorIDs)
+    outSpec.addDetectorIDs(ids);
+
+  // set up the summing statistics
+  outputWorkspace->mutableRun().addProperty(
+      "NumAllSpectra", static_cast<int>(totalCounts[0]), "", true);
+  outputWorkspace->mutableRun().addProperty(
+      "NumMaskSpectra", static_cast<int>(totalCounts[1]), "", true);
+  outputWorkspace->mutableRun().addProperty(
+      "NumZeroSpectra", static_cast<int>(totalCounts[2]), "", true);
+
+  setProperty("OutputWorkspace", std::move(outputWorkspace));
+}
+
+/** Determines the set of indices to sum from the properties. The indices are
+ * checked against m_numberOfSpectra.
+ */
+void SumSpectra::determineIndices() {
+  // Try and retrieve the optional properties
+  m_minWsInd = getProperty("StartWorkspaceIndex");
+  m_maxWsInd = getProperty("EndWorkspaceIndex");
+  const std::vector<int> indices_list = getProperty("ListOfWorkspaceIndices");
+
+  // Check 'StartSpectrum' is in range 0-m_numberOfSpectra
+  if (m_minWsInd >= m_numberOfSpectra) {
+    g_log.warning("StartWorkspaceIndex out of range! Set to 0.");
+    m_minWsInd = 0;
+  }
+
+  if (indices_list.empty()) {
+    // If no list was given and no max, just do all.
+    if (isEmpty(m_maxWsInd))
+      m_maxWsInd = m_numberOfSpectra - 1;
+  }
+
+  // Something for m_maxWsIndex was given but it is out of range?
+  if (!isEmpty(m_maxWsInd) &&
+      (m_maxWsInd > m_numberOfSpectra - 1 || m_maxWsInd < m_minWsInd)) {
+    g_log.warning("EndWorkspaceIndex out of range! Set to max Workspace Index");
+    m_maxWsInd = m_numberOfSpectra - 1;
+  }
+
+  // Make the set of indices to sum up from the list
+  m_indices.insert(indices_list.begin(), indices_list.end());
+
+  // And add the range too, if any
+  if (!isEmpty(m_maxWsInd)) {
+    for (int i = m_minWsInd; i <= m_maxWsInd; i++)
+      m_indices.insert(i);
+  }
+}
+
 /**
  * Determine the minimum spectrum No for summing. This requires that
  * SumSpectra::indices has aly been set.
@@ -535,12 +693,12 @@ void SumSpectra::execEvent(EventWorkspace_const_sptr localworkspace,
     }
     numSpectra++;
 
-    // Add the event lists with the operator
-    const EventList &tOutEL = localworkspace->getSpectrum(i);
-    if (tOutEL.empty()) {
+    // Add the event lists. The events of a slice are copied directly from
+    // the workspace it shares them with.
+    if (localworkspace->getNumberEvents(i) == 0) {
       ++numZeros;
     }
-    outEL += tOutEL;
+    localworkspace->addEventsTo(i, outEL);
 
     progress.report();
   }
@@ -556,5 +714,11 @@ void SumSpectra::execEvent(EventWorkspace_const_sptr localworkspace,
   setProperty("OutputWorkspace", std::move(outputWorkspace));
 }
 
+Parallel::ExecutionMode SumSpectra::getParallelExecutionMode(
+    const std::map<std::string, Parallel::StorageMode> &storageModes) const {
+  return Parallel::getCorrespondingExecutionMode(
+      storageModes.at("InputWorkspace"));
+}
+
 } // namespace Algorithms
 } // namespace Mantid
@@ -14,10 +14,15 @@
 #include "MantidDataHandling/LoadInstrument.h"
 #include "MantidDataObjects/EventWorkspace.h"
 #include "MantidDataObjects/Workspace2D.h"
+#include "MantidDataObjects/WorkspaceCreation.h"
 #include "MantidGeometry/Instrument.h"
 #include "MantidGeometry/Objects/Object.h"
+#include "MantidIndexing/IndexInfo.h"
 #include "MantidKernel/OptionalBool.h"
 #include "MantidKernel/UnitFactory.h"
+#include "MantidTestHelpers/ComponentCreationHelper.h"
+#include "MantidTestHelpers/ParallelAlgorithmCreation.h"
+#include "MantidTestHelpers/ParallelRunner.h"
 
 using namespace Mantid::Kernel;
 using namespace Mantid::API;
@@ -101,6 +106,32 @@ void setup_Points_WS(std::string &inputSpace) {
   loader.setProperty("RewriteSpectraMap", Mantid::Kernel::OptionalBool(false));
   loader.execute();
 }
+
+void run_parallel_distributed(const Mantid::Parallel::Communicator &comm,
+                              const bool alignBins) {
+  using namespace Mantid;
+  MatrixWorkspace_sptr ws = create<Workspace2D>(
+      ComponentCreationHelper::createTestInstrumentRectangular(1, 4),
+      Indexing::IndexInfo(16, Parallel::StorageMode::Distributed, comm),
+      HistogramData::Histogram(BinEdges{1000, 2000, 3000}, Counts{1, 2}));
+  ws->getAxis(0)->unit() = UnitFactory::Instance().create("TOF");
+  auto alg = ParallelTestHelpers::create<ConvertUnits>(comm);
+  alg->setProperty("InputWorkspace", ws);
+  alg->setProperty("Target", "dSpacing");
+  alg->setProperty("AlignBins", alignBins);
+  if (alignBins && comm.size() > 1) {
+    TS_ASSERT_THROWS_EQUALS(alg->execute(), const std::runtime_error &e,
+                            std::string(e.what()),
+                            "ConvertUnits: AlignBins is not supported for "
+                            "distributed workspaces.");
+  } else {
+    TS_ASSERT_THROWS_NOTHING(alg->execute());
+    MatrixWorkspace_const_sptr out = alg->getProperty("OutputWorkspace");
+    TS_ASSERT_EQUALS(out->storageMode(), Parallel::StorageMode::Distributed);
+    TS_ASSERT_EQUALS(out->getNumberHistograms(), ws->getNumberHistograms());
+    TS_ASSERT_EQUALS(out->getAxis(0)->unit()->unitID(), "dSpacing");
+  }
+}
 }
 
 class ConvertUnitsTest : public CxxTest::TestSuite {
@@ -818,6 +849,14 @@ public:
     AnalysisDataService::Instance().remove(wsName);
   }
 
+  void test_parallel_distributed() {
+    ParallelTestHelpers::runParallel(run_parallel_distributed, false);
+  }
+
+  void test_parallel_distributed_AlignBins() {
+    ParallelTestHelpers::runParallel(run_parallel_distributed, true);
+  }
+
 private:
   ConvertUnits alg;
   std::string inputSpace;
@@ -10,9 +10,15 @@
 #include "MantidDataHandling/LoadNexus.h"
 #include "MantidDataHandling/LoadRaw3.h"
 #include "MantidDataObjects/EventWorkspace.h"
+#include "MantidDataObjects/GroupingWorkspace.h"
+#include "MantidDataObjects/WorkspaceCreation.h"
+#include "MantidIndexing/IndexInfo.h"
 #include "MantidKernel/UnitFactory.h"
 #include <cxxtest/TestSuite.h>
 #include "MantidKernel/cow_ptr.h"
+#include "MantidTestHelpers/ComponentCreationHelper.h"
+#include "MantidTestHelpers/ParallelAlgorithmCreation.h"
+#include "MantidTestHelpers/ParallelRunner.h"
 #include "MantidTestHelpers/WorkspaceCreationHelper.h"
 #include "MantidAPI/FrameworkManager.h"
 
@@ -23,6 +29,77 @@ using namespace Mantid::Kernel;
 using namespace Mantid::Algorithms;
 using namespace Mantid::DataObjects;
 using Mantid::HistogramData::BinEdges;
+using Mantid::HistogramData::Counts;
+
+namespace {
+/// Focus two banks of four pixels into one spectrum per bank
+MatrixWorkspace_sptr focus_two_banks(const Parallel::Communicator &comm,
+                                     const Parallel::StorageMode storageMode) {
+  auto instrument =
+      ComponentCreationHelper::createTestInstrumentRectangular(2, 2);
+  auto grouping = boost::make_shared<GroupingWorkspace>(instrument);
+  for (detid_t id = 4; id < 8; ++id)
+    grouping->setValue(id, 1.0);
+  for (detid_t id = 8; id < 12; ++id)
+    grouping->setValue(id, 2.0);
+
+  MatrixWorkspace_sptr ws = create<Workspace2D>(
+      instrument, Indexing::IndexInfo(8, storageMode, comm),
+      HistogramData::Histogram(BinEdges{1, 2, 3, 4}, Counts{1, 2, 3}));
+  ws->getAxis(0)->unit() = UnitFactory::Instance().create("dSpacing");
+  for (size_t i = 0; i < ws->getNumberHistograms(); ++i)
+    ws->mutableY(i) *= static_cast<double>(ws->getSpectrum(i).getSpectrumNo());
+
+  auto alg = ParallelTestHelpers::create<DiffractionFocussing2>(comm);
+  alg->setProperty("InputWorkspace", ws);
+  alg->setProperty("GroupingWorkspace", grouping);
+  TS_ASSERT_THROWS_NOTHING(alg->execute());
+  return alg->getProperty("OutputWorkspace");
+}
+
+void run_parallel_distributed(const Parallel::Communicator &comm) {
+  const auto out = focus_two_banks(comm, Parallel::StorageMode::Distributed);
+  if (comm.size() > 1)
+    TS_ASSERT_EQUALS(out->storageMode(), Parallel::StorageMode::MasterOnly);
+  if (comm.rank() != 0)
+    return;
+  const auto expected = focus_two_banks(Parallel::Communicator(),
+                                        Parallel::StorageMode::Cloned);
+  TS_ASSERT_EQUALS(out->getNumberHistograms(), 2);
+  for (size_t i = 0; i < expected->getNumberHistograms(); ++i) {
+    TS_ASSERT_EQUALS(out->getSpectrum(i).getDetectorIDs(),
+                     expected->getSpectrum(i).getDetectorIDs());
+    TS_ASSERT_EQUALS(out->x(i).rawData(), expected->x(i).rawData());
+    for (size_t bin = 0; bin < expected->y(i).size(); ++bin) {
+      TS_ASSERT_DELTA(out->y(i)[bin], expected->y(i)[bin], 1e-12);
+      TS_ASSERT_DELTA(out->e(i)[bin], expected->e(i)[bin], 1e-12);
+    }
+  }
+}
+
+void run_parallel_distributed_events(const Parallel::Communicator &comm) {
+  auto instrument =
+      ComponentCreationHelper::createTestInstrumentRectangular(1, 2);
+  auto grouping = boost::make_shared<GroupingWorkspace>(instrument);
+  for (detid_t id = 4; id < 8; ++id)
+    grouping->setValue(id, 1.0);
+  MatrixWorkspace_sptr ws = create<EventWorkspace>(
+      instrument,
+      Indexing::IndexInfo(4, Parallel::StorageMode::Distributed, comm),
+      BinEdges{1, 2, 3, 4});
+  ws->getAxis(0)->unit() = UnitFactory::Instance().create("dSpacing");
+
+  auto alg = ParallelTestHelpers::create<DiffractionFocussing2>(comm);
+  alg->setProperty("InputWorkspace", ws);
+  alg->setProperty("GroupingWorkspace", grouping);
+  TS_ASSERT_THROWS(alg->execute(), std::runtime_error);
+  alg->setProperty("PreserveEvents", false);
+  TS_ASSERT_THROWS_NOTHING(alg->execute());
+  MatrixWorkspace_const_sptr out = alg->getProperty("OutputWorkspace");
+  if (comm.rank() == 0)
+    TS_ASSERT(boost::dynamic_pointer_cast<const Workspace2D>(out));
+}
+}
 
 class DiffractionFocussing2Test : public CxxTest::TestSuite {
 public:
@@ -95,6 +172,14 @@ public:
     dotestEventWorkspace(false, 1, false);
   }
 
+  void test_parallel_distributed() {
+    ParallelTestHelpers::runParallel(run_parallel_distributed);
+  }
+
+  void test_parallel_distributed_events_require_histogram_output() {
+    ParallelTestHelpers::runParallel(run_parallel_distributed_events);
+  }
+
   void dotestEventWorkspace(bool inplace, size_t numgroups,
                             bool preserveEvents = true,
                             int bankWidthInPixels = 16) {
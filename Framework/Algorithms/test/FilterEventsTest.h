@@ -248,6 +248,59 @@ public:
     return;
   }
 
+  //----------------------------------------------------------------------------------------------
+  /** Filter events into slices of the input and check that the outputs hold
+   * the same events as the copied outputs of test_FilterNoCorrection
+   */
+  void test_FilterIntoSlices() {
+    int64_t runstart_i64 = 20000000000;
+    int64_t pulsedt = 100 * 1000 * 1000;
+    int64_t tofdt = 10 * 1000 * 1000;
+    size_t numpulses = 5;
+
+    EventWorkspace_sptr inpWS =
+        createEventWorkspace(runstart_i64, pulsedt, tofdt, numpulses);
+    AnalysisDataService::Instance().addOrReplace("TestSlices", inpWS);
+    SplittersWorkspace_sptr splws =
+        createSplittersWorkspace(runstart_i64, pulsedt, tofdt);
+    AnalysisDataService::Instance().addOrReplace("SplitterSlices", splws);
+
+    for (const bool slices : {false, true}) {
+      FilterEvents filter;
+      filter.initialize();
+      filter.setProperty("InputWorkspace", "TestSlices");
+      filter.setProperty("OutputWorkspaceBaseName",
+                         slices ? "Sliced" : "Copied");
+      filter.setProperty("SplitterWorkspace", "SplitterSlices");
+      filter.setProperty("OutputSlices", slices);
+      TS_ASSERT_THROWS_NOTHING(filter.execute());
+      TS_ASSERT(filter.isExecuted());
+    }
+
+    // Changing the input afterwards changes neither kind of output
+    inpWS->getSpectrum(0).clear();
+
+    for (const std::string suffix : {"_0", "_1", "_2", "_unfiltered"}) {
+      auto copied = AnalysisDataService::Instance().retrieveWS<EventWorkspace>(
+          "Copied" + suffix);
+      auto sliced = AnalysisDataService::Instance().retrieveWS<EventWorkspace>(
+          "Sliced" + suffix);
+      TS_ASSERT(sliced->isSlice());
+      TS_ASSERT_EQUALS(sliced->getNumberEvents(), copied->getNumberEvents());
+      for (size_t i = 0; i < copied->getNumberHistograms(); ++i) {
+        TS_ASSERT_EQUALS(sliced->getSpectrum(i).getDetectorIDs(),
+                         copied->getSpectrum(i).getDetectorIDs());
+        TS_ASSERT_EQUALS(sliced->getSpectrum(i).getEvents(),
+                         copied->getSpectrum(i).getEvents());
+      }
+      AnalysisDataService::Instance().remove("Copied" + suffix);
+      AnalysisDataService::Instance().remove("Sliced" + suffix);
+    }
+
+    AnalysisDataService::Instance().remove("TestSlices");
+    AnalysisDataService::Instance().remove("SplitterSlices");
+  }
+
   //----------------------------------------------------------------------------------------------
   /**  Filter events without any correction and test for user-specified
    *workspace starting value
@@ -54,6 +54,39 @@ public:
     TS_ASSERT_DELTA(1.0 / std::sqrt(m_nevents), error, 1e-08);
   }
 
+  void test_Scatter_Paths_Are_Reused_For_Each_Detector() {
+    using Mantid::Kernel::V3D;
+    using Mantid::Algorithms::MCScatterPaths;
+    using namespace MonteCarloTesting;
+    using namespace ::testing;
+
+    MockRNG rng;
+    auto mcabsorb = createTestObject();
+    // Random numbers are only drawn while generating the paths
+    EXPECT_CALL(rng, nextValue())
+        .Times(Exactly(30))
+        .WillRepeatedly(Return(0.5));
+    const Mantid::Algorithms::IBeamProfile::Ray testRay = {V3D(-2, 0, 0),
+                                                           V3D(1, 0, 0)};
+    EXPECT_CALL(m_testBeamProfile, generatePoint(_, _))
+        .Times(Exactly(static_cast<int>(m_nevents)))
+        .WillRepeatedly(Return(testRay));
+    MCScatterPaths paths;
+    mcabsorb.generateScatterPaths(rng, paths);
+    TS_ASSERT_EQUALS(m_nevents, paths.size());
+    TS_ASSERT_EQUALS(1, paths.objects.size());
+
+    const double lambdaBefore(2.5), lambdaAfter(3.5);
+    double factor(0.0), error(0.0);
+    std::tie(factor, error) = mcabsorb.calculate(paths, 0, V3D(0.7, 0.7, 1.4),
+                                                 lambdaBefore, lambdaAfter);
+    TS_ASSERT_DELTA(0.0043828472, factor, 1e-08);
+    TS_ASSERT_DELTA(1.0 / std::sqrt(m_nevents), error, 1e-08);
+    std::tie(factor, error) = mcabsorb.calculate(paths, 0, V3D(-0.7, 0.7, 1.4),
+                                                 lambdaBefore, lambdaAfter);
+    TS_ASSERT_LESS_THAN(0.0, factor);
+  }
+
   //----------------------------------------------------------------------------
   // Failure cases
   //----------------------------------------------------------------------------
@@ -6,7 +6,12 @@
 #include "MantidAPI/SpectrumInfo.h"
 #include "MantidAPI/WorkspaceFactory.h"
 #include "MantidDataObjects/Workspace2D.h"
+#include "MantidDataObjects/WorkspaceCreation.h"
 #include "MantidGeometry/Instrument/ParameterMap.h"
+#include "MantidIndexing/IndexInfo.h"
+#include "MantidTestHelpers/ComponentCreationHelper.h"
+#include "MantidTestHelpers/ParallelAlgorithmCreation.h"
+#include "MantidTestHelpers/ParallelRunner.h"
 #include "MantidTestHelpers/WorkspaceCreationHelper.h"
 #include <boost/lexical_cast.hpp>
 #include <cxxtest/TestSuite.h>
@@ -16,6 +21,62 @@
 using namespace Mantid;
 using namespace Mantid::API;
 using namespace Mantid::DataObjects;
+using Mantid::HistogramData::BinEdges;
+using Mantid::HistogramData::Counts;
+using Mantid::HistogramData::Histogram;
+
+namespace {
+void run_parallel_distributed(const Parallel::Communicator &comm) {
+  // 16 pixels, each with counts 1 and 4
+  Indexing::IndexInfo indexInfo(16, Parallel::StorageMode::Distributed, comm);
+  MatrixWorkspace_sptr ws = create<Workspace2D>(
+      ComponentCreationHelper::createTestInstrumentRectangular(1, 4),
+      indexInfo, Histogram(BinEdges{1, 2, 4}, Counts{1, 4}));
+  auto alg = ParallelTestHelpers::create<Algorithms::SumSpectra>(comm);
+  alg->setProperty("InputWorkspace", ws);
+  alg->setProperty("StartWorkspaceIndex", 2);
+  TS_ASSERT_THROWS_NOTHING(alg->execute());
+  MatrixWorkspace_const_sptr out = alg->getProperty("OutputWorkspace");
+  if (comm.size() > 1)
+    TS_ASSERT_EQUALS(out->storageMode(), Parallel::StorageMode::MasterOnly);
+  if (comm.rank() != 0)
+    return;
+  TS_ASSERT_EQUALS(out->getNumberHistograms(), 1);
+  TS_ASSERT_EQUALS(out->getSpectrum(0).getSpectrumNo(), 3);
+  TS_ASSERT_EQUALS(out->getSpectrum(0).getDetectorIDs().size(), 14);
+  TS_ASSERT_EQUALS(out->y(0)[0], 14.0);
+  TS_ASSERT_EQUALS(out->y(0)[1], 56.0);
+  TS_ASSERT_DELTA(out->e(0)[0], std::sqrt(14.0), 1e-12);
+  TS_ASSERT_DELTA(out->e(0)[1], std::sqrt(56.0), 1e-12);
+  TS_ASSERT_EQUALS(out->run().getPropertyValueAsType<int>("NumAllSpectra"),
+                   14);
+}
+
+void run_parallel_distributed_without_root(const Parallel::Communicator &comm) {
+  // Index i is on rank i % size, so with 3 or more ranks the root holds none
+  // of the selected spectra
+  Indexing::IndexInfo indexInfo(16, Parallel::StorageMode::Distributed, comm);
+  MatrixWorkspace_sptr ws = create<Workspace2D>(
+      ComponentCreationHelper::createTestInstrumentRectangular(1, 4),
+      indexInfo, Histogram(BinEdges{1, 2, 4}, Counts{1, 4}));
+  auto alg = ParallelTestHelpers::create<Algorithms::SumSpectra>(comm);
+  alg->setProperty("InputWorkspace", ws);
+  alg->setProperty("ListOfWorkspaceIndices", std::vector<int>{1, 2});
+  TS_ASSERT_THROWS_NOTHING(alg->execute());
+  MatrixWorkspace_const_sptr out = alg->getProperty("OutputWorkspace");
+  if (comm.rank() != 0)
+    return;
+  TS_ASSERT_EQUALS(out->getNumberHistograms(), 1);
+  TS_ASSERT_EQUALS(out->x(0).rawData(), std::vector<double>({1, 2, 4}));
+  TS_ASSERT_EQUALS(out->getSpectrum(0).getSpectrumNo(), 2);
+  TS_ASSERT_EQUALS(out->getSpectrum(0).getDetectorIDs().size(), 2);
+  TS_ASSERT_EQUALS(out->y(0)[0], 2.0);
+  TS_ASSERT_EQUALS(out->y(0)[1], 8.0);
+  TS_ASSERT_DELTA(out->e(0)[1], std::sqrt(8.0), 1e-12);
+  TS_ASSERT_EQUALS(out->run().getPropertyValueAsType<int>("NumAllSpectra"),
+                   2);
+}
+}
 
 class SumSpectraTest : public CxxTest::TestSuite {
 public:
@@ -508,6 +569,14 @@ public:
     AnalysisDataService::Instance().remove(outWsName);
   }
 
+  void test_parallel_distributed() {
+    ParallelTestHelpers::runParallel(run_parallel_distributed);
+  }
+
+  void test_parallel_distributed_without_spectra_on_root() {
+    ParallelTestHelpers::runParallel(run_parallel_distributed_without_root);
+  }
+
 private:
   int nTestHist;
   Mantid::Algorithms::SumSpectra alg; // Test with range limits
@@ -0,0 +1,95 @@
+#ifndef MANTID_BENCHMARKS_BENCHMARKRUNNER_H_
+#define MANTID_BENCHMARKS_BENCHMARKRUNNER_H_
+
+#include <json/json.h>
+
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace Mantid {
+namespace Benchmarks {
+
+/** Summary of the wall times of the repetitions of a benchmark, in seconds.
+ */
+struct Statistics {
+  size_t repeats{0};
+  double min{0.0};
+  double max{0.0};
+  double mean{0.0};
+  double median{0.0};
+  double stddev{0.0};
+
+  static Statistics fromSamples(std::vector<double> samples);
+};
+
+/** A single benchmark. Only run is timed. setup prepares the data before
+  every repetition, e.g., by copying a workspace that run modifies, and
+  teardown cleans up after every repetition.
+ */
+struct BenchmarkCase {
+  /// Name of the timed operation, e.g., "EventList::sortTof"
+  std::string name;
+  /// Parameters of the synthetic data, reported with the timings
+  std::map<std::string, double> parameters;
+  /// Number of items (e.g., events) processed by run, used for throughput
+  double items{0.0};
+  std::function<void()> setup;
+  std::function<void()> run;
+  std::function<void()> teardown;
+};
+
+/** BenchmarkRunner : Runs benchmark cases for a range of thread counts and
+  collects the statistics of the wall times as JSON.
+
+  Every case is run warmup times untimed and then repeats times timed for
+  each thread count. Cases whose name does not contain the filter string are
+  skipped.
+
+  Copyright &copy; 2017 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class BenchmarkRunner {
+public:
+  struct Options {
+    std::vector<int> threads;
+    size_t repeats{5};
+    size_t warmup{1};
+    std::string filter;
+  };
+
+  explicit BenchmarkRunner(Options options);
+
+  bool selected(const std::string &name) const;
+  void run(const BenchmarkCase &benchmark);
+  Json::Value results() const;
+
+private:
+  Options m_options;
+  Json::Value m_results;
+};
+
+} // namespace Benchmarks
+} // namespace Mantid
+
+#endif /* MANTID_BENCHMARKS_BENCHMARKRUNNER_H_ */
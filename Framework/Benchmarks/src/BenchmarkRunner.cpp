@@ -0,0 +1,125 @@
+#include "MantidBenchmarks/BenchmarkRunner.h"
+#include "MantidKernel/DateAndTime.h"
+#include "MantidKernel/MantidVersion.h"
+#include "MantidKernel/MultiThreaded.h"
+#include "MantidKernel/TaskRuntime.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <numeric>
+
+namespace Mantid {
+namespace Benchmarks {
+
+/** Compute the statistics of a set of wall times
+ * @param samples :: wall times in seconds
+ * @return the statistics, all zero if there are no samples
+ */
+Statistics Statistics::fromSamples(std::vector<double> samples) {
+  Statistics stats;
+  stats.repeats = samples.size();
+  if (samples.empty())
+    return stats;
+  std::sort(samples.begin(), samples.end());
+  const size_t n = samples.size();
+  stats.min = samples.front();
+  stats.max = samples.back();
+  stats.mean = std::accumulate(samples.begin(), samples.end(), 0.0) /
+               static_cast<double>(n);
+  stats.median = n % 2 == 1 ? samples[n / 2]
+                            : 0.5 * (samples[n / 2 - 1] + samples[n / 2]);
+  if (n > 1) {
+    double sumSq = 0.0;
+    for (const auto sample : samples)
+      sumSq += (sample - stats.mean) * (sample - stats.mean);
+    stats.stddev = std::sqrt(sumSq / static_cast<double>(n - 1));
+  }
+  return stats;
+}
+
+/** Constructor. Raises the cap of the TaskRuntime to the largest thread
+ * count, so that every count of the sweep can be reached.
+ * @param options :: thread counts, repetitions and filter. If no thread
+ * counts are given the maximum number of threads is used.
+ */
+BenchmarkRunner::BenchmarkRunner(Options options)
+    : m_options(std::move(options)) {
+  if (m_options.threads.empty())
+    m_options.threads.push_back(Kernel::TaskRuntime::maxConcurrency());
+  const int maxThreads =
+      *std::max_element(m_options.threads.begin(), m_options.threads.end());
+  if (maxThreads > Kernel::TaskRuntime::maxConcurrency())
+    Kernel::TaskRuntime::setMaxConcurrency(maxThreads);
+  m_results["version"] = Kernel::MantidVersion::version();
+  m_results["revision"] = Kernel::MantidVersion::revisionFull();
+  m_results["date"] = Kernel::DateAndTime::getCurrentTime().toISO8601String();
+  m_results["max_threads"] = Kernel::TaskRuntime::maxConcurrency();
+  m_results["repeats"] = static_cast<Json::UInt64>(m_options.repeats);
+  m_results["benchmarks"] = Json::Value(Json::arrayValue);
+}
+
+/// @return true if a benchmark of this name passes the filter
+bool BenchmarkRunner::selected(const std::string &name) const {
+  return name.find(m_options.filter) != std::string::npos;
+}
+
+/** Run a benchmark for all thread counts and record its statistics
+ * @param benchmark :: the benchmark to run
+ */
+void BenchmarkRunner::run(const BenchmarkCase &benchmark) {
+  if (!selected(benchmark.name))
+    return;
+  const auto runOnce = [&benchmark]() {
+    if (benchmark.setup)
+      benchmark.setup();
+    const auto start = std::chrono::steady_clock::now();
+    benchmark.run();
+    const std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    if (benchmark.teardown)
+      benchmark.teardown();
+    return elapsed.count();
+  };
+
+  for (const int threads : m_options.threads) {
+    // The limit applies to the tasks and loops of the TaskRuntime, and the
+    // OpenMP setting to any loop outside the PARALLEL_* macros
+    Kernel::TaskRuntime::ScopedLimit threadLimit(threads);
+    PARALLEL_SET_NUM_THREADS(threads);
+    for (size_t i = 0; i < m_options.warmup; ++i)
+      runOnce();
+    std::vector<double> samples;
+    for (size_t i = 0; i < m_options.repeats; ++i)
+      samples.push_back(runOnce());
+    const auto stats = Statistics::fromSamples(samples);
+
+    Json::Value result;
+    result["name"] = benchmark.name;
+    result["threads"] = threads;
+    Json::Value parameters(Json::objectValue);
+    for (const auto &parameter : benchmark.parameters)
+      parameters[parameter.first] = parameter.second;
+    result["parameters"] = parameters;
+    result["repeats"] = static_cast<Json::UInt64>(stats.repeats);
+    result["min_s"] = stats.min;
+    result["max_s"] = stats.max;
+    result["mean_s"] = stats.mean;
+    result["median_s"] = stats.median;
+    result["stddev_s"] = stats.stddev;
+    if (benchmark.items > 0.0 && stats.median > 0.0)
+      result["items_per_s"] = benchmark.items / stats.median;
+    m_results["benchmarks"].append(result);
+
+    std::cerr << benchmark.name << " threads=" << threads
+              << " median=" << stats.median << "s stddev=" << stats.stddev
+              << "s\n";
+  }
+}
+
+/// @return all results recorded so far, with the version of Mantid
+Json::Value BenchmarkRunner::results() const { return m_results; }
+
+} // namespace Benchmarks
+} // namespace Mantid
@@ -0,0 +1,330 @@
+#include "MantidAPI/AnalysisDataService.h"
+#include "MantidAPI/Axis.h"
+#include "MantidAPI/Run.h"
+#include "MantidAlgorithms/DiffractionFocussing2.h"
+#include "MantidAlgorithms/FilterEvents.h"
+#include "MantidAlgorithms/Rebin.h"
+#include "MantidBenchmarks/BenchmarkRunner.h"
+#include "MantidDataObjects/EventWorkspace.h"
+#include "MantidDataObjects/GroupingWorkspace.h"
+#include "MantidDataObjects/SplittersWorkspace.h"
+#include "MantidKernel/MersenneTwister.h"
+#include "MantidKernel/MultiThreaded.h"
+#include "MantidKernel/TimeSeriesProperty.h"
+#include "MantidKernel/TimeSplitter.h"
+#include "MantidKernel/VectorHelper.h"
+#include "MantidKernel/make_unique.h"
+#include "MantidTestHelpers/WorkspaceCreationHelper.h"
+
+#include <boost/algorithm/string/classification.hpp>
+#include <boost/algorithm/string/split.hpp>
+#include <boost/lexical_cast.hpp>
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+
+using namespace Mantid;
+using namespace Mantid::API;
+using namespace Mantid::Benchmarks;
+using namespace Mantid::DataObjects;
+using namespace Mantid::Kernel;
+
+namespace {
+/// Run start of the synthetic data
+const int64_t RUN_START = 20000000000;
+/// Duration of the synthetic run in seconds
+const int64_t RUN_DURATION = 600;
+/// Pulse frequency of the source in Hz
+const int64_t PULSE_FREQUENCY = 60;
+/// Time-of-flight range of the events in microseconds
+const double TOF_MIN = 1000.0;
+const double TOF_MAX = 20000.0;
+/// Length of the splitter intervals in seconds
+const int64_t SPLITTER_INTERVAL = 10;
+/// Number of targets the splitter intervals cycle through
+const int NUM_SPLITTER_TARGETS = 4;
+/// Logarithmic binning used for histogramming
+const std::vector<double> REBIN_PARAMS{TOF_MIN, -0.0005, TOF_MAX};
+
+struct Settings {
+  BenchmarkRunner::Options runner;
+  std::string output;
+  std::vector<int> eventsPerPixel{100, 1000};
+  int banks{4};
+  int pixels{32};
+};
+
+void usage() {
+  std::cerr << "Usage: EventBenchmarks [--output FILE] [--threads N,N,...] "
+               "[--events N,N,...] [--banks N] [--pixels N] [--repeats N] "
+               "[--filter NAME]\n"
+               "  --output   JSON file for the results (default: stdout)\n"
+               "  --threads  thread counts to run with (default: maximum)\n"
+               "  --events   events per pixel to sweep (default: 100,1000)\n"
+               "  --banks    rectangular banks in the instrument (default: "
+               "4)\n"
+               "  --pixels   pixels along each side of a bank (default: 32)\n"
+               "  --repeats  timed repetitions of each case (default: 5)\n"
+               "  --filter   only run benchmarks whose name contains NAME\n";
+}
+
+std::vector<int> parseList(const std::string &value) {
+  std::vector<std::string> items;
+  boost::split(items, value, boost::is_any_of(","));
+  std::vector<int> list;
+  for (const auto &item : items)
+    list.push_back(boost::lexical_cast<int>(item));
+  return list;
+}
+
+Settings parseArguments(int argc, char *argv[]) {
+  Settings settings;
+  for (int i = 1; i < argc; ++i) {
+    const std::string option(argv[i]);
+    if (option == "--help" || option == "-h") {
+      usage();
+      std::exit(0);
+    }
+    if (i + 1 >= argc)
+      throw std::invalid_argument("Missing value for " + option);
+    const std::string value(argv[++i]);
+    if (option == "--output")
+      settings.output = value;
+    else if (option == "--threads")
+      settings.runner.threads = parseList(value);
+    else if (option == "--events")
+      settings.eventsPerPixel = parseList(value);
+    else if (option == "--banks")
+      settings.banks = boost::lexical_cast<int>(value);
+    else if (option == "--pixels")
+      settings.pixels = boost::lexical_cast<int>(value);
+    else if (option == "--repeats")
+      settings.runner.repeats = boost::lexical_cast<size_t>(value);
+    else if (option == "--filter")
+      settings.runner.filter = value;
+    else
+      throw std::invalid_argument("Unknown option " + option);
+  }
+  return settings;
+}
+
+/** Create an event workspace with rectangular banks and random events,
+ * uniform in time-of-flight and pulse time. The events are not sorted.
+ */
+EventWorkspace_sptr createWorkspace(const Settings &settings,
+                                    const int eventsPerPixel) {
+  auto ws = WorkspaceCreationHelper::createEventWorkspaceWithFullInstrument(
+      settings.banks, settings.pixels, true);
+  ws->getAxis(0)->setUnit("TOF");
+  ws->setAllX(HistogramData::BinEdges{TOF_MIN, TOF_MAX});
+
+  const int64_t numPulses = RUN_DURATION * PULSE_FREQUENCY;
+  const int64_t pulsePeriod = 1000000000 / PULSE_FREQUENCY;
+  const int64_t numSpectra = static_cast<int64_t>(ws->getNumberHistograms());
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int64_t i = 0; i < numSpectra; ++i) {
+    MersenneTwister random(static_cast<size_t>(i) + 1, 0.0, 1.0);
+    auto &eventList = ws->getSpectrum(i);
+    eventList.reserve(eventsPerPixel);
+    for (int j = 0; j < eventsPerPixel; ++j) {
+      const double tof = TOF_MIN + (TOF_MAX - TOF_MIN) * random.nextValue();
+      const auto pulse =
+          static_cast<int64_t>(random.nextValue() * (numPulses - 1));
+      eventList.addEventQuickly(
+          TofEvent(tof, DateAndTime(RUN_START + pulse * pulsePeriod)));
+    }
+  }
+
+  auto &run = ws->mutableRun();
+  run.addProperty("run_start", DateAndTime(RUN_START).toISO8601String(), true);
+  auto protonCharge =
+      make_unique<TimeSeriesProperty<double>>("proton_charge");
+  for (int64_t pulse = 0; pulse < numPulses; ++pulse)
+    protonCharge->addValue(DateAndTime(RUN_START + pulse * pulsePeriod), 1.0);
+  run.addLogData(protonCharge.release());
+  run.integrateProtonCharge();
+  return ws;
+}
+
+/// Splitter intervals cycling through the targets over the whole run
+TimeSplitterType createSplitter() {
+  TimeSplitterType splitter;
+  const int64_t step = SPLITTER_INTERVAL * 1000000000;
+  for (int64_t i = 0; i * SPLITTER_INTERVAL < RUN_DURATION; ++i)
+    splitter.emplace_back(DateAndTime(RUN_START + i * step),
+                          DateAndTime(RUN_START + (i + 1) * step),
+                          static_cast<int>(i % NUM_SPLITTER_TARGETS));
+  return splitter;
+}
+
+/// One group per bank of the rectangular instrument
+GroupingWorkspace_sptr createGrouping(const EventWorkspace &ws,
+                                      const Settings &settings) {
+  auto grouping = boost::make_shared<GroupingWorkspace>(ws.getInstrument());
+  const int pixelsPerBank = settings.pixels * settings.pixels;
+  for (int bank = 1; bank <= settings.banks; ++bank)
+    for (int pixel = 0; pixel < pixelsPerBank; ++pixel)
+      grouping->setValue(bank * pixelsPerBank + pixel, bank);
+  return grouping;
+}
+
+/// Run a function for every event list of a workspace in parallel
+template <typename Func> void forEachList(EventWorkspace &ws, Func func) {
+  const int64_t numSpectra = static_cast<int64_t>(ws.getNumberHistograms());
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int64_t i = 0; i < numSpectra; ++i)
+    func(ws.getSpectrum(i));
+}
+
+void runBenchmarks(BenchmarkRunner &runner, const Settings &settings,
+                   const int eventsPerPixel) {
+  const auto input = createWorkspace(settings, eventsPerPixel);
+  const auto numEvents = static_cast<double>(input->getNumberEvents());
+  const std::map<std::string, double> parameters{
+      {"events_per_pixel", eventsPerPixel},
+      {"pixels", static_cast<double>(input->getNumberHistograms())},
+      {"events", numEvents}};
+  const auto makeCase = [&](const std::string &name) {
+    BenchmarkCase benchmark;
+    benchmark.name = name;
+    benchmark.parameters = parameters;
+    benchmark.items = numEvents;
+    return benchmark;
+  };
+  // Cases that modify the events work on a fresh copy in every repetition
+  EventWorkspace_sptr ws;
+  const auto copyInput = [&]() { ws = input->clone(); };
+  const auto release = [&]() { ws.reset(); };
+
+  auto sorted = input->clone();
+  sorted->sortAll(TOF_SORT, nullptr);
+  MantidVec edges;
+  VectorHelper::createAxisFromRebinParams(REBIN_PARAMS, edges);
+
+  auto benchmark = makeCase("EventList::generateHistogram");
+  benchmark.run = [&]() {
+    forEachList(*sorted, [&edges](const EventList &eventList) {
+      MantidVec y;
+      MantidVec e;
+      eventList.generateHistogram(edges, y, e);
+    });
+  };
+  runner.run(benchmark);
+
+  benchmark = makeCase("EventList::sortTof");
+  benchmark.setup = copyInput;
+  benchmark.run = [&]() {
+    forEachList(*ws, [](const EventList &eventList) { eventList.sortTof(); });
+  };
+  benchmark.teardown = release;
+  runner.run(benchmark);
+
+  const auto splitter = createSplitter();
+  benchmark = makeCase("EventList::splitByFullTime");
+  benchmark.run = [&]() {
+    forEachList(*sorted, [&splitter](const EventList &eventList) {
+      std::vector<EventList> outputs(NUM_SPLITTER_TARGETS);
+      std::map<int, EventList *> outputMap;
+      for (int target = 0; target < NUM_SPLITTER_TARGETS; ++target)
+        outputMap[target] = &outputs[target];
+      auto localSplitter = splitter;
+      eventList.splitByFullTime(localSplitter, outputMap, false, 1.0, 0.0);
+    });
+  };
+  benchmark.setup = nullptr;
+  benchmark.teardown = nullptr;
+  runner.run(benchmark);
+
+  benchmark = makeCase("EventList::compressEvents");
+  benchmark.run = [&]() {
+    forEachList(*sorted, [](EventList &eventList) {
+      EventList compressed;
+      eventList.compressEvents(1.0, &compressed);
+    });
+  };
+  runner.run(benchmark);
+
+  benchmark = makeCase("EventList::convertTof");
+  benchmark.setup = copyInput;
+  benchmark.run = [&]() {
+    forEachList(*ws,
+                [](EventList &eventList) { eventList.convertTof(1.1, 5.0); });
+  };
+  benchmark.teardown = release;
+  runner.run(benchmark);
+
+  auto splitterWS = boost::make_shared<SplittersWorkspace>();
+  for (const auto &interval : splitter)
+    splitterWS->addSplitter(interval);
+  benchmark = makeCase("FilterEvents");
+  benchmark.setup = nullptr;
+  benchmark.run = [&]() {
+    Algorithms::FilterEvents alg;
+    alg.initialize();
+    alg.setChild(true);
+    alg.setRethrows(true);
+    alg.setProperty("InputWorkspace", input);
+    alg.setProperty("SplitterWorkspace", splitterWS);
+    alg.setProperty("OutputWorkspaceBaseName", "__benchmark_filtered");
+    alg.execute();
+  };
+  benchmark.teardown = []() { AnalysisDataService::Instance().clear(); };
+  runner.run(benchmark);
+
+  benchmark = makeCase("Rebin");
+  benchmark.run = [&]() {
+    Algorithms::Rebin alg;
+    alg.initialize();
+    alg.setChild(true);
+    alg.setRethrows(true);
+    alg.setProperty("InputWorkspace", input);
+    alg.setPropertyValue("OutputWorkspace", "__benchmark_rebinned");
+    alg.setProperty("Params", REBIN_PARAMS);
+    alg.setProperty("PreserveEvents", false);
+    alg.execute();
+  };
+  benchmark.teardown = nullptr;
+  runner.run(benchmark);
+
+  const auto grouping = createGrouping(*input, settings);
+  benchmark = makeCase("DiffractionFocussing2");
+  benchmark.run = [&]() {
+    Algorithms::DiffractionFocussing2 alg;
+    alg.initialize();
+    alg.setChild(true);
+    alg.setRethrows(true);
+    alg.setProperty("InputWorkspace", input);
+    alg.setProperty("GroupingWorkspace", grouping);
+    alg.setPropertyValue("OutputWorkspace", "__benchmark_focussed");
+    alg.setProperty("PreserveEvents", true);
+    alg.execute();
+  };
+  runner.run(benchmark);
+}
+} // namespace
+
+int main(int argc, char *argv[]) {
+  try {
+    const auto settings = parseArguments(argc, argv);
+    BenchmarkRunner runner(settings.runner);
+    for (const auto eventsPerPixel : settings.eventsPerPixel)
+      runBenchmarks(runner, settings, eventsPerPixel);
+
+    Json::StyledWriter writer;
+    const auto json = writer.write(runner.results());
+    if (settings.output.empty()) {
+      std::cout << json;
+    } else {
+      std::ofstream file(settings.output);
+      file << json;
+      if (!file)
+        throw std::runtime_error("Could not write " + settings.output);
+    }
+  } catch (std::exception &e) {
+    std::cerr << "EventBenchmarks: " << e.what() << '\n';
+    usage();
+    return 1;
+  }
+  return 0;
+}
@@ -96,6 +96,9 @@ private:
   void init() override;
   void exec() override;
 
+  /// Check if the spectra are fitted together
+  bool isBatchFit(const API::IFunction &function) const;
+
   /// Get a workspace
   InputData getWorkspace(const InputData &data);
 
@@ -0,0 +1,135 @@
+#ifndef MANTID_CURVEFITTING_BATCHFITTER_H_
+#define MANTID_CURVEFITTING_BATCHFITTER_H_
+
+#include "MantidAPI/IFunction.h"
+#include "MantidAPI/MatrixWorkspace_fwd.h"
+#include "MantidCurveFitting/DllConfig.h"
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace Mantid {
+namespace API {
+class Progress;
+}
+namespace CurveFitting {
+
+/** BatchFitter : Fits one function to many spectra concurrently.
+
+  The spectra are split into contiguous chains which are fitted in parallel.
+  Each chain has its own copy of the function, cost function and domain
+  creator, which are reused for all of its spectra, so that fitting a spectrum
+  does not set up a Fit algorithm. With warm start on, every fit of a chain
+  starts from the parameters found for the previous spectrum of the chain and
+  the first one from the prototype's; otherwise every fit starts from the
+  prototype's parameters and the results do not depend on the chains.
+
+  The spectra are fitted the way Fit fits a spectrum of a MatrixWorkspace with
+  EvaluationType CentrePoint, CalcErrors on and CreateOutput off.
+
+  Copyright &copy; 2017 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class MANTID_CURVEFITTING_DLL BatchFitter {
+public:
+  /// A spectrum to fit
+  struct Spectrum {
+    API::MatrixWorkspace_sptr workspace;
+    size_t workspaceIndex;
+  };
+
+  /// The result of fitting one spectrum
+  struct Result {
+    /// Fitted values of all parameters of the function
+    std::vector<double> parameters;
+    /// Errors of the parameters
+    std::vector<double> errors;
+    /// Cost function value divided by the number of degrees of freedom
+    double chi2OverDoF{0.0};
+    /// "success" or the reason the fit failed
+    std::string status;
+  };
+
+  explicit BatchFitter(API::IFunction_const_sptr prototype);
+
+  static bool canFit(const API::IFunction &function);
+
+  /// Set the minimizer, as for the Minimizer property of Fit
+  void setMinimizer(const std::string &minimizer) { m_minimizer = minimizer; }
+  /// Set the name of the cost function
+  void setCostFunction(const std::string &costFunction) {
+    m_costFunction = costFunction;
+  }
+  /// Set the maximum number of iterations of each fit
+  void setMaxIterations(size_t maxIterations) {
+    m_maxIterations = maxIterations;
+  }
+  /// Set the fitting range. EMPTY_DBL() means the whole spectrum.
+  void setRange(double startX, double endX) {
+    m_startX = startX;
+    m_endX = endX;
+  }
+  /// Set the peak radius of the domains, 0 means the whole x axis
+  void setPeakRadius(int peakRadius) { m_peakRadius = peakRadius; }
+  /// Start each fit from the result of the previous one of its chain
+  void setWarmStart(bool on) { m_warmStart = on; }
+  /// Set the number of chains with warm start, 0 means one per thread
+  void setNumberOfChains(size_t numberOfChains) {
+    m_numberOfChains = numberOfChains;
+  }
+  /// Set the WorkspaceIndex attributes of the function to that of a spectrum
+  void setPassWorkspaceIndex(bool on) { m_passWorkspaceIndex = on; }
+  /// Set a function called by each chain before every fit, which throws to
+  /// cancel the fits, e.g., Algorithm::interruption_point
+  void setInterruptionPoint(std::function<void()> interruptionPoint) {
+    m_interruptionPoint = std::move(interruptionPoint);
+  }
+
+  std::vector<Result> fit(const std::vector<Spectrum> &spectra,
+                          API::Progress *progress = nullptr) const;
+
+private:
+  struct Worker;
+  size_t numberOfChains(size_t numberOfSpectra) const;
+  void fitChain(Worker &worker, const std::vector<Spectrum> &spectra,
+                size_t begin, size_t end, std::vector<Result> &results,
+                API::Progress *progress) const;
+  Result fitSpectrum(Worker &worker, const Spectrum &spectrum) const;
+
+  /// The function to fit with its initial parameters
+  API::IFunction_const_sptr m_prototype;
+  std::string m_minimizer{"Levenberg-Marquardt"};
+  std::string m_costFunction{"Least squares"};
+  size_t m_maxIterations{500};
+  double m_startX;
+  double m_endX;
+  int m_peakRadius{0};
+  bool m_warmStart{false};
+  size_t m_numberOfChains{0};
+  bool m_passWorkspaceIndex{false};
+  std::function<void()> m_interruptionPoint;
+};
+
+} // namespace CurveFitting
+} // namespace Mantid
+
+#endif /* MANTID_CURVEFITTING_BATCHFITTER_H_ */
@@ -0,0 +1,125 @@
+#ifndef MANTID_CURVEFITTING_COMPILEDEXPRESSION_H_
+#define MANTID_CURVEFITTING_COMPILEDEXPRESSION_H_
+
+#include "MantidCurveFitting/DllConfig.h"
+
+#include <string>
+#include <vector>
+
+namespace Mantid {
+namespace API {
+class Jacobian;
+}
+namespace CurveFitting {
+
+/** CompiledExpression : A formula of one variable and a set of parameters,
+  compiled into a program which evaluates it and its derivatives with respect
+  to the parameters over arrays of values of the variable.
+
+  The formula uses the arithmetic of muParser: the operators + - * / ^, unary
+  minus, numbers, the constants _pi and _e and muParser's one-argument
+  functions, as well as erf and erfc. Any other name must be the variable or
+  one of the parameters. The derivatives are computed alongside the values
+  (forward mode automatic differentiation), so they are exact up to rounding.
+
+  The program keeps its work arrays between calls, so an instance must not be
+  used by several threads at once.
+
+  Copyright &copy; 2017 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class MANTID_CURVEFITTING_DLL CompiledExpression {
+public:
+  CompiledExpression(const std::string &formula, const std::string &variable,
+                     const std::vector<std::string> &parameters);
+
+  /// The number of parameters
+  size_t nParams() const { return m_nParams; }
+
+  void evaluate(const double *parameters, const double *x, const size_t n,
+                double *out) const;
+  void derivatives(const double *parameters, const double *x, const size_t n,
+                   API::Jacobian &jacobian) const;
+
+private:
+  class Compiler;
+
+  /// Kinds of instructions of the program: values, then unary operations,
+  /// then binary operations
+  enum class Code {
+    Number,
+    Variable,
+    Parameter,
+    Negate,
+    Function,
+    Add,
+    Subtract,
+    Multiply,
+    Divide,
+    Power
+  };
+  static bool isLeaf(Code code) { return code < Code::Negate; }
+  static bool isBinary(Code code) { return code > Code::Function; }
+
+  /// An instruction of the program
+  struct Instruction {
+    Code code{Code::Number};
+    /// The value of a Number
+    double number{0.0};
+    /// The index of a Parameter
+    size_t index{0};
+    /// The function of a Function and its derivative
+    double (*function)(double){nullptr};
+    double (*derivative)(double){nullptr};
+    /// For each parameter, true if the result depends on it
+    std::vector<char> dependsOn;
+    /// The parameters the result depends on
+    std::vector<size_t> dependencies;
+  };
+
+  void run(const double *parameters, const double *x, const size_t n,
+           bool withDerivatives) const;
+  void runBinary(size_t k, size_t top, const size_t n,
+                 bool withDerivatives) const;
+  double *value(size_t slot, const size_t n) const;
+  double *derivative(size_t slot, size_t parameter, const size_t n) const;
+  double *scratch(size_t i, const size_t n) const;
+
+  /// The instructions in postfix order
+  std::vector<Instruction> m_program;
+  /// The number of parameters
+  size_t m_nParams;
+  /// The largest number of values on the stack of the program
+  size_t m_stackSize;
+  /// The values on the stack
+  mutable std::vector<std::vector<double>> m_values;
+  /// The derivatives of the values on the stack, m_nParams per value
+  mutable std::vector<std::vector<double>> m_derivatives;
+  /// The instruction which produced each value on the stack
+  mutable std::vector<size_t> m_producers;
+  /// Work arrays for partial derivatives
+  mutable std::vector<std::vector<double>> m_scratch;
+};
+
+} // namespace CurveFitting
+} // namespace Mantid
+
+#endif /* MANTID_CURVEFITTING_COMPILEDEXPRESSION_H_ */
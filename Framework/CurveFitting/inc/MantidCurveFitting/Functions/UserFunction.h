@@ -7,6 +7,7 @@
 #include "MantidAPI/ParamFunction.h"
 #include "MantidAPI/IFunction1D.h"
 #include <boost/shared_array.hpp>
+#include <memory>
 
 namespace mu {
 class Parser;
@@ -14,6 +15,7 @@ class Parser;
 
 namespace Mantid {
 namespace CurveFitting {
+class CompiledExpression;
 namespace Functions {
 /**
 A user defined function.
@@ -85,6 +87,8 @@ private:
   std::string m_formula;
   /// extended muParser instance
   mu::Parser *m_parser;
+  /// The formula compiled for evaluation over arrays, if it can be compiled
+  std::unique_ptr<CompiledExpression> m_compiled;
   /// Used as 'x' variable in m_parser.
   mutable double m_x;
   /// True indicates that input formula contains 'x' variable
@@ -96,6 +100,8 @@ private:
 
   /// mu::Parser callback function for setting variables.
   static double *AddVariable(const char *varName, void *pufun);
+  /// The values of the parameters
+  std::vector<double> parameterValues() const;
 };
 
 } // namespace Functions
@@ -5,6 +5,7 @@
 // Includes
 //----------------------------------------------------------------------
 #include "MantidCurveFitting/Algorithms/Fit1D.h"
+#include "MantidCurveFitting/CompiledExpression.h"
 #include "MantidGeometry/muParser_Silent.h"
 #include <boost/shared_array.hpp>
 
@@ -118,6 +119,8 @@ private:
   boost::shared_array<double> m_tmp;
   /// Temporary data storage
   boost::shared_array<double> m_tmp1;
+  /// The formula compiled for evaluation over arrays, if it can be compiled
+  std::unique_ptr<CompiledExpression> m_compiled;
 };
 
 } // namespace Functions
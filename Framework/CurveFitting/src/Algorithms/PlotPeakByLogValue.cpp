@@ -8,6 +8,7 @@
 #include <boost/algorithm/string/replace.hpp>
 
 #include "MantidCurveFitting/Algorithms/PlotPeakByLogValue.h"
+#include "MantidCurveFitting/BatchFitter.h"
 #include "MantidAPI/IFuncMinimizer.h"
 #include "MantidAPI/AlgorithmManager.h"
 #include "MantidAPI/FuncMinimizerFactory.h"
@@ -25,6 +26,7 @@
 #include "MantidAPI/BinEdgeAxis.h"
 #include "MantidAPI/Run.h"
 #include "MantidAPI/WorkspaceFactory.h"
+#include "MantidKernel/BoundedValidator.h"
 #include "MantidKernel/ListValidator.h"
 #include "MantidKernel/MandatoryValidator.h"
 
@@ -144,6 +146,15 @@ void PlotPeakByLogValue::init() {
           new Kernel::ListValidator<std::string>(evaluationTypes)),
       "The way the function is evaluated: CentrePoint or Histogram.",
       Kernel::Direction::Input);
+
+  auto mustBeNonNegative = boost::make_shared<BoundedValidator<int>>();
+  mustBeNonNegative->setLower(0);
+  declareProperty("SequentialChains", 1, mustBeNonNegative,
+                  "The number of chains the spectra are split into when "
+                  "FitType is 'Sequential'. The chains are fitted in "
+                  "parallel and each one starts with the initial values "
+                  "defined in the Function property. 0 means one chain per "
+                  "thread.");
 }
 
 /**
@@ -201,6 +212,11 @@ void PlotPeakByLogValue::exec() {
 
   setProperty("OutputWorkspace", result);
 
+  // Spectra fitted together after the loop, with the labels of their rows
+  const bool batchFit = isBatchFit(*ifun);
+  std::vector<BatchFitter::Spectrum> batchSpectra;
+  std::vector<std::pair<std::string, double>> batchRows;
+
   std::vector<std::string> covariance_workspaces;
   std::vector<std::string> fit_workspaces;
   std::vector<std::string> parameter_workspaces;
@@ -265,6 +281,12 @@ void PlotPeakByLogValue::exec() {
         logValue = logp->lastValue();
       }
 
+      if (batchFit) {
+        batchSpectra.push_back({data.ws, static_cast<size_t>(j)});
+        batchRows.emplace_back(wsNames[i].name, logValue);
+        continue;
+      }
+
       double chi2;
 
       try {
@@ -360,6 +382,52 @@ void PlotPeakByLogValue::exec() {
     } // for(;j < jend;++j)
   }
 
+  if (!batchSpectra.empty()) {
+    BatchFitter fitter(ifun);
+    fitter.setMinimizer(getPropertyValue("Minimizer"));
+    fitter.setCostFunction(getPropertyValue("CostFunction"));
+    const int maxIterations = getProperty("MaxIterations");
+    if (maxIterations < 0) {
+      throw std::invalid_argument("MaxIterations must not be negative");
+    }
+    fitter.setMaxIterations(static_cast<size_t>(maxIterations));
+    const double startX = getProperty("StartX");
+    const double endX = getProperty("EndX");
+    fitter.setRange(startX, endX);
+    const int peakRadius = getProperty("PeakRadius");
+    fitter.setPeakRadius(peakRadius);
+    fitter.setWarmStart(!individual);
+    const int chains = getProperty("SequentialChains");
+    fitter.setNumberOfChains(static_cast<size_t>(chains));
+    fitter.setPassWorkspaceIndex(passWSIndexToFunction);
+    fitter.setInterruptionPoint([this]() { interruption_point(); });
+
+    Progress prog(this, 0.0, 1.0, batchSpectra.size());
+    std::vector<BatchFitter::Result> fits;
+    try {
+      fits = fitter.fit(batchSpectra, &prog);
+    } catch (...) {
+      g_log.error("Error in fitting the spectra");
+      throw;
+    }
+
+    for (size_t k = 0; k < fits.size(); ++k) {
+      const auto &fit = fits[k];
+      g_log.debug() << "Fit result " << fit.status << ' ' << fit.chi2OverDoF
+                    << '\n';
+      TableRow row = result->appendRow();
+      if (isDataName) {
+        row << batchRows[k].first;
+      } else {
+        row << batchRows[k].second;
+      }
+      for (size_t iPar = 0; iPar < fit.parameters.size(); ++iPar) {
+        row << fit.parameters[iPar] << fit.errors[iPar];
+      }
+      row << fit.chi2OverDoF;
+    }
+  }
+
   if (createFitOutput) {
     // collect output of fit for each spectrum into workspace groups
     API::IAlgorithm_sptr groupAlg =
@@ -394,6 +462,33 @@ void PlotPeakByLogValue::exec() {
   }
 }
 
+/** Check if the spectra can be fitted together by a BatchFitter instead of
+  * running Fit for each of them. This is the case unless Fit has to create
+  * output workspaces or the fit depends on the name of the spectrum.
+  * @param function :: the fitting function
+  * @return true if the spectra are fitted by a BatchFitter
+  */
+bool PlotPeakByLogValue::isBatchFit(const API::IFunction &function) const {
+  const bool createFitOutput = getProperty("CreateOutput");
+  if (createFitOutput || getPropertyValue("EvaluationType") != "CentrePoint" ||
+      !BatchFitter::canFit(function)) {
+    return false;
+  }
+  const std::string minimizerName = getPropertyValue("Minimizer");
+  if (minimizerName.find('$') != std::string::npos) {
+    return false;
+  }
+  auto minimizer =
+      FuncMinimizerFactory::Instance().createMinimizer(minimizerName);
+  for (auto &minimizerProp : minimizer->getProperties()) {
+    if (dynamic_cast<Mantid::API::WorkspaceProperty<> *>(minimizerProp) &&
+        !minimizerProp->value().empty()) {
+      return false;
+    }
+  }
+  return true;
+}
+
 /** Get a workspace identified by an InputData structure.
   * @param data :: InputData with name and either spec or i fields defined.
   * @return InputData structure with the ws field set if everything was OK.
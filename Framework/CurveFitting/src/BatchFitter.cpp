@@ -0,0 +1,259 @@
+#include "MantidCurveFitting/BatchFitter.h"
+#include "MantidCurveFitting/CostFunctions/CostFuncFitting.h"
+#include "MantidCurveFitting/FitMW.h"
+#include "MantidCurveFitting/GSLMatrix.h"
+
+#include "MantidAPI/CompositeFunction.h"
+#include "MantidAPI/CostFunctionFactory.h"
+#include "MantidAPI/FuncMinimizerFactory.h"
+#include "MantidAPI/FunctionDomain1D.h"
+#include "MantidAPI/FunctionValues.h"
+#include "MantidAPI/IFuncMinimizer.h"
+#include "MantidAPI/IFunction1DSpectrum.h"
+#include "MantidAPI/IFunctionGeneral.h"
+#include "MantidAPI/IFunctionMD.h"
+#include "MantidAPI/ILatticeFunction.h"
+#include "MantidAPI/MatrixWorkspace.h"
+#include "MantidAPI/MultiDomainFunction.h"
+#include "MantidAPI/Progress.h"
+#include "MantidKernel/EmptyValues.h"
+#include "MantidKernel/Exception.h"
+#include "MantidKernel/TaskRuntime.h"
+
+#include <gsl/gsl_errno.h>
+
+#include <algorithm>
+#include <memory>
+
+namespace Mantid {
+namespace CurveFitting {
+
+using namespace API;
+
+namespace {
+/// Set the WorkspaceIndex attribute of a function and all its members
+void setWorkspaceIndexAttribute(IFunction &function, int wsIndex) {
+  const std::string attName = "WorkspaceIndex";
+  if (function.hasAttribute(attName)) {
+    function.setAttributeValue(attName, wsIndex);
+  }
+  if (auto cf = dynamic_cast<CompositeFunction *>(&function)) {
+    for (size_t i = 0; i < cf->nFunctions(); ++i) {
+      setWorkspaceIndexAttribute(*cf->getFunction(i), wsIndex);
+    }
+  }
+}
+} // namespace
+
+/// The objects a chain of fits reuses
+struct BatchFitter::Worker {
+  IFunction_sptr function;
+  boost::shared_ptr<CostFunctions::CostFuncFitting> costFunction;
+  FitMW domainCreator;
+};
+
+/** Constructor
+ * @param prototype :: the function to fit. Its parameters are the initial
+ * values of the fits.
+ * @throw std::invalid_argument if the function cannot be fitted to spectra
+ * of a MatrixWorkspace by this class
+ */
+BatchFitter::BatchFitter(API::IFunction_const_sptr prototype)
+    : m_prototype(std::move(prototype)), m_startX(EMPTY_DBL()),
+      m_endX(EMPTY_DBL()) {
+  if (!m_prototype || !canFit(*m_prototype))
+    throw std::invalid_argument("BatchFitter: the function must be a "
+                                "function of a single spectrum");
+  // Disable default gsl error handler (which is to call abort!)
+  gsl_set_error_handler_off();
+}
+
+/** Check if a function is fitted to a spectrum of a MatrixWorkspace by
+ * FitMW, the domain creator this class uses.
+ * @param function :: a fitting function
+ * @return true if the function can be used with this class
+ */
+bool BatchFitter::canFit(const API::IFunction &function) {
+  return !dynamic_cast<const ILatticeFunction *>(&function) &&
+         !dynamic_cast<const IFunctionMD *>(&function) &&
+         !dynamic_cast<const IFunction1DSpectrum *>(&function) &&
+         !dynamic_cast<const IFunctionGeneral *>(&function) &&
+         !dynamic_cast<const MultiDomainFunction *>(&function);
+}
+
+/** Fit the function to spectra
+ * @param spectra :: the spectra to fit
+ * @param progress :: optional progress, reported once per spectrum
+ * @return the results in the order of the spectra
+ * @throw the first exception thrown by a fit
+ */
+std::vector<BatchFitter::Result>
+BatchFitter::fit(const std::vector<Spectrum> &spectra,
+                 API::Progress *progress) const {
+  std::vector<Result> results(spectra.size());
+  if (spectra.empty())
+    return results;
+
+  // Functions are cloned through the function factory, so the workers are
+  // created before the fits start
+  const size_t nChains = numberOfChains(spectra.size());
+  std::vector<std::unique_ptr<Worker>> workers;
+  workers.reserve(nChains);
+  for (size_t i = 0; i < nChains; ++i) {
+    auto worker = std::unique_ptr<Worker>(new Worker());
+    worker->function = m_prototype->clone();
+    worker->costFunction =
+        boost::dynamic_pointer_cast<CostFunctions::CostFuncFitting>(
+            CostFunctionFactory::Instance().create(m_costFunction));
+    if (!worker->costFunction)
+      throw std::invalid_argument("BatchFitter: " + m_costFunction +
+                                  " is not a fitting cost function");
+    workers.push_back(std::move(worker));
+  }
+
+  Kernel::TaskRuntime::TaskGroup group;
+  for (size_t chain = 0; chain < nChains; ++chain) {
+    const size_t begin = chain * spectra.size() / nChains;
+    const size_t end = (chain + 1) * spectra.size() / nChains;
+    Worker &worker = *workers[chain];
+    group.run([this, &worker, &spectra, begin, end, &results, progress]() {
+      fitChain(worker, spectra, begin, end, results, progress);
+    });
+  }
+  group.wait();
+  return results;
+}
+
+/** Get the number of chains the spectra are split into. Without warm start
+ * the results do not depend on it, so there is one chain per thread.
+ * @param numberOfSpectra :: the number of spectra to fit
+ * @return the number of chains
+ */
+size_t BatchFitter::numberOfChains(size_t numberOfSpectra) const {
+  size_t chains = static_cast<size_t>(Kernel::TaskRuntime::concurrency());
+  if (m_warmStart && m_numberOfChains > 0)
+    chains = m_numberOfChains;
+  return std::max<size_t>(1, std::min(chains, numberOfSpectra));
+}
+
+/** Fit a contiguous range of spectra one after another. The interruption
+ * point is called before each fit.
+ * @param worker :: the objects of the chain
+ * @param spectra :: all spectra
+ * @param begin :: index of the first spectrum of the chain
+ * @param end :: index past the last spectrum of the chain
+ * @param results :: the results of all spectra
+ * @param progress :: optional progress
+ */
+void BatchFitter::fitChain(Worker &worker, const std::vector<Spectrum> &spectra,
+                           size_t begin, size_t end,
+                           std::vector<Result> &results,
+                           API::Progress *progress) const {
+  auto &function = *worker.function;
+  for (size_t i = begin; i < end; ++i) {
+    if (m_interruptionPoint)
+      m_interruptionPoint();
+    if (!m_warmStart && i != begin) {
+      for (size_t iPar = 0; iPar < function.nParams(); ++iPar) {
+        function.setParameter(iPar, m_prototype->getParameter(iPar));
+      }
+    }
+    results[i] = fitSpectrum(worker, spectra[i]);
+    if (progress)
+      progress->report();
+  }
+}
+
+/** Fit the function of a worker to a spectrum, starting from its current
+ * parameters. The steps are those of Fit.
+ * @param worker :: the objects of the chain
+ * @param spectrum :: the spectrum to fit
+ * @return the result of the fit
+ */
+BatchFitter::Result BatchFitter::fitSpectrum(Worker &worker,
+                                             const Spectrum &spectrum) const {
+  auto &function = *worker.function;
+  auto &creator = worker.domainCreator;
+  if (m_passWorkspaceIndex) {
+    setWorkspaceIndexAttribute(function,
+                               static_cast<int>(spectrum.workspaceIndex));
+  }
+  creator.setWorkspace(spectrum.workspace);
+  creator.setWorkspaceIndex(spectrum.workspaceIndex);
+  creator.setRange(m_startX, m_endX);
+
+  FunctionDomain_sptr domain;
+  FunctionValues_sptr values;
+  IFuncMinimizer_sptr minimizer;
+  // Some minimizers keep state between runs, so each fit gets a new one
+  auto initialize = [&](size_t maxIterations) {
+    function.setUpForFit();
+    creator.createDomain(domain, values);
+    if (auto d1d = dynamic_cast<FunctionDomain1D *>(domain.get())) {
+      if (m_peakRadius != 0) {
+        d1d->setPeakRadius(m_peakRadius);
+      }
+    }
+    creator.initFunction(worker.function);
+    worker.costFunction->setFittingFunction(worker.function, domain, values);
+    minimizer = FuncMinimizerFactory::Instance().createMinimizer(m_minimizer);
+    minimizer->initialize(worker.costFunction, maxIterations);
+  };
+  initialize(m_maxIterations);
+
+  size_t iter = 0;
+  bool isFinished = false;
+  while (iter < m_maxIterations) {
+    try {
+      function.iterationStarting();
+      isFinished = !minimizer->iterate(iter);
+      function.iterationFinished();
+    } catch (Kernel::Exception::FitSizeWarning &) {
+      // The function changed its number of parameters or ties
+      if (auto cf = dynamic_cast<CompositeFunction *>(&function)) {
+        cf->checkFunction();
+      }
+      initialize(m_maxIterations - iter);
+    }
+    ++iter;
+    if (isFinished)
+      break;
+  }
+  minimizer->finalize();
+
+  Result result;
+  result.status = minimizer->getError();
+  if (iter >= m_maxIterations) {
+    if (!result.status.empty()) {
+      result.status += '\n';
+    }
+    result.status += "Failed to converge after " +
+                     std::to_string(m_maxIterations) + " iterations.";
+  }
+  if (result.status.empty()) {
+    result.status = "success";
+  }
+
+  auto &costFunction = *worker.costFunction;
+  size_t dof = domain->size() - costFunction.nParams();
+  if (dof == 0)
+    dof = 1;
+  const double rawCostFuncVal = minimizer->costFunctionVal();
+  result.chi2OverDoF = rawCostFuncVal / static_cast<double>(dof);
+  if (costFunction.nParams() > 0) {
+    GSLMatrix covar;
+    costFunction.calCovarianceMatrix(covar);
+    costFunction.calFittingErrors(covar, rawCostFuncVal);
+  }
+
+  result.parameters.resize(function.nParams());
+  result.errors.resize(function.nParams());
+  for (size_t i = 0; i < function.nParams(); ++i) {
+    result.parameters[i] = function.getParameter(i);
+    result.errors[i] = function.getError(i);
+  }
+  return result;
+}
+
+} // namespace CurveFitting
+} // namespace Mantid
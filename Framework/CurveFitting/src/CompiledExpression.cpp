@@ -0,0 +1,632 @@
+#include "MantidCurveFitting/CompiledExpression.h"
+#include "MantidAPI/Jacobian.h"
+#include "MantidGeometry/muParser_Silent.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <stdexcept>
+
+namespace Mantid {
+namespace CurveFitting {
+
+namespace {
+/// A function of one argument known to muParser and its derivative
+struct FunctionDefinition {
+  const char *name;
+  double (*function)(double);
+  double (*derivative)(double);
+};
+
+double sign(double v) { return v < 0.0 ? -1.0 : (v > 0.0 ? 1.0 : 0.0); }
+double zero(double) { return 0.0; }
+double gaussian(double v) { return 2.0 / std::sqrt(M_PI) * std::exp(-v * v); }
+
+const FunctionDefinition FUNCTIONS[] = {
+    {"sin", [](double v) { return std::sin(v); },
+     [](double v) { return std::cos(v); }},
+    {"cos", [](double v) { return std::cos(v); },
+     [](double v) { return -std::sin(v); }},
+    {"tan", [](double v) { return std::tan(v); },
+     [](double v) { return 1.0 / (std::cos(v) * std::cos(v)); }},
+    {"asin", [](double v) { return std::asin(v); },
+     [](double v) { return 1.0 / std::sqrt(1.0 - v * v); }},
+    {"acos", [](double v) { return std::acos(v); },
+     [](double v) { return -1.0 / std::sqrt(1.0 - v * v); }},
+    {"atan", [](double v) { return std::atan(v); },
+     [](double v) { return 1.0 / (1.0 + v * v); }},
+    {"sinh", [](double v) { return std::sinh(v); },
+     [](double v) { return std::cosh(v); }},
+    {"cosh", [](double v) { return std::cosh(v); },
+     [](double v) { return std::sinh(v); }},
+    {"tanh", [](double v) { return std::tanh(v); },
+     [](double v) { return 1.0 - std::tanh(v) * std::tanh(v); }},
+    {"asinh", [](double v) { return std::asinh(v); },
+     [](double v) { return 1.0 / std::sqrt(v * v + 1.0); }},
+    {"acosh", [](double v) { return std::acosh(v); },
+     [](double v) { return 1.0 / std::sqrt(v * v - 1.0); }},
+    {"atanh", [](double v) { return std::atanh(v); },
+     [](double v) { return 1.0 / (1.0 - v * v); }},
+    {"log2", [](double v) { return std::log2(v); },
+     [](double v) { return 1.0 / (v * M_LN2); }},
+    {"log10", [](double v) { return std::log10(v); },
+     [](double v) { return 1.0 / (v * M_LN10); }},
+    {"ln", [](double v) { return std::log(v); },
+     [](double v) { return 1.0 / v; }},
+    {"exp", [](double v) { return std::exp(v); },
+     [](double v) { return std::exp(v); }},
+    {"sqrt", [](double v) { return std::sqrt(v); },
+     [](double v) { return 0.5 / std::sqrt(v); }},
+    {"sign", sign, zero},
+    {"rint", [](double v) { return std::floor(v + 0.5); }, zero},
+    {"abs", [](double v) { return std::fabs(v); }, sign},
+    {"erf", [](double v) { return std::erf(v); }, gaussian},
+    {"erfc", [](double v) { return std::erfc(v); },
+     [](double v) { return -gaussian(v); }}};
+
+/// Details of the syntax which differ between versions of muParser
+struct Dialect {
+  /// The name of muParser's log function in FUNCTIONS
+  const char *logName;
+  /// True if -a^b means (-a)^b
+  bool minusBeforePower;
+};
+
+const Dialect &muParserDialect() {
+  static const Dialect dialect = []() {
+    mu::Parser parser;
+    parser.SetExpr("log(10)");
+    const bool log10 = std::abs(parser.Eval() - 1.0) < 1e-12;
+    parser.SetExpr("-2^2");
+    return Dialect{log10 ? "log10" : "ln", parser.Eval() > 0.0};
+  }();
+  return dialect;
+}
+} // namespace
+
+/** Parses a formula and translates it into a program
+ */
+class CompiledExpression::Compiler {
+public:
+  Compiler(const std::string &formula, const std::string &variable,
+           const std::vector<std::string> &parameters)
+      : m_formula(formula), m_variable(variable), m_parameters(parameters),
+        m_dialect(muParserDialect()), m_pos(0) {}
+
+  /// Translate the formula
+  std::vector<Instruction> compile() {
+    Node root = sum();
+    skipSpaces();
+    if (m_pos != m_formula.size())
+      fail("unexpected '" + m_formula.substr(m_pos, 1) + "'");
+    std::vector<Instruction> program;
+    emit(root, program);
+    return program;
+  }
+
+private:
+  /// A node of the parsed formula
+  struct Node {
+    Instruction instruction;
+    std::vector<Node> args;
+  };
+
+  Node sum() {
+    Node node = product();
+    for (char c = peek(); c == '+' || c == '-'; c = peek()) {
+      ++m_pos;
+      node = binary(c == '+' ? Code::Add : Code::Subtract, std::move(node),
+                    product());
+    }
+    return node;
+  }
+
+  Node product() {
+    Node node = unary();
+    for (char c = peek(); c == '*' || c == '/'; c = peek()) {
+      ++m_pos;
+      node = binary(c == '*' ? Code::Multiply : Code::Divide, std::move(node),
+                    unary());
+    }
+    return node;
+  }
+
+  /// A signed power, unless a sign binds stronger than ^
+  Node unary() {
+    bool negative = false;
+    if (!m_dialect.minusBeforePower && takeSign(negative))
+      return signed_(negative, unary());
+    return power();
+  }
+
+  /// ^ is right associative
+  Node power() {
+    Node node = primary();
+    if (peek() == '^') {
+      ++m_pos;
+      node = binary(Code::Power, std::move(node), unary());
+    }
+    return node;
+  }
+
+  Node primary() {
+    bool negative = false;
+    if (m_dialect.minusBeforePower && takeSign(negative))
+      return signed_(negative, primary());
+    return unsignedPrimary();
+  }
+
+  Node unsignedPrimary() {
+    const char c = peek();
+    if (c == '(') {
+      ++m_pos;
+      Node node = sum();
+      expect(')');
+      return node;
+    }
+    if (std::isdigit(c) || c == '.')
+      return number();
+    if (std::isalpha(c) || c == '_')
+      return name();
+    if (c == '\0')
+      fail("unexpected end of formula");
+    fail("unexpected '" + std::string(1, c) + "'");
+  }
+
+  Node number() {
+    const size_t start = m_pos;
+    size_t nDigits = 0;
+    for (; std::isdigit(current()); ++m_pos)
+      ++nDigits;
+    if (current() == '.') {
+      for (++m_pos; std::isdigit(current()); ++m_pos)
+        ++nDigits;
+    }
+    if (nDigits == 0)
+      fail("malformed number");
+    if (current() == 'e' || current() == 'E') {
+      size_t end = m_pos + 1;
+      if (end < m_formula.size() &&
+          (m_formula[end] == '+' || m_formula[end] == '-'))
+        ++end;
+      if (end < m_formula.size() && std::isdigit(m_formula[end])) {
+        for (m_pos = end; std::isdigit(current()); ++m_pos) {
+        }
+      }
+    }
+    return constant(std::stod(m_formula.substr(start, m_pos - start)));
+  }
+
+  Node name() {
+    const size_t start = m_pos;
+    while (std::isalnum(current()) || current() == '_')
+      ++m_pos;
+    std::string name = m_formula.substr(start, m_pos - start);
+    if (peek() == '(') {
+      ++m_pos;
+      Node arg = sum();
+      expect(')');
+      return function(name, std::move(arg));
+    }
+    if (name == m_variable) {
+      Node node;
+      node.instruction.code = Code::Variable;
+      return node;
+    }
+    auto it = std::find(m_parameters.begin(), m_parameters.end(), name);
+    if (it != m_parameters.end()) {
+      Node node;
+      node.instruction.code = Code::Parameter;
+      node.instruction.index = std::distance(m_parameters.begin(), it);
+      return node;
+    }
+    if (name == "_pi")
+      return constant(M_PI);
+    if (name == "_e")
+      return constant(M_E);
+    fail("unknown name " + name);
+  }
+
+  Node function(std::string name, Node arg) {
+    if (name == "log")
+      name = m_dialect.logName;
+    for (const auto &definition : FUNCTIONS) {
+      if (name == definition.name) {
+        if (arg.instruction.code == Code::Number)
+          return constant(definition.function(arg.instruction.number));
+        Node node;
+        node.instruction.code = Code::Function;
+        node.instruction.function = definition.function;
+        node.instruction.derivative = definition.derivative;
+        node.args.push_back(std::move(arg));
+        return node;
+      }
+    }
+    fail("unsupported function " + name);
+  }
+
+  Node constant(double value) {
+    Node node;
+    node.instruction.code = Code::Number;
+    node.instruction.number = value;
+    return node;
+  }
+
+  Node signed_(bool negative, Node arg) {
+    return negative ? negate(std::move(arg)) : std::move(arg);
+  }
+
+  Node negate(Node arg) {
+    if (arg.instruction.code == Code::Number)
+      return constant(-arg.instruction.number);
+    Node node;
+    node.instruction.code = Code::Negate;
+    node.args.push_back(std::move(arg));
+    return node;
+  }
+
+  /// A binary operation, evaluated now if both operands are numbers
+  Node binary(Code code, Node left, Node right) {
+    if (left.instruction.code == Code::Number &&
+        right.instruction.code == Code::Number) {
+      const double a = left.instruction.number;
+      const double b = right.instruction.number;
+      switch (code) {
+      case Code::Add:
+        return constant(a + b);
+      case Code::Subtract:
+        return constant(a - b);
+      case Code::Multiply:
+        return constant(a * b);
+      case Code::Divide:
+        return constant(a / b);
+      default:
+        return constant(std::pow(a, b));
+      }
+    }
+    Node node;
+    node.instruction.code = code;
+    node.args.push_back(std::move(left));
+    node.args.push_back(std::move(right));
+    return node;
+  }
+
+  /// Append the instructions of a node in postfix order and record the
+  /// parameters its result depends on
+  void emit(const Node &node, std::vector<Instruction> &program) {
+    Instruction instruction = node.instruction;
+    instruction.dependsOn.assign(m_parameters.size(), 0);
+    if (instruction.code == Code::Parameter)
+      instruction.dependsOn[instruction.index] = 1;
+    for (const auto &arg : node.args) {
+      emit(arg, program);
+      const auto &argDependsOn = program.back().dependsOn;
+      for (size_t i = 0; i < argDependsOn.size(); ++i)
+        instruction.dependsOn[i] |= argDependsOn[i];
+    }
+    for (size_t i = 0; i < instruction.dependsOn.size(); ++i) {
+      if (instruction.dependsOn[i])
+        instruction.dependencies.push_back(i);
+    }
+    program.push_back(std::move(instruction));
+  }
+
+  char current() const {
+    return m_pos < m_formula.size() ? m_formula[m_pos] : '\0';
+  }
+
+  void skipSpaces() {
+    while (std::isspace(current()))
+      ++m_pos;
+  }
+
+  /// The next character which is not a space
+  char peek() {
+    skipSpaces();
+    return current();
+  }
+
+  /// Consume a sign if the next character is one
+  bool takeSign(bool &negative) {
+    const char c = peek();
+    if (c != '-' && c != '+')
+      return false;
+    ++m_pos;
+    negative = c == '-';
+    return true;
+  }
+
+  void expect(char c) {
+    if (peek() != c)
+      fail("expected '" + std::string(1, c) + "'");
+    ++m_pos;
+  }
+
+  [[noreturn]] void fail(const std::string &message) const {
+    throw std::invalid_argument("Cannot compile formula " + m_formula + ": " +
+                                message);
+  }
+
+  const std::string &m_formula;
+  const std::string &m_variable;
+  const std::vector<std::string> &m_parameters;
+  const Dialect &m_dialect;
+  /// The position of the next character to parse
+  size_t m_pos;
+};
+
+/** Constructor
+ * @param formula :: the formula
+ * @param variable :: the name of the variable
+ * @param parameters :: the names of the parameters
+ * @throw std::invalid_argument if the formula uses features of muParser
+ * which are not supported or names which are not the variable or a parameter
+ */
+CompiledExpression::CompiledExpression(
+    const std::string &formula, const std::string &variable,
+    const std::vector<std::string> &parameters)
+    : m_program(Compiler(formula, variable, parameters).compile()),
+      m_nParams(parameters.size()), m_stackSize(0) {
+  size_t depth = 0;
+  for (const auto &instruction : m_program) {
+    if (isLeaf(instruction.code))
+      ++depth;
+    else if (isBinary(instruction.code))
+      --depth;
+    m_stackSize = std::max(m_stackSize, depth);
+  }
+  m_values.resize(m_stackSize);
+  m_derivatives.resize(m_stackSize * m_nParams);
+  m_producers.resize(m_stackSize);
+  m_scratch.resize(2);
+}
+
+/** Evaluate the formula
+ * @param parameters :: the values of the parameters
+ * @param x :: the values of the variable
+ * @param n :: the number of values of the variable
+ * @param out :: the values of the formula
+ */
+void CompiledExpression::evaluate(const double *parameters, const double *x,
+                                  const size_t n, double *out) const {
+  if (n == 0)
+    return;
+  run(parameters, x, n, false);
+  std::copy_n(value(0, n), n, out);
+}
+
+/** Calculate the derivatives of the formula with respect to the parameters
+ * @param parameters :: the values of the parameters
+ * @param x :: the values of the variable
+ * @param n :: the number of values of the variable
+ * @param jacobian :: receives the derivative by parameter j at x[i] at (i, j)
+ */
+void CompiledExpression::derivatives(const double *parameters,
+                                     const double *x, const size_t n,
+                                     API::Jacobian &jacobian) const {
+  if (n == 0)
+    return;
+  run(parameters, x, n, true);
+  const auto &dependsOn = m_program.back().dependsOn;
+  for (size_t j = 0; j < m_nParams; ++j) {
+    if (dependsOn[j]) {
+      const double *d = derivative(0, j, n);
+      for (size_t i = 0; i < n; ++i)
+        jacobian.set(i, j, d[i]);
+    } else {
+      for (size_t i = 0; i < n; ++i)
+        jacobian.set(i, j, 0.0);
+    }
+  }
+}
+
+/** Run the program. The result is left in the first value of the stack.
+ * @param parameters :: the values of the parameters
+ * @param x :: the values of the variable
+ * @param n :: the number of values of the variable
+ * @param withDerivatives :: calculate the derivatives along with the values
+ */
+void CompiledExpression::run(const double *parameters, const double *x,
+                             const size_t n, bool withDerivatives) const {
+  size_t top = 0;
+  for (size_t k = 0; k < m_program.size(); ++k) {
+    const auto &instruction = m_program[k];
+    const bool derivatives =
+        withDerivatives && !instruction.dependencies.empty();
+    switch (instruction.code) {
+    case Code::Number:
+      std::fill_n(value(top, n), n, instruction.number);
+      m_producers[top++] = k;
+      break;
+    case Code::Variable:
+      std::copy_n(x, n, value(top, n));
+      m_producers[top++] = k;
+      break;
+    case Code::Parameter:
+      std::fill_n(value(top, n), n, parameters[instruction.index]);
+      if (derivatives)
+        std::fill_n(derivative(top, instruction.index, n), n, 1.0);
+      m_producers[top++] = k;
+      break;
+    case Code::Negate: {
+      double *u = value(top - 1, n);
+      if (derivatives) {
+        for (auto j : instruction.dependencies) {
+          double *d = derivative(top - 1, j, n);
+          for (size_t i = 0; i < n; ++i)
+            d[i] = -d[i];
+        }
+      }
+      for (size_t i = 0; i < n; ++i)
+        u[i] = -u[i];
+      m_producers[top - 1] = k;
+      break;
+    }
+    case Code::Function: {
+      double *u = value(top - 1, n);
+      if (derivatives) {
+        double *df = scratch(0, n);
+        for (size_t i = 0; i < n; ++i)
+          df[i] = instruction.derivative(u[i]);
+        for (auto j : instruction.dependencies) {
+          double *d = derivative(top - 1, j, n);
+          for (size_t i = 0; i < n; ++i)
+            d[i] *= df[i];
+        }
+      }
+      for (size_t i = 0; i < n; ++i)
+        u[i] = instruction.function(u[i]);
+      m_producers[top - 1] = k;
+      break;
+    }
+    default:
+      runBinary(k, top, n, derivatives);
+      --top;
+      m_producers[top - 1] = k;
+    }
+  }
+}
+
+/** Run a binary operation on the top two values of the stack. The result
+ * replaces the left operand.
+ * @param k :: the index of the instruction
+ * @param top :: the number of values on the stack
+ * @param n :: the number of values of the variable
+ * @param withDerivatives :: calculate the derivatives along with the values
+ */
+void CompiledExpression::runBinary(size_t k, size_t top, const size_t n,
+                                   bool withDerivatives) const {
+  const auto &instruction = m_program[k];
+  const size_t left = top - 2;
+  const size_t right = top - 1;
+  double *u = value(left, n);
+  const double *w = value(right, n);
+
+  if (withDerivatives) {
+    const auto &leftDependsOn = m_program[m_producers[left]].dependsOn;
+    const auto &rightDependsOn = m_program[m_producers[right]].dependsOn;
+    // The partial derivatives of the result by u and w, 1 and +-1 for + and -
+    const double *dfdu = nullptr;
+    const double *dfdw = nullptr;
+    if (instruction.code == Code::Multiply) {
+      dfdu = w;
+      dfdw = u;
+    } else if (instruction.code == Code::Divide) {
+      double *a = scratch(0, n);
+      double *b = scratch(1, n);
+      for (size_t i = 0; i < n; ++i) {
+        a[i] = 1.0 / w[i];
+        b[i] = -u[i] * a[i] * a[i];
+      }
+      dfdu = a;
+      dfdw = b;
+    } else if (instruction.code == Code::Power) {
+      // At u == 0 the formulas below give inf or 0 * log(0). The derivative
+      // by w tends to 0 for w > 0, and the one by u is taken as 0 where it
+      // is not finite, so that a fit over x = 0 gets a usable Jacobian.
+      if (!m_program[m_producers[left]].dependencies.empty()) {
+        double *a = scratch(0, n);
+        for (size_t i = 0; i < n; ++i)
+          a[i] = u[i] == 0.0 && w[i] > 0.0 && w[i] < 1.0
+                     ? 0.0
+                     : w[i] * std::pow(u[i], w[i] - 1.0);
+        dfdu = a;
+      }
+      if (!m_program[m_producers[right]].dependencies.empty()) {
+        double *b = scratch(1, n);
+        for (size_t i = 0; i < n; ++i)
+          b[i] = u[i] == 0.0 && w[i] > 0.0
+                     ? 0.0
+                     : std::pow(u[i], w[i]) * std::log(u[i]);
+        dfdw = b;
+      }
+    }
+
+    for (auto j : instruction.dependencies) {
+      const bool byLeft = leftDependsOn[j] != 0;
+      const bool byRight = rightDependsOn[j] != 0;
+      double *d = derivative(left, j, n);
+      const double *dw = byRight ? derivative(right, j, n) : nullptr;
+      switch (instruction.code) {
+      case Code::Add:
+        if (byLeft && byRight) {
+          for (size_t i = 0; i < n; ++i)
+            d[i] += dw[i];
+        } else if (byRight) {
+          std::copy_n(dw, n, d);
+        }
+        break;
+      case Code::Subtract:
+        if (byLeft && byRight) {
+          for (size_t i = 0; i < n; ++i)
+            d[i] -= dw[i];
+        } else if (byRight) {
+          for (size_t i = 0; i < n; ++i)
+            d[i] = -dw[i];
+        }
+        break;
+      default:
+        if (byLeft && byRight) {
+          for (size_t i = 0; i < n; ++i)
+            d[i] = d[i] * dfdu[i] + dw[i] * dfdw[i];
+        } else if (byLeft) {
+          for (size_t i = 0; i < n; ++i)
+            d[i] *= dfdu[i];
+        } else {
+          for (size_t i = 0; i < n; ++i)
+            d[i] = dw[i] * dfdw[i];
+        }
+      }
+    }
+  }
+
+  switch (instruction.code) {
+  case Code::Add:
+    for (size_t i = 0; i < n; ++i)
+      u[i] += w[i];
+    break;
+  case Code::Subtract:
+    for (size_t i = 0; i < n; ++i)
+      u[i] -= w[i];
+    break;
+  case Code::Multiply:
+    for (size_t i = 0; i < n; ++i)
+      u[i] *= w[i];
+    break;
+  case Code::Divide:
+    for (size_t i = 0; i < n; ++i)
+      u[i] /= w[i];
+    break;
+  default:
+    for (size_t i = 0; i < n; ++i)
+      u[i] = std::pow(u[i], w[i]);
+  }
+}
+
+/// The array of a value on the stack with room for n values
+double *CompiledExpression::value(size_t slot, const size_t n) const {
+  auto &values = m_values[slot];
+  if (values.size() < n)
+    values.resize(n);
+  return values.data();
+}
+
+/// The array of the derivative of a value on the stack by a parameter
+double *CompiledExpression::derivative(size_t slot, size_t parameter,
+                                       const size_t n) const {
+  auto &values = m_derivatives[slot * m_nParams + parameter];
+  if (values.size() < n)
+    values.resize(n);
+  return values.data();
+}
+
+/// A work array with room for n values
+double *CompiledExpression::scratch(size_t i, const size_t n) const {
+  auto &values = m_scratch[i];
+  if (values.size() < n)
+    values.resize(n);
+  return values.data();
+}
+
+} // namespace CurveFitting
+} // namespace Mantid
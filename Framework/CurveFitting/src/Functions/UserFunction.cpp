@@ -2,8 +2,11 @@
 // Includes
 //----------------------------------------------------------------------
 #include "MantidCurveFitting/Functions/UserFunction.h"
+#include "MantidCurveFitting/CompiledExpression.h"
+#include "MantidAPI/FunctionDomain1D.h"
 #include "MantidAPI/FunctionFactory.h"
 #include "MantidAPI/MuParserUtils.h"
+#include "MantidKernel/make_unique.h"
 #include <boost/tokenizer.hpp>
 #include "MantidGeometry/muParser_Silent.h"
 
@@ -63,6 +66,7 @@ void UserFunction::setAttribute(const std::string &attName,
   }
 
   m_x_set = false;
+  m_compiled.reset();
   clearAllParameters();
 
   try {
@@ -93,6 +97,25 @@ void UserFunction::setAttribute(const std::string &attName,
   }
 
   m_parser->SetExpr(m_formula);
+
+  std::vector<std::string> names;
+  for (size_t i = 0; i < nParams(); i++) {
+    names.push_back(parameterName(i));
+  }
+  try {
+    m_compiled = Kernel::make_unique<CompiledExpression>(m_formula, "x", names);
+  } catch (std::invalid_argument &) {
+    // Formulas using other features of muParser are evaluated point by point
+  }
+}
+
+/// The values of the parameters in the order of their declaration
+std::vector<double> UserFunction::parameterValues() const {
+  std::vector<double> values(nParams());
+  for (size_t i = 0; i < values.size(); i++) {
+    values[i] = getParameter(i);
+  }
+  return values;
 }
 
 /** Calculate the fitting function.
@@ -104,6 +127,10 @@ void UserFunction::setAttribute(const std::string &attName,
 */
 void UserFunction::function1D(double *out, const double *xValues,
                               const size_t nData) const {
+  if (m_compiled) {
+    m_compiled->evaluate(parameterValues().data(), xValues, nData, out);
+    return;
+  }
   for (size_t i = 0; i < nData; i++) {
     m_x = xValues[i];
     out[i] = m_parser->Eval();
@@ -111,6 +138,8 @@ void UserFunction::function1D(double *out, const double *xValues,
 }
 
 /**
+* The derivatives are exact if the formula could be compiled and numerical
+* otherwise.
 * @param domain :: the space on which the function acts
 * @param jacobian :: the set of partial derivatives of the function with respect
 * to the
@@ -118,6 +147,15 @@ void UserFunction::function1D(double *out, const double *xValues,
 */
 void UserFunction::functionDeriv(const API::FunctionDomain &domain,
                                  API::Jacobian &jacobian) {
+  auto d1d = dynamic_cast<const FunctionDomain1D *>(&domain);
+  if (m_compiled && d1d &&
+      !dynamic_cast<const FunctionDomain1DHistogram *>(&domain)) {
+    if (d1d->size() > 0) {
+      m_compiled->derivatives(parameterValues().data(), d1d->getPointerAt(0),
+                              d1d->size(), jacobian);
+    }
+    return;
+  }
   calNumericalDeriv(domain, jacobian);
 }
 
@@ -5,6 +5,7 @@
 #include "MantidKernel/MandatoryValidator.h"
 #include "MantidKernel/StringTokenizer.h"
 #include "MantidKernel/UnitFactory.h"
+#include "MantidKernel/make_unique.h"
 
 namespace Mantid {
 namespace CurveFitting {
@@ -63,6 +64,13 @@ void UserFunction1D::prepare() {
   if (!m_x_set)
     throw std::runtime_error("Formula does not contain the x variable");
 
+  try {
+    m_compiled =
+        Kernel::make_unique<CompiledExpression>(funct, "x", m_parameterNames);
+  } catch (std::invalid_argument &) {
+    // Formulas using other features of muParser are evaluated point by point
+  }
+
   // Set the initial values to the fit parameters
   std::string initParams = getProperty("InitialParameters");
   if (!initParams.empty()) {
@@ -109,6 +117,10 @@ void UserFunction1D::prepare() {
  */
 void UserFunction1D::function(const double *in, double *out,
                               const double *xValues, const size_t nData) {
+  if (m_compiled) {
+    m_compiled->evaluate(in, xValues, nData, out);
+    return;
+  }
   for (size_t i = 0; i < static_cast<size_t>(m_nPars); i++)
     m_parameters[i] = in[i];
 
@@ -129,6 +141,10 @@ void UserFunction1D::functionDeriv(const double *in, Jacobian *out,
   // throw Exception::NotImplementedError("No derivative function provided");
   if (nData == 0)
     return;
+  if (m_compiled) {
+    m_compiled->derivatives(in, xValues, nData, *out);
+    return;
+  }
   std::vector<double> dp(m_nPars);
   std::vector<double> in1(m_nPars);
   for (int i = 0; i < m_nPars; i++) {
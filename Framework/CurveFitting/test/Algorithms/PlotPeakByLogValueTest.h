@@ -24,6 +24,7 @@
 #include "MantidTestHelpers/WorkspaceCreationHelper.h"
 #include <sstream>
 #include <algorithm>
+#include <cmath>
 
 using namespace Mantid;
 using namespace Mantid::API;
@@ -253,6 +254,43 @@ public:
     WorkspaceCreationHelper::removeWS("PlotPeakResult");
   }
 
+  void test_sequential_chains_match_serial_fits() {
+    createData();
+    auto run = [](const std::string &output, bool createOutput, int chains) {
+      PlotPeakByLogValue alg;
+      alg.initialize();
+      alg.setPropertyValue("Input", "PlotPeakGroup");
+      alg.setPropertyValue("OutputWorkspace", output);
+      alg.setPropertyValue("WorkspaceIndex", "1");
+      alg.setPropertyValue("LogValue", "var");
+      alg.setPropertyValue("FitType", "Sequential");
+      alg.setProperty("CreateOutput", createOutput);
+      alg.setProperty("SequentialChains", chains);
+      alg.setPropertyValue("Function",
+                           "name=LinearBackground,A0=1,A1=0.3;name="
+                           "Gaussian,PeakCentre=5,Height=2,Sigma=0.1");
+      TS_ASSERT_THROWS_NOTHING(alg.execute());
+      TS_ASSERT(alg.isExecuted());
+      return WorkspaceCreationHelper::getWS<TableWorkspace>(output);
+    };
+    // CreateOutput makes PlotPeakByLogValue run Fit for each spectrum
+    auto serial = run("PlotPeakResultSerial", true, 1);
+    auto chained = run("PlotPeakResultChains", false, 3);
+
+    TS_ASSERT_EQUALS(chained->rowCount(), 3);
+    TS_ASSERT_EQUALS(chained->columnCount(), serial->columnCount());
+    for (size_t row = 0; row < serial->rowCount(); ++row) {
+      for (size_t col = 0; col < serial->columnCount(); ++col) {
+        const double expected = serial->Double(row, col);
+        TS_ASSERT_DELTA(chained->Double(row, col), expected,
+                        1e-5 * (1.0 + std::abs(expected)));
+      }
+    }
+
+    deleteData();
+    AnalysisDataService::Instance().clear();
+  }
+
   void testSpectraList_plotting_against_bin_edge_axis() {
     auto ws = createTestWorkspace();
     AnalysisDataService::Instance().add("PLOTPEAKBYLOGVALUETEST_WS", ws);
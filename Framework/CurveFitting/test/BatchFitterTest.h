@@ -0,0 +1,199 @@
+#ifndef MANTID_CURVEFITTING_BATCHFITTERTEST_H_
+#define MANTID_CURVEFITTING_BATCHFITTERTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidCurveFitting/BatchFitter.h"
+#include "MantidAPI/AlgorithmManager.h"
+#include "MantidAPI/FrameworkManager.h"
+#include "MantidAPI/FunctionFactory.h"
+#include "MantidAPI/MultiDomainFunction.h"
+#include "MantidDataObjects/Workspace2D.h"
+#include "MantidKernel/TaskRuntime.h"
+#include "MantidTestHelpers/WorkspaceCreationHelper.h"
+
+#include <atomic>
+#include <cmath>
+#include <stdexcept>
+
+using namespace Mantid::API;
+using Mantid::CurveFitting::BatchFitter;
+using Mantid::Kernel::TaskRuntime;
+
+class BatchFitterTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static BatchFitterTest *createSuite() { return new BatchFitterTest(); }
+  static void destroySuite(BatchFitterTest *suite) { delete suite; }
+
+  BatchFitterTest() { FrameworkManager::Instance(); }
+
+  void test_individual_fits_match_Fit() {
+    auto ws = createWorkspace(6);
+    auto prototype = createFunction();
+    BatchFitter fitter(prototype);
+    const auto results = fitter.fit(spectra(ws));
+
+    TS_ASSERT_EQUALS(results.size(), 6);
+    for (size_t i = 0; i < results.size(); ++i) {
+      auto function = prototype->clone();
+      double chi2 = 0.0;
+      runFit(function, ws, i, chi2);
+      TS_ASSERT_EQUALS(results[i].status, "success");
+      TS_ASSERT_DELTA(results[i].chi2OverDoF, chi2, 1e-10);
+      TS_ASSERT_EQUALS(results[i].parameters.size(), function->nParams());
+      for (size_t iPar = 0; iPar < function->nParams(); ++iPar) {
+        TS_ASSERT_DELTA(results[i].parameters[iPar],
+                        function->getParameter(iPar), 1e-10);
+        TS_ASSERT_DELTA(results[i].errors[iPar], function->getError(iPar),
+                        1e-10);
+      }
+    }
+  }
+
+  void test_warm_start_with_one_chain_matches_sequential_Fit() {
+    auto ws = createWorkspace(5);
+    BatchFitter fitter(createFunction());
+    fitter.setWarmStart(true);
+    fitter.setNumberOfChains(1);
+    const auto results = fitter.fit(spectra(ws));
+
+    auto function = createFunction();
+    for (size_t i = 0; i < results.size(); ++i) {
+      double chi2 = 0.0;
+      runFit(function, ws, i, chi2);
+      TS_ASSERT_DELTA(results[i].chi2OverDoF, chi2, 1e-10);
+      for (size_t iPar = 0; iPar < function->nParams(); ++iPar) {
+        TS_ASSERT_DELTA(results[i].parameters[iPar],
+                        function->getParameter(iPar), 1e-10);
+      }
+    }
+  }
+
+  void test_individual_fits_do_not_depend_on_number_of_threads() {
+    auto ws = createWorkspace(8);
+    BatchFitter fitter(createFunction());
+    const auto parallel = fitter.fit(spectra(ws));
+    std::vector<BatchFitter::Result> serial;
+    {
+      TaskRuntime::ScopedLimit limit(1);
+      serial = fitter.fit(spectra(ws));
+    }
+    TS_ASSERT_EQUALS(serial.size(), parallel.size());
+    for (size_t i = 0; i < serial.size(); ++i) {
+      TS_ASSERT_EQUALS(serial[i].parameters, parallel[i].parameters);
+      TS_ASSERT_EQUALS(serial[i].chi2OverDoF, parallel[i].chi2OverDoF);
+    }
+  }
+
+  void test_fitting_range() {
+    auto ws = createWorkspace(2);
+    BatchFitter fitter(createFunction());
+    fitter.setRange(4.0, 6.0);
+    const auto results = fitter.fit(spectra(ws));
+
+    auto function = createFunction();
+    auto fit = AlgorithmManager::Instance().create("Fit");
+    fit->setChild(true);
+    fit->setProperty("Function", function);
+    fit->setProperty("InputWorkspace",
+                     boost::static_pointer_cast<Workspace>(ws));
+    fit->setProperty("WorkspaceIndex", 1);
+    fit->setProperty("StartX", 4.0);
+    fit->setProperty("EndX", 6.0);
+    fit->setProperty("CalcErrors", true);
+    fit->execute();
+    const double chi2 = fit->getProperty("OutputChi2overDoF");
+    TS_ASSERT_DELTA(results[1].chi2OverDoF, chi2, 1e-10);
+    TS_ASSERT_DELTA(results[1].parameters[3], function->getParameter(3),
+                    1e-10);
+  }
+
+  void test_interruption_point_stops_all_chains() {
+    auto ws = createWorkspace(6);
+    BatchFitter fitter(createFunction());
+    fitter.setWarmStart(true);
+    fitter.setNumberOfChains(3);
+    std::atomic<int> calls(0);
+    fitter.setInterruptionPoint([&calls]() {
+      if (++calls > 2)
+        throw std::runtime_error("cancelled");
+    });
+    TS_ASSERT_THROWS(fitter.fit(spectra(ws)), std::runtime_error);
+    // every chain stops at its next check
+    TS_ASSERT_LESS_THAN_EQUALS(calls.load(), 5);
+  }
+
+  void test_no_spectra_gives_no_results() {
+    BatchFitter fitter(createFunction());
+    TS_ASSERT(fitter.fit({}).empty());
+  }
+
+  void test_multi_domain_function_is_rejected() {
+    auto function = FunctionFactory::Instance().createInitialized(
+        "composite=MultiDomainFunction;name=FlatBackground");
+    TS_ASSERT(!BatchFitter::canFit(*function));
+    TS_ASSERT_THROWS(BatchFitter{function}, std::invalid_argument);
+  }
+
+  void test_cost_function_must_be_a_fitting_one() {
+    auto ws = createWorkspace(1);
+    BatchFitter fitter(createFunction());
+    fitter.setCostFunction("NotACostFunction");
+    TS_ASSERT_THROWS_ANYTHING(fitter.fit(spectra(ws)));
+  }
+
+private:
+  /// A background and a peak which moves and broadens with the index
+  MatrixWorkspace_sptr createWorkspace(int nSpectra) {
+    auto ws = WorkspaceCreationHelper::create2DWorkspaceBinned(nSpectra, 100,
+                                                               0.0, 0.1);
+    for (int i = 0; i < nSpectra; ++i) {
+      const double a = 1.0 + 0.3 * i;
+      const double b = 0.3 - 0.02 * i;
+      const double h = 2.0 - 0.2 * i;
+      const double c = 5.0 + 0.03 * i;
+      const double s = 0.1 + 0.01 * i;
+      const auto &x = ws->points(i);
+      auto &y = ws->mutableY(i);
+      auto &e = ws->mutableE(i);
+      for (size_t k = 0; k < y.size(); ++k) {
+        const double dx = x[k] - c;
+        y[k] = a + b * x[k] + h * std::exp(-0.5 * dx * dx / (s * s));
+        e[k] = 0.1;
+      }
+    }
+    return ws;
+  }
+
+  IFunction_sptr createFunction() {
+    return FunctionFactory::Instance().createInitialized(
+        "name=LinearBackground,A0=1,A1=0.3;"
+        "name=Gaussian,Height=2,PeakCentre=5,Sigma=0.1");
+  }
+
+  std::vector<BatchFitter::Spectrum> spectra(const MatrixWorkspace_sptr &ws) {
+    std::vector<BatchFitter::Spectrum> result;
+    for (size_t i = 0; i < ws->getNumberHistograms(); ++i) {
+      result.push_back({ws, i});
+    }
+    return result;
+  }
+
+  void runFit(const IFunction_sptr &function, const MatrixWorkspace_sptr &ws,
+              size_t index, double &chi2) {
+    auto fit = AlgorithmManager::Instance().create("Fit");
+    fit->setChild(true);
+    fit->setProperty("Function", function);
+    fit->setProperty("InputWorkspace",
+                     boost::static_pointer_cast<Workspace>(ws));
+    fit->setProperty("WorkspaceIndex", static_cast<int>(index));
+    fit->setProperty("CalcErrors", true);
+    fit->execute();
+    TS_ASSERT(fit->isExecuted());
+    chi2 = fit->getProperty("OutputChi2overDoF");
+  }
+};
+
+#endif /* MANTID_CURVEFITTING_BATCHFITTERTEST_H_ */
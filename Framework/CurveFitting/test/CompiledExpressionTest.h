@@ -0,0 +1,172 @@
+#ifndef MANTID_CURVEFITTING_COMPILEDEXPRESSIONTEST_H_
+#define MANTID_CURVEFITTING_COMPILEDEXPRESSIONTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidCurveFitting/CompiledExpression.h"
+#include "MantidCurveFitting/Jacobian.h"
+#include "MantidGeometry/muParser_Silent.h"
+
+#include <cmath>
+#include <functional>
+
+using Mantid::CurveFitting::CompiledExpression;
+
+class CompiledExpressionTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static CompiledExpressionTest *createSuite() {
+    return new CompiledExpressionTest();
+  }
+  static void destroySuite(CompiledExpressionTest *suite) { delete suite; }
+
+  void test_peak_on_background() {
+    check("h*exp(-0.5*(x-c)^2/s^2) + A0 + A1*x", {"h", "c", "s", "A0", "A1"},
+          {2.0, 0.5, 0.3, 1.0, 0.2}, [](const double *p, double x) {
+            return p[0] * exp(-0.5 * pow(x - p[1], 2) / pow(p[2], 2)) + p[3] +
+                   p[4] * x;
+          });
+  }
+
+  void test_division() {
+    check("a/(b - x) - c/x", {"a", "b", "c"}, {1.5, 3.2, 0.4},
+          [](const double *p, double x) {
+            return p[0] / (p[1] - x) - p[2] / x;
+          });
+  }
+
+  void test_power_is_right_associative() {
+    check("a^b^2 + x", {"a", "b"}, {1.5, 1.2}, [](const double *p, double x) {
+      return pow(p[0], pow(p[1], 2)) + x;
+    });
+  }
+
+  void test_power_of_variable() {
+    check("x^a", {"a"}, {1.5},
+          [](const double *p, double x) { return pow(x, p[0]); });
+  }
+
+  void test_power_derivatives_at_zero() {
+    const std::vector<double> x{0.0, 0.5, 1.0};
+    for (double power : {0.5, 1.0, 2.5}) {
+      CompiledExpression expression("a*x^b", "x", {"a", "b"});
+      const std::vector<double> values{2.0, power};
+      Mantid::CurveFitting::Jacobian jacobian(x.size(), 2);
+      expression.derivatives(values.data(), x.data(), x.size(), jacobian);
+      TS_ASSERT_EQUALS(jacobian.get(0, 0), 0.0);
+      TS_ASSERT_EQUALS(jacobian.get(0, 1), 0.0);
+      TS_ASSERT_DELTA(jacobian.get(1, 1), 2.0 * pow(0.5, power) * log(0.5),
+                      1e-12);
+    }
+    // the base itself depends on a parameter
+    CompiledExpression expression("(a*x)^b", "x", {"a", "b"});
+    for (double power : {0.5, 1.0, 2.5}) {
+      const std::vector<double> values{2.0, power};
+      Mantid::CurveFitting::Jacobian jacobian(x.size(), 2);
+      expression.derivatives(values.data(), x.data(), x.size(), jacobian);
+      TS_ASSERT_EQUALS(jacobian.get(0, 0), 0.0);
+      TS_ASSERT_EQUALS(jacobian.get(0, 1), 0.0);
+    }
+  }
+
+  void test_signs_and_powers_are_evaluated_like_muParser() {
+    const std::vector<double> x{-1.5, 0.5, 2.0};
+    for (auto formula : {"-x^2", "-2^x", "a*-x^2", "2^-x", "-a^-x",
+                         "x^2^-a", "1-x^2", "-(x)^a*2", "a/-x^2"}) {
+      CompiledExpression expression(formula, "x", {"a"});
+      const double a = 2.0;
+      std::vector<double> out(x.size());
+      expression.evaluate(&a, x.data(), x.size(), out.data());
+
+      mu::Parser parser;
+      double var = 0.0;
+      double par = a;
+      parser.DefineVar("x", &var);
+      parser.DefineVar("a", &par);
+      parser.SetExpr(formula);
+      for (size_t i = 0; i < x.size(); ++i) {
+        var = x[i];
+        const double expected = parser.Eval();
+        if (std::isnan(expected)) {
+          TSM_ASSERT(formula, std::isnan(out[i]));
+        } else {
+          TSM_ASSERT_DELTA(formula, out[i], expected,
+                           1e-12 * (1.0 + std::abs(expected)));
+        }
+      }
+    }
+  }
+
+  void test_functions_and_constants() {
+    check("2*_pi*log10(b)*sqrt(abs(a*x)) + erf(a*x) - tanh(b*x) + _e",
+          {"a", "b"}, {1.5, 2.2}, [](const double *p, double x) {
+            return 2 * M_PI * log10(p[1]) * sqrt(fabs(p[0] * x)) +
+                   erf(p[0] * x) - tanh(p[1] * x) + M_E;
+          });
+  }
+
+  void test_numbers_and_signs() {
+    check("1.5e-1*x + .5 + 2E+1*a - -a", {"a"}, {1.5},
+          [](const double *p, double x) {
+            return 0.15 * x + 0.5 + 20 * p[0] + p[0];
+          });
+  }
+
+  void test_parameters_which_are_not_used() {
+    check("a*x", {"a", "b"}, {1.5, 2.0},
+          [](const double *p, double x) { return p[0] * x; });
+  }
+
+  void test_formula_without_parameters() {
+    check("x*x + 1", {}, {},
+          [](const double *, double x) { return x * x + 1; });
+  }
+
+  void test_unsupported_formulas_throw() {
+    const std::vector<std::string> parameters{"a", "b"};
+    for (auto formula : {"a<b", "min(a,x)", "x < a ? a : b", "foo(x)", "2e",
+                         "a*", "(x", "q*x"}) {
+      TS_ASSERT_THROWS(CompiledExpression(formula, "x", parameters),
+                       std::invalid_argument);
+    }
+  }
+
+private:
+  /// Compare values and derivatives with a reference function and its
+  /// numerical derivatives
+  void check(const std::string &formula,
+             const std::vector<std::string> &parameters,
+             std::vector<double> values,
+             std::function<double(const double *, double)> reference) {
+    CompiledExpression expression(formula, "x", parameters);
+    TS_ASSERT_EQUALS(expression.nParams(), parameters.size());
+    const std::vector<double> x{-0.7, 0.3, 0.9, 1.7, 2.5};
+    std::vector<double> out(x.size());
+    expression.evaluate(values.data(), x.data(), x.size(), out.data());
+    Mantid::CurveFitting::Jacobian jacobian(x.size(), values.size());
+    expression.derivatives(values.data(), x.data(), x.size(), jacobian);
+
+    for (size_t i = 0; i < x.size(); ++i) {
+      const double expected = reference(values.data(), x[i]);
+      if (std::isnan(expected)) {
+        TS_ASSERT(std::isnan(out[i]));
+        continue;
+      }
+      TS_ASSERT_DELTA(out[i], expected, 1e-12 * (1.0 + std::abs(expected)));
+      for (size_t j = 0; j < values.size(); ++j) {
+        const double h = 1e-6 * (1.0 + std::abs(values[j]));
+        auto shifted = values;
+        shifted[j] += h;
+        const double up = reference(shifted.data(), x[i]);
+        shifted[j] -= 2.0 * h;
+        const double down = reference(shifted.data(), x[i]);
+        const double numerical = (up - down) / (2.0 * h);
+        TS_ASSERT_DELTA(jacobian.get(i, j), numerical,
+                        1e-5 * (1.0 + std::abs(numerical)));
+      }
+    }
+  }
+};
+
+#endif /* MANTID_CURVEFITTING_COMPILEDEXPRESSIONTEST_H_ */
@@ -11,6 +11,8 @@
 #include "MantidAPI/AnalysisDataService.h"
 #include "MantidAPI/ITableWorkspace.h"
 
+#include <cmath>
+
 using namespace Mantid::CurveFitting;
 using namespace Mantid::CurveFitting::Functions;
 using namespace Mantid::API;
@@ -67,6 +69,41 @@ public:
     FrameworkManager::Instance().deleteWorkspace("UserFunction1D1_Workspace");
   }
 
+  void testPowerLawFitOverZero() {
+    auto ws = boost::dynamic_pointer_cast<Mantid::DataObjects::Workspace2D>(
+        WorkspaceFactory::Instance().create("Workspace2D", 1, 10, 10));
+    for (int j = 0; j < 10; j++) {
+      const double x = 0.5 * j;
+      ws->dataX(0)[j] = x;
+      ws->dataY(0)[j] = 3. * std::pow(x, 1.5);
+      ws->dataE(0)[j] = 1.;
+    }
+    AnalysisDataService::Instance().add("UserFunction1DPowerWS", ws);
+
+    IAlgorithm *alg =
+        FrameworkManager::Instance().createAlgorithm("UserFunction1D");
+    alg->initialize();
+    alg->setPropertyValue("InputWorkspace", "UserFunction1DPowerWS");
+    alg->setPropertyValue("WorkspaceIndex", "0");
+    alg->setPropertyValue("Function", "a*x^b");
+    alg->setPropertyValue("InitialParameters", "a=2,b=1.2");
+    alg->setPropertyValue("Output", "UserFunction1DPower");
+    TS_ASSERT_THROWS_NOTHING(alg->execute());
+    TS_ASSERT(alg->isExecuted());
+
+    ITableWorkspace_sptr params =
+        AnalysisDataService::Instance().retrieveWS<ITableWorkspace>(
+            "UserFunction1DPower_Parameters");
+    TS_ASSERT_DELTA(params->Double(1, 1), 3, 0.01);
+    TS_ASSERT_DELTA(params->Double(2, 1), 1.5, 0.01);
+
+    FrameworkManager::Instance().deleteWorkspace("UserFunction1DPowerWS");
+    FrameworkManager::Instance().deleteWorkspace(
+        "UserFunction1DPower_Parameters");
+    FrameworkManager::Instance().deleteWorkspace(
+        "UserFunction1DPower_Workspace");
+  }
+
 private:
   Mantid::DataObjects::Workspace2D_sptr setupWS() {
     Mantid::DataObjects::Workspace2D_sptr ws =
@@ -78,6 +78,57 @@ public:
     TS_ASSERT(categories.size() == 1);
     TS_ASSERT(categories[0] == "General");
   }
+
+  void test_derivatives_of_compiled_formula_are_exact() {
+    UserFunction fun;
+    fun.setAttribute("Formula",
+                     UserFunction::Attribute("h*exp(-(x-c)^2/(2*s^2))"));
+    fun.setParameter("h", 2.2);
+    fun.setParameter("c", 0.4);
+    fun.setParameter("s", 0.3);
+
+    const size_t nData = 10;
+    std::vector<double> x(nData);
+    for (size_t i = 0; i < nData; i++) {
+      x[i] = 0.1 * static_cast<double>(i);
+    }
+    FunctionDomain1DVector domain(x);
+    UserTestJacobian J(nData, 3);
+    fun.functionDeriv(domain, J);
+
+    for (size_t i = 0; i < nData; i++) {
+      const double t = (x[i] - 0.4) / 0.3;
+      const double g = exp(-0.5 * t * t);
+      TS_ASSERT_DELTA(J.get(i, 0), g, 1e-12);
+      TS_ASSERT_DELTA(J.get(i, 1), 2.2 * g * t / 0.3, 1e-12);
+      TS_ASSERT_DELTA(J.get(i, 2), 2.2 * g * t * t / 0.3, 1e-12);
+    }
+  }
+
+  void test_formula_which_cannot_be_compiled() {
+    UserFunction fun;
+    fun.setAttribute("Formula", UserFunction::Attribute("x < c ? a : a*x"));
+    TS_ASSERT_EQUALS(fun.nParams(), 2);
+    fun.setParameter("c", 0.5);
+    fun.setParameter("a", 3.0);
+
+    const size_t nData = 10;
+    std::vector<double> x(nData), y(nData);
+    for (size_t i = 0; i < nData; i++) {
+      x[i] = 0.1 * static_cast<double>(i);
+    }
+    fun.function1D(&y[0], &x[0], nData);
+    for (size_t i = 0; i < nData; i++) {
+      TS_ASSERT_DELTA(y[i], x[i] < 0.5 ? 3.0 : 3.0 * x[i], 1e-12);
+    }
+
+    FunctionDomain1DVector domain(x);
+    UserTestJacobian J(nData, 2);
+    fun.functionDeriv(domain, J);
+    for (size_t i = 0; i < nData; i++) {
+      TS_ASSERT_DELTA(J.get(i, 1), x[i] < 0.5 ? 1.0 : x[i], 1e-6);
+    }
+  }
 };
 
 #endif /*USERFUNCTIONTEST_H_*/
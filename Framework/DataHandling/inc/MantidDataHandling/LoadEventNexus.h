@@ -175,6 +175,8 @@ public:
   /// A count of events discarded because they came from a pixel that's not in
   /// the IDF
   size_t discarded_events;
+  /// Time spent in the ProcessBankData tasks, summed over all threads
+  double m_processTime;
 
   /// Do we pre-count the # of events in each pixel ID?
   bool precount;
@@ -241,6 +243,7 @@ private:
 
   void createWorkspaceIndexMaps(const bool monitors,
                                 const std::vector<std::string> &bankNames);
+  bool hasLocalPixels(const std::string &bankName) const;
   void loadEvents(API::Progress *const prog, const bool monitors);
   void createSpectraMapping(
       const std::string &nxsfile, const bool monitorsOnly,
@@ -277,6 +280,10 @@ private:
   /// to open the nexus file with specific exception handling/message
   void safeOpenFile(const std::string fname);
 
+  Parallel::ExecutionMode getParallelExecutionMode(
+      const std::map<std::string, Parallel::StorageMode> &storageModes)
+      const override;
+
   /// Was the instrument loaded?
   bool m_instrument_loaded_correctly;
 
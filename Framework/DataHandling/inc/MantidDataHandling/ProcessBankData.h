@@ -17,8 +17,8 @@ namespace DataHandling {
 //==============================================================================================
 // Class ProcessBankData
 //==============================================================================================
-/** This task does the disk IO from loading the NXS file,
-* and so will be on a disk IO mutex */
+/** This task turns the arrays read from one bank of the NXS file into events
+* in the output workspace. It does no disk IO. */
 class ProcessBankData : public Mantid::Kernel::Task {
 public:
   //----------------------------------------------------------------------------------------------
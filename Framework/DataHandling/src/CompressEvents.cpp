@@ -3,6 +3,7 @@
 #include "MantidDataObjects/EventWorkspace.h"
 #include "MantidKernel/ArrayProperty.h"
 #include "MantidKernel/BoundedValidator.h"
+#include "MantidKernel/TaskRuntime.h"
 
 #include "tbb/parallel_for.h"
 
@@ -65,34 +66,38 @@ void CompressEvents::exec() {
                                                            false);
     // We DONT copy the data though
     // Loop over the histograms (detector spectra)
-    tbb::parallel_for(tbb::blocked_range<size_t>(0, noSpectra),
-                      [tolerance, &inputWS, &outputWS, &prog](
-                          const tbb::blocked_range<size_t> &range) {
-                        for (size_t index = range.begin(); index < range.end();
-                             ++index) {
-                          // The input event list
-                          EventList &input_el = inputWS->getSpectrum(index);
-                          // And on the output side
-                          EventList &output_el = outputWS->getSpectrum(index);
-                          // Copy other settings into output
-                          output_el.setX(input_el.ptrX());
-                          // The EventList method does the work.
-                          input_el.compressEvents(tolerance, &output_el);
-                          prog.report("Compressing");
-                        }
-                      });
+    Kernel::TaskRuntime::execute([noSpectra, tolerance, &inputWS, &outputWS,
+                                  &prog]() {
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, noSpectra),
+                        [tolerance, &inputWS, &outputWS, &prog](
+                            const tbb::blocked_range<size_t> &range) {
+        for (size_t index = range.begin(); index < range.end(); ++index) {
+          // The input event list
+          EventList &input_el = inputWS->getSpectrum(index);
+          // And on the output side
+          EventList &output_el = outputWS->getSpectrum(index);
+          // Copy other settings into output
+          output_el.setX(input_el.ptrX());
+          // The EventList method does the work.
+          input_el.compressEvents(tolerance, &output_el);
+          prog.report("Compressing");
+        }
+      });
+    });
   } else {
-    tbb::parallel_for(
-        tbb::blocked_range<size_t>(0, noSpectra),
-        [tolerance, &outputWS, &prog](const tbb::blocked_range<size_t> &range) {
-          for (size_t index = range.begin(); index < range.end(); ++index) {
-            // The input (also output) event list
-            auto &output_el = outputWS->getSpectrum(index);
-            // The EventList method does the work.
-            output_el.compressEvents(tolerance, &output_el);
-            prog.report("Compressing");
-          }
-        });
+    Kernel::TaskRuntime::execute([noSpectra, tolerance, &outputWS, &prog]() {
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, noSpectra),
+                        [tolerance, &outputWS,
+                         &prog](const tbb::blocked_range<size_t> &range) {
+        for (size_t index = range.begin(); index < range.end(); ++index) {
+          // The input (also output) event list
+          auto &output_el = outputWS->getSpectrum(index);
+          // The EventList method does the work.
+          output_el.compressEvents(tolerance, &output_el);
+          prog.report("Compressing");
+        }
+      });
+    });
   }
   // Cast to the matrixOutputWS and save it
   this->setProperty("OutputWorkspace", outputWS);
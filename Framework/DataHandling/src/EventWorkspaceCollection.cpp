@@ -1,11 +1,14 @@
 #include "MantidDataHandling/EventWorkspaceCollection.h"
 #include "MantidDataObjects/EventWorkspace.h"
+#include "MantidDataObjects/WorkspaceCreation.h"
+#include "MantidIndexing/IndexInfo.h"
 #include "MantidKernel/UnitFactory.h"
 #include "MantidGeometry/Instrument.h"
 #include "MantidAPI/Axis.h"
 #include "MantidAPI/Run.h"
 #include "MantidAPI/Sample.h"
 #include "MantidAPI/WorkspaceFactory.h"
+#include "MantidTypes/SpectrumDefinition.h"
 
 #include <vector>
 #include <set>
@@ -254,6 +257,30 @@ void EventWorkspaceCollection::padSpectra(const std::vector<int32_t> &padding) {
   }
 }
 
+/** Partition the spectra of all periods over the ranks of a communicator.
+ * The spectra that are not assigned to this rank are removed.
+ * @param communicator :: the ranks the spectra are distributed over
+ */
+void EventWorkspaceCollection::distribute(
+    const Parallel::Communicator &communicator) {
+  for (auto &ws : m_WsVec) {
+    const auto &indexInfo = ws->indexInfo();
+    std::vector<Indexing::SpectrumNumber> spectrumNumbers;
+    for (size_t i = 0; i < indexInfo.size(); ++i)
+      spectrumNumbers.push_back(indexInfo.spectrumNumber(i));
+    Indexing::IndexInfo distributed(std::move(spectrumNumbers),
+                                    Parallel::StorageMode::Distributed,
+                                    communicator);
+    const auto &definitions = *indexInfo.spectrumDefinitions();
+    std::vector<SpectrumDefinition> localDefinitions;
+    for (size_t i = 0; i < definitions.size(); ++i)
+      if (distributed.isOnThisPartition(Indexing::GlobalSpectrumIndex(i)))
+        localDefinitions.push_back(definitions[i]);
+    distributed.setSpectrumDefinitions(std::move(localDefinitions));
+    ws = create<EventWorkspace>(*ws, distributed, HistogramData::BinEdges(2));
+  }
+}
+
 void EventWorkspaceCollection::setInstrument(
     const Geometry::Instrument_const_sptr &inst) {
   for (auto &ws : m_WsVec) {
@@ -13,13 +13,16 @@
 #include "MantidGeometry/Instrument/RectangularDetector.h"
 #include "MantidKernel/ArrayProperty.h"
 #include "MantidKernel/BoundedValidator.h"
+#include "MantidKernel/InvisibleProperty.h"
+#include "MantidKernel/ListValidator.h"
 #include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/ThreadPool.h"
-#include "MantidKernel/ThreadSchedulerMutexes.h"
 #include "MantidKernel/TimeSeriesProperty.h"
 #include "MantidKernel/Timer.h"
 #include "MantidKernel/UnitFactory.h"
 #include "MantidKernel/VisibleWhenProperty.h"
+#include "MantidParallel/Collectives.h"
+#include "MantidParallel/Communicator.h"
 
 #include <boost/function.hpp>
 #include <boost/random/mersenne_twister.hpp>
@@ -27,6 +30,11 @@
 #include <boost/shared_array.hpp>
 #include <boost/shared_ptr.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
 #include <functional>
 
 using std::map;
@@ -66,13 +74,127 @@ void copyLogs(const Mantid::DataHandling::EventWorkspaceCollection_sptr &from,
     }
   }
 }
+
+/** Combine the TOF range and the event count of all ranks, so that all
+ * ranks get the same X-vector.
+ * @param comm :: communicator of the ranks
+ * @param shortest :: shortest TOF on this rank, replaced by the global one
+ * @param longest :: longest TOF on this rank, replaced by the global one
+ * @param numEvents :: events on this rank, replaced by the total
+ */
+void reduceTofRange(const Parallel::Communicator &comm, double &shortest,
+                    double &longest, size_t &numEvents) {
+  const double localShortest = shortest;
+  const double localLongest = longest;
+  const size_t localNumEvents = numEvents;
+  Parallel::all_reduce(comm, localShortest, shortest,
+                       [](double a, double b) { return std::min(a, b); });
+  Parallel::all_reduce(comm, localLongest, longest,
+                       [](double a, double b) { return std::max(a, b); });
+  Parallel::all_reduce(comm, localNumEvents, numEvents, std::plus<size_t>());
+}
+
+/// Number of events that may be read from disk ahead of the processing stage
+/// (about 1.2 GB of id/tof arrays).
+const size_t READ_AHEAD_EVENTS = 100 * 1000 * 1000;
+
+//==============================================================================================
+// Class ReadAheadLimit
+//==============================================================================================
+/** Bounds the number of events that have been read from disk but not yet
+ * consumed by the ProcessBankData tasks, so that the read stage cannot run
+ * arbitrarily far ahead of the processing stage.
+ */
+class ReadAheadLimit {
+public:
+  explicit ReadAheadLimit(size_t maxEvents)
+      : m_maxEvents(maxEvents), m_inFlight(0) {}
+
+  /** Block until the events in flight have dropped below the limit, or
+   * until stop() returns true.
+   * @param stop :: checked periodically to abandon the wait
+   * @param help :: called whenever no events were released for a while, so
+   * that the waiting thread can process some of them itself
+   */
+  void waitForRoom(const std::function<bool()> &stop,
+                   const std::function<void()> &help) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (m_inFlight >= m_maxEvents && !stop()) {
+      if (m_changed.wait_for(lock, std::chrono::milliseconds(100)) ==
+          std::cv_status::timeout) {
+        lock.unlock();
+        help();
+        lock.lock();
+      }
+    }
+  }
+
+  /// Register events that have just been read
+  void add(size_t numEvents) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_inFlight += numEvents;
+  }
+
+  /// Release events whose buffers have been freed
+  void release(size_t numEvents) {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_inFlight -= numEvents;
+    }
+    m_changed.notify_all();
+  }
+
+private:
+  const size_t m_maxEvents;
+  size_t m_inFlight;
+  std::mutex m_mutex;
+  std::condition_variable m_changed;
+};
+
+//==============================================================================================
+// Class BankTaskScheduler
+//==============================================================================================
+/** FIFO scheduler that reports itself as non-empty while the read stage is
+ * still producing ProcessBankData tasks. Idle worker threads then keep
+ * polling for work instead of exiting.
+ */
+class BankTaskScheduler : public ThreadSchedulerFIFO {
+public:
+  BankTaskScheduler() : ThreadSchedulerFIFO(), m_reading(true) {}
+
+  bool empty() override { return !m_reading && ThreadSchedulerFIFO::empty(); }
+
+  /// Signal that no more tasks will be pushed by the read stage
+  void finishedReading() { m_reading = false; }
+
+  /** Run one queued task on the calling thread, as a pool thread would. The
+   * pool shares the worker threads of the TaskRuntime, which may all be busy
+   * while the read stage waits for room.
+   */
+  void runOneTask() {
+    Task *task = pop(0);
+    if (!task)
+      return;
+    try {
+      task->run();
+    } catch (std::exception &e) {
+      abort(std::runtime_error(e.what()));
+    }
+    finished(task, 0);
+    delete task;
+  }
+
+private:
+  std::atomic<bool> m_reading;
+};
 }
 
 //==============================================================================================
 // Class LoadBankFromDiskTask
 //==============================================================================================
-/** This task does the disk IO from loading the NXS file,
-* and so will be on a disk IO mutex */
+/** This task does the disk IO from loading the NXS file. It is run in
+* sequence for every bank by the read stage of LoadEventNexus::loadEvents, and
+* pushes ProcessBankData tasks for the data it has read. */
 class LoadBankFromDiskTask : public Task {
 
 public:
@@ -85,26 +207,22 @@ public:
   * @param numEvents :: The number of events in the bank.
   * @param oldNeXusFileNames :: Identify if file is of old variety.
   * @param prog :: an optional Progress object
-  * @param ioMutex :: a mutex shared for all Disk I-O tasks
-  * @param scheduler :: the ThreadScheduler that runs this task.
+  * @param readAhead :: limit on the events read but not yet processed
+  * @param scheduler :: the ThreadScheduler that runs the processing tasks.
   * @param framePeriodNumbers :: Period numbers corresponding to each frame
   */
   LoadBankFromDiskTask(LoadEventNexus *alg, const std::string &entry_name,
                        const std::string &entry_type,
                        const std::size_t numEvents,
                        const bool oldNeXusFileNames, Progress *prog,
-                       boost::shared_ptr<std::mutex> ioMutex,
-                       ThreadScheduler *scheduler,
+                       ReadAheadLimit *readAhead, ThreadScheduler *scheduler,
                        const std::vector<int> &framePeriodNumbers)
       : Task(), alg(alg), entry_name(entry_name), entry_type(entry_type),
-        // prog(prog), scheduler(scheduler), thisBankPulseTimes(NULL),
-        // m_loadError(false),
-        prog(prog), scheduler(scheduler), m_loadError(false),
-        m_oldNexusFileNames(oldNeXusFileNames), m_loadStart(), m_loadSize(),
-        m_event_id(nullptr), m_event_time_of_flight(nullptr),
-        m_have_weight(false), m_event_weight(nullptr),
-        m_framePeriodNumbers(framePeriodNumbers) {
-    setMutex(ioMutex);
+        prog(prog), readAhead(readAhead), scheduler(scheduler),
+        m_loadError(false), m_oldNexusFileNames(oldNeXusFileNames),
+        m_loadStart(), m_loadSize(), m_event_id(nullptr),
+        m_event_time_of_flight(nullptr), m_have_weight(false),
+        m_event_weight(nullptr), m_framePeriodNumbers(framePeriodNumbers) {
     m_cost = static_cast<double>(numEvents);
     m_min_id = std::numeric_limits<uint32_t>::max();
     m_max_id = 0;
@@ -507,6 +625,23 @@ public:
       return;
     }
 
+    size_t numEvents = m_loadSize[0];
+    size_t startAt = m_loadStart[0];
+
+    // convert things to shared_arrays. The events are accounted for in the
+    // read-ahead limit until the last task using them has finished.
+    readAhead->add(numEvents);
+    ReadAheadLimit *limit = readAhead;
+    boost::shared_array<uint32_t> event_id_shrd(
+        m_event_id, [limit, numEvents](uint32_t *ids) {
+          delete[] ids;
+          limit->release(numEvents);
+        });
+    boost::shared_array<float> event_time_of_flight_shrd(
+        m_event_time_of_flight);
+    boost::shared_array<float> event_weight_shrd(m_event_weight);
+    boost::shared_ptr<std::vector<uint64_t>> event_index_shrd(event_index_ptr);
+
     const auto bank_size = m_max_id - m_min_id;
     const uint32_t minSpectraToLoad = static_cast<uint32_t>(alg->m_specMin);
     const uint32_t maxSpectraToLoad = static_cast<uint32_t>(alg->m_specMax);
@@ -543,16 +678,6 @@ public:
       mid_id = (m_max_id + m_min_id) / 2;
 
     // No error? Launch a new task to process that data.
-    size_t numEvents = m_loadSize[0];
-    size_t startAt = m_loadStart[0];
-
-    // convert things to shared_arrays
-    boost::shared_array<uint32_t> event_id_shrd(m_event_id);
-    boost::shared_array<float> event_time_of_flight_shrd(
-        m_event_time_of_flight);
-    boost::shared_array<float> event_weight_shrd(m_event_weight);
-    boost::shared_ptr<std::vector<uint64_t>> event_index_shrd(event_index_ptr);
-
     ProcessBankData *newTask1 = new ProcessBankData(
         alg, entry_name, prog, event_id_shrd, event_time_of_flight_shrd,
         numEvents, startAt, event_index_shrd, thisBankPulseTimes, m_have_weight,
@@ -591,7 +716,9 @@ private:
   std::string entry_type;
   /// Progress reporting
   Progress *prog;
-  /// ThreadScheduler running this task
+  /// Limit on the events read ahead of processing
+  ReadAheadLimit *readAhead;
+  /// ThreadScheduler running the processing tasks
   ThreadScheduler *scheduler;
   /// Object with the pulse times for this bank
   boost::shared_ptr<BankPulseTimes> thisBankPulseTimes;
@@ -631,8 +758,8 @@ LoadEventNexus::LoadEventNexus()
       filter_tof_max(0), m_specList(), m_specMin(0), m_specMax(0),
       filter_time_start(), filter_time_stop(), chunk(0), totalChunks(0),
       firstChunkForBank(0), eventsPerChunk(0), m_tofMutex(), longest_tof(0),
-      shortest_tof(0), bad_tofs(0), discarded_events(0), precount(0),
-      compressTolerance(0), eventVectors(), m_eventVectorMutex(),
+      shortest_tof(0), bad_tofs(0), discarded_events(0), m_processTime(0.),
+      precount(0), compressTolerance(0), eventVectors(), m_eventVectorMutex(),
       eventid_max(0), pixelID_to_wi_vector(), pixelID_to_wi_offset(),
       m_bankPulseTimes(), m_allBanksPulseTimes(), m_top_entry_name(),
       m_file(nullptr), splitProcessing(false), m_haveWeights(false),
@@ -866,6 +993,17 @@ void LoadEventNexus::init() {
   declareProperty(
       make_unique<PropertyWithValue<bool>>("LoadLogs", true, Direction::Input),
       "Load the Sample/DAS logs from the file (default True).");
+
+  std::vector<std::string> propOptions{
+      Parallel::toString(Parallel::StorageMode::Cloned),
+      Parallel::toString(Parallel::StorageMode::Distributed)};
+  declareProperty(
+      "ParallelStorageMode", Parallel::toString(Parallel::StorageMode::Cloned),
+      boost::make_shared<StringListValidator>(propOptions),
+      "The parallel storage mode of the output workspace for MPI builds. If "
+      "Distributed, each rank loads the events of its own spectra.");
+  setPropertySettings("ParallelStorageMode",
+                      Kernel::make_unique<InvisibleProperty>());
 }
 
 //----------------------------------------------------------------------------------------------
@@ -968,7 +1106,10 @@ void LoadEventNexus::exec() {
   // object-level workspace ptr
   loadEvents(&prog, false); // Do not load monitor blocks
 
-  if (discarded_events > 0) {
+  // In a distributed load the events of the other ranks are discarded too
+  if (discarded_events > 0 &&
+      m_ws->getSingleHeldWorkspace()->storageMode() !=
+          Parallel::StorageMode::Distributed) {
     g_log.information() << discarded_events
                         << " events were encountered coming from pixels which "
                            "are not in the Instrument Definition File."
@@ -1122,6 +1263,11 @@ void LoadEventNexus::createWorkspaceIndexMaps(
   // to
   createSpectraMapping(m_filename, monitors, bankNames);
 
+  // Keep only the spectra of this rank, the events of the others are dropped
+  if (!monitors && Parallel::fromString(getProperty("ParallelStorageMode")) ==
+                       Parallel::StorageMode::Distributed)
+    m_ws->distribute(communicator());
+
   // This map will be used to find the workspace index
   if (this->event_id_is_spec)
     pixelID_to_wi_vector =
@@ -1131,6 +1277,33 @@ void LoadEventNexus::createWorkspaceIndexMaps(
         m_ws->getDetectorIDToWorkspaceIndexVector(pixelID_to_wi_offset, true);
 }
 
+/** Check whether a bank has pixels whose spectra are on this rank. Only
+* distributed loads have banks without local pixels, they need not be read.
+* @param bankName :: name of the NXevent_data entry of the bank
+* @return true if events of the bank may go to this rank
+*/
+bool LoadEventNexus::hasLocalPixels(const std::string &bankName) const {
+  if (this->event_id_is_spec ||
+      m_ws->getSingleHeldWorkspace()->storageMode() !=
+          Parallel::StorageMode::Distributed)
+    return true;
+  std::vector<IDetector_const_sptr> dets;
+  m_ws->getInstrument()->getDetectorsInBank(
+      dets, bankName.substr(0, bankName.find("_events")));
+  // Banks that are not in the instrument tree are read to be safe
+  if (dets.empty())
+    return true;
+  return std::any_of(dets.cbegin(), dets.cend(),
+                     [this](const IDetector_const_sptr &det) {
+                       const auto id = det->getID();
+                       if (id < 0 || id > eventid_max)
+                         return false;
+                       return m_haveWeights
+                                  ? weightedEventVectors[0][id] != nullptr
+                                  : eventVectors[0][id] != nullptr;
+                     });
+}
+
 /** Load the instrument from the nexus file
 *
 * @param nexusfilename :: The name of the nexus file being loaded
@@ -1507,10 +1680,12 @@ void LoadEventNexus::loadEvents(API::Progress *const prog,
       static_cast<double>(std::numeric_limits<uint32_t>::max()) * 0.1;
   longest_tof = 0.;
 
-  // Make the thread pool
-  ThreadScheduler *scheduler = new ThreadSchedulerMutexes();
+  // Make the thread pool. The calling thread is the read stage: it is the only
+  // one touching the file, so the slab reads need no lock, while the pool
+  // threads run the ProcessBankData tasks it produces.
+  ReadAheadLimit readAhead(READ_AHEAD_EVENTS);
+  auto scheduler = new BankTaskScheduler();
   ThreadPool pool(scheduler);
-  auto diskIOMutex = boost::make_shared<std::mutex>();
   size_t bank0 = 0;
   size_t bankn = bankNames.size();
 
@@ -1574,10 +1749,9 @@ void LoadEventNexus::loadEvents(API::Progress *const prog,
     }
   }
 
-  // split banks up if the number of cores is more than twice the number of
-  // banks
-  splitProcessing =
-      bool(bankNames.size() * 2 < ThreadPool::getNumPhysicalCores());
+  // split banks up if the pool has more than twice as many threads as there
+  // are banks
+  splitProcessing = bool(bankNames.size() * 2 < pool.getNumThreads());
 
   // set up progress bar for the rest of the (multi-threaded) process
   size_t numProg = bankNames.size() * (1 + 3); // 1 = disktask, 3 = proc task
@@ -1587,19 +1761,55 @@ void LoadEventNexus::loadEvents(API::Progress *const prog,
 
   const std::vector<int> periodLogVec = periodLog->valuesAsVector();
 
-  for (size_t i = bank0; i < bankn; i++) {
-    // We make tasks for loading
-    if (bankNumEvents[i] > 0)
-      pool.schedule(new LoadBankFromDiskTask(
-          this, bankNames[i], classType, bankNumEvents[i], oldNeXusFileNames,
-          prog2.get(), diskIOMutex, scheduler, periodLogVec));
+  // Start the processing threads, then read the banks in sequence, feeding
+  // the pool as each one comes off the disk.
+  Timer wallTimer;
+  double readTime(0.), readWaitTime(0.);
+  m_processTime = 0.;
+  auto stopReading = [this, scheduler] {
+    return getCancel() || scheduler->getAborted();
+  };
+  std::exception_ptr readError;
+  pool.start();
+  try {
+    for (size_t i = bank0; i < bankn; i++) {
+      if (bankNumEvents[i] == 0 || !hasLocalPixels(bankNames[i]))
+        continue;
+      Timer stageTimer;
+      readAhead.waitForRoom(stopReading,
+                            [scheduler]() { scheduler->runOneTask(); });
+      readWaitTime += stageTimer.elapsed();
+      if (stopReading())
+        break;
+      LoadBankFromDiskTask(this, bankNames[i], classType, bankNumEvents[i],
+                           oldNeXusFileNames, prog2.get(), &readAhead,
+                           scheduler, periodLogVec)
+          .run();
+      readTime += stageTimer.elapsed();
+    }
+  } catch (...) {
+    readError = std::current_exception();
+    scheduler->clear();
   }
-  // Start and end all threads
+  // Let the threads drain the remaining tasks and end
+  scheduler->finishedReading();
   pool.joinAll();
-  diskIOMutex.reset();
+  if (readError)
+    std::rethrow_exception(readError);
+
+  const double wallTime = wallTimer.elapsed();
+  const double numThreads = static_cast<double>(pool.getNumThreads());
+  g_log.information()
+      << "Bank loading took " << wallTime << " s: read stage " << readTime
+      << " s (plus " << readWaitTime
+      << " s waiting for the processing stage), processing stage "
+      << m_processTime << " s summed over " << numThreads << " threads. "
+      << "The load was "
+      << (readTime * numThreads >= m_processTime ? "I/O" : "CPU")
+      << " bound.\n";
 
   // Info reporting
-  const std::size_t eventsLoaded = m_ws->getNumberEvents();
+  std::size_t eventsLoaded = m_ws->getNumberEvents();
   g_log.information() << "Read " << eventsLoaded << " events"
                       << ". Shortest TOF: " << shortest_tof
                       << " microsec; longest TOF: " << longest_tof
@@ -1636,6 +1846,11 @@ void LoadEventNexus::loadEvents(API::Progress *const prog,
       }
     }
   }
+  // The X-vector must be the same on all ranks of a distributed load
+  if (m_ws->getSingleHeldWorkspace()->storageMode() ==
+      Parallel::StorageMode::Distributed)
+    reduceTofRange(communicator(), shortest_tof, longest_tof, eventsLoaded);
+
   // Now, create a default X-vector for histogramming, with just 2 bins.
   if (eventsLoaded > 0)
     m_ws->setAllX(HistogramData::BinEdges{shortest_tof - 1, longest_tof + 1});
@@ -2530,5 +2745,12 @@ void LoadEventNexus::safeOpenFile(const std::string fname) {
   }
 }
 
+Parallel::ExecutionMode LoadEventNexus::getParallelExecutionMode(
+    const std::map<std::string, Parallel::StorageMode> &storageModes) const {
+  UNUSED_ARG(storageModes);
+  return Parallel::getCorrespondingExecutionMode(
+      Parallel::fromString(getProperty("ParallelStorageMode")));
+}
+
 } // namespace DataHandling
 } // namespace Mantid
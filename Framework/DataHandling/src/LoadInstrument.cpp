@@ -178,7 +178,7 @@ void LoadInstrument::exec() {
     } else {
       // Really create the instrument
       Progress prog(this, 0.0, 1.0, 100);
-      instrument = parser.parseXML(&prog);
+      instrument = parser.parseXMLOrCache(&prog);
       // Parse the instrument tree (internally create ComponentInfo and
       // DetectorInfo). This is an optimization that avoids duplicate parsing of
       // the instrument tree when loading multiple workspaces with the same
@@ -30,6 +30,8 @@ ProcessBankData::ProcessBankData(
  * FIXME/TODO - split run() into readable methods
 */
 void ProcessBankData::run() { // override {
+  // Only time the processing, not the wait in the scheduler's queue
+  m_timer.reset();
   // Local tof limits
   double my_shortest_tof =
       static_cast<double>(std::numeric_limits<uint32_t>::max()) * 0.1;
@@ -234,6 +236,7 @@ void ProcessBankData::run() { // override {
     }
     alg->bad_tofs += badTofs;
     alg->discarded_events += my_discarded_events;
+    alg->m_processTime += m_timer.elapsed_no_reset();
   }
 
 #ifndef _WIN32
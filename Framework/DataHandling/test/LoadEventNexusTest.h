@@ -9,17 +9,53 @@
 #include "MantidAPI/SpectrumInfo.h"
 #include "MantidAPI/Workspace.h"
 #include "MantidDataObjects/EventWorkspace.h"
+#include "MantidIndexing/IndexInfo.h"
 #include "MantidKernel/Property.h"
 #include "MantidKernel/TimeSeriesProperty.h"
 #include "MantidDataHandling/LoadEventNexus.h"
+#include "MantidParallel/Collectives.h"
+#include "MantidTestHelpers/ParallelAlgorithmCreation.h"
+#include "MantidTestHelpers/ParallelRunner.h"
 #include <cxxtest/TestSuite.h>
 
+#include <numeric>
+
 using namespace Mantid::Geometry;
 using namespace Mantid::API;
 using namespace Mantid::DataObjects;
 using namespace Mantid::Kernel;
 using namespace Mantid::DataHandling;
 
+namespace {
+void run_MPI_load(const Mantid::Parallel::Communicator &comm) {
+  using namespace Mantid;
+  auto alg = ParallelTestHelpers::create<LoadEventNexus>(comm);
+  alg->setProperty("Filename", "CNCS_7860_event.nxs");
+  alg->setProperty("LoadLogs", false);
+  alg->setProperty("ParallelStorageMode", "Parallel::StorageMode::Distributed");
+  TS_ASSERT_THROWS_NOTHING(alg->execute());
+  MatrixWorkspace_const_sptr ws = alg->getProperty("OutputWorkspace");
+  auto eventWS = boost::dynamic_pointer_cast<const EventWorkspace>(ws);
+  TS_ASSERT(eventWS);
+  TS_ASSERT_EQUALS(ws->storageMode(), Parallel::StorageMode::Distributed);
+  TS_ASSERT_EQUALS(ws->indexInfo().globalSize(), 51200);
+  // The TOF range is the one of all events, not only of those on this rank
+  TS_ASSERT_DELTA(ws->x(0).front(), 44162.6, 0.05);
+  TS_ASSERT_DELTA(ws->x(0).back(), 60830.2, 0.05);
+
+  const size_t numEvents = eventWS->getNumberEvents();
+  if (comm.rank() == 0) {
+    std::vector<size_t> allNumEvents;
+    Parallel::gather(comm, numEvents, allNumEvents, 0);
+    TS_ASSERT_EQUALS(std::accumulate(allNumEvents.begin(),
+                                     allNumEvents.end(), size_t{0}),
+                     112266);
+  } else {
+    Parallel::gather(comm, numEvents, 0);
+  }
+}
+}
+
 class LoadEventNexusTest : public CxxTest::TestSuite {
 private:
   void
@@ -748,6 +784,8 @@ public:
     }
   }
 
+  void test_MPI_load() { ParallelTestHelpers::runParallel(run_MPI_load); }
+
 private:
   std::string wsSpecFilterAndEventMonitors;
 };
@@ -6,7 +6,12 @@
 #include "MantidKernel/DiskBuffer.h"
 #include <nexus/NeXusFile.hpp>
 
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <map>
 #include <mutex>
+#include <thread>
 
 namespace Mantid {
 namespace DataObjects {
@@ -16,6 +21,13 @@ namespace DataObjects {
   controller interface
   * Expected to provide thread-safe file access.
 
+  * The file is accessed by a background I/O thread. Saved blocks are queued
+  and written in the order of their positions in the file, adjacent blocks
+  being merged into one write; loads of queued blocks are served from the
+  queue. Blocks can be read ahead of the loads with prefetchBlock. The events
+  data can be compressed by the deflate filter of the file, which is
+  controlled by the MDWorkspace.Compression configuration key.
+
     @date March 15, 2013
 
     Copyright &copy; 2008-2010 ISIS Rutherford Appleton Laboratory, NScD Oak
@@ -63,7 +75,11 @@ public:
                  const uint64_t /*blockPosition*/,
                  const size_t /*BlockSize*/) const override;
 
+  void prefetchBlock(const uint64_t blockPosition,
+                     const size_t nPoints) const override;
+
   void flushData() const override;
+  void flushCache() override;
   void closeFile() override;
 
   ~BoxControllerNeXusIO() override;
@@ -76,12 +92,32 @@ public:
   // Auxiliary functions (non-virtual, used for testing)
   int64_t getNDataColums() const { return m_BlockSize[1]; }
   // get pointer to the Nexus file --> compatribility testing only.
-  ::NeXus::File *getFile() { return m_File; }
+  ::NeXus::File *getFile();
+  /// compress the events data of the files created from now on
+  void setCompression(bool compress) { m_compress = compress; }
+  /// @return true if the events data of new files are compressed
+  bool getCompression() const { return m_compress; }
+
+protected:
+  void writesIssued(Kernel::ISaveable *lastSaved) override;
 
 private:
   /// Default size of the events block which can be written in the NeXus array
   /// at once identified by efficiency or some other external reasons
   enum { DATA_CHUNK = 10000 };
+  /// The largest amount of memory (in bytes) used by the queued writes and by
+  /// the blocks read ahead. Saving blocks waits when the queue is full.
+  static constexpr size_t MAX_QUEUED_BYTES = 256 * 1024 * 1024;
+
+  /// A block of events in the format of the file, waiting to be written or
+  /// read ahead of a load
+  struct QueuedBlock {
+    /// number of events in the block
+    uint64_t nPoints;
+    /// the events data
+    std::vector<char> data;
+  };
+  typedef std::map<uint64_t, QueuedBlock> BlockMap;
 
   /// full file name (with path) of the Nexis file responsible for the IO
   /// operations (as NeXus filename has very strange properties and often
@@ -105,6 +141,39 @@ private:
   std::vector<int64_t> m_BlockSize;
   /// lock Nexus file operations as Nexus is not thread safe
   mutable std::mutex m_fileMutex;
+  /// the size in bytes of the numbers in the events data of the file
+  size_t m_fileElementSize;
+  /// compress the events data of new files
+  bool m_compress;
+
+  //------ background I/O
+  /// the thread which reads and writes the events data
+  std::thread m_ioThread;
+  /// lock the queues of the I/O thread
+  mutable std::mutex m_queueMutex;
+  /// signals the I/O thread that there is work to do
+  mutable std::condition_variable m_workQueued;
+  /// signals that the I/O thread has finished a piece of work
+  mutable std::condition_variable m_workDone;
+  /// blocks waiting to be written, by position in the file
+  mutable BlockMap m_pendingWrites;
+  /// the positions [begin, end) of the events the I/O thread is writing
+  mutable uint64_t m_writingBegin;
+  mutable uint64_t m_writingEnd;
+  /// blocks read ahead, by position in the file
+  mutable BlockMap m_readAhead;
+  /// the blocks requested by prefetchBlock, as position and number of events
+  mutable std::deque<std::pair<uint64_t, size_t>> m_readRequests;
+  /// memory used by the pending writes and the blocks read ahead
+  mutable size_t m_queuedBytes;
+  /// incremented for every block saved, to discard outdated read ahead
+  mutable uint64_t m_writeCount;
+  /// the file is flushed once the pending writes are written
+  mutable bool m_flushRequested;
+  /// tells the I/O thread to finish
+  bool m_stopIO;
+  /// the first error of the I/O thread, rethrown in the calling thread
+  mutable std::exception_ptr m_ioError;
 
   // Mainly static information which may be split into different IO classes
   // selected through chein of responsibility.
@@ -161,6 +230,17 @@ private:
   template <typename Type>
   void loadGenericBlock(std::vector<Type> &Block, const uint64_t blockPosition,
                         const size_t nPoints) const;
+
+  void startIOThread();
+  void stopIOThread();
+  void runIOThread();
+  void writeQueuedBlocks(std::unique_lock<std::mutex> &lock);
+  void readAhead(std::unique_lock<std::mutex> &lock);
+  void waitForPendingWrites() const;
+  void rethrowIOError() const;
+  bool overlapsWrites(const uint64_t begin, const uint64_t end) const;
+  bool copyQueuedBlock(char *destination, const uint64_t blockPosition,
+                       const size_t nPoints, const size_t pointSize) const;
 };
 }
 }
@@ -31,6 +31,17 @@ enum EventSortType {
   TIMEATSAMPLE_SORT
 };
 
+/// Ranges [begin, end) of indices of events in an EventList
+typedef std::vector<std::pair<size_t, size_t>> EventIndexRanges;
+
+/// Number of events in index ranges
+inline size_t numberOfEvents(const EventIndexRanges &ranges) {
+  size_t total = 0;
+  for (const auto &range : ranges)
+    total += range.second - range.first;
+  return total;
+}
+
 //==========================================================================================
 /** @class Mantid::DataObjects::EventList
 
@@ -317,6 +328,33 @@ public:
                                   const std::vector<int> &vec_target,
                                   std::map<int, EventList *> outputs) const;
 
+  /// Find the events of each output of splitByFullTime as index ranges
+  void splitRangesByFullTime(Kernel::TimeSplitterType &splitter,
+                             std::map<int, EventIndexRanges> &outputs,
+                             bool docorrection, double toffactor,
+                             double tofshift) const;
+
+  /// Find the events of each output of splitByFullTimeMatrixSplitter as index
+  /// ranges
+  std::string splitRangesByFullTimeMatrixSplitter(
+      const std::vector<int64_t> &vec_splitters_time,
+      const std::vector<int> &vecgroups,
+      std::map<int, EventIndexRanges> &outputs, bool docorrection,
+      double toffactor, double tofshift) const;
+
+  /// Find the events of each output of splitByPulseTime as index ranges
+  void splitRangesByPulseTime(Kernel::TimeSplitterType &splitter,
+                              std::map<int, EventIndexRanges> &outputs) const;
+
+  /// Append the events in index ranges of another list
+  void appendEventRanges(const EventList &source,
+                         const EventIndexRanges &ranges);
+
+  /// Histogram the events in index ranges of this list
+  void generateHistogramForRanges(const EventIndexRanges &ranges,
+                                  const MantidVec &X, MantidVec &Y,
+                                  MantidVec &E, bool skipError = false) const;
+
   void multiply(const double value, const double error = 0.0) override;
   EventList &operator*=(const double value);
 
@@ -488,16 +526,15 @@ private:
   void splitByTimeHelper(Kernel::TimeSplitterType &splitter,
                          std::vector<EventList *> outputs,
                          typename std::vector<T> &events) const;
-  template <class T>
-  void splitByFullTimeHelper(Kernel::TimeSplitterType &splitter,
-                             std::map<int, EventList *> outputs,
-                             typename std::vector<T> &events, bool docorrection,
+  template <class T, class Sink>
+  void splitByFullTimeHelper(Kernel::TimeSplitterType &splitter, Sink &outputs,
+                             const std::vector<T> &events, bool docorrection,
                              double toffactor, double tofshift) const;
   /// Split events by pulse time
-  template <class T>
+  template <class T, class Sink>
   void splitByPulseTimeHelper(Kernel::TimeSplitterType &splitter,
-                              std::map<int, EventList *> outputs,
-                              typename std::vector<T> &events) const;
+                              Sink &outputs,
+                              const std::vector<T> &events) const;
 
   /// Split events (template) by pulse time with matrix splitters
   template <class T>
@@ -507,17 +544,17 @@ private:
                                    std::map<int, EventList *> outputs,
                                    typename std::vector<T> &events) const;
 
-  template <class T>
+  template <class T, class Sink>
   std::string splitByFullTimeVectorSplitterHelper(
       const std::vector<int64_t> &vectimes, const std::vector<int> &vecgroups,
-      std::map<int, EventList *> outputs, typename std::vector<T> &vecEvents,
-      bool docorrection, double toffactor, double tofshift) const;
+      Sink &outputs, const std::vector<T> &vecEvents, bool docorrection,
+      double toffactor, double tofshift) const;
 
-  template <class T>
+  template <class T, class Sink>
   std::string splitByFullTimeSparseVectorSplitterHelper(
       const std::vector<int64_t> &vectimes, const std::vector<int> &vecgroups,
-      std::map<int, EventList *> outputs, typename std::vector<T> &vecEvents,
-      bool docorrection, double toffactor, double tofshift) const;
+      Sink &outputs, const std::vector<T> &vecEvents, bool docorrection,
+      double toffactor, double tofshift) const;
 
   template <class T>
   static void multiplyHelper(std::vector<T> &events, const double value,
@@ -0,0 +1,89 @@
+#ifndef MANTID_DATAOBJECTS_EVENTSLICE_H_
+#define MANTID_DATAOBJECTS_EVENTSLICE_H_
+
+#include "MantidDataObjects/DllConfig.h"
+#include "MantidDataObjects/EventList.h"
+
+#include <boost/shared_ptr.hpp>
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Mantid {
+namespace DataObjects {
+class EventWorkspace;
+
+/** EventSlice : Refers to a subset of the events of another EventWorkspace,
+  so that the events of a workspace which is a slice of another one are not
+  copied until they are needed.
+
+  The events of each spectrum are given as ranges of indices into the event
+  list with the same workspace index in the parent workspace. The parent must
+  not be changed while slices refer to it. A list of the slice is filled from
+  the ranges (materialized) the first time it is accessed as an EventList;
+  until then, its number of events, its histogram and sums over several lists
+  are computed from the parent's events directly.
+
+  Copyright &copy; 2017 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class MANTID_DATAOBJECTS_DLL EventSlice {
+public:
+  EventSlice(boost::shared_ptr<const EventWorkspace> parent,
+             std::vector<EventIndexRanges> ranges);
+  EventSlice(const EventSlice &other);
+  EventSlice &operator=(const EventSlice &) = delete;
+
+  /// The workspace holding the events
+  const EventWorkspace &parent() const { return *m_parent; }
+  /// Ranges of indices of the events of a list in the parent's list
+  const EventIndexRanges &ranges(const size_t index) const {
+    return m_ranges[index];
+  }
+
+  bool isMaterialized(const size_t index) const;
+  void materialize(const size_t index, EventList &eventList);
+  size_t getNumberEvents(const size_t index) const;
+  void generateHistogram(const size_t index, const MantidVec &X, MantidVec &Y,
+                         MantidVec &E, bool skipError) const;
+  void addEventsTo(const size_t index, EventList &output) const;
+
+private:
+  /// Number of locks shared by the lists for materializing
+  static const size_t NumLocks = 64;
+
+  /// The workspace holding the events
+  boost::shared_ptr<const EventWorkspace> m_parent;
+  /// Index ranges of the events of each list in the parent
+  std::vector<EventIndexRanges> m_ranges;
+  /// True for each list whose events have been copied from the parent
+  std::unique_ptr<std::atomic<bool>[]> m_materialized;
+  /// Locks for materializing, list i uses lock i % NumLocks
+  std::array<std::mutex, NumLocks> m_locks;
+};
+
+} // namespace DataObjects
+} // namespace Mantid
+
+#endif /* MANTID_DATAOBJECTS_EVENTSLICE_H_ */
@@ -6,6 +6,7 @@
 #include "MantidDataObjects/EventList.h"
 #include "MantidKernel/System.h"
 #include <boost/date_time/posix_time/posix_time.hpp>
+#include <memory>
 #include <string>
 
 namespace Mantid {
@@ -14,6 +15,7 @@ class Progress;
 }
 
 namespace DataObjects {
+class EventSlice;
 class EventWorkspaceMRU;
 
 /** \class EventWorkspace
@@ -118,6 +120,12 @@ public:
   // The total number of events across all of the spectra.
   std::size_t getNumberEvents() const override;
 
+  // The number of events in one spectrum
+  std::size_t getNumberEvents(const std::size_t index) const;
+
+  // Append the events of one spectrum to another event list
+  void addEventsTo(const std::size_t index, EventList &output) const;
+
   // Type of the events
   Mantid::API::EventType getEventType() const override;
 
@@ -141,6 +149,12 @@ public:
   void getIntegratedSpectra(std::vector<double> &out, const double minX,
                             const double maxX,
                             const bool entireRange) const override;
+
+  // Refer to a subset of the events of another workspace rather than copying
+  void setSliceOf(boost::shared_ptr<const EventWorkspace> parent,
+                  std::vector<EventIndexRanges> ranges);
+  /// True if the events are a subset of those of another workspace
+  bool isSlice() const { return static_cast<bool>(m_slice); }
   EventWorkspace &operator=(const EventWorkspace &other) = delete;
 
 protected:
@@ -160,6 +174,9 @@ private:
 
   /// Container for the MRU lists of the event lists contained.
   mutable EventWorkspaceMRU *mru;
+
+  /// Events shared with another workspace, if the workspace is a slice
+  std::unique_ptr<EventSlice> m_slice;
 };
 
 /// shared pointer to the EventWorkspace class
@@ -4,6 +4,7 @@
 #include "MantidDataObjects/MDGridBox.h"
 #include "MantidDataObjects/MDLeanEvent.h"
 #include "MantidKernel/DiskBuffer.h"
+#include "MantidKernel/MultiThreaded.h"
 #include <algorithm>
 #include <boost/math/special_functions/round.hpp>
 #include <cmath>
@@ -559,6 +560,63 @@ TMDE(void MDBox)::integrateSphere(Mantid::API::CoordTransform &radiusTransform,
                                   const bool useOnePercentBackgroundCorrection) const {
   // If the box is cached to disk, you need to retrieve it
   const std::vector<MDE> &events = this->getConstEvents();
+  integrateEventsInSphere(events, radiusTransform, radiusSquared, signal,
+                          errorSquared, innerRadiusSquared,
+                          useOnePercentBackgroundCorrection);
+  // it is constant access, so no saving or fiddling with the buffer is needed.
+  // Events just can be dropped if necessary
+  // m_Saveable->releaseEvents();
+  if (m_Saveable) {
+    m_Saveable->setBusy(false);
+  }
+}
+
+/** Integrate the signal within several spheres. The events are retrieved once
+ * and the spheres are integrated in parallel.
+ *
+ * @param spheres :: the spheres to integrate.
+ * @param useOnePercentBackgroundCorrection :: if true, leave out the top 1% of
+ *        the events of the shells from their background.
+ */
+TMDE(void MDBox)::integrateSpheres(
+    std::vector<IntegrationSphere *> &spheres,
+    const bool useOnePercentBackgroundCorrection) const {
+  // If the box is cached to disk, you need to retrieve it
+  const std::vector<MDE> &events = this->getConstEvents();
+  const int numSpheres = static_cast<int>(spheres.size());
+  PARALLEL_FOR_IF(numSpheres > 1)
+  for (int i = 0; i < numSpheres; ++i) {
+    IntegrationSphere &sphere = *spheres[i];
+    integrateEventsInSphere(events, *sphere.radiusTransform,
+                            sphere.radiusSquared, sphere.signal,
+                            sphere.errorSquared, sphere.innerRadiusSquared,
+                            useOnePercentBackgroundCorrection);
+  }
+  if (m_Saveable) {
+    m_Saveable->setBusy(false);
+  }
+}
+
+/** Add the signal and squared error of the events within a sphere, or a
+ * spherical shell.
+ *
+ * @param events :: the events of the box.
+ * @param radiusTransform :: nd-to-1 coordinate transformation that converts
+ *        from these dimensions to the distance (squared) from the center of
+ *        the sphere.
+ * @param radiusSquared :: radius^2 below which to integrate
+ * @param[out] signal :: the integrated signal is added to it.
+ * @param[out] errorSquared :: the integrated squared error is added to it.
+ * @param innerRadiusSquared :: radius^2 above which to integrate
+ * @param useOnePercentBackgroundCorrection :: if true, leave out the top 1% of
+ *        the events of a shell.
+ */
+TMDE(void MDBox)::integrateEventsInSphere(
+    const std::vector<MDE> &events,
+    const Mantid::API::CoordTransform &radiusTransform,
+    const coord_t radiusSquared, signal_t &signal, signal_t &errorSquared,
+    const coord_t innerRadiusSquared,
+    const bool useOnePercentBackgroundCorrection) {
   if (innerRadiusSquared == 0.0) {
     // For each MDLeanEvent
     for (const auto &it : events) {
@@ -597,12 +655,6 @@ TMDE(void MDBox)::integrateSphere(Mantid::API::CoordTransform &radiusTransform,
       errorSquared += vals[k].second;
     }
   }
-  // it is constant access, so no saving or fiddling with the buffer is needed.
-  // Events just can be dropped if necessary
-  // m_Saveable->releaseEvents();
-  if (m_Saveable) {
-    m_Saveable->setBusy(false);
-  }
 }
 
 /** Integrate the signal within a sphere; for example, to perform single-crystal
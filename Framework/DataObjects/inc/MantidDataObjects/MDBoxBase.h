@@ -8,6 +8,7 @@
 #include "MantidAPI/BoxController.h"
 #include "MantidAPI/IMDWorkspace.h"
 #include "MantidAPI/CoordTransform.h"
+#include "MantidDataObjects/CoordTransformDistance.h"
 #include "MantidGeometry/MDGeometry/MDDimensionExtents.h"
 #include "MantidGeometry/MDGeometry/MDImplicitFunction.h"
 #include "MantidKernel/ISaveable.h"
@@ -21,6 +22,23 @@
 namespace Mantid {
 namespace DataObjects {
 
+/** A sphere, or spherical shell, integrated by MDBoxBase::integrateSpheres.
+ * The signal and squared error of the events inside are added to signal and
+ * errorSquared.
+ */
+struct IntegrationSphere {
+  /// Transformation to the squared distance from the center of the sphere
+  CoordTransformDistance *radiusTransform;
+  /// radius^2 below which to integrate
+  coord_t radiusSquared;
+  /// radius^2 above which to integrate
+  coord_t innerRadiusSquared;
+  /// The integrated signal
+  signal_t signal;
+  /// The integrated squared error
+  signal_t errorSquared;
+};
+
 #ifndef __INTEL_COMPILER // As of July 13, the packing has no effect for the
                          // Intel compiler and produces a warning
 #pragma pack(push, 4)    // Ensure the structure is no larger than it needs to
@@ -133,6 +151,11 @@ public:
       const coord_t innerRadiusSquared = 0.0,
       const bool useOnePercentBackgroundCorrection = true) const override = 0;
 
+  /** Integrate several spheres at once */
+  virtual void
+  integrateSpheres(std::vector<IntegrationSphere *> &spheres,
+                   const bool useOnePercentBackgroundCorrection = true) const;
+
   /** Find the centroid around a sphere */
   void centroidSphere(Mantid::API::CoordTransform &radiusTransform,
                       const coord_t radiusSquared, coord_t *centroid,
@@ -225,6 +225,24 @@ TMDE(coord_t *MDBoxBase)::getVertexesArray(size_t &numVertices,
   return out;
 }
 
+//-----------------------------------------------------------------------------------------------
+/** Integrate the signal within several spheres, adding to the signal and
+ * squared error of each. By default each sphere is integrated on its own.
+ *
+ * @param spheres :: the spheres to integrate.
+ * @param useOnePercentBackgroundCorrection :: if true, leave out the top 1% of
+ *        the events of the shells from their background.
+ */
+TMDE(void MDBoxBase)::integrateSpheres(
+    std::vector<IntegrationSphere *> &spheres,
+    const bool useOnePercentBackgroundCorrection) const {
+  for (auto sphere : spheres)
+    this->integrateSphere(*sphere->radiusTransform, sphere->radiusSquared,
+                          sphere->signal, sphere->errorSquared,
+                          sphere->innerRadiusSquared,
+                          useOnePercentBackgroundCorrection);
+}
+
 //-----------------------------------------------------------------------------------------------
 /** Add several events, starting and stopping at particular point in a vector.
  * Bounds checking IS performed, and events outside the range are rejected.
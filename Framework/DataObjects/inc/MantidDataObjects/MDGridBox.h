@@ -156,6 +156,13 @@ public:
       const coord_t innerRadiusSquared = 0.0,
       const bool useOnePercentBackgroundCorrection = true) const override;
 
+  void integrateSpheres(
+      std::vector<IntegrationSphere *> &spheres,
+      const bool useOnePercentBackgroundCorrection = true) const override;
+
+  void findTouchedChildren(const IntegrationSphere &sphere,
+                           std::vector<std::pair<size_t, bool>> &touched) const;
+
   void centroidSphere(Mantid::API::CoordTransform &radiusTransform,
                       const coord_t radiusSquared, coord_t *centroid,
                       signal_t &signal) const override;
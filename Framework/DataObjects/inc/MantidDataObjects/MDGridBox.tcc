@@ -1,6 +1,7 @@
 #include "MantidKernel/Task.h"
 #include "MantidKernel/Utils.h"
 #include "MantidKernel/FunctionTask.h"
+#include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/Timer.h"
 #include "MantidKernel/ThreadPool.h"
 #include "MantidKernel/ThreadScheduler.h"
@@ -12,6 +13,7 @@
 #include <boost/math/special_functions/round.hpp>
 #include <boost/optional.hpp>
 #include <ostream>
+#include <tuple>
 #include "MantidKernel/Strings.h"
 
 // These pragmas ignores the warning in the ctor where "d<nd-1" for nd=1.
@@ -1249,6 +1251,175 @@ TMDE(void MDGridBox)::integrateSphere(API::CoordTransform &radiusTransform,
   delete[] boxMightTouch;
 }
 
+//-----------------------------------------------------------------------------------------------
+/** Integrate the signal within several spheres in one pass over the boxes.
+ * Each child is visited once, with all the spheres which may partly contain
+ * it, and the children are visited in order, so that the signal of each
+ * sphere is summed in the same order as by integrateSphere.
+ *
+ * @param spheres :: the spheres to integrate.
+ * @param useOnePercentBackgroundCorrection :: if true, leave out the top 1% of
+ *        the events of the shells from their background.
+ */
+TMDE(void MDGridBox)::integrateSpheres(
+    std::vector<IntegrationSphere *> &spheres,
+    const bool useOnePercentBackgroundCorrection) const {
+  // The children touched by each sphere, flagged true if fully contained
+  std::vector<std::vector<std::pair<size_t, bool>>> touched(spheres.size());
+  const int numSpheres = static_cast<int>(spheres.size());
+  PARALLEL_FOR_IF(numSpheres > 1)
+  for (int i = 0; i < numSpheres; ++i)
+    findTouchedChildren(*spheres[i], touched[i]);
+
+  // (child, sphere, fully contained), sorted by child
+  using Visit = std::tuple<size_t, size_t, bool>;
+  std::vector<Visit> visits;
+  for (size_t i = 0; i < touched.size(); ++i)
+    for (const auto &child : touched[i])
+      visits.emplace_back(child.first, i, child.second);
+  std::stable_sort(visits.begin(), visits.end(),
+                   [](const Visit &a, const Visit &b) {
+                     return std::get<0>(a) < std::get<0>(b);
+                   });
+
+  std::vector<IntegrationSphere *> partialSpheres;
+  auto visit = visits.cbegin();
+  while (visit != visits.cend()) {
+    const size_t i = std::get<0>(*visit);
+    MDBoxBase<MDE, nd> *box = m_Children[i];
+    partialSpheres.clear();
+    for (; visit != visits.cend() && std::get<0>(*visit) == i; ++visit) {
+      IntegrationSphere *sphere = spheres[std::get<1>(*visit)];
+      if (std::get<2>(*visit)) {
+        // Use the integrated sum of signal in the box
+        sphere->signal += box->getSignal();
+        sphere->errorSquared += box->getErrorSquared();
+      } else {
+        partialSpheres.push_back(sphere);
+      }
+    }
+    // Use the detailed integration method, for all the spheres at once.
+    if (!partialSpheres.empty())
+      box->integrateSpheres(partialSpheres, useOnePercentBackgroundCorrection);
+  }
+}
+
+//-----------------------------------------------------------------------------------------------
+/** Find the children fully or partly contained in a sphere, with the same
+ * tests as integrateSphere. Only the vertices and children close enough to
+ * the center of the sphere to pass the tests are looked at.
+ *
+ * @param sphere :: the sphere to integrate.
+ * @param touched [out] :: set to the linear indices of the children which
+ *        may be partly contained, in increasing order, each flagged true if
+ *        the child is fully contained.
+ */
+TMDE(void MDGridBox)::findTouchedChildren(
+    const IntegrationSphere &sphere,
+    std::vector<std::pair<size_t, bool>> &touched) const {
+  CoordTransformDistance &radiusTransform = *sphere.radiusTransform;
+  const coord_t radiusSquared = sphere.radiusSquared;
+  const coord_t innerRadiusSquared = sphere.innerRadiusSquared;
+  const coord_t *center = radiusTransform.getCenter();
+  const bool *dimensionsUsed = radiusTransform.getDimensionsUsed();
+
+  // A child further than this from the center in one dimension has neither a
+  // contained vertex nor a center close enough to be touching.
+  const double reach = std::sqrt(diagonalSquared * 0.72 +
+                                 std::max(radiusSquared, innerRadiusSquared));
+  size_t boxMin[nd];
+  size_t boxMax[nd];
+  size_t vertexMax[nd];
+  size_t localIndexMaker[nd];
+  size_t numLocalBoxes = 1;
+  for (size_t d = 0; d < nd; ++d) {
+    boxMin[d] = 0;
+    boxMax[d] = split[d];
+    const double min = this->extents[d].getMin();
+    // Keep one more child on each side to allow for rounding
+    const double first =
+        std::floor((center[d] - reach - min) / m_SubBoxSize[d]) - 1.0;
+    const double last =
+        std::floor((center[d] + reach - min) / m_SubBoxSize[d]) + 1.0;
+    if (dimensionsUsed[d] && std::isfinite(first) && std::isfinite(last)) {
+      if (last < 0.0 || first >= static_cast<double>(split[d]))
+        return;
+      if (first > 0.0)
+        boxMin[d] = static_cast<size_t>(first);
+      if (last + 1.0 < static_cast<double>(split[d]))
+        boxMax[d] = static_cast<size_t>(last) + 1;
+    }
+    vertexMax[d] = boxMax[d] + 1;
+    localIndexMaker[d] = numLocalBoxes;
+    numLocalBoxes *= boxMax[d] - boxMin[d];
+  }
+  size_t indexMaker[nd];
+  Kernel::Utils::NestedForLoop::SetUpIndexMaker(nd, indexMaker, split);
+
+  // The number of contained vertices of each child in range
+  std::vector<size_t> verticesContained(numLocalBoxes, 0);
+  size_t maxVertices = 1 << nd;
+
+  size_t vertexIndex[nd];
+  size_t boxIndex[nd];
+  std::copy(boxMin, boxMin + nd, vertexIndex);
+  bool allDone = false;
+  while (!allDone) {
+    // Coordinates of this vertex, as in integrateSphere
+    coord_t vertexCoord[nd];
+    for (size_t d = 0; d < nd; ++d)
+      vertexCoord[d] = static_cast<coord_t>(vertexIndex[d]) *
+                           static_cast<coord_t>(m_SubBoxSize[d]) +
+                       static_cast<coord_t>(this->extents[d].getMin());
+
+    coord_t out[nd];
+    radiusTransform.apply(vertexCoord, out);
+    if (out[0] < radiusSquared && out[0] > innerRadiusSquared) {
+      // This vertex is shared by up to 2^nd adjacent boxes
+      for (size_t neighb = 0; neighb < maxVertices; ++neighb) {
+        bool badIndex = false;
+        size_t localIndex = 0;
+        for (size_t d = 0; d < nd; d++) {
+          // unsigned(0)-1 is a large positive number, so it is out of range
+          boxIndex[d] = vertexIndex[d] - ((neighb & ((size_t)1 << d)) >> d);
+          if (boxIndex[d] < boxMin[d] || boxIndex[d] >= boxMax[d]) {
+            badIndex = true;
+            break;
+          }
+          localIndex += (boxIndex[d] - boxMin[d]) * localIndexMaker[d];
+        }
+        if (!badIndex)
+          verticesContained[localIndex]++;
+      }
+    }
+    allDone = Kernel::Utils::NestedForLoop::Increment(nd, vertexIndex,
+                                                      vertexMax, boxMin);
+  }
+
+  // Check each child in range, in the order of their linear indices
+  std::copy(boxMin, boxMin + nd, boxIndex);
+  for (size_t localIndex = 0; localIndex < numLocalBoxes; ++localIndex) {
+    const size_t i =
+        Kernel::Utils::NestedForLoop::GetLinearIndex(nd, boxIndex, indexMaker);
+    Kernel::Utils::NestedForLoop::Increment(nd, boxIndex, boxMax, boxMin);
+
+    if (verticesContained[localIndex] >= maxVertices) {
+      touched.emplace_back(i, true);
+    } else if (verticesContained[localIndex] == 0) {
+      // The box may be touching even if none of its vertices is contained
+      coord_t boxCenter[nd];
+      m_Children[i]->getCenter(boxCenter);
+      coord_t out[nd];
+      radiusTransform.apply(boxCenter, out);
+      if (out[0] < diagonalSquared * 0.72 + radiusSquared ||
+          out[0] < diagonalSquared * 0.72 + innerRadiusSquared)
+        touched.emplace_back(i, false);
+    } else {
+      touched.emplace_back(i, false);
+    }
+  }
+}
+
 //-----------------------------------------------------------------------------------------------
 /** Find the centroid of all events contained within by doing a weighted average
  * of their coordinates.
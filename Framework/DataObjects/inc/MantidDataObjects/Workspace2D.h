@@ -15,6 +15,9 @@ namespace DataObjects {
     Concrete workspace implementation. Data is a vector of Histogram1D.
     Since Histogram1D have share ownership of X, Y or E arrays,
     duplication is avoided for workspaces for example with identical time bins.
+    The Histogram1D objects are held by value in one vector rather than being
+    allocated one by one. Their X, Y and E arrays are still allocated
+    separately and shared copy-on-write.
 
     \author Laurent C Chapon, ISIS, RAL
     \date 26/09/2007
@@ -111,8 +114,8 @@ protected:
   /// a vector holding workspace index of monitors in the workspace
   std::vector<specnum_t> m_monitorList;
 
-  /// A vector that holds the 1D histograms
-  std::vector<Histogram1D *> data;
+  /// The 1D histograms, held by value in a single vector
+  std::vector<Histogram1D> data;
 
 private:
   Workspace2D *doClone() const override;
@@ -5,13 +5,22 @@
 #include "MantidDataObjects/MDBoxFlatTree.h"
 #include "MantidKernel/ConfigService.h"
 #include "MantidKernel/Exception.h"
+#include "MantidKernel/ISaveable.h"
+#include "MantidKernel/Logger.h"
 #include "MantidAPI/FileFinder.h"
 #include "MantidDataObjects/MDEvent.h"
 
+#include <cstring>
+#include <iterator>
 #include <string>
 
 namespace Mantid {
 namespace DataObjects {
+namespace {
+/// static logger
+Kernel::Logger g_log("BoxControllerNeXusIO");
+}
+
 // Default headers(attributes) describing the contents of the data, written by
 // this class
 const char *EventHeaders[] = {
@@ -26,11 +35,19 @@ std::string BoxControllerNeXusIO::g_DBDataName("free_space_blocks");
 */
 BoxControllerNeXusIO::BoxControllerNeXusIO(API::BoxController *const bc)
     : m_File(nullptr), m_ReadOnly(true), m_dataChunk(DATA_CHUNK), m_bc(bc),
-      m_BlockStart(2, 0), m_BlockSize(2, 0), m_CoordSize(sizeof(coord_t)),
+      m_BlockStart(2, 0), m_BlockSize(2, 0),
+      m_fileElementSize(sizeof(coord_t)), m_compress(false), m_writingBegin(0),
+      m_writingEnd(0), m_queuedBytes(0), m_writeCount(0),
+      m_flushRequested(false), m_stopIO(false), m_CoordSize(sizeof(coord_t)),
       m_EventType(FatEvent), m_EventsVersion("1.0"),
       m_ReadConversion(noConversion) {
   m_BlockSize[1] = 4 + m_bc->getNDims();
 
+  int compress(0);
+  if (Kernel::ConfigService::Instance().getValue(
+          "MDWorkspace.Compression", compress) == 1)
+    m_compress = compress != 0;
+
   for (auto &EventHeader : EventHeaders) {
     m_EventsTypeHeaders.push_back(EventHeader);
   }
@@ -163,6 +180,7 @@ bool BoxControllerNeXusIO::openFile(const std::string &fileName,
   else
     prepareNxSToWrite_CurVersion();
 
+  startIOThread();
   return true;
 }
 /**Create group responsible for keeping events and add necessary attributes to
@@ -217,13 +235,15 @@ void BoxControllerNeXusIO::prepareNxSToWrite_CurVersion() {
     std::vector<int64_t> chunk(m_BlockSize);
     chunk[0] = static_cast<int64_t>(m_dataChunk);
 
-    // Make and open the data
+    // Make and open the data. LZW is the deflate filter of HDF5
+    const auto compression = m_compress ? ::NeXus::LZW : ::NeXus::NONE;
     if (m_CoordSize == 4)
       m_File->makeCompData("event_data", ::NeXus::FLOAT32, m_BlockSize,
-                           ::NeXus::NONE, chunk, true);
+                           compression, chunk, true);
     else
       m_File->makeCompData("event_data", ::NeXus::FLOAT64, m_BlockSize,
-                           ::NeXus::NONE, chunk, true);
+                           compression, chunk, true);
+    m_fileElementSize = m_CoordSize;
 
     // A little bit of description for humans to read later
     m_File->putAttr("description", m_EventsTypeHeaders[m_EventType]);
@@ -249,10 +269,12 @@ void BoxControllerNeXusIO::prepareNxSdata_CurVersion() {
   case (::NeXus::FLOAT64):
     if (m_CoordSize == 4)
       m_ReadConversion = doubleToFolat;
+    m_fileElementSize = 8;
     break;
   case (::NeXus::FLOAT32):
     if (m_CoordSize == 8)
       m_ReadConversion = floatToDouble;
+    m_fileElementSize = 4;
     break;
 
   default:
@@ -323,30 +345,61 @@ void BoxControllerNeXusIO::getDiskBufferFileData() {
 
 //-------------------------------------------------------------------------------------------------------------------------------------
 /** Save generc data block on specific position within properly opened NeXus
-  *data array
+  *data array. The block is queued and written by the I/O thread.
   *@param DataBlock     -- the vector with data to write
   *@param blockPosition -- The starting place to save data to   */
 template <typename Type>
 void BoxControllerNeXusIO::saveGenericBlock(
     const std::vector<Type> &DataBlock, const uint64_t blockPosition) const {
-  std::vector<int64_t> start(2, 0);
-  // Specify the dimensions
-  std::vector<int64_t> dims(m_BlockSize);
-
-  std::lock_guard<std::mutex> _lock(m_fileMutex);
-  start[0] = int64_t(blockPosition);
-  dims[0] = int64_t(DataBlock.size() / this->getNDataColums());
-
-  // ugly cast but why would putSlab change the data?. This is NeXus bug which
-  // makes putSlab method non-constant
-  std::vector<Type> &mData = const_cast<std::vector<Type> &>(DataBlock);
-
-  {
-    m_File->putSlab<Type>(mData, start, dims);
-
-    if (blockPosition + dims[0] > this->getFileLength())
-      this->setFileLength(blockPosition + dims[0]);
+  const auto nPoints =
+      static_cast<uint64_t>(DataBlock.size() / this->getNDataColums());
+  if (nPoints == 0)
+    return;
+  const uint64_t blockEnd = blockPosition + nPoints;
+  const size_t nBytes = DataBlock.size() * sizeof(Type);
+
+  std::unique_lock<std::mutex> lock(m_queueMutex);
+  rethrowIOError();
+  // The queued writes must not overlap, so an older write which overlaps the
+  // new one must be written first, unless the new one simply replaces it
+  m_workDone.wait(lock, [&] {
+    if (m_ioError)
+      return true;
+    if (m_queuedBytes + nBytes > MAX_QUEUED_BYTES && !m_pendingWrites.empty())
+      return false;
+    if (blockPosition < m_writingEnd && m_writingBegin < blockEnd)
+      return false;
+    auto same = m_pendingWrites.find(blockPosition);
+    if (same != m_pendingWrites.end() && same->second.nPoints <= nPoints) {
+      auto next = std::next(same);
+      return next == m_pendingWrites.end() || next->first >= blockEnd;
+    }
+    return !overlapsWrites(blockPosition, blockEnd);
+  });
+  rethrowIOError();
+
+  // Blocks read ahead are now out of date
+  for (auto it = m_readAhead.begin(); it != m_readAhead.end();) {
+    const uint64_t end = it->first + it->second.nPoints;
+    if (it->first < blockEnd && blockPosition < end) {
+      m_queuedBytes -= it->second.data.size();
+      it = m_readAhead.erase(it);
+    } else {
+      ++it;
+    }
   }
+
+  auto &block = m_pendingWrites[blockPosition];
+  m_queuedBytes -= block.data.size();
+  block.nPoints = nPoints;
+  block.data.resize(nBytes);
+  std::memcpy(block.data.data(), DataBlock.data(), nBytes);
+  m_queuedBytes += nBytes;
+  ++m_writeCount;
+
+  if (blockEnd > this->getFileLength())
+    this->setFileLength(blockEnd);
+  m_workQueued.notify_one();
 }
 
 /** Save float data block on specific position within properly opened NeXus data
@@ -384,13 +437,30 @@ void BoxControllerNeXusIO::loadGenericBlock(std::vector<Type> &Block,
 
   std::vector<int64_t> start(2, 0);
   std::vector<int64_t> size(m_BlockSize);
-
-  std::lock_guard<std::mutex> _lock(m_fileMutex);
-
   start[0] = static_cast<int64_t>(blockPosition);
   size[0] = static_cast<int64_t>(nPoints);
   Block.resize(size[0] * size[1]);
+  if (nPoints == 0)
+    return;
 
+  {
+    std::unique_lock<std::mutex> lock(m_queueMutex);
+    rethrowIOError();
+    if (sizeof(Type) == m_fileElementSize &&
+        copyQueuedBlock(reinterpret_cast<char *>(Block.data()), blockPosition,
+                        nPoints, Block.size() / nPoints * sizeof(Type)))
+      return;
+    // The file does not have the data of the writes which are still queued
+    const uint64_t blockEnd = blockPosition + nPoints;
+    m_workDone.wait(lock, [&] {
+      return m_ioError ||
+             !(overlapsWrites(blockPosition, blockEnd) ||
+               (blockPosition < m_writingEnd && m_writingBegin < blockEnd));
+    });
+    rethrowIOError();
+  }
+
+  std::lock_guard<std::mutex> _lock(m_fileMutex);
   m_File->getSlab(&Block[0], start, size);
 }
 
@@ -456,41 +526,330 @@ void BoxControllerNeXusIO::loadBlock(std::vector<double> &Block,
 
 //-------------------------------------------------------------------------------------------------------------------------------------
 
-/// Clear NeXus internal cache
+/** Ask the I/O thread to read a data block, which is expected to be loaded
+  *soon, into memory. The request is ignored if the block is being written.
+  *@param blockPosition -- The starting place to read data from
+  *@param nPoints       -- number of data points (events) to read
+*/
+void BoxControllerNeXusIO::prefetchBlock(const uint64_t blockPosition,
+                                         const size_t nPoints) const {
+  if (nPoints == 0 || blockPosition + nPoints > this->getFileLength())
+    return;
+  std::lock_guard<std::mutex> lock(m_queueMutex);
+  if (!m_ioThread.joinable() || m_readAhead.count(blockPosition))
+    return;
+  m_readRequests.emplace_back(blockPosition, nPoints);
+  m_workQueued.notify_one();
+}
+
+/** Called by the disk buffer once it has saved a batch of boxes. The file is
+  *flushed by the I/O thread when the blocks are written, instead of waiting
+  *for the writes here.
+*/
+void BoxControllerNeXusIO::writesIssued(Kernel::ISaveable * /*lastSaved*/) {
+  std::lock_guard<std::mutex> lock(m_queueMutex);
+  m_flushRequested = true;
+  m_workQueued.notify_one();
+}
+
+/// Write the queued blocks and clear NeXus internal cache
 void BoxControllerNeXusIO::flushData() const {
+  waitForPendingWrites();
   std::lock_guard<std::mutex> _lock(m_fileMutex);
   m_File->flush();
 }
+
+/// Write everything in the disk buffer and wait until it is in the file
+void BoxControllerNeXusIO::flushCache() {
+  DiskBuffer::flushCache();
+  if (m_File)
+    flushData();
+}
+
+/// @return the NeXus file, once the queued blocks are written
+::NeXus::File *BoxControllerNeXusIO::getFile() {
+  if (m_File)
+    waitForPendingWrites();
+  return m_File;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------
+/// Start the thread which reads and writes the events data
+void BoxControllerNeXusIO::startIOThread() {
+  m_stopIO = false;
+  m_flushRequested = false;
+  m_ioError = nullptr;
+  m_ioThread = std::thread(&BoxControllerNeXusIO::runIOThread, this);
+}
+
+/// Write the queued blocks and stop the I/O thread
+void BoxControllerNeXusIO::stopIOThread() {
+  if (!m_ioThread.joinable())
+    return;
+  {
+    std::lock_guard<std::mutex> lock(m_queueMutex);
+    m_stopIO = true;
+    m_workQueued.notify_one();
+  }
+  m_ioThread.join();
+  m_readRequests.clear();
+  m_readAhead.clear();
+  m_pendingWrites.clear();
+  m_queuedBytes = 0;
+}
+
+/// The loop of the I/O thread. Reads ahead have priority over writes, as a
+/// load may be waiting for them.
+void BoxControllerNeXusIO::runIOThread() {
+  std::unique_lock<std::mutex> lock(m_queueMutex);
+  while (true) {
+    m_workQueued.wait(lock, [this] {
+      return m_stopIO || m_flushRequested || !m_pendingWrites.empty() ||
+             !m_readRequests.empty();
+    });
+    if (!m_readRequests.empty() && !m_stopIO) {
+      readAhead(lock);
+    } else if (!m_pendingWrites.empty()) {
+      writeQueuedBlocks(lock);
+    } else if (m_flushRequested) {
+      m_flushRequested = false;
+      lock.unlock();
+      try {
+        std::lock_guard<std::mutex> fileLock(m_fileMutex);
+        m_File->flush();
+      } catch (...) {
+        lock.lock();
+        if (!m_ioError)
+          m_ioError = std::current_exception();
+        lock.unlock();
+      }
+      lock.lock();
+    } else if (m_stopIO) {
+      break;
+    }
+  }
+}
+
+/** Write the first run of adjacent queued blocks in one go. Called by the I/O
+  *thread with the queue locked; the queue is unlocked while writing.
+  *@param lock -- the lock of the queue
+*/
+void BoxControllerNeXusIO::writeQueuedBlocks(
+    std::unique_lock<std::mutex> &lock) {
+  auto it = m_pendingWrites.begin();
+  const uint64_t begin = it->first;
+  uint64_t end = begin + it->second.nPoints;
+  std::vector<char> data = std::move(it->second.data);
+  it = m_pendingWrites.erase(it);
+  while (it != m_pendingWrites.end() && it->first == end &&
+         data.size() < MAX_QUEUED_BYTES / 8) {
+    data.insert(data.end(), it->second.data.begin(), it->second.data.end());
+    end += it->second.nPoints;
+    it = m_pendingWrites.erase(it);
+  }
+  m_writingBegin = begin;
+  m_writingEnd = end;
+  const bool failed = static_cast<bool>(m_ioError);
+  lock.unlock();
+
+  if (!failed) {
+    std::vector<int64_t> start(2, 0);
+    std::vector<int64_t> dims(m_BlockSize);
+    start[0] = static_cast<int64_t>(begin);
+    dims[0] = static_cast<int64_t>(end - begin);
+    try {
+      std::lock_guard<std::mutex> fileLock(m_fileMutex);
+      m_File->putSlab(data.data(), start, dims);
+    } catch (...) {
+      lock.lock();
+      if (!m_ioError)
+        m_ioError = std::current_exception();
+      lock.unlock();
+    }
+  }
+
+  lock.lock();
+  m_queuedBytes -= data.size();
+  m_writingBegin = 0;
+  m_writingEnd = 0;
+  m_workDone.notify_all();
+}
+
+/** Read the first requested block ahead of its load. Called by the I/O thread
+  *with the queue locked; the queue is unlocked while reading.
+  *@param lock -- the lock of the queue
+*/
+void BoxControllerNeXusIO::readAhead(std::unique_lock<std::mutex> &lock) {
+  const auto request = m_readRequests.front();
+  m_readRequests.pop_front();
+  const uint64_t begin = request.first;
+  const uint64_t end = begin + request.second;
+  const size_t nBytes =
+      request.second * static_cast<size_t>(m_BlockSize[1]) * m_fileElementSize;
+  if (m_ioError || m_readAhead.count(begin) || overlapsWrites(begin, end) ||
+      (begin < m_writingEnd && m_writingBegin < end))
+    return;
+  if (m_queuedBytes + nBytes > MAX_QUEUED_BYTES) {
+    // drop the blocks read ahead which were not loaded
+    for (const auto &block : m_readAhead)
+      m_queuedBytes -= block.second.data.size();
+    m_readAhead.clear();
+    if (m_queuedBytes + nBytes > MAX_QUEUED_BYTES)
+      return;
+  }
+  const uint64_t writeCount = m_writeCount;
+  m_queuedBytes += nBytes;
+  lock.unlock();
+
+  QueuedBlock block;
+  block.nPoints = request.second;
+  block.data.resize(nBytes);
+  std::vector<int64_t> start(2, 0);
+  std::vector<int64_t> size(m_BlockSize);
+  start[0] = static_cast<int64_t>(begin);
+  size[0] = static_cast<int64_t>(request.second);
+  bool success = true;
+  try {
+    std::lock_guard<std::mutex> fileLock(m_fileMutex);
+    m_File->getSlab(block.data.data(), start, size);
+  } catch (...) {
+    // the load will report the error
+    success = false;
+  }
+
+  lock.lock();
+  // A block saved meanwhile could make the data out of date
+  if (success && writeCount == m_writeCount && !m_readAhead.count(begin))
+    m_readAhead[begin] = std::move(block);
+  else
+    m_queuedBytes -= nBytes;
+  m_workDone.notify_all();
+}
+
+/// Wait until the queued blocks are written to the file
+void BoxControllerNeXusIO::waitForPendingWrites() const {
+  std::unique_lock<std::mutex> lock(m_queueMutex);
+  m_workDone.wait(lock, [this] {
+    return m_ioError || (m_pendingWrites.empty() && m_writingEnd == 0);
+  });
+  rethrowIOError();
+}
+
+/// Rethrow the error of the I/O thread, if any. Called with the queue locked.
+void BoxControllerNeXusIO::rethrowIOError() const {
+  if (m_ioError) {
+    auto error = m_ioError;
+    m_ioError = nullptr;
+    std::rethrow_exception(error);
+  }
+}
+
+/** Check if a range of positions overlaps a queued write. Called with the
+  *queue locked.
+  *@param begin -- the first position of the range
+  *@param end   -- one past the last position of the range
+  *@returns true if a pending write overlaps the range
+*/
+bool BoxControllerNeXusIO::overlapsWrites(const uint64_t begin,
+                                          const uint64_t end) const {
+  // The pending writes do not overlap each other, so only the last one
+  // starting before the end of the range can overlap it
+  auto it = m_pendingWrites.lower_bound(end);
+  if (it == m_pendingWrites.begin())
+    return false;
+  --it;
+  return it->first + it->second.nPoints > begin;
+}
+
+/** Copy a block from a pending write containing it, or from the blocks read
+  *ahead. Called with the queue locked.
+  *@param destination   -- where to copy the data
+  *@param blockPosition -- the position of the block in the file
+  *@param nPoints       -- the number of data points (events) of the block
+  *@param pointSize     -- the size of a data point in bytes
+  *@returns true if the block was found and copied
+*/
+bool BoxControllerNeXusIO::copyQueuedBlock(char *destination,
+                                           const uint64_t blockPosition,
+                                           const size_t nPoints,
+                                           const size_t pointSize) const {
+  auto it = m_pendingWrites.upper_bound(blockPosition);
+  if (it != m_pendingWrites.begin()) {
+    --it;
+    const auto &block = it->second;
+    if (it->first + block.nPoints >= blockPosition + nPoints &&
+        block.data.size() == block.nPoints * pointSize) {
+      std::memcpy(destination,
+                  block.data.data() + (blockPosition - it->first) * pointSize,
+                  nPoints * pointSize);
+      return true;
+    }
+  }
+
+  auto ahead = m_readAhead.find(blockPosition);
+  if (ahead != m_readAhead.end() && ahead->second.nPoints == nPoints &&
+      ahead->second.data.size() == nPoints * pointSize) {
+    std::memcpy(destination, ahead->second.data.data(), nPoints * pointSize);
+    m_queuedBytes -= ahead->second.data.size();
+    m_readAhead.erase(ahead);
+    return true;
+  }
+  return false;
+}
 /** flush disk buffer data from memory and close underlying NeXus file*/
 void BoxControllerNeXusIO::closeFile() {
   if (m_File) {
-    // write all file-backed data still stack in the data buffer into the file.
-    this->flushCache();
-    // lock file
-    std::lock_guard<std::mutex> _lock(m_fileMutex);
-
-    m_File->closeData(); // close events data
-    if (!m_ReadOnly)     // write free space groups from the disk buffer
-    {
-      std::vector<uint64_t> freeSpaceBlocks;
-      this->getFreeSpaceVector(freeSpaceBlocks);
-      if (!freeSpaceBlocks.empty()) {
-        std::vector<int64_t> free_dims(2, 2);
-        free_dims[0] = int64_t(freeSpaceBlocks.size() / 2);
-
-        m_File->writeUpdatedData(g_DBDataName, freeSpaceBlocks, free_dims);
+    try {
+      // write all file-backed data still stack in the data buffer into the
+      // file. The I/O thread writes the queued blocks before it stops below.
+      DiskBuffer::flushCache();
+      // write the queued blocks and stop the I/O thread
+      stopIOThread();
+      // lock file
+      std::lock_guard<std::mutex> _lock(m_fileMutex);
+
+      m_File->closeData(); // close events data
+      if (!m_ReadOnly)     // write free space groups from the disk buffer
+      {
+        std::vector<uint64_t> freeSpaceBlocks;
+        this->getFreeSpaceVector(freeSpaceBlocks);
+        if (!freeSpaceBlocks.empty()) {
+          std::vector<int64_t> free_dims(2, 2);
+          free_dims[0] = int64_t(freeSpaceBlocks.size() / 2);
+
+          m_File->writeUpdatedData(g_DBDataName, freeSpaceBlocks, free_dims);
+        }
       }
-    }
 
-    m_File->closeGroup(); // close events group
-    m_File->closeGroup(); // close workspace group
-    m_File->close();      // close NeXus file
+      m_File->closeGroup(); // close events group
+      m_File->closeGroup(); // close workspace group
+      m_File->close();      // close NeXus file
+    } catch (...) {
+      // A failed write must not leave the I/O thread running on this object
+      // or the file open
+      stopIOThread();
+      delete m_File;
+      m_File = nullptr;
+      throw;
+    }
 
     delete m_File;
     m_File = nullptr;
+    // report a write which failed
+    rethrowIOError();
   }
 }
 
-BoxControllerNeXusIO::~BoxControllerNeXusIO() { this->closeFile(); }
+/// The destructor closes the file, but only logs a failure to write it
+BoxControllerNeXusIO::~BoxControllerNeXusIO() {
+  try {
+    this->closeFile();
+  } catch (std::exception &ex) {
+    g_log.error() << "Error while closing " << m_fileName << ": " << ex.what()
+                  << '\n';
+  } catch (...) {
+    g_log.error() << "Unknown error while closing " << m_fileName << '\n';
+  }
+}
 }
 }
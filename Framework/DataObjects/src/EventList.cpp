@@ -4,6 +4,8 @@
 #include "MantidKernel/DateAndTime.h"
 #include "MantidKernel/Exception.h"
 #include "MantidKernel/Logger.h"
+#include "MantidKernel/RadixSort.h"
+#include "MantidKernel/TaskRuntime.h"
 #include "MantidKernel/Unit.h"
 
 #ifdef _MSC_VER
@@ -15,6 +17,7 @@
 #pragma warning(default : 4180)
 #endif
 
+#include <algorithm>
 #include <cfloat>
 #include <cmath>
 #include <functional>
@@ -81,6 +84,131 @@ public:
     return (tAtSample1 < tAtSample2);
   }
 };
+
+/// Lists of TofEvent's at least this long are radix sorted. The threshold
+/// grows with the size of the event, as each radix pass moves whole events.
+const size_t RADIX_SORT_MIN_EVENTS = 2048;
+/// Lists at least this long are sorted with several threads
+const size_t PARALLEL_SORT_MIN_EVENTS = 10 * 1000 * 1000;
+
+/// Radix sort key for the time-of-flight of an event
+template <typename T> uint64_t tofKey(const T &event) {
+  return Kernel::radixKey(event.tof());
+}
+
+/// Radix sort key for the pulse time of an event
+template <typename T> uint64_t pulseTimeKey(const T &event) {
+  return Kernel::radixKey(event.pulseTime().totalNanoseconds());
+}
+
+/**
+ * Sort events, choosing the method from the number and type of events.
+ * Small lists use a serial comparison sort, so that sorting many lists from
+ * a parallel loop does not spawn tasks for each of them. Medium lists use a
+ * radix sort and very large lists a parallel comparison sort.
+ * @param events : The events to sort
+ * @param compare : Comparison of two events, consistent with radixSort
+ * @param radixSort : Functor radix sorting the events
+ */
+template <typename T, typename Compare, typename RadixSort>
+void sortEvents(std::vector<T> &events, Compare compare, RadixSort radixSort) {
+  // Events are often loaded in order of pulse time already
+  if (std::is_sorted(events.cbegin(), events.cend(), compare))
+    return;
+  const size_t numEvents = events.size();
+  if (numEvents >= PARALLEL_SORT_MIN_EVENTS)
+    Kernel::TaskRuntime::execute([&events, &compare]() {
+      tbb::parallel_sort(events.begin(), events.end(), compare);
+    });
+  else if (numEvents * sizeof(TofEvent) >= RADIX_SORT_MIN_EVENTS * sizeof(T))
+    radixSort(events);
+  else
+    std::sort(events.begin(), events.end(), compare);
+}
+
+/// Output of the split helpers that copies each event to the event list of
+/// its group
+class CopyToEventLists {
+public:
+  explicit CopyToEventLists(std::map<int, EventList *> &outputs)
+      : m_outputs(outputs) {}
+  /// Returns false if there is no output list for the group
+  template <typename T> bool operator()(int group, const T &event, size_t) {
+    EventList *output = m_outputs[group];
+    if (!output)
+      return false;
+    output->addEventQuickly(event);
+    return true;
+  }
+
+private:
+  std::map<int, EventList *> &m_outputs;
+};
+
+/// Output of the split helpers that records the index of each event in the
+/// ranges of its group, merging consecutive indices into one range
+class RecordEventRanges {
+public:
+  explicit RecordEventRanges(std::map<int, EventIndexRanges> &outputs)
+      : m_outputs(outputs) {}
+  /// Returns false if there are no output ranges for the group
+  template <typename T> bool operator()(int group, const T &, size_t index) {
+    auto output = m_outputs.find(group);
+    if (output == m_outputs.end())
+      return false;
+    auto &ranges = output->second;
+    if (!ranges.empty() && ranges.back().second == index)
+      ++ranges.back().second;
+    else
+      ranges.emplace_back(index, index + 1);
+    return true;
+  }
+
+private:
+  std::map<int, EventIndexRanges> &m_outputs;
+};
+
+/**
+ * Append the events in index ranges of one vector to another.
+ * @param events : The vector to append to
+ * @param source : The vector holding the events
+ * @param ranges : Ranges [begin, end) of indices into source
+ */
+template <typename T1, typename T2>
+void appendRanges(std::vector<T1> &events, const std::vector<T2> &source,
+                  const EventIndexRanges &ranges) {
+  events.reserve(events.size() + numberOfEvents(ranges));
+  for (const auto &range : ranges)
+    events.insert(events.end(), source.begin() + range.first,
+                  source.begin() + range.second);
+}
+
+/**
+ * Histogram the events in index ranges of a vector, which need not be sorted
+ * by TOF.
+ * @param events : The vector holding the events
+ * @param ranges : Ranges [begin, end) of indices into events
+ * @param X : The bin boundaries
+ * @param Y : Sum of the weights in each bin
+ * @param E2 : Sum of the squared errors in each bin
+ */
+template <typename T>
+void histogramRanges(const std::vector<T> &events,
+                     const EventIndexRanges &ranges, const MantidVec &X,
+                     MantidVec &Y, MantidVec &E2) {
+  for (const auto &range : ranges) {
+    for (size_t i = range.first; i < range.second; ++i) {
+      const T &event = events[i];
+      const double tof = event.tof();
+      if (tof < X.front() || tof >= X.back())
+        continue;
+      const auto bin = static_cast<size_t>(
+          std::upper_bound(X.begin(), X.end(), tof) - X.begin() - 1);
+      Y[bin] += event.weight();
+      E2[bin] += event.errorSquared();
+    }
+  }
+}
 }
 //==========================================================================
 /// --------------------- TofEvent Comparators
@@ -119,6 +247,29 @@ bool compareEventPulseTimeTOF(const TofEvent &e1, const TofEvent &e2) {
   return false;
 }
 
+/** Radix sort events by TOF
+ * @param events :: the events to sort
+ *  */
+template <typename T> void radixSortTof(std::vector<T> &events) {
+  Kernel::radixSort(events, tofKey<T>);
+}
+
+/** Radix sort events by pulse time
+ * @param events :: the events to sort
+ *  */
+template <typename T> void radixSortPulseTime(std::vector<T> &events) {
+  Kernel::radixSort(events, pulseTimeKey<T>);
+}
+
+/** Radix sort events by pulse time, then TOF. As the sort is stable, sorting
+ * by TOF and then by pulse time leaves events of the same pulse in TOF order.
+ * @param events :: the events to sort
+ *  */
+template <typename T> void radixSortPulseTimeTof(std::vector<T> &events) {
+  Kernel::radixSort(events, tofKey<T>);
+  Kernel::radixSort(events, pulseTimeKey<T>);
+}
+
 /// Constructor (empty)
 // EventWorkspace is always histogram data and so is thus EventList
 EventList::EventList()
@@ -971,7 +1122,7 @@ void EventList::setSortOrder(const EventSortType order) const {
 //  }
 
 // --------------------------------------------------------------------------
-/** Sort events by TOF in one thread */
+/** Sort events by TOF */
 void EventList::sortTof() const {
   if (this->order == TOF_SORT)
     return; // nothing to do
@@ -984,15 +1135,15 @@ void EventList::sortTof() const {
 
   switch (eventType) {
   case TOF:
-    tbb::parallel_sort(events.begin(), events.end(), compareEventTof<TofEvent>);
+    sortEvents(events, compareEventTof<TofEvent>, radixSortTof<TofEvent>);
     break;
   case WEIGHTED:
-    tbb::parallel_sort(weightedEvents.begin(), weightedEvents.end(),
-                       compareEventTof<WeightedEvent>);
+    sortEvents(weightedEvents, compareEventTof<WeightedEvent>,
+               radixSortTof<WeightedEvent>);
     break;
   case WEIGHTED_NOTIME:
-    tbb::parallel_sort(weightedEventsNoTime.begin(), weightedEventsNoTime.end(),
-                       compareEventTof<WeightedEventNoTime>);
+    sortEvents(weightedEventsNoTime, compareEventTof<WeightedEventNoTime>,
+               radixSortTof<WeightedEventNoTime>);
     break;
   }
   // Save the order to avoid unnecessary re-sorting.
@@ -1022,22 +1173,24 @@ void EventList::sortTimeAtSample(const double &tofFactor,
     return;
 
   // Perform sort.
-  switch (eventType) {
-  case TOF: {
-    CompareTimeAtSample<TofEvent> comparitor(tofFactor, tofShift);
-    tbb::parallel_sort(events.begin(), events.end(), comparitor);
-  } break;
-  case WEIGHTED: {
-    CompareTimeAtSample<WeightedEvent> comparitor(tofFactor, tofShift);
-    tbb::parallel_sort(weightedEvents.begin(), weightedEvents.end(),
-                       comparitor);
-  } break;
-  case WEIGHTED_NOTIME: {
-    CompareTimeAtSample<WeightedEventNoTime> comparitor(tofFactor, tofShift);
-    tbb::parallel_sort(weightedEventsNoTime.begin(), weightedEventsNoTime.end(),
-                       comparitor);
-  } break;
-  }
+  Kernel::TaskRuntime::execute([this, tofFactor, tofShift]() {
+    switch (eventType) {
+    case TOF: {
+      CompareTimeAtSample<TofEvent> comparitor(tofFactor, tofShift);
+      tbb::parallel_sort(events.begin(), events.end(), comparitor);
+    } break;
+    case WEIGHTED: {
+      CompareTimeAtSample<WeightedEvent> comparitor(tofFactor, tofShift);
+      tbb::parallel_sort(weightedEvents.begin(), weightedEvents.end(),
+                         comparitor);
+    } break;
+    case WEIGHTED_NOTIME: {
+      CompareTimeAtSample<WeightedEventNoTime> comparitor(tofFactor, tofShift);
+      tbb::parallel_sort(weightedEventsNoTime.begin(),
+                         weightedEventsNoTime.end(), comparitor);
+    } break;
+    }
+  });
   // Save the order to avoid unnecessary re-sorting.
   this->order = TIMEATSAMPLE_SORT;
 }
@@ -1057,11 +1210,11 @@ void EventList::sortPulseTime() const {
   // Perform sort.
   switch (eventType) {
   case TOF:
-    tbb::parallel_sort(events.begin(), events.end(), compareEventPulseTime);
+    sortEvents(events, compareEventPulseTime, radixSortPulseTime<TofEvent>);
     break;
   case WEIGHTED:
-    tbb::parallel_sort(weightedEvents.begin(), weightedEvents.end(),
-                       compareEventPulseTime);
+    sortEvents(weightedEvents, compareEventPulseTime,
+               radixSortPulseTime<WeightedEvent>);
     break;
   case WEIGHTED_NOTIME:
     // Do nothing; there is no time to sort
@@ -1087,11 +1240,12 @@ void EventList::sortPulseTimeTOF() const {
 
   switch (eventType) {
   case TOF:
-    tbb::parallel_sort(events.begin(), events.end(), compareEventPulseTimeTOF);
+    sortEvents(events, compareEventPulseTimeTOF,
+               radixSortPulseTimeTof<TofEvent>);
     break;
   case WEIGHTED:
-    tbb::parallel_sort(weightedEvents.begin(), weightedEvents.end(),
-                       compareEventPulseTimeTOF);
+    sortEvents(weightedEvents, compareEventPulseTimeTOF,
+               radixSortPulseTimeTof<WeightedEvent>);
     break;
   case WEIGHTED_NOTIME:
     // Do nothing; there is no time to sort
@@ -3879,10 +4033,10 @@ void EventList::splitByTime(Kernel::TimeSplitterType &splitter,
  * @param tofshift :: amount to shift (in SECOND) to correct TOF in formula:
  *toffactor*tof+tofshift
  */
-template <class T>
+template <class T, class Sink>
 void EventList::splitByFullTimeHelper(Kernel::TimeSplitterType &splitter,
-                                      std::map<int, EventList *> outputs,
-                                      typename std::vector<T> &events,
+                                      Sink &outputs,
+                                      const std::vector<T> &events,
                                       bool docorrection, double toffactor,
                                       double tofshift) const {
   // 1. Prepare to Iterate through the splitter at the same time
@@ -3902,7 +4056,6 @@ void EventList::splitByFullTimeHelper(Kernel::TimeSplitterType &splitter,
 
     // a) Skip the events before the start of the time
     // TODO This step can be
-    EventList *myOutput = outputs[-1];
     while (itev != itev_end) {
       int64_t fulltime;
       if (docorrection)
@@ -3912,8 +4065,7 @@ void EventList::splitByFullTimeHelper(Kernel::TimeSplitterType &splitter,
                    static_cast<int64_t>(itev->m_tof * 1000);
       if (fulltime < start) {
         // a1) Record to index = -1 space
-        const T eventCopy(*itev);
-        myOutput->addEventQuickly(eventCopy);
+        outputs(-1, *itev, static_cast<size_t>(itev - events.begin()));
         itev++;
       } else {
         break;
@@ -3932,10 +4084,7 @@ void EventList::splitByFullTimeHelper(Kernel::TimeSplitterType &splitter,
                    static_cast<int64_t>(itev->m_tof * 1000);
       if (fulltime < stop) {
         // b1) Copy the event into another
-        const T eventCopy(*itev);
-        EventList *myOutput = outputs[index];
-        // Add the copy to the output
-        myOutput->addEventQuickly(eventCopy);
+        outputs(index, *itev, static_cast<size_t>(itev - events.begin()));
         ++itev;
       } else {
         break;
@@ -3995,13 +4144,14 @@ void EventList::splitByFullTime(Kernel::TimeSplitterType &splitter,
     // this->duplicate(outputs[-1]);
   } else {
     // 3B. Split
+    CopyToEventLists copy(outputs);
     switch (eventType) {
     case TOF:
-      splitByFullTimeHelper(splitter, outputs, this->events, docorrection,
+      splitByFullTimeHelper(splitter, copy, this->events, docorrection,
                             toffactor, tofshift);
       break;
     case WEIGHTED:
-      splitByFullTimeHelper(splitter, outputs, this->weightedEvents,
+      splitByFullTimeHelper(splitter, copy, this->weightedEvents,
                             docorrection, toffactor, tofshift);
       break;
     case WEIGHTED_NOTIME:
@@ -4030,14 +4180,14 @@ void EventList::splitByFullTime(Kernel::TimeSplitterType &splitter,
  * @param tofshift :: shift in SECOND to TOF for correcting event time from
  *detector to sample
  */
-template <class T>
+template <class T, class Sink>
 std::string EventList::splitByFullTimeVectorSplitterHelper(
     const std::vector<int64_t> &vectimes, const std::vector<int> &vecgroups,
-    std::map<int, EventList *> outputs, typename std::vector<T> &vecEvents,
-    bool docorrection, double toffactor, double tofshift) const {
+    Sink &outputs, const std::vector<T> &vecEvents, bool docorrection,
+    double toffactor, double tofshift) const {
   // Define variables for events
   // size_t numevents = events.size();
-  typename std::vector<T>::iterator eviter;
+  typename std::vector<T>::const_iterator eviter;
   std::stringstream msgss;
 
   // Loop through events
@@ -4067,15 +4217,12 @@ std::string EventList::splitByFullTimeVectorSplitterHelper(
     }
 
     // Copy event to the proper group
-    EventList *myOutput = outputs[group];
-    if (!myOutput) {
+    if (!outputs(group, *eviter,
+                 static_cast<size_t>(eviter - vecEvents.begin()))) {
       std::stringstream errss;
       errss << "Group " << group << " has a NULL output EventList. "
             << "\n";
       msgss << errss.str();
-    } else {
-      const T eventCopy(*eviter);
-      myOutput->addEventQuickly(eventCopy);
     }
   }
 
@@ -4102,11 +4249,11 @@ std::string EventList::splitByFullTimeVectorSplitterHelper(
  * @param tofshift :: shift in SECOND to TOF for correcting event time from
  *detector to sample
  */
-template <class T>
+template <class T, class Sink>
 std::string EventList::splitByFullTimeSparseVectorSplitterHelper(
     const std::vector<int64_t> &vectimes, const std::vector<int> &vecgroups,
-    std::map<int, EventList *> outputs, typename std::vector<T> &vecEvents,
-    bool docorrection, double toffactor, double tofshift) const {
+    Sink &outputs, const std::vector<T> &vecEvents, bool docorrection,
+    double toffactor, double tofshift) const {
   // Define variables for events
   // size_t numevents = events.size();
   // typename std::vector<T>::iterator eviter;
@@ -4151,11 +4298,9 @@ std::string EventList::splitByFullTimeSparseVectorSplitterHelper(
       }
 
       if (absolute_time < stop_i64) {
-        // in the splitter, then copy the event into another
-        const T eventCopy(*iter_events);
-        // Copy event to the proper group
-        EventList *myOutput = outputs[group];
-        if (!myOutput) {
+        // in the splitter, then copy the event into the proper group
+        if (!outputs(group, *iter_events,
+                     static_cast<size_t>(iter_events - vecEvents.begin()))) {
           // there is no such group defined. quit for this group
           std::stringstream errss;
           errss << "Group " << group << " has a NULL output EventList. "
@@ -4163,8 +4308,6 @@ std::string EventList::splitByFullTimeSparseVectorSplitterHelper(
           msgss << errss.str();
           throw std::runtime_error(errss.str());
         }
-        // Add the copy to the output
-        myOutput->addEventQuickly(eventCopy);
         ++iter_events;
       } else {
         // event occurs after the stop time, it should belonged to the next
@@ -4236,26 +4379,27 @@ std::string EventList::splitByFullTimeMatrixSplitter(
     // splitters and number of events
     bool sparse_splitter = vec_splitters_time.size() < this->getNumberEvents();
 
+    CopyToEventLists copy(vec_outputEventList);
     switch (eventType) {
     case TOF:
       if (sparse_splitter)
         debugmessage = splitByFullTimeSparseVectorSplitterHelper(
-            vec_splitters_time, vecgroups, vec_outputEventList, this->events,
-            docorrection, toffactor, tofshift);
+            vec_splitters_time, vecgroups, copy, this->events, docorrection,
+            toffactor, tofshift);
       else
         debugmessage = splitByFullTimeVectorSplitterHelper(
-            vec_splitters_time, vecgroups, vec_outputEventList, this->events,
-            docorrection, toffactor, tofshift);
+            vec_splitters_time, vecgroups, copy, this->events, docorrection,
+            toffactor, tofshift);
       break;
     case WEIGHTED:
       if (sparse_splitter)
         debugmessage = splitByFullTimeSparseVectorSplitterHelper(
-            vec_splitters_time, vecgroups, vec_outputEventList,
-            this->weightedEvents, docorrection, toffactor, tofshift);
+            vec_splitters_time, vecgroups, copy, this->weightedEvents,
+            docorrection, toffactor, tofshift);
       else
         debugmessage = splitByFullTimeVectorSplitterHelper(
-            vec_splitters_time, vecgroups, vec_outputEventList,
-            this->weightedEvents, docorrection, toffactor, tofshift);
+            vec_splitters_time, vecgroups, copy, this->weightedEvents,
+            docorrection, toffactor, tofshift);
       break;
     case WEIGHTED_NOTIME:
       debugmessage = "TOF type is weighted no time.  Impossible to split. ";
@@ -4270,10 +4414,10 @@ std::string EventList::splitByFullTimeMatrixSplitter(
 //--------------------------------------------------
 /** Split the event list into n outputs by each event's pulse time only
  */
-template <class T>
+template <class T, class Sink>
 void EventList::splitByPulseTimeHelper(Kernel::TimeSplitterType &splitter,
-                                       std::map<int, EventList *> outputs,
-                                       typename std::vector<T> &events) const {
+                                       Sink &outputs,
+                                       const std::vector<T> &events) const {
   // Prepare to TimeSplitter Iterate through the splitter at the same time
   auto itspl = splitter.begin();
   auto itspl_end = splitter.end();
@@ -4292,12 +4436,10 @@ void EventList::splitByPulseTimeHelper(Kernel::TimeSplitterType &splitter,
 
     // Skip the events before the start of the time and put to 'unfiltered'
     // EventList
-    EventList *myOutput = outputs[-1];
     while (itev != itev_end) {
       if (itev->m_pulsetime < start) {
         // Record to index = -1 space
-        const T eventCopy(*itev);
-        myOutput->addEventQuickly(eventCopy);
+        outputs(-1, *itev, static_cast<size_t>(itev - events.begin()));
         ++itev;
       } else {
         // Event within a splitter interval
@@ -4310,10 +4452,7 @@ void EventList::splitByPulseTimeHelper(Kernel::TimeSplitterType &splitter,
 
       if (itev->m_pulsetime < stop) {
         // Duplicate event
-        const T eventCopy(*itev);
-        EventList *myOutput = outputs[index];
-        // Add the copy to the output
-        myOutput->addEventQuickly(eventCopy);
+        outputs(index, *itev, static_cast<size_t>(itev - events.begin()));
         ++itev;
       } else {
         // Out of interval
@@ -4363,12 +4502,13 @@ void EventList::splitByPulseTime(Kernel::TimeSplitterType &splitter,
     (*outputs[-1]) = (*this);
   } else {
     // Split
+    CopyToEventLists copy(outputs);
     switch (eventType) {
     case TOF:
-      splitByPulseTimeHelper(splitter, outputs, this->events);
+      splitByPulseTimeHelper(splitter, copy, this->events);
       break;
     case WEIGHTED:
-      splitByPulseTimeHelper(splitter, outputs, this->weightedEvents);
+      splitByPulseTimeHelper(splitter, copy, this->weightedEvents);
       break;
     case WEIGHTED_NOTIME:
       break;
@@ -4481,6 +4621,213 @@ void EventList::splitByPulseTimeWithMatrixHelper(
   } // END-WHILE Splitter
 }
 
+//----------------------------------------------------------------------------------------------
+/** Find the events that splitByFullTime() would copy to each output, without
+ * copying them. The events of each output are given as ranges of indices into
+ * this list, which is sorted by pulse time and TOF first.
+ *
+ * @param splitter :: a TimeSplitterType giving where the events go
+ * @param outputs :: a map from output index to the index ranges of its events.
+ *        Groups that are not in the map are ignored.
+ * @param docorrection :: a boolean to indiciate whether it is need to do
+ *correction
+ * @param toffactor:  a correction factor for each TOF to multiply with
+ * @param tofshift:  a correction shift for each TOF to add with
+ */
+void EventList::splitRangesByFullTime(Kernel::TimeSplitterType &splitter,
+                                      std::map<int, EventIndexRanges> &outputs,
+                                      bool docorrection, double toffactor,
+                                      double tofshift) const {
+  if (eventType == WEIGHTED_NOTIME)
+    throw std::runtime_error("EventList::splitByTime() called on an EventList "
+                             "that no longer has time information.");
+
+  this->sortPulseTimeTOF();
+  for (auto &output : outputs)
+    output.second.clear();
+
+  if (splitter.empty()) {
+    auto unfiltered = outputs.find(-1);
+    if (unfiltered != outputs.end() && this->getNumberEvents() > 0)
+      unfiltered->second.emplace_back(0, this->getNumberEvents());
+  } else {
+    RecordEventRanges record(outputs);
+    if (eventType == TOF)
+      splitByFullTimeHelper(splitter, record, this->events, docorrection,
+                            toffactor, tofshift);
+    else
+      splitByFullTimeHelper(splitter, record, this->weightedEvents,
+                            docorrection, toffactor, tofshift);
+  }
+}
+
+//----------------------------------------------------------------------------------------------
+/** Find the events that splitByFullTimeMatrixSplitter() would copy to each
+ * output, without copying them. The events of each output are given as ranges
+ * of indices into this list, which is sorted by pulse time and TOF first.
+ *
+ * @param vec_splitters_time :: vector of splitting times
+ * @param vecgroups :: vector of index group for splitters
+ * @param outputs :: a map from output index to the index ranges of its events
+ * @param docorrection :: flag to do TOF correction from detector to sample
+ * @param toffactor :: factor multiplied to TOF for correction
+ * @param tofshift :: shift to TOF in unit of SECOND for correction
+ * @return debug message of the split helper
+ */
+std::string EventList::splitRangesByFullTimeMatrixSplitter(
+    const std::vector<int64_t> &vec_splitters_time,
+    const std::vector<int> &vecgroups,
+    std::map<int, EventIndexRanges> &outputs, bool docorrection,
+    double toffactor, double tofshift) const {
+  if (eventType == WEIGHTED_NOTIME)
+    throw std::runtime_error("EventList::splitByTime() called on an EventList "
+                             "that no longer has time information.");
+
+  sortPulseTimeTOF();
+  for (auto &output : outputs)
+    output.second.clear();
+
+  std::string debugmessage;
+  if (vecgroups.empty()) {
+    auto unfiltered = outputs.find(-1);
+    if (unfiltered != outputs.end() && this->getNumberEvents() > 0)
+      unfiltered->second.emplace_back(0, this->getNumberEvents());
+    return debugmessage;
+  }
+
+  const bool sparse_splitter =
+      vec_splitters_time.size() < this->getNumberEvents();
+  RecordEventRanges record(outputs);
+  if (eventType == TOF) {
+    if (sparse_splitter)
+      debugmessage = splitByFullTimeSparseVectorSplitterHelper(
+          vec_splitters_time, vecgroups, record, this->events, docorrection,
+          toffactor, tofshift);
+    else
+      debugmessage = splitByFullTimeVectorSplitterHelper(
+          vec_splitters_time, vecgroups, record, this->events, docorrection,
+          toffactor, tofshift);
+  } else {
+    if (sparse_splitter)
+      debugmessage = splitByFullTimeSparseVectorSplitterHelper(
+          vec_splitters_time, vecgroups, record, this->weightedEvents,
+          docorrection, toffactor, tofshift);
+    else
+      debugmessage = splitByFullTimeVectorSplitterHelper(
+          vec_splitters_time, vecgroups, record, this->weightedEvents,
+          docorrection, toffactor, tofshift);
+  }
+  return debugmessage;
+}
+
+//----------------------------------------------------------------------------------------------
+/** Find the events that splitByPulseTime() would copy to each output, without
+ * copying them. The events of each output are given as ranges of indices into
+ * this list, which is sorted by pulse time and TOF first.
+ *
+ * @param splitter :: a TimeSplitterType giving where the events go
+ * @param outputs :: a map from output index to the index ranges of its events
+ */
+void EventList::splitRangesByPulseTime(
+    Kernel::TimeSplitterType &splitter,
+    std::map<int, EventIndexRanges> &outputs) const {
+  if (eventType == WEIGHTED_NOTIME)
+    throw std::runtime_error("EventList::splitByTime() called on an EventList "
+                             "that no longer has time information.");
+
+  this->sortPulseTimeTOF();
+  for (auto &output : outputs)
+    output.second.clear();
+
+  if (splitter.empty()) {
+    auto unfiltered = outputs.find(-1);
+    if (unfiltered != outputs.end() && this->getNumberEvents() > 0)
+      unfiltered->second.emplace_back(0, this->getNumberEvents());
+  } else {
+    RecordEventRanges record(outputs);
+    if (eventType == TOF)
+      splitByPulseTimeHelper(splitter, record, this->events);
+    else
+      splitByPulseTimeHelper(splitter, record, this->weightedEvents);
+  }
+}
+
+//----------------------------------------------------------------------------------------------
+/** Append the events in index ranges of another list to this one. The event
+ * type of this list is raised to that of the source if needed. Detector IDs
+ * and the sort order are left to the caller.
+ *
+ * @param source :: the list holding the events
+ * @param ranges :: ranges [begin, end) of indices into the source
+ */
+void EventList::appendEventRanges(const EventList &source,
+                                  const EventIndexRanges &ranges) {
+  if (ranges.empty())
+    return;
+  this->switchTo(std::max(this->getEventType(), source.getEventType()));
+
+  switch (this->getEventType()) {
+  case TOF:
+    appendRanges(this->events, source.events, ranges);
+    break;
+  case WEIGHTED:
+    if (source.getEventType() == TOF)
+      appendRanges(this->weightedEvents, source.events, ranges);
+    else
+      appendRanges(this->weightedEvents, source.weightedEvents, ranges);
+    break;
+  case WEIGHTED_NOTIME:
+    if (source.getEventType() == TOF)
+      appendRanges(this->weightedEventsNoTime, source.events, ranges);
+    else if (source.getEventType() == WEIGHTED)
+      appendRanges(this->weightedEventsNoTime, source.weightedEvents, ranges);
+    else
+      appendRanges(this->weightedEventsNoTime, source.weightedEventsNoTime,
+                   ranges);
+    break;
+  }
+  this->order = UNSORTED;
+}
+
+//----------------------------------------------------------------------------------------------
+/** Histogram the events in index ranges of this list, without copying them
+ *into a list of their own.
+ *
+ * @param ranges :: ranges [begin, end) of indices of the events
+ * @param X :: The x bins
+ * @param Y :: The generated counts histogram
+ * @param E :: The generated error histogram
+ * @param skipError :: skip calculating the error
+ */
+void EventList::generateHistogramForRanges(const EventIndexRanges &ranges,
+                                           const MantidVec &X, MantidVec &Y,
+                                           MantidVec &E, bool skipError) const {
+  if (X.size() <= 1) {
+    Y.clear();
+    E.clear();
+    return;
+  }
+  Y.assign(X.size() - 1, 0.0);
+  E.assign(X.size() - 1, 0.0);
+
+  switch (eventType) {
+  case TOF:
+    histogramRanges(this->events, ranges, X, Y, E);
+    break;
+  case WEIGHTED:
+    histogramRanges(this->weightedEvents, ranges, X, Y, E);
+    break;
+  case WEIGHTED_NOTIME:
+    histogramRanges(this->weightedEventsNoTime, ranges, X, Y, E);
+    break;
+  }
+
+  if (skipError)
+    return;
+  std::transform(E.begin(), E.end(), E.begin(),
+                 static_cast<double (*)(double)>(sqrt));
+}
+
 //--------------------------------------------------------------------------
 /** Get the vector of events contained in an EventList;
  * this is overloaded by event type.
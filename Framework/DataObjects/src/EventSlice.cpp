@@ -0,0 +1,93 @@
+#include "MantidDataObjects/EventSlice.h"
+#include "MantidDataObjects/EventWorkspace.h"
+
+#include <stdexcept>
+#include <utility>
+
+namespace Mantid {
+namespace DataObjects {
+
+/** Constructor
+ * @param parent :: the workspace holding the events. It must not be changed
+ * while the slice refers to it.
+ * @param ranges :: index ranges of the events of each list in the list with
+ * the same index in the parent
+ * @throw std::invalid_argument if the number of lists does not match
+ */
+EventSlice::EventSlice(boost::shared_ptr<const EventWorkspace> parent,
+                       std::vector<EventIndexRanges> ranges)
+    : m_parent(std::move(parent)), m_ranges(std::move(ranges)),
+      m_materialized(new std::atomic<bool>[m_ranges.size()]) {
+  if (!m_parent || m_parent->getNumberHistograms() != m_ranges.size())
+    throw std::invalid_argument("EventSlice: the number of index ranges does "
+                                "not match the parent workspace");
+  for (size_t i = 0; i < m_ranges.size(); ++i)
+    m_materialized[i] = false;
+}
+
+/** Copy constructor. The copy refers to the same parent.
+ * @param other :: the slice to copy
+ */
+EventSlice::EventSlice(const EventSlice &other)
+    : m_parent(other.m_parent), m_ranges(other.m_ranges),
+      m_materialized(new std::atomic<bool>[m_ranges.size()]) {
+  for (size_t i = 0; i < m_ranges.size(); ++i)
+    m_materialized[i] = other.m_materialized[i].load();
+}
+
+/** @param index :: index of the list
+ * @return true if the events of the list have been copied from the parent
+ */
+bool EventSlice::isMaterialized(const size_t index) const {
+  return m_materialized[index];
+}
+
+/** Copy the events of a list from the parent, unless that was done before.
+ * The list keeps the event type and sort order set by
+ * EventWorkspace::setSliceOf().
+ * @param index :: index of the list
+ * @param eventList :: the list of the slice with this index
+ */
+void EventSlice::materialize(const size_t index, EventList &eventList) {
+  if (m_materialized[index])
+    return;
+  std::lock_guard<std::mutex> lock(m_locks[index % NumLocks]);
+  if (m_materialized[index])
+    return;
+  const EventList &source = m_parent->getSpectrum(index);
+  eventList.appendEventRanges(source, m_ranges[index]);
+  eventList.setSortOrder(source.getSortType());
+  m_materialized[index] = true;
+}
+
+/** @param index :: index of the list
+ * @return the number of events of the list
+ */
+size_t EventSlice::getNumberEvents(const size_t index) const {
+  return numberOfEvents(m_ranges[index]);
+}
+
+/** Histogram the events of a list from the parent's events
+ * @param index :: index of the list
+ * @param X :: The x bins
+ * @param Y :: The generated counts histogram
+ * @param E :: The generated error histogram
+ * @param skipError :: skip calculating the error
+ */
+void EventSlice::generateHistogram(const size_t index, const MantidVec &X,
+                                   MantidVec &Y, MantidVec &E,
+                                   bool skipError) const {
+  m_parent->getSpectrum(index).generateHistogramForRanges(m_ranges[index], X,
+                                                          Y, E, skipError);
+}
+
+/** Append the events of a list from the parent's events to another list
+ * @param index :: index of the list
+ * @param output :: the list to append to
+ */
+void EventSlice::addEventsTo(const size_t index, EventList &output) const {
+  output.appendEventRanges(m_parent->getSpectrum(index), m_ranges[index]);
+}
+
+} // namespace DataObjects
+} // namespace Mantid
@@ -6,6 +6,7 @@
 #include "MantidAPI/SpectraAxis.h"
 #include "MantidAPI/SpectrumInfo.h"
 #include "MantidAPI/WorkspaceFactory.h"
+#include "MantidDataObjects/EventSlice.h"
 #include "MantidDataObjects/EventWorkspaceMRU.h"
 #include "MantidGeometry/IDetector.h"
 #include "MantidGeometry/Instrument.h"
@@ -15,10 +16,13 @@
 #include "MantidKernel/FunctionTask.h"
 #include "MantidKernel/IPropertyManager.h"
 #include "MantidKernel/MultiThreaded.h"
+#include "MantidKernel/TaskRuntime.h"
 #include "MantidKernel/TimeSeriesProperty.h"
+#include "MantidKernel/make_unique.h"
 
 #include "MantidAPI/Algorithm.tcc"
 #include "tbb/parallel_for.h"
+#include <algorithm>
 #include <limits>
 #include <numeric>
 
@@ -31,6 +35,8 @@ namespace DataObjects {
 namespace {
 // static logger
 Kernel::Logger g_log("EventWorkspace");
+/// Fewest events sortAll() gives to one task
+const size_t MIN_EVENTS_PER_SORT_BATCH = 100000;
 } // namespace
 
 DECLARE_WORKSPACE(EventWorkspace)
@@ -44,6 +50,9 @@ EventWorkspace::EventWorkspace(const Parallel::StorageMode storageMode)
 
 EventWorkspace::EventWorkspace(const EventWorkspace &other)
     : IEventWorkspace(other), mru(new EventWorkspaceMRU) {
+  // A copy of a slice shares the events of the same parent
+  if (other.m_slice)
+    m_slice = Kernel::make_unique<EventSlice>(*other.m_slice);
   for (const auto &el : other.data) {
     // Create a new event list, copying over the events
     auto newel = new EventList(*el);
@@ -173,6 +182,8 @@ const EventList &EventWorkspace::getSpectrum(const size_t index) const {
   if (index >= data.size())
     throw std::range_error(
         "EventWorkspace::getSpectrum, workspace index out of range");
+  if (m_slice)
+    m_slice->materialize(index, *data[index]);
   return *data[index];
 }
 
@@ -387,12 +398,51 @@ void EventWorkspace::getEventXMinMax(double &xmin, double &xmax) const {
 /// The total number of events across all of the spectra.
 /// @returns The total number of events
 size_t EventWorkspace::getNumberEvents() const {
+  if (m_slice) {
+    size_t total = 0;
+    for (size_t i = 0; i < data.size(); ++i)
+      total += getNumberEvents(i);
+    return total;
+  }
   return std::accumulate(data.begin(), data.end(), size_t{0},
                          [](size_t total, EventList *list) {
                            return total + list->getNumberEvents();
                          });
 }
 
+/** The number of events in one spectrum. Unlike getSpectrum(), this does not
+ * copy the events of a slice.
+ * @param index :: the workspace index
+ * @returns The number of events in the spectrum
+ */
+size_t EventWorkspace::getNumberEvents(const std::size_t index) const {
+  if (index >= data.size())
+    throw std::range_error(
+        "EventWorkspace::getNumberEvents, workspace index out of range");
+  if (m_slice && !m_slice->isMaterialized(index))
+    return m_slice->getNumberEvents(index);
+  return data[index]->getNumberEvents();
+}
+
+/** Append the events of one spectrum to another event list, and add its
+ * detector IDs to those of the list. The events of a slice are copied from
+ * the parent directly.
+ * @param index :: the workspace index
+ * @param output :: the list to append to
+ */
+void EventWorkspace::addEventsTo(const std::size_t index,
+                                 EventList &output) const {
+  if (index >= data.size())
+    throw std::range_error(
+        "EventWorkspace::addEventsTo, workspace index out of range");
+  if (m_slice && !m_slice->isMaterialized(index)) {
+    m_slice->addEventsTo(index, output);
+    output.addDetectorIDs(data[index]->getDetectorIDs());
+    return;
+  }
+  output += getSpectrum(index);
+}
+
 /** Get the EventType of the most-specialized EventList in the workspace
  *
  * @return the EventType of the most-specialized EventList in the workspace
@@ -416,8 +466,8 @@ Mantid::API::EventType EventWorkspace::getEventType() const {
  * @param type :: EventType to switch to
  */
 void EventWorkspace::switchEventType(const Mantid::API::EventType type) {
-  for (auto &eventList : this->data)
-    eventList->switchTo(type);
+  for (size_t i = 0; i < data.size(); ++i)
+    getSpectrum(i).switchTo(type);
 }
 
 /// Returns true always - an EventWorkspace always represents histogramm-able
@@ -538,7 +588,12 @@ void EventWorkspace::generateHistogram(const std::size_t index,
   if (index >= data.size())
     throw std::range_error(
         "EventWorkspace::generateHistogram, histogram number out of range");
-  this->data[index]->generateHistogram(X, Y, E, skipError);
+  // Bin the events of a slice where they are rather than copying them
+  if (m_slice && !m_slice->isMaterialized(index)) {
+    m_slice->generateHistogram(index, X, Y, E, skipError);
+    return;
+  }
+  this->getSpectrum(index).generateHistogram(X, Y, E, skipError);
 }
 
 /** Using the event data in the event list, generate a histogram of it w.r.t
@@ -558,7 +613,7 @@ void EventWorkspace::generateHistogramPulseTime(const std::size_t index,
   if (index >= data.size())
     throw std::range_error("EventWorkspace::generateHistogramPulseTime, "
                            "histogram number out of range");
-  this->data[index]->generateHistogramPulseTime(X, Y, E, skipError);
+  this->getSpectrum(index).generateHistogramPulseTime(X, Y, E, skipError);
 }
 
 /*** Set all histogram X vectors.
@@ -575,22 +630,28 @@ void EventWorkspace::setAllX(const HistogramData::BinEdges &x) {
   this->clearMRU();
 }
 
-/** Task for sorting an event list */
+/** Task for sorting batches of event lists */
 class EventSortingTask {
 public:
   /// ctor
   EventSortingTask(const EventWorkspace *WS, EventSortType sortType,
+                   const std::vector<size_t> &batchStart,
                    Mantid::API::Progress *prog)
-      : m_sortType(sortType), m_WS(WS), prog(prog) {}
+      : m_sortType(sortType), m_WS(WS), m_batchStart(batchStart), prog(prog) {
+  }
 
-  // Execute the sort as specified.
+  // Execute the sort as specified, one batch after the other.
   void operator()(const tbb::blocked_range<size_t> &range) const {
-    for (size_t wi = range.begin(); wi < range.end(); ++wi) {
-      m_WS->getSpectrum(wi).sort(m_sortType);
+    for (size_t batch = range.begin(); batch < range.end(); ++batch) {
+      const size_t begin = m_batchStart[batch];
+      const size_t end = m_batchStart[batch + 1];
+      for (size_t wi = begin; wi < end; ++wi) {
+        m_WS->getSpectrum(wi).sort(m_sortType);
+      }
+      // Report progress
+      if (prog)
+        prog->reportIncrement(end - begin, "Sorting");
     }
-    // Report progress
-    if (prog)
-      prog->report("Sorting");
   }
 
 private:
@@ -598,6 +659,8 @@ private:
   EventSortType m_sortType;
   /// EventWorkspace on which to sort
   const EventWorkspace *m_WS;
+  /// Workspace index of the first list of each batch, and the end
+  const std::vector<size_t> &m_batchStart;
   /// Optional Progress dialog.
   Mantid::API::Progress *prog;
 };
@@ -618,8 +681,8 @@ EventSortType EventWorkspace::getSortType() const {
 
 /*** Sort all event lists. Uses a parallelized algorithm
  * @param sortType :: How to sort the event lists.
- * @param prog :: a progress report object. If the pointer is not NULL, each
- * event list will call prog.report() once.
+ * @param prog :: a progress report object. If the pointer is not NULL, the
+ * progress is incremented once for each event list.
  */
 void EventWorkspace::sortAll(EventSortType sortType,
                              Mantid::API::Progress *prog) const {
@@ -630,9 +693,29 @@ void EventWorkspace::sortAll(EventSortType sortType,
     return;
   }
 
-  // Create the thread pool, and optimize by doing the longest sorts first.
-  EventSortingTask task(this, sortType, prog);
-  tbb::parallel_for(tbb::blocked_range<size_t>(0, data.size()), task);
+  // Group the lists into batches holding similar numbers of events. Each
+  // batch is one task, so workspaces with many small lists do not pay for a
+  // task per list, and the work is balanced when list sizes differ.
+  const size_t numBatches = 8 * static_cast<size_t>(PARALLEL_GET_MAX_THREADS);
+  const size_t eventsPerBatch =
+      std::max(this->getNumberEvents() / numBatches, MIN_EVENTS_PER_SORT_BATCH);
+  std::vector<size_t> batchStart(1, 0);
+  size_t eventsInBatch = 0;
+  for (size_t wi = 0; wi < data.size(); ++wi) {
+    eventsInBatch += getNumberEvents(wi);
+    if (eventsInBatch >= eventsPerBatch) {
+      batchStart.push_back(wi + 1);
+      eventsInBatch = 0;
+    }
+  }
+  if (batchStart.back() != data.size())
+    batchStart.push_back(data.size());
+
+  EventSortingTask task(this, sortType, batchStart, prog);
+  Kernel::TaskRuntime::execute([&batchStart, &task]() {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, batchStart.size() - 1, 1),
+                      task);
+  });
 }
 
 /** Integrate all the spectra in the matrix workspace within the range given.
@@ -658,11 +741,43 @@ void EventWorkspace::getIntegratedSpectra(std::vector<double> &out,
   for (int wksp_index = 0; wksp_index < int(this->getNumberHistograms());
        wksp_index++) {
     // Get Handle to data
-    EventList *el = this->data[wksp_index];
+    const EventList &el = this->getSpectrum(wksp_index);
 
     // Let the eventList do the integration
-    out[wksp_index] = el->integrate(minX, maxX, entireRange);
+    out[wksp_index] = el.integrate(minX, maxX, entireRange);
+  }
+}
+
+/** Refer to a subset of the events of another workspace rather than holding
+ * copies of them. The events of a list are copied from the parent when the list
+ * is first accessed through getSpectrum(); getNumberEvents(), addEventsTo() and
+ * generateHistogram() use the parent's events directly until then. Each list
+ * takes the event type and sort order of the parent's list. The detector IDs
+ * and X values are left as they are.
+ *
+ * @param parent :: the workspace holding the events. It must have the same
+ * number of spectra and must not be changed while the slice refers to it.
+ * @param ranges :: index ranges of the events of each list in the parent's
+ * list with the same index
+ * @throw std::runtime_error if the workspace already has events
+ */
+void EventWorkspace::setSliceOf(boost::shared_ptr<const EventWorkspace> parent,
+                                std::vector<EventIndexRanges> ranges) {
+  if (getNumberEvents() > 0)
+    throw std::runtime_error(
+        "EventWorkspace::setSliceOf, the workspace already has events");
+  auto slice = Kernel::make_unique<EventSlice>(std::move(parent),
+                                               std::move(ranges));
+  if (slice->parent().getNumberHistograms() != data.size())
+    throw std::invalid_argument("EventWorkspace::setSliceOf, the parent has a "
+                                "different number of spectra");
+  for (size_t i = 0; i < data.size(); ++i) {
+    const EventList &source = slice->parent().getSpectrum(i);
+    data[i]->switchTo(source.getEventType());
+    data[i]->setSortOrder(source.getSortType());
   }
+  m_slice = std::move(slice);
+  clearMRU();
 }
 
 } // namespace DataObjects
@@ -25,35 +25,10 @@ Workspace2D::Workspace2D(const Parallel::StorageMode storageMode)
 
 Workspace2D::Workspace2D(const Workspace2D &other)
     : HistoWorkspace(other), m_noVectors(other.m_noVectors),
-      m_monitorList(other.m_monitorList) {
-  data.resize(m_noVectors);
-
-  for (size_t i = 0; i < m_noVectors; ++i) {
-    data[i] = new Histogram1D(*(other.data[i]));
-  }
-}
+      m_monitorList(other.m_monitorList), data(other.data) {}
 
 /// Destructor
-Workspace2D::~Workspace2D() {
-// On MSVC when you allocate memory in a multithreaded loop, like our cow_ptrs
-// will do, the
-// deallocation time increases by a huge amount if the memory is just
-// naively deallocated in a serial order. This is because when it was
-// allocated in the omp loop then the actual memory ends up being
-// interleaved and then trying to deallocate this serially leads to
-// lots of swapping in and out of memory. See
-// http://social.msdn.microsoft.com/Forums/en-US/2fe4cfc7-ca5c-4665-8026-42e0ba634214/visual-studio-$
-
-#ifdef _MSC_VER
-  PARALLEL_FOR_IF(Kernel::threadSafe(*this))
-  for (int64_t i = 0; i < static_cast<int64_t>(m_noVectors); i++) {
-#else
-  for (size_t i = 0; i < m_noVectors; ++i) {
-#endif
-    // Clear out the memory
-    delete data[i];
-  }
-}
+Workspace2D::~Workspace2D() = default;
 
 /**
  * Sets the size of the workspace and initializes arrays to zero
@@ -70,7 +45,8 @@ Workspace2D::~Workspace2D() {
 void Workspace2D::init(const std::size_t &NVectors, const std::size_t &XLength,
                        const std::size_t &YLength) {
   m_noVectors = NVectors;
-  data.resize(m_noVectors);
+  data.clear();
+  data.reserve(m_noVectors);
 
   auto x = Kernel::make_cow<HistogramData::HistogramX>(
       XLength, HistogramData::LinearGenerator(1.0, 1.0));
@@ -82,10 +58,10 @@ void Workspace2D::init(const std::size_t &NVectors, const std::size_t &XLength,
   spec.setCounts(y);
   spec.setCountStandardDeviations(e);
   for (size_t i = 0; i < m_noVectors; i++) {
-    data[i] = new Histogram1D(spec);
+    data.push_back(spec);
     // Default spectrum number = starts at 1, for workspace index 0.
-    data[i]->setSpectrumNo(specnum_t(i + 1));
-    data[i]->setDetectorID(detid_t(i + 1));
+    data[i].setSpectrumNo(specnum_t(i + 1));
+    data[i].setDetectorID(detid_t(i + 1));
   }
 
   // Add axes that reference the data
@@ -97,7 +73,8 @@ void Workspace2D::init(const std::size_t &NVectors, const std::size_t &XLength,
 void Workspace2D::init(const std::size_t &NVectors,
                        const HistogramData::Histogram &histogram) {
   m_noVectors = NVectors;
-  data.resize(m_noVectors);
+  data.clear();
+  data.reserve(m_noVectors);
 
   HistogramData::Histogram initializedHistogram(histogram);
   if (!histogram.sharedY()) {
@@ -114,10 +91,10 @@ void Workspace2D::init(const std::size_t &NVectors,
   Histogram1D spec(initializedHistogram.xMode(), initializedHistogram.yMode());
   spec.setHistogram(initializedHistogram);
   for (size_t i = 0; i < m_noVectors; i++) {
-    data[i] = new Histogram1D(spec);
+    data.push_back(spec);
     // Default spectrum number = starts at 1, for workspace index 0.
-    data[i]->setSpectrumNo(specnum_t(i + 1));
-    data[i]->setDetectorID(detid_t(i + 1));
+    data[i].setSpectrumNo(specnum_t(i + 1));
+    data[i].setDetectorID(detid_t(i + 1));
   }
 
   // Add axes that reference the data
@@ -139,7 +116,7 @@ size_t Workspace2D::size() const { return data.size() * blocksize(); }
 /// get the size of each vector
 size_t Workspace2D::blocksize() const {
   return (!data.empty())
-             ? static_cast<ISpectrum const *>(data[0])->dataY().size()
+             ? static_cast<const ISpectrum &>(data[0]).dataY().size()
              : 0;
 }
 
@@ -230,8 +207,8 @@ void Workspace2D::setImageYAndE(const API::MantidImage &imageY,
       auto pE = rowE.begin();
       for (auto pY = rowY.begin(); pY != rowY.end() && pE != rowE.end();
            ++pY, ++pE, ++spec) {
-        data[spec]->dataY()[0] = *pY;
-        data[spec]->dataE()[0] = *pE;
+        data[spec].dataY()[0] = *pY;
+        data[spec].dataE()[0] = *pE;
       }
     }
   } else {
@@ -258,18 +235,18 @@ void Workspace2D::setImageYAndE(const API::MantidImage &imageY,
 
       const auto &rowY = imageY[i];
       const auto &rowE = imageE[i];
-      data[i]->dataY() = rowY;
-      data[i]->dataE() = rowE;
+      data[i].dataY() = rowY;
+      data[i].dataE() = rowE;
     }
     // X values. Set first spectrum and copy/propagate that one to all the other
     // spectra
     PARALLEL_FOR_IF(parallelExecution)
     for (int i = 0; i < static_cast<int>(width) + 1; ++i) {
-      data[0]->dataX()[i] = i * scale_1;
+      data[0].dataX()[i] = i * scale_1;
     }
     PARALLEL_FOR_IF(parallelExecution)
     for (int i = 1; i < static_cast<int>(height); ++i) {
-      data[i]->setX(data[0]->ptrX());
+      data[i].setX(data[0].ptrX());
     }
   }
 }
@@ -291,7 +268,7 @@ const Histogram1D &Workspace2D::getSpectrum(const size_t index) const {
        << " out of range " << m_noVectors;
     throw std::range_error(ss.str());
   }
-  return *data[index];
+  return data[index];
 }
 
 //--------------------------------------------------------------------------------------------
@@ -226,7 +226,187 @@ public:
 
   void test_WriteFloatReadDouble() { this->WriteReadRead<float, double>(); }
 
+  void test_queued_blocks_are_read_back_before_and_after_writing() {
+    using Mantid::DataObjects::BoxControllerNeXusIO;
+
+    std::unique_ptr<BoxControllerNeXusIO> pSaver(createTestBoxController());
+    pSaver->setDataType(sizeof(float), "MDEvent");
+    TS_ASSERT_THROWS_NOTHING(pSaver->openFile(this->xxfFileName, "w"));
+    const std::string FullPathFile = pSaver->getFileName();
+    const size_t nColumns = pSaver->getNDataColums();
+
+    // Three adjacent blocks, saved out of order, and a separate one
+    const auto first = makeBlock(10, nColumns, 0.f);
+    const auto second = makeBlock(5, nColumns, 1000.f);
+    const auto third = makeBlock(20, nColumns, 2000.f);
+    const auto separate = makeBlock(7, nColumns, 3000.f);
+    TS_ASSERT_THROWS_NOTHING(pSaver->saveBlock(second, 10));
+    TS_ASSERT_THROWS_NOTHING(pSaver->saveBlock(separate, 100));
+    TS_ASSERT_THROWS_NOTHING(pSaver->saveBlock(first, 0));
+    TS_ASSERT_THROWS_NOTHING(pSaver->saveBlock(third, 15));
+
+    std::vector<float> toRead;
+    TS_ASSERT_THROWS_NOTHING(pSaver->loadBlock(toRead, 10, 5));
+    TS_ASSERT_EQUALS(toRead, second);
+    TS_ASSERT_THROWS_NOTHING(pSaver->loadBlock(toRead, 100, 7));
+    TS_ASSERT_EQUALS(toRead, separate);
+    // a part of a block
+    TS_ASSERT_THROWS_NOTHING(pSaver->loadBlock(toRead, 17, 3));
+    TS_ASSERT_EQUALS(toRead, std::vector<float>(third.begin() + 2 * nColumns,
+                                                third.begin() + 5 * nColumns));
+
+    // a block replacing a queued one
+    const auto replacement = makeBlock(5, nColumns, 4000.f);
+    TS_ASSERT_THROWS_NOTHING(pSaver->saveBlock(replacement, 10));
+    TS_ASSERT_THROWS_NOTHING(pSaver->flushData());
+    TS_ASSERT_THROWS_NOTHING(pSaver->loadBlock(toRead, 10, 5));
+    TS_ASSERT_EQUALS(toRead, replacement);
+    TS_ASSERT_THROWS_NOTHING(pSaver->closeFile());
+
+    // everything is in the file
+    TS_ASSERT_THROWS_NOTHING(pSaver->openFile(FullPathFile, "r"));
+    TS_ASSERT_THROWS_NOTHING(pSaver->loadBlock(toRead, 0, 35));
+    auto expected = first;
+    expected.insert(expected.end(), replacement.begin(), replacement.end());
+    expected.insert(expected.end(), third.begin(), third.end());
+    TS_ASSERT_EQUALS(toRead, expected);
+    TS_ASSERT_THROWS_NOTHING(pSaver->loadBlock(toRead, 100, 7));
+    TS_ASSERT_EQUALS(toRead, separate);
+    TS_ASSERT_THROWS_NOTHING(pSaver->closeFile());
+
+    pSaver.reset();
+    if (Poco::File(FullPathFile).exists())
+      Poco::File(FullPathFile).remove();
+  }
+
+  void test_prefetched_blocks_are_loaded() {
+    using Mantid::DataObjects::BoxControllerNeXusIO;
+
+    std::unique_ptr<BoxControllerNeXusIO> pSaver(createTestBoxController());
+    pSaver->setDataType(sizeof(float), "MDEvent");
+    TS_ASSERT_THROWS_NOTHING(pSaver->openFile(this->xxfFileName, "w"));
+    const std::string FullPathFile = pSaver->getFileName();
+    const size_t nColumns = pSaver->getNDataColums();
+    const auto block = makeBlock(30, nColumns, 0.f);
+    TS_ASSERT_THROWS_NOTHING(pSaver->saveBlock(block, 0));
+    TS_ASSERT_THROWS_NOTHING(pSaver->closeFile());
+
+    TS_ASSERT_THROWS_NOTHING(pSaver->openFile(FullPathFile, "r"));
+    TS_ASSERT_THROWS_NOTHING(pSaver->prefetchBlock(0, 10));
+    TS_ASSERT_THROWS_NOTHING(pSaver->prefetchBlock(10, 20));
+    // beyond the end of the file, ignored
+    TS_ASSERT_THROWS_NOTHING(pSaver->prefetchBlock(25, 10));
+    std::vector<float> toRead;
+    TS_ASSERT_THROWS_NOTHING(pSaver->loadBlock(toRead, 10, 20));
+    TS_ASSERT_EQUALS(toRead, std::vector<float>(block.begin() + 10 * nColumns,
+                                                block.end()));
+    TS_ASSERT_THROWS_NOTHING(pSaver->loadBlock(toRead, 0, 10));
+    TS_ASSERT_EQUALS(toRead, std::vector<float>(block.begin(),
+                                                block.begin() + 10 * nColumns));
+    TS_ASSERT_THROWS_NOTHING(pSaver->closeFile());
+
+    pSaver.reset();
+    if (Poco::File(FullPathFile).exists())
+      Poco::File(FullPathFile).remove();
+  }
+
+  void test_flushCache_and_destructor_write_the_queued_blocks() {
+    using Mantid::DataObjects::BoxControllerNeXusIO;
+
+    std::unique_ptr<BoxControllerNeXusIO> pSaver(createTestBoxController());
+    pSaver->setDataType(sizeof(float), "MDEvent");
+    TS_ASSERT_THROWS_NOTHING(pSaver->openFile(this->xxfFileName, "w"));
+    const std::string FullPathFile = pSaver->getFileName();
+    const size_t nColumns = pSaver->getNDataColums();
+    const auto first = makeBlock(10, nColumns, 0.f);
+    const auto second = makeBlock(10, nColumns, 1000.f);
+    TS_ASSERT_THROWS_NOTHING(pSaver->saveBlock(first, 0));
+    TS_ASSERT_THROWS_NOTHING(pSaver->flushCache());
+    TS_ASSERT_THROWS_NOTHING(pSaver->saveBlock(second, 10));
+    // the destructor closes the file
+    TS_ASSERT_THROWS_NOTHING(pSaver.reset());
+
+    pSaver.reset(createTestBoxController());
+    pSaver->setDataType(sizeof(float), "MDEvent");
+    TS_ASSERT_THROWS_NOTHING(pSaver->openFile(FullPathFile, "r"));
+    std::vector<float> toRead;
+    TS_ASSERT_THROWS_NOTHING(pSaver->loadBlock(toRead, 0, 20));
+    auto expected = first;
+    expected.insert(expected.end(), second.begin(), second.end());
+    TS_ASSERT_EQUALS(toRead, expected);
+    TS_ASSERT_THROWS_NOTHING(pSaver->closeFile());
+
+    pSaver.reset();
+    if (Poco::File(FullPathFile).exists())
+      Poco::File(FullPathFile).remove();
+  }
+
+  void test_a_failed_background_write_releases_the_file() {
+    using Mantid::DataObjects::BoxControllerNeXusIO;
+
+    std::unique_ptr<BoxControllerNeXusIO> pSaver(createTestBoxController());
+    pSaver->setDataType(sizeof(float), "MDEvent");
+    TS_ASSERT_THROWS_NOTHING(pSaver->openFile(this->xxfFileName, "w"));
+    const std::string FullPathFile = pSaver->getFileName();
+    const auto block = makeBlock(10, pSaver->getNDataColums(), 0.f);
+    TS_ASSERT_THROWS_NOTHING(pSaver->saveBlock(block, 0));
+    TS_ASSERT_THROWS_NOTHING(pSaver->closeFile());
+
+    // Writing to a file opened for reading fails on the I/O thread
+    pSaver.reset(createTestBoxController());
+    pSaver->setDataType(sizeof(float), "MDEvent");
+    TS_ASSERT_THROWS_NOTHING(pSaver->openFile(FullPathFile, "r"));
+    TS_ASSERT_THROWS_NOTHING(pSaver->saveBlock(block, 10));
+    TS_ASSERT_THROWS_ANYTHING(pSaver->closeFile());
+    TS_ASSERT(!pSaver->isOpened());
+
+    // The destructor only logs the failure
+    TS_ASSERT_THROWS_NOTHING(pSaver->openFile(FullPathFile, "r"));
+    TS_ASSERT_THROWS_NOTHING(pSaver->saveBlock(block, 10));
+    TS_ASSERT_THROWS_NOTHING(pSaver.reset());
+
+    if (Poco::File(FullPathFile).exists())
+      Poco::File(FullPathFile).remove();
+  }
+
+  void test_compressed_events_are_read_back() {
+    using Mantid::DataObjects::BoxControllerNeXusIO;
+
+    std::unique_ptr<BoxControllerNeXusIO> pSaver(createTestBoxController());
+    pSaver->setDataType(sizeof(double), "MDLeanEvent");
+    pSaver->setCompression(true);
+    TS_ASSERT(pSaver->getCompression());
+    TS_ASSERT_THROWS_NOTHING(pSaver->openFile(this->xxfFileName, "w"));
+    const std::string FullPathFile = pSaver->getFileName();
+    const size_t nColumns = pSaver->getNDataColums();
+    std::vector<double> toWrite(nColumns * 1000);
+    for (size_t i = 0; i < toWrite.size(); ++i) {
+      toWrite[i] = static_cast<double>(i % 17);
+    }
+    TS_ASSERT_THROWS_NOTHING(pSaver->saveBlock(toWrite, 0));
+    TS_ASSERT_THROWS_NOTHING(pSaver->closeFile());
+
+    TS_ASSERT_THROWS_NOTHING(pSaver->openFile(FullPathFile, "r"));
+    std::vector<double> toRead;
+    TS_ASSERT_THROWS_NOTHING(pSaver->loadBlock(toRead, 0, 1000));
+    TS_ASSERT_EQUALS(toRead, toWrite);
+    TS_ASSERT_THROWS_NOTHING(pSaver->closeFile());
+
+    pSaver.reset();
+    if (Poco::File(FullPathFile).exists())
+      Poco::File(FullPathFile).remove();
+  }
+
 private:
+  /// Create events data with distinct values
+  std::vector<float> makeBlock(size_t nEvents, size_t nColumns, float offset) {
+    std::vector<float> block(nEvents * nColumns);
+    for (size_t i = 0; i < block.size(); ++i) {
+      block[i] = offset + static_cast<float>(i);
+    }
+    return block;
+  }
+
   /// Create a test box controller. Ownership is passed to the caller
   Mantid::DataObjects::BoxControllerNeXusIO *createTestBoxController() {
     return new Mantid::DataObjects::BoxControllerNeXusIO(sc.get());
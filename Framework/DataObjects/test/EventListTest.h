@@ -1524,6 +1524,37 @@ public:
     }
   }
 
+  /// Lists this long are radix sorted rather than comparison sorted
+  void test_sorting_long_lists_all_types() {
+    // fake_data() reads the suite-wide count, so put it back afterwards
+    const int savedNumEvents = NUMEVENTS;
+    NUMEVENTS = 20000;
+    for (int this_type = 0; this_type < 3; this_type++) {
+      EventType curType = static_cast<EventType>(this_type);
+      EventList el = this->fake_data();
+      el.switchTo(curType);
+
+      el.sortTof();
+      TS_ASSERT_EQUALS(el.getNumberEvents(), NUMEVENTS);
+      for (size_t i = 1; i < el.getNumberEvents(); i++)
+        TSM_ASSERT_LESS_THAN_EQUALS(this_type, el.getEvent(i - 1).tof(),
+                                    el.getEvent(i).tof());
+
+      if (curType == WEIGHTED_NOTIME)
+        continue;
+      el.sortPulseTimeTOF();
+      TS_ASSERT_EQUALS(el.getNumberEvents(), NUMEVENTS);
+      for (size_t i = 1; i < el.getNumberEvents(); i++) {
+        TSM_ASSERT_LESS_THAN_EQUALS(this_type, el.getEvent(i - 1).pulseTime(),
+                                    el.getEvent(i).pulseTime());
+        if (el.getEvent(i - 1).pulseTime() == el.getEvent(i).pulseTime())
+          TSM_ASSERT_LESS_THAN_EQUALS(this_type, el.getEvent(i - 1).tof(),
+                                      el.getEvent(i).tof());
+      }
+    }
+    NUMEVENTS = savedNumEvents;
+  }
+
   //-----------------------------------------------------------------------------------------------
   void test_filterByPulseTime() {
     // Go through each possible EventType (except the no-time one) as the input
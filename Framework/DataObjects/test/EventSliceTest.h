@@ -0,0 +1,160 @@
+#ifndef MANTID_DATAOBJECTS_EVENTSLICETEST_H_
+#define MANTID_DATAOBJECTS_EVENTSLICETEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidDataObjects/EventSlice.h"
+#include "MantidDataObjects/EventWorkspace.h"
+#include "MantidDataObjects/WorkspaceCreation.h"
+#include "MantidKernel/TimeSplitter.h"
+#include "MantidTestHelpers/WorkspaceCreationHelper.h"
+
+using namespace Mantid::DataObjects;
+using Mantid::MantidVec;
+using Mantid::Kernel::DateAndTime;
+using Mantid::Kernel::TimeSplitterType;
+
+class EventSliceTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static EventSliceTest *createSuite() { return new EventSliceTest(); }
+  static void destroySuite(EventSliceTest *suite) { delete suite; }
+
+  void test_split_ranges_hold_the_events_copied_by_split() {
+    auto ws = WorkspaceCreationHelper::createEventWorkspace2(1, 100);
+    const EventList &el = ws->getSpectrum(0);
+    auto splitter = createSplitter();
+
+    EventList out0, out1;
+    el.splitByFullTime(splitter, {{0, &out0}, {1, &out1}}, false, 1.0, 0.0);
+    std::map<int, EventIndexRanges> ranges{{0, {}}, {1, {}}};
+    el.splitRangesByFullTime(splitter, ranges, false, 1.0, 0.0);
+
+    // The list is sorted by pulse time, so each interval is one range
+    TS_ASSERT_EQUALS(ranges[0].size(), 1);
+    TS_ASSERT_EQUALS(numberOfEvents(ranges[0]), 60);
+    TS_ASSERT_EQUALS(numberOfEvents(ranges[1]), 20);
+    EventList appended;
+    appended.appendEventRanges(el, ranges[0]);
+    TS_ASSERT_EQUALS(appended.getEvents(), out0.getEvents());
+    appended.clear();
+    appended.appendEventRanges(el, ranges[1]);
+    TS_ASSERT_EQUALS(appended.getEvents(), out1.getEvents());
+  }
+
+  void test_histogram_of_ranges_matches_histogram_of_copy() {
+    auto ws = WorkspaceCreationHelper::createEventWorkspace2(1, 100);
+    const EventList &el = ws->getSpectrum(0);
+    auto splitter = createSplitter();
+    EventList out0, out1;
+    el.splitByFullTime(splitter, {{0, &out0}, {1, &out1}}, false, 1.0, 0.0);
+    std::map<int, EventIndexRanges> ranges{{0, {}}, {1, {}}};
+    el.splitRangesByFullTime(splitter, ranges, false, 1.0, 0.0);
+
+    const MantidVec X{0.0, 10.0, 20.0, 50.0, 99.0};
+    MantidVec expectedY, expectedE, Y, E;
+    out0.generateHistogram(X, expectedY, expectedE);
+    el.generateHistogramForRanges(ranges[0], X, Y, E);
+    TS_ASSERT_EQUALS(Y, expectedY);
+    TS_ASSERT_EQUALS(E, expectedE);
+  }
+
+  void test_slice_counts_events_without_copying_them() {
+    auto parent = WorkspaceCreationHelper::createEventWorkspace2(3, 100);
+    auto slice = createSlice(parent, 0);
+
+    TS_ASSERT(slice->isSlice());
+    TS_ASSERT_EQUALS(slice->getNumberEvents(), 3 * 60);
+    TS_ASSERT_EQUALS(slice->getNumberEvents(1), 60);
+    TS_ASSERT_EQUALS(slice->getEventType(), parent->getEventType());
+
+    const MantidVec X{0.0, 25.0, 50.0, 100.0};
+    MantidVec Y, E;
+    slice->generateHistogram(1, X, Y, E);
+    TS_ASSERT_EQUALS(Y, MantidVec({30.0, 30.0, 0.0}));
+
+    EventList sum;
+    slice->addEventsTo(0, sum);
+    slice->addEventsTo(2, sum);
+    TS_ASSERT_EQUALS(sum.getNumberEvents(), 120);
+    TS_ASSERT(sum.hasDetectorID(0));
+    TS_ASSERT(sum.hasDetectorID(2));
+    TS_ASSERT_EQUALS(slice->getNumberEvents(0), 60);
+  }
+
+  void test_events_are_copied_when_a_spectrum_is_accessed() {
+    auto parent = WorkspaceCreationHelper::createEventWorkspace2(3, 100);
+    auto slice = createSlice(parent, 1);
+    auto splitter = createSplitter();
+    EventList other, expected;
+    parent->getSpectrum(1).splitByFullTime(
+        splitter, {{0, &other}, {1, &expected}}, false, 1.0, 0.0);
+
+    const auto &spectrum =
+        static_cast<const EventWorkspace &>(*slice).getSpectrum(1);
+    TS_ASSERT_EQUALS(spectrum.getEvents(), expected.getEvents());
+    TS_ASSERT_EQUALS(spectrum.getSortType(), PULSETIMETOF_SORT);
+
+    slice->getSpectrum(1) += TofEvent(1.0, 0);
+    TS_ASSERT_EQUALS(slice->getNumberEvents(1), 21);
+    TS_ASSERT_EQUALS(slice->getNumberEvents(), 61);
+    TS_ASSERT_EQUALS(parent->getNumberEvents(), 3 * 200);
+  }
+
+  void test_copy_of_slice_shares_the_parent() {
+    auto parent = WorkspaceCreationHelper::createEventWorkspace2(3, 100);
+    auto slice = createSlice(parent, 0);
+    slice->getSpectrum(0).clear();
+
+    auto copy = slice->clone();
+    TS_ASSERT(copy->isSlice());
+    TS_ASSERT_EQUALS(copy->getNumberEvents(0), 0);
+    TS_ASSERT_EQUALS(copy->getNumberEvents(1), 60);
+    TS_ASSERT_EQUALS(copy->getSpectrum(2).getNumberEvents(), 60);
+  }
+
+  void test_setSliceOf_throws_if_workspace_has_events() {
+    auto parent = WorkspaceCreationHelper::createEventWorkspace2(3, 100);
+    auto ws = WorkspaceCreationHelper::createEventWorkspace2(3, 100);
+    TS_ASSERT_THROWS(
+        ws->setSliceOf(parent, std::vector<EventIndexRanges>(3)),
+        std::runtime_error);
+  }
+
+  void test_setSliceOf_throws_if_number_of_spectra_differs() {
+    auto parent = WorkspaceCreationHelper::createEventWorkspace2(3, 100);
+    auto ws = create<EventWorkspace>(*parent);
+    TS_ASSERT_THROWS(
+        ws->setSliceOf(parent, std::vector<EventIndexRanges>(2)),
+        std::invalid_argument);
+  }
+
+private:
+  /// Events of createEventWorkspace2 from 10 to 40 s go to 0, 50 to 60 s to 1
+  TimeSplitterType createSplitter() {
+    const DateAndTime start("2010-01-01T00:00:00");
+    TimeSplitterType splitter;
+    splitter.emplace_back(start + 10.0, start + 40.0, 0);
+    splitter.emplace_back(start + 50.0, start + 60.0, 1);
+    return splitter;
+  }
+
+  /// Slice of the events of one output of createSplitter()
+  std::unique_ptr<EventWorkspace>
+  createSlice(const EventWorkspace_sptr &parent, int output) {
+    auto splitter = createSplitter();
+    std::vector<EventIndexRanges> slices(parent->getNumberHistograms());
+    for (size_t i = 0; i < slices.size(); ++i) {
+      std::map<int, EventIndexRanges> ranges{{0, {}}, {1, {}}};
+      parent->getSpectrum(i).splitRangesByFullTime(splitter, ranges, false,
+                                                   1.0, 0.0);
+      slices[i] = ranges[output];
+    }
+    auto slice = create<EventWorkspace>(*parent);
+    slice->setSliceOf(parent, std::move(slices));
+    return slice;
+  }
+};
+
+#endif /* MANTID_DATAOBJECTS_EVENTSLICETEST_H_ */
@@ -1382,6 +1382,61 @@ public:
     delete box_ptr;
   }
 
+  //------------------------------------------------------------------------------------------------
+  /** Integrating many spheres and shells at once gives exactly the same sums
+   * as integrating them one at a time */
+  void test_integrateSpheres_matches_integrateSphere() {
+    // Split 5x5x5, 2 deep.
+    MDGridBox<MDLeanEvent<3>, 3> *box_ptr =
+        MDEventsTestHelper::makeRecursiveMDGridBox<3>(5, 1);
+    boost::mt19937 rng;
+    boost::uniform_real<double> u(0, 5.0);
+    boost::variate_generator<boost::mt19937 &, boost::uniform_real<double>> gen(
+        rng, u);
+    std::vector<MDLeanEvent<3>> events;
+    for (size_t i = 0; i < 10000; ++i) {
+      double centers[3] = {gen(), gen(), gen()};
+      events.push_back(MDLeanEvent<3>(gen(), gen(), centers));
+    }
+    box_ptr->addEvents(events);
+    box_ptr->refreshCache();
+
+    bool dimensionsUsed[3] = {true, true, true};
+    std::vector<std::unique_ptr<CoordTransformDistance>> transforms;
+    std::vector<IntegrationSphere> spheres;
+    for (size_t i = 0; i < 50; ++i) {
+      // Some of the spheres are partly or fully off the box
+      coord_t center[3] = {static_cast<coord_t>(2.2 * gen() - 3.0),
+                           static_cast<coord_t>(gen()),
+                           static_cast<coord_t>(gen())};
+      transforms.emplace_back(
+          new CoordTransformDistance(3, center, dimensionsUsed));
+      const auto radius = static_cast<coord_t>(0.1 + gen() / 2.0);
+      spheres.push_back({transforms.back().get(), radius * radius, 0.0, 0.0,
+                         0.0});
+      spheres.push_back({transforms.back().get(), 4.0f * radius * radius,
+                         radius * radius, 0.0, 0.0});
+    }
+    std::vector<IntegrationSphere *> spherePointers;
+    for (auto &sphere : spheres)
+      spherePointers.push_back(&sphere);
+    box_ptr->integrateSpheres(spherePointers);
+
+    for (const auto &sphere : spheres) {
+      signal_t signal = 0;
+      signal_t errorSquared = 0;
+      box_ptr->integrateSphere(*sphere.radiusTransform, sphere.radiusSquared,
+                               signal, errorSquared,
+                               sphere.innerRadiusSquared);
+      TS_ASSERT_EQUALS(sphere.signal, signal);
+      TS_ASSERT_EQUALS(sphere.errorSquared, errorSquared);
+    }
+    TS_ASSERT_DIFFERS(spheres[0].signal + spheres[1].signal, 0.0);
+
+    delete box_ptr->getBoxController();
+    delete box_ptr;
+  }
+
   //------------------------------------------------------------------------------------------------
   /** For test_integrateSphere
    *
@@ -1713,6 +1768,30 @@ public:
     do_test_sphereIntegrate(center, 1.0, 0.0, 1e-3);
   }
 
+  /** Many small spheres integrated in one pass over the boxes */
+  void test_spheresIntegrate_many() {
+    bool dimensionsUsed[3] = {true, true, true};
+    std::vector<std::unique_ptr<CoordTransformDistance>> transforms;
+    std::vector<IntegrationSphere> spheres;
+    for (size_t i = 0; i < 1000; i++) {
+      coord_t center[3] = {static_cast<coord_t>(0.5 + 0.4 * (i % 10)),
+                           static_cast<coord_t>(0.5 + 0.4 * (i / 10 % 10)),
+                           static_cast<coord_t>(0.5 + 0.4 * (i / 100))};
+      transforms.emplace_back(
+          new CoordTransformDistance(3, center, dimensionsUsed));
+      spheres.push_back({transforms.back().get(), 0.04f, 0.0, 0.0, 0.0});
+    }
+    std::vector<IntegrationSphere *> spherePointers;
+    for (auto &sphere : spheres)
+      spherePointers.push_back(&sphere);
+    box3b->integrateSpheres(spherePointers);
+
+    // The expected number of events in a sphere of radius 0.2
+    for (const auto &sphere : spheres)
+      TS_ASSERT_DELTA(sphere.signal, 1e6 / 125 * (4.0 * M_PI / 3.0) * 0.008,
+                      200.0);
+  }
+
   //-----------------------------------------------------------------------------
   /** Do a sphere centroiding
    *
@@ -219,6 +219,23 @@ public:
     TS_ASSERT_THROWS_ANYTHING(ws->getSpectrum(4));
   }
 
+  void test_spectra_are_stored_contiguously() {
+    Workspace2D ws;
+    ws.initialize(4, 3, 2);
+    for (size_t i = 1; i < 4; ++i)
+      TS_ASSERT_EQUALS(&ws.getSpectrum(i), &ws.getSpectrum(0) + i);
+  }
+
+  void test_clone_shares_data_until_modified() {
+    Workspace2D_sptr cloned(ws->clone());
+    TS_ASSERT_EQUALS(cloned->sharedX(0), ws->sharedX(0));
+    TS_ASSERT_EQUALS(cloned->sharedY(0), ws->sharedY(0));
+    cloned->mutableY(0)[0] += 1.0;
+    TS_ASSERT_DIFFERS(cloned->sharedY(0), ws->sharedY(0));
+    TS_ASSERT_EQUALS(cloned->y(0)[0], ws->y(0)[0] + 1.0);
+    TS_ASSERT_EQUALS(&cloned->getSpectrum(1), &cloned->getSpectrum(0) + 1);
+  }
+
   /**
    * Test that a Workspace2D_sptr can be held as a property and
    * retrieved as const or non-const sptr,
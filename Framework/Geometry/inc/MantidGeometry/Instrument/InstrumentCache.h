@@ -0,0 +1,73 @@
+#ifndef MANTID_GEOMETRY_INSTRUMENTCACHE_H_
+#define MANTID_GEOMETRY_INSTRUMENTCACHE_H_
+
+#include "MantidGeometry/DllConfig.h"
+
+#include <boost/shared_ptr.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Mantid {
+namespace Geometry {
+class Instrument;
+class Object;
+
+/** InstrumentCache : Writes a fully built instrument to a versioned binary
+  file and reads it back, so that loading an instrument does not have to
+  parse its definition file again.
+
+  The cache holds the component tree with the relative positions and
+  rotations of all components, the detector IDs, the shapes, the source,
+  sample, chopper and monitor markers, the reference frame and the
+  parameters of the definition file. A cache is only valid for the definition
+  file and the build of Mantid it was written by: the file stores the
+  checksum of the XML and the revision of Mantid, and read() returns nothing
+  if the checksum, the revision, the version or the layout of the file do not
+  match.
+
+  Only instruments built from CompAssembly, ObjCompAssembly, ObjComponent and
+  Detector components can be cached. Instruments with rectangular or
+  structured detectors, or with neutronic positions, are always parsed from
+  XML.
+
+  Copyright &copy; 2017 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class MANTID_GEOMETRY_DLL InstrumentCache {
+public:
+  /// Version of the file layout, increased whenever the layout changes
+  static const uint32_t Version;
+
+  static bool isCachable(const Instrument &instrument);
+  static void write(const Instrument &instrument, const std::string &checksum,
+                    const std::string &filename);
+  static boost::shared_ptr<Instrument>
+  read(const std::string &filename, const std::string &checksum,
+       const Instrument &prototype,
+       std::vector<boost::shared_ptr<Object>> &shapes);
+};
+
+} // namespace Geometry
+} // namespace Mantid
+
+#endif /* MANTID_GEOMETRY_INSTRUMENTCACHE_H_ */
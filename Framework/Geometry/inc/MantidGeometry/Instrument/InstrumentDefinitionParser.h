@@ -81,6 +81,10 @@ public:
   boost::shared_ptr<Instrument>
   parseXML(Kernel::ProgressBase *progressReporter);
 
+  /// Load the instrument from its cache file, or parse the XML and cache it
+  boost::shared_ptr<Instrument>
+  parseXMLOrCache(Kernel::ProgressBase *progressReporter);
+
   /// Add/overwrite any parameters specified in instrument with param values
   /// specified in <component-link> XML elements
   void setComponentLinks(boost::shared_ptr<Geometry::Instrument> &instrument,
@@ -107,6 +111,9 @@ public:
   /// creates a vtp filename from a given xml filename
   const std::string createVTPFileName();
 
+  /// creates an instrument cache filename from a given xml filename
+  const std::string createInstrumentCacheFileName();
+
 private:
   /// shared Constructor logic
   void initialise(const std::string &filename, const std::string &instName,
@@ -305,6 +312,11 @@ private:
   CachingOption writeAndApplyCache(IDFObject_const_sptr firstChoiceCache,
                                    IDFObject_const_sptr fallBackCache);
 
+  /// Write out the instrument cache file.
+  void writeInstrumentCache(const std::string &checksum,
+                            IDFObject_const_sptr firstChoiceCache,
+                            IDFObject_const_sptr fallBackCache);
+
   /// This method returns the parent appended which its child components and
   /// also name of type of the last child component
   std::string getShapeCoorSysComp(
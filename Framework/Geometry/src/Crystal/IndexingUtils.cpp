@@ -2,6 +2,7 @@
 #include "MantidGeometry/Crystal/NiggliCell.h"
 #include "MantidKernel/Quat.h"
 #include "MantidKernel/EigenConversionHelpers.h"
+#include "MantidKernel/MultiThreaded.h"
 #include <algorithm>
 #include <cmath>
 #include <boost/math/special_functions/round.hpp>
@@ -27,6 +28,53 @@ using Mantid::Kernel::Quat;
 namespace {
 const constexpr double DEG_TO_RAD = M_PI / 180.;
 const constexpr double RAD_TO_DEG = 180. / M_PI;
+/// The number of directions FFTScanFor_Directions projects the Q vectors on
+/// in one pass
+const constexpr size_t FFT_DIRECTION_BLOCK = 16;
+
+/**
+  Compute the largest magnitude of the FFT past the DC term, as returned by
+  IndexingUtils::GetMagFFT, for a block of directions. The Q vectors are
+  projected on all directions of the block in one pass over them.
+
+  @param q_vectors     The Q vectors, already divided by 2 pi.
+  @param directions    The first direction of the block.
+  @param n_directions  The number of directions of the block.
+  @param N             The number of bins of the projections. This MUST BE a
+                       power of 2.
+  @param index_factor  Factor mapping a projected Q vector to a bin.
+  @param projections   Work array of n_directions * N values.
+  @param max_mag_fft   Array filled with the largest magnitude of the FFT
+                       past the DC term for each direction.
+ */
+void blockMaxMagFFT(const std::vector<V3D> &q_vectors, const V3D *directions,
+                    const size_t n_directions, const size_t N,
+                    double index_factor, double projections[],
+                    double max_mag_fft[]) {
+  std::fill(projections, projections + n_directions * N, 0.0);
+  for (const auto &q_vec : q_vectors) {
+    for (size_t dir = 0; dir < n_directions; dir++) {
+      double dot_prod = directions[dir].scalar_prod(q_vec);
+      size_t index = static_cast<size_t>(fabs(index_factor * dot_prod));
+      projections[dir * N + std::min(index, N - 1)] += 1;
+    }
+  }
+
+  size_t dc_end = 5; // as in GetMagFFT
+  for (size_t dir = 0; dir < n_directions; dir++) {
+    double *dir_projections = projections + dir * N;
+    gsl_fft_real_radix2_transform(dir_projections, 1, N);
+    double max_mag = 0.0;
+    for (size_t i = dc_end; i < N / 2; i++) {
+      double magnitude =
+          sqrt(dir_projections[i] * dir_projections[i] +
+               dir_projections[N - i] * dir_projections[N - i]);
+      if (magnitude > max_mag)
+        max_mag = magnitude;
+    }
+    max_mag_fft[dir] = max_mag;
+  }
+}
 }
 
 /**
@@ -1177,6 +1225,9 @@ size_t IndexingUtils::ScanFor_Directions(std::vector<V3D> &directions,
    will consist of vectors, V, for which V dot Q is essentially an integer for
    the most Q vectors.  The difference between V dot Q and an integer must be
    less than the required tolerance for it to count as an integer.
+   The directions are scanned in parallel, in blocks on which the Q vectors
+   are projected together.  The result does not depend on the number of
+   threads.
     @param  directions          Vector that will be filled with the directions
                                 that may correspond to unit cell edges.
     @param  q_vectors           Vector of new Vector3D objects that contains
@@ -1204,7 +1255,6 @@ size_t IndexingUtils::FFTScanFor_Directions(std::vector<V3D> &directions,
 #define N_FFT_STEPS 512
 #define HALF_FFT_STEPS 256
 
-  double fit_error;
   int max_indexed = 0;
 
   // first, make hemisphere of possible directions
@@ -1229,17 +1279,23 @@ size_t IndexingUtils::FFTScanFor_Directions(std::vector<V3D> &directions,
   std::vector<double> max_fft_val;
   max_fft_val.resize(full_list.size());
 
-  double projections[N_FFT_STEPS];
-  double magnitude_fft[HALF_FFT_STEPS];
-
   double index_factor = N_FFT_STEPS / max_mag_Q; // maps |proj Q| to index
 
-  for (size_t dir_num = 0; dir_num < full_list.size(); dir_num++) {
-    V3D current_dir = full_list[dir_num];
-    max_mag_fft = GetMagFFT(q_vectors, current_dir, N_FFT_STEPS, projections,
-                            index_factor, magnitude_fft);
-
-    max_fft_val[dir_num] = max_mag_fft;
+  std::vector<V3D> scaled_qs;
+  scaled_qs.reserve(q_vectors.size());
+  for (const auto &q_vector : q_vectors)
+    scaled_qs.push_back(q_vector / (2.0 * M_PI));
+
+  const int num_blocks = static_cast<int>(
+      (full_list.size() + FFT_DIRECTION_BLOCK - 1) / FFT_DIRECTION_BLOCK);
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int block = 0; block < num_blocks; block++) {
+    const size_t first = static_cast<size_t>(block) * FFT_DIRECTION_BLOCK;
+    const size_t n_dirs =
+        std::min(FFT_DIRECTION_BLOCK, full_list.size() - first);
+    std::vector<double> block_projections(FFT_DIRECTION_BLOCK * N_FFT_STEPS);
+    blockMaxMagFFT(scaled_qs, &full_list[first], n_dirs, N_FFT_STEPS,
+                   index_factor, block_projections.data(), &max_fft_val[first]);
   }
   // find the directions with the 500 largest
   // fft values, and place them in temp_dirs vector
@@ -1273,31 +1329,41 @@ size_t IndexingUtils::FFTScanFor_Directions(std::vector<V3D> &directions,
   // FFT to find the cell edge length that
   // corresponds to the max_mag_fft.  Only keep
   // directions with length nearly in bounds
-  V3D temp;
-  std::vector<V3D> temp_dirs_2;
-
-  for (auto &temp_dir : temp_dirs) {
-    GetMagFFT(q_vectors, temp_dir, N_FFT_STEPS, projections, index_factor,
+  // The candidate directions are processed in parallel, keeping their order
+  const int num_temp_dirs = static_cast<int>(temp_dirs.size());
+  std::vector<double> d_values(temp_dirs.size(), -1.0);
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int i = 0; i < num_temp_dirs; i++) {
+    double projections[N_FFT_STEPS];
+    double magnitude_fft[HALF_FFT_STEPS];
+    GetMagFFT(q_vectors, temp_dirs[i], N_FFT_STEPS, projections, index_factor,
               magnitude_fft);
 
     double position = GetFirstMaxIndex(magnitude_fft, N_FFT_STEPS, threshold);
     if (position > 0) {
       double q_val = max_mag_Q / position;
-      double d_val = 1 / q_val;
-      if (d_val >= 0.8 * min_d && d_val <= 1.2 * max_d) {
-        temp = temp_dir * d_val;
-        temp_dirs_2.push_back(temp);
-      }
+      d_values[i] = 1 / q_val;
+    }
+  }
+
+  std::vector<V3D> temp_dirs_2;
+  for (size_t i = 0; i < temp_dirs.size(); i++) {
+    double d_val = d_values[i];
+    if (d_val > 0 && d_val >= 0.8 * min_d && d_val <= 1.2 * max_d) {
+      temp_dirs_2.push_back(temp_dirs[i] * d_val);
     }
   }
   // look at how many peaks were indexed
   // for each of the initial directions
+  std::vector<int> num_indexed_1D(temp_dirs_2.size());
+  const int num_temp_dirs_2 = static_cast<int>(temp_dirs_2.size());
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int i = 0; i < num_temp_dirs_2; i++) {
+    num_indexed_1D[i] =
+        NumberIndexed_1D(temp_dirs_2[i], q_vectors, required_tolerance);
+  }
   max_indexed = 0;
-  int num_indexed;
-  V3D current_dir;
-  for (auto &dir_num : temp_dirs_2) {
-    current_dir = dir_num;
-    num_indexed = NumberIndexed_1D(current_dir, q_vectors, required_tolerance);
+  for (int num_indexed : num_indexed_1D) {
     if (num_indexed > max_indexed)
       max_indexed = num_indexed;
   }
@@ -1305,21 +1371,34 @@ size_t IndexingUtils::FFTScanFor_Directions(std::vector<V3D> &directions,
   // only keep original directions that index
   // at least 50% of max num indexed
   temp_dirs.clear();
-  for (auto &dir_num : temp_dirs_2) {
-    current_dir = dir_num;
-    num_indexed = NumberIndexed_1D(current_dir, q_vectors, required_tolerance);
-    if (num_indexed >= 0.50 * max_indexed)
-      temp_dirs.push_back(current_dir);
+  for (size_t i = 0; i < temp_dirs_2.size(); i++) {
+    if (num_indexed_1D[i] >= 0.50 * max_indexed)
+      temp_dirs.push_back(temp_dirs_2[i]);
   }
   // refine directions and again find the
   // max number indexed, for the optimized
   // directions
-  max_indexed = 0;
-  std::vector<int> index_vals;
-  std::vector<V3D> indexed_qs;
-  for (auto &temp_dir : temp_dirs) {
-    num_indexed = GetIndexedPeaks_1D(temp_dir, q_vectors, required_tolerance,
-                                     index_vals, indexed_qs, fit_error);
+  std::vector<int> max_indexed_refined(temp_dirs.size(), 0);
+  std::exception_ptr error;
+  const int num_refined = static_cast<int>(temp_dirs.size());
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int i = 0; i < num_refined; i++) {
+    V3D &temp_dir = temp_dirs[i];
+    std::vector<int> index_vals;
+    std::vector<V3D> indexed_qs;
+    double fit_error;
+    int num_indexed;
+    try {
+      num_indexed = GetIndexedPeaks_1D(temp_dir, q_vectors,
+                                       required_tolerance, index_vals,
+                                       indexed_qs, fit_error);
+    } catch (...) {
+      PARALLEL_CRITICAL(FFTScanFor_Directions_error) {
+        if (!error)
+          error = std::current_exception();
+      }
+      continue;
+    }
     try {
       int count = 0;
       while (count < 5) // 5 iterations should be enough for
@@ -1329,8 +1408,8 @@ size_t IndexingUtils::FFTScanFor_Directions(std::vector<V3D> &directions,
         num_indexed =
             GetIndexedPeaks_1D(temp_dir, q_vectors, required_tolerance,
                                index_vals, indexed_qs, fit_error);
-        if (num_indexed > max_indexed)
-          max_indexed = num_indexed;
+        if (num_indexed > max_indexed_refined[i])
+          max_indexed_refined[i] = num_indexed;
 
         count++;
       }
@@ -1338,22 +1417,33 @@ size_t IndexingUtils::FFTScanFor_Directions(std::vector<V3D> &directions,
       // don't continue to refine if the direction fails to optimize properly
     }
   }
+  if (error)
+    std::rethrow_exception(error);
+  max_indexed = 0;
+  for (int num_indexed : max_indexed_refined) {
+    if (num_indexed > max_indexed)
+      max_indexed = num_indexed;
+  }
   // discard those with length out of bounds
   temp_dirs_2.clear();
   for (auto &temp_dir : temp_dirs) {
-    current_dir = temp_dir;
-    double length = current_dir.norm();
+    double length = temp_dir.norm();
     if (length >= min_d && length <= max_d)
-      temp_dirs_2.push_back(current_dir);
+      temp_dirs_2.push_back(temp_dir);
   }
   // only keep directions that index at
   // least 75% of the max number of peaks
+  num_indexed_1D.resize(temp_dirs_2.size());
+  const int num_in_bounds = static_cast<int>(temp_dirs_2.size());
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int i = 0; i < num_in_bounds; i++) {
+    num_indexed_1D[i] =
+        NumberIndexed_1D(temp_dirs_2[i], q_vectors, required_tolerance);
+  }
   temp_dirs.clear();
-  for (auto &dir_num : temp_dirs_2) {
-    current_dir = dir_num;
-    num_indexed = NumberIndexed_1D(current_dir, q_vectors, required_tolerance);
-    if (num_indexed > max_indexed * 0.75)
-      temp_dirs.push_back(current_dir);
+  for (size_t i = 0; i < temp_dirs_2.size(); i++) {
+    if (num_indexed_1D[i] > max_indexed * 0.75)
+      temp_dirs.push_back(temp_dirs_2[i]);
   }
 
   std::sort(temp_dirs.begin(), temp_dirs.end(), V3D::CompareMagnitude);
@@ -0,0 +1,582 @@
+#include "MantidGeometry/Instrument/InstrumentCache.h"
+#include "MantidGeometry/Instrument.h"
+#include "MantidGeometry/Instrument/Detector.h"
+#include "MantidGeometry/Instrument/ObjCompAssembly.h"
+#include "MantidGeometry/Instrument/ReferenceFrame.h"
+#include "MantidGeometry/Instrument/XMLInstrumentParameter.h"
+#include "MantidGeometry/Objects/Object.h"
+#include "MantidGeometry/Objects/ShapeFactory.h"
+#include "MantidKernel/Interpolation.h"
+#include "MantidKernel/Logger.h"
+#include "MantidKernel/MantidVersion.h"
+
+#include <Poco/File.h>
+
+#include <boost/make_shared.hpp>
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+#include <typeinfo>
+#include <unordered_map>
+
+namespace Mantid {
+namespace Geometry {
+
+namespace {
+/// static logger
+Kernel::Logger g_log("InstrumentCache");
+
+/// Identifies a cache file
+const char MAGIC[] = {'M', 'T', 'D', 'I', 'N', 'S', 'T', 'C'};
+/// Written in the byte order of the writing machine
+const uint32_t ENDIAN_MARKER = 0x01020304;
+
+/// The component types that can be cached
+enum class ComponentType : uint8_t {
+  Assembly = 0,
+  ObjAssembly = 1,
+  ObjComponent = 2,
+  Detector = 3
+};
+
+/// The components of an instrument in pre-order, with the shapes they use
+struct Layout {
+  std::vector<const IComponent *> components;
+  std::vector<ComponentType> types;
+  std::vector<int32_t> parents;
+  std::vector<boost::shared_ptr<const Object>> shapes;
+  std::unordered_map<const IComponent *, int32_t> componentIndex;
+  std::unordered_map<const Object *, int32_t> shapeIndex;
+};
+
+/**
+ * Return the type of a component if it can be cached.
+ * @param comp :: A component of the instrument
+ * @param type :: [output] The cached type of the component
+ * @return True if the exact type of the component can be cached
+ */
+bool componentType(const IComponent &comp, ComponentType &type) {
+  const std::type_info &info = typeid(comp);
+  if (info == typeid(CompAssembly))
+    type = ComponentType::Assembly;
+  else if (info == typeid(ObjCompAssembly))
+    type = ComponentType::ObjAssembly;
+  else if (info == typeid(ObjComponent))
+    type = ComponentType::ObjComponent;
+  else if (info == typeid(Detector))
+    type = ComponentType::Detector;
+  else
+    return false;
+  return true;
+}
+
+/**
+ * Add a shape to the layout unless it is already there.
+ * @param shape :: The shape, may be null
+ * @param layout :: The layout to add to
+ * @return False if the shape cannot be recreated from its XML
+ */
+bool addShape(const boost::shared_ptr<const Object> &shape, Layout &layout) {
+  if (!shape || layout.shapeIndex.count(shape.get()) > 0)
+    return true;
+  if (shape->getShapeXML().empty())
+    return false;
+  layout.shapeIndex.emplace(shape.get(),
+                            static_cast<int32_t>(layout.shapes.size()));
+  layout.shapes.push_back(shape);
+  return true;
+}
+
+/**
+ * Walk the component tree in pre-order and collect the components and shapes.
+ * @param comp :: The component to add, with its children
+ * @param parent :: Index of the parent component
+ * @param layout :: The layout to add to
+ * @return False if any component cannot be cached
+ */
+bool addComponent(const IComponent &comp, int32_t parent, Layout &layout) {
+  ComponentType type;
+  if (!componentType(comp, type))
+    return false;
+  const auto index = static_cast<int32_t>(layout.components.size());
+  layout.components.push_back(&comp);
+  layout.types.push_back(type);
+  layout.parents.push_back(parent);
+  layout.componentIndex.emplace(&comp, index);
+  if (const auto *objComp = dynamic_cast<const ObjComponent *>(&comp)) {
+    if (!addShape(objComp->shape(), layout))
+      return false;
+  }
+  if (const auto *assembly = dynamic_cast<const ICompAssembly *>(&comp)) {
+    for (int i = 0; i < assembly->nelements(); ++i) {
+      if (!addComponent(*assembly->getChild(i), index, layout))
+        return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Collect the layout of an instrument.
+ * @param instrument :: A base instrument
+ * @param layout :: [output] The components and shapes of the instrument
+ * @return False if the instrument cannot be cached
+ */
+bool collectLayout(const Instrument &instrument, Layout &layout) {
+  if (instrument.isParametrized() || instrument.getPhysicalInstrument())
+    return false;
+  // The instrument itself is stored as the root assembly
+  layout.components.push_back(&instrument);
+  layout.types.push_back(ComponentType::Assembly);
+  layout.parents.push_back(-1);
+  layout.componentIndex.emplace(&instrument, 0);
+  for (int i = 0; i < instrument.nelements(); ++i) {
+    if (!addComponent(*instrument.getChild(i), 0, layout))
+      return false;
+  }
+  return true;
+}
+
+/// Appends values to a byte buffer
+class Writer {
+public:
+  template <typename T> void write(const T &value) {
+    const auto *bytes = reinterpret_cast<const char *>(&value);
+    m_buffer.append(bytes, sizeof(T));
+  }
+  void write(const std::string &value) {
+    write(static_cast<uint64_t>(value.size()));
+    m_buffer.append(value);
+  }
+  void write(const Kernel::V3D &value) {
+    write(value.X());
+    write(value.Y());
+    write(value.Z());
+  }
+  void write(const Kernel::Quat &value) {
+    write(value.real());
+    write(value.imagI());
+    write(value.imagJ());
+    write(value.imagK());
+  }
+  const std::string &buffer() const { return m_buffer; }
+
+private:
+  std::string m_buffer;
+};
+
+/// Reads values back from a byte buffer, throwing if it runs out
+class Reader {
+public:
+  explicit Reader(const std::string &buffer) : m_buffer(buffer), m_pos(0) {}
+  template <typename T> T read() {
+    T value;
+    std::memcpy(&value, take(sizeof(T)), sizeof(T));
+    return value;
+  }
+  std::string readString() {
+    const auto size = read<uint64_t>();
+    if (size > m_buffer.size())
+      throw std::runtime_error("String length exceeds the cache size");
+    const char *bytes = take(static_cast<size_t>(size));
+    return std::string(bytes, static_cast<size_t>(size));
+  }
+  Kernel::V3D readV3D() {
+    const auto x = read<double>();
+    const auto y = read<double>();
+    const auto z = read<double>();
+    return Kernel::V3D(x, y, z);
+  }
+  Kernel::Quat readQuat() {
+    const auto w = read<double>();
+    const auto a = read<double>();
+    const auto b = read<double>();
+    const auto c = read<double>();
+    return Kernel::Quat(w, a, b, c);
+  }
+  bool atEnd() const { return m_pos == m_buffer.size(); }
+
+private:
+  const char *take(size_t size) {
+    if (size > m_buffer.size() - m_pos)
+      throw std::runtime_error("Unexpected end of the instrument cache");
+    const char *bytes = m_buffer.data() + m_pos;
+    m_pos += size;
+    return bytes;
+  }
+  const std::string &m_buffer;
+  size_t m_pos;
+};
+
+/// Convert an axis of the reference frame back to its enum value
+PointingAlong axisOf(const Kernel::V3D &vec) {
+  if (vec.X() != 0.)
+    return X;
+  if (vec.Y() != 0.)
+    return Y;
+  return Z;
+}
+
+/// Index of a component in the layout, or -1 if there is none
+int32_t indexOf(const Layout &layout, const IComponent *comp) {
+  if (!comp)
+    return -1;
+  const auto it = layout.componentIndex.find(comp);
+  if (it == layout.componentIndex.end())
+    throw std::runtime_error("Component is not part of the instrument tree");
+  return it->second;
+}
+
+/// Serialize an interpolation table, an empty string meaning none
+std::string interpolationToString(
+    const boost::shared_ptr<Kernel::Interpolation> &interpolation) {
+  if (!interpolation)
+    return std::string();
+  std::ostringstream out;
+  out.precision(17);
+  interpolation->printSelf(out);
+  return out.str();
+}
+} // namespace
+
+const uint32_t InstrumentCache::Version = 2;
+
+/**
+ * Check whether an instrument can be written to a cache file.
+ * @param instrument :: A base instrument built from its definition file
+ * @return True if every component of the instrument can be cached
+ */
+bool InstrumentCache::isCachable(const Instrument &instrument) {
+  Layout layout;
+  return collectLayout(instrument, layout);
+}
+
+/**
+ * Write an instrument to a cache file. The file is written under a temporary
+ * name first and then renamed, so that readers never see a partial file.
+ * @param instrument :: A base instrument built from its definition file
+ * @param checksum :: Checksum of the definition the instrument was built from
+ * @param filename :: Full path of the cache file
+ * @throws std::invalid_argument if the instrument cannot be cached
+ * @throws std::runtime_error if the file cannot be written
+ */
+void InstrumentCache::write(const Instrument &instrument,
+                            const std::string &checksum,
+                            const std::string &filename) {
+  Layout layout;
+  if (!collectLayout(instrument, layout))
+    throw std::invalid_argument("Instrument " + instrument.getName() +
+                                " cannot be cached");
+
+  Writer out;
+  for (const char c : MAGIC)
+    out.write(c);
+  out.write(Version);
+  out.write(ENDIAN_MARKER);
+  out.write(std::string(Kernel::MantidVersion::revisionFull()));
+  out.write(checksum);
+
+  // Instrument
+  out.write(instrument.getDefaultView());
+  out.write(instrument.getDefaultAxis());
+  out.write(instrument.getValidFromDate().totalNanoseconds());
+  out.write(instrument.getValidToDate().totalNanoseconds());
+  const auto frame = instrument.getReferenceFrame();
+  out.write(static_cast<uint8_t>(frame->pointingUp()));
+  out.write(static_cast<uint8_t>(frame->pointingAlongBeam()));
+  out.write(static_cast<uint8_t>(axisOf(frame->vecThetaSign())));
+  out.write(static_cast<uint8_t>(frame->getHandedness()));
+  out.write(frame->origin());
+
+  // Shapes
+  out.write(static_cast<uint64_t>(layout.shapes.size()));
+  for (const auto &shape : layout.shapes) {
+    out.write(static_cast<int32_t>(shape->getName()));
+    out.write(shape->getShapeXML());
+  }
+
+  // Components in pre-order, so parents always precede their children
+  out.write(static_cast<uint64_t>(layout.components.size()));
+  for (size_t i = 0; i < layout.components.size(); ++i) {
+    const IComponent &comp = *layout.components[i];
+    out.write(static_cast<uint8_t>(layout.types[i]));
+    out.write(layout.parents[i]);
+    out.write(comp.getName());
+    out.write(comp.getRelativePos());
+    out.write(comp.getRelativeRot());
+    int32_t shape(-1);
+    if (const auto *objComp = dynamic_cast<const ObjComponent *>(&comp)) {
+      if (objComp->shape())
+        shape = layout.shapeIndex.at(objComp->shape().get());
+    }
+    out.write(shape);
+    if (layout.types[i] == ComponentType::Detector) {
+      const auto &det = dynamic_cast<const Detector &>(comp);
+      out.write(static_cast<int32_t>(det.getID()));
+      out.write(static_cast<uint8_t>(instrument.isMonitor(det.getID())));
+    }
+  }
+
+  // Source, sample and chopper points
+  const auto source = instrument.getSource();
+  out.write(indexOf(layout, source ? source->getComponentID() : nullptr));
+  const auto sample = instrument.getSample();
+  out.write(indexOf(layout, sample ? sample->getComponentID() : nullptr));
+  out.write(static_cast<uint64_t>(instrument.getNumberOfChopperPoints()));
+  for (size_t i = 0; i < instrument.getNumberOfChopperPoints(); ++i)
+    out.write(
+        indexOf(layout, instrument.getChopperPoint(i)->getComponentID()));
+
+  // Parameters of the definition file
+  const auto &units = instrument.getLogfileUnit();
+  out.write(static_cast<uint64_t>(units.size()));
+  for (const auto &unit : units) {
+    out.write(unit.first);
+    out.write(unit.second);
+  }
+  const auto &parameters = instrument.getLogfileCache();
+  out.write(static_cast<uint64_t>(parameters.size()));
+  for (const auto &entry : parameters) {
+    const XMLInstrumentParameter &param = *entry.second;
+    out.write(entry.first.first);
+    out.write(indexOf(layout, entry.first.second));
+    out.write(indexOf(layout, param.m_component));
+    out.write(param.m_logfileID);
+    out.write(param.m_value);
+    out.write(interpolationToString(param.m_interpolation));
+    out.write(param.m_formula);
+    out.write(param.m_formulaUnit);
+    out.write(param.m_resultUnit);
+    out.write(param.m_paramName);
+    out.write(param.m_type);
+    out.write(param.m_tie);
+    out.write(static_cast<uint64_t>(param.m_constraint.size()));
+    for (const auto &constraint : param.m_constraint)
+      out.write(constraint);
+    out.write(param.m_penaltyFactor);
+    out.write(param.m_fittingFunction);
+    out.write(param.m_extractSingleValueAs);
+    out.write(param.m_eq);
+    out.write(param.m_angleConvertConst);
+    out.write(param.m_description);
+  }
+
+  const std::string tempname = filename + ".tmp";
+  {
+    std::ofstream file(tempname, std::ios::binary | std::ios::trunc);
+    file.write(out.buffer().data(),
+               static_cast<std::streamsize>(out.buffer().size()));
+    if (!file)
+      throw std::runtime_error("Unable to write instrument cache " + tempname);
+  }
+  Poco::File(tempname).moveTo(filename);
+}
+
+/**
+ * Rebuild an instrument from a cache file. The whole file is read in one go
+ * and decoded from memory.
+ * @param filename :: Full path of the cache file
+ * @param checksum :: Checksum of the definition the caller wants to load
+ * @param prototype :: The empty instrument created for the definition, which
+ * provides the name, filename and XML of the result
+ * @param shapes :: [output] The shapes used by the instrument
+ * @return The instrument, or a null pointer if the file does not exist or does
+ * not match the checksum, the version, the revision of Mantid or the layout
+ * this code writes
+ */
+boost::shared_ptr<Instrument>
+InstrumentCache::read(const std::string &filename, const std::string &checksum,
+                      const Instrument &prototype,
+                      std::vector<boost::shared_ptr<Object>> &shapes) {
+  std::ifstream file(filename, std::ios::binary);
+  if (!file)
+    return nullptr;
+  const std::string buffer((std::istreambuf_iterator<char>(file)),
+                           std::istreambuf_iterator<char>());
+  file.close();
+
+  try {
+    Reader in(buffer);
+    for (const char c : MAGIC) {
+      if (in.read<char>() != c)
+        return nullptr;
+    }
+    // The classes the cache rebuilds may change between builds without the
+    // layout changing, so a cache is only used by the build that wrote it
+    if (in.read<uint32_t>() != Version ||
+        in.read<uint32_t>() != ENDIAN_MARKER ||
+        in.readString() != Kernel::MantidVersion::revisionFull() ||
+        in.readString() != checksum) {
+      g_log.information() << "Instrument cache " << filename
+                          << " is out of date\n";
+      return nullptr;
+    }
+
+    // Instrument
+    auto instrument = boost::make_shared<Instrument>(prototype.getName());
+    instrument->setFilename(prototype.getFilename());
+    instrument->setXmlText(prototype.getXmlText());
+    instrument->setDefaultView(in.readString());
+    instrument->setDefaultViewAxis(in.readString());
+    instrument->setValidFromDate(Kernel::DateAndTime(in.read<int64_t>()));
+    instrument->setValidToDate(Kernel::DateAndTime(in.read<int64_t>()));
+    const auto up = static_cast<PointingAlong>(in.read<uint8_t>());
+    const auto along = static_cast<PointingAlong>(in.read<uint8_t>());
+    const auto thetaSign = static_cast<PointingAlong>(in.read<uint8_t>());
+    const auto handedness = static_cast<Handedness>(in.read<uint8_t>());
+    instrument->setReferenceFrame(boost::make_shared<ReferenceFrame>(
+        up, along, thetaSign, handedness, in.readString()));
+
+    // Shapes
+    shapes.clear();
+    shapes.resize(static_cast<size_t>(in.read<uint64_t>()));
+    ShapeFactory shapeCreator;
+    for (auto &shape : shapes) {
+      const auto name = in.read<int32_t>();
+      shape = shapeCreator.createShape(in.readString(), false);
+      shape->setName(name);
+    }
+    auto shapeAt = [&shapes](int32_t index) {
+      if (index < 0)
+        return boost::shared_ptr<Object>();
+      return shapes.at(static_cast<size_t>(index));
+    };
+
+    // Components. Each constructor or add() hands ownership to the parent.
+    std::vector<IComponent *> components(
+        static_cast<size_t>(in.read<uint64_t>()));
+    std::vector<std::pair<const Detector *, bool>> detectors;
+    for (size_t i = 0; i < components.size(); ++i) {
+      const auto type = static_cast<ComponentType>(in.read<uint8_t>());
+      const auto parentIndex = in.read<int32_t>();
+      const auto name = in.readString();
+      const auto pos = in.readV3D();
+      const auto rot = in.readQuat();
+      const auto shape = shapeAt(in.read<int32_t>());
+      IComponent *comp(nullptr);
+      if (i == 0) {
+        comp = instrument.get();
+      } else {
+        auto *parent = dynamic_cast<ICompAssembly *>(
+            components.at(static_cast<size_t>(parentIndex)));
+        if (!parent || parentIndex >= static_cast<int32_t>(i))
+          throw std::runtime_error("Invalid parent in the instrument cache");
+        switch (type) {
+        case ComponentType::Assembly:
+          comp = new CompAssembly(name, parent);
+          break;
+        case ComponentType::ObjAssembly: {
+          auto *objAssembly = new ObjCompAssembly(name, parent);
+          if (shape)
+            objAssembly->setOutline(shape);
+          comp = objAssembly;
+          break;
+        }
+        case ComponentType::ObjComponent:
+          comp = new ObjComponent(name, shape, parent);
+          parent->add(comp);
+          break;
+        case ComponentType::Detector: {
+          const auto id = static_cast<detid_t>(in.read<int32_t>());
+          auto *det = new Detector(name, id, shape, parent);
+          parent->add(det);
+          detectors.emplace_back(det, in.read<uint8_t>() != 0);
+          comp = det;
+          break;
+        }
+        default:
+          throw std::runtime_error("Unknown component in the instrument cache");
+        }
+      }
+      comp->setPos(pos);
+      comp->setRot(rot);
+      components[i] = comp;
+    }
+    auto componentAt = [&components](int32_t index) -> IComponent * {
+      if (index < 0)
+        return nullptr;
+      return components.at(static_cast<size_t>(index));
+    };
+
+    // Source, sample, chopper points and detectors
+    if (auto *source = componentAt(in.read<int32_t>()))
+      instrument->markAsSource(source);
+    if (auto *sample = componentAt(in.read<int32_t>()))
+      instrument->markAsSamplePos(sample);
+    const auto nchoppers = in.read<uint64_t>();
+    for (uint64_t i = 0; i < nchoppers; ++i) {
+      auto *chopper =
+          dynamic_cast<ObjComponent *>(componentAt(in.read<int32_t>()));
+      if (!chopper)
+        throw std::runtime_error("Invalid chopper in the instrument cache");
+      instrument->markAsChopperPoint(chopper);
+    }
+    for (const auto &det : detectors) {
+      if (det.second)
+        instrument->markAsMonitor(det.first);
+      else
+        instrument->markAsDetectorIncomplete(det.first);
+    }
+    instrument->markAsDetectorFinalize();
+
+    // Parameters of the definition file
+    auto &units = instrument->getLogfileUnit();
+    const auto nunits = in.read<uint64_t>();
+    for (uint64_t i = 0; i < nunits; ++i) {
+      const auto key = in.readString();
+      units[key] = in.readString();
+    }
+    auto &parameters = instrument->getLogfileCache();
+    const auto nparameters = in.read<uint64_t>();
+    for (uint64_t i = 0; i < nparameters; ++i) {
+      const auto key = in.readString();
+      const IComponent *keyComp = componentAt(in.read<int32_t>());
+      const IComponent *comp = componentAt(in.read<int32_t>());
+      const auto logfileID = in.readString();
+      const auto value = in.readString();
+      boost::shared_ptr<Kernel::Interpolation> interpolation;
+      const auto table = in.readString();
+      if (!table.empty()) {
+        interpolation = boost::make_shared<Kernel::Interpolation>();
+        std::istringstream tableStream(table);
+        tableStream >> *interpolation;
+      }
+      const auto formula = in.readString();
+      const auto formulaUnit = in.readString();
+      const auto resultUnit = in.readString();
+      const auto paramName = in.readString();
+      const auto paramType = in.readString();
+      const auto tie = in.readString();
+      std::vector<std::string> constraint(
+          static_cast<size_t>(in.read<uint64_t>()));
+      for (auto &c : constraint)
+        c = in.readString();
+      auto penaltyFactor = in.readString();
+      const auto fitFunc = in.readString();
+      const auto extractSingleValueAs = in.readString();
+      const auto eq = in.readString();
+      const auto angleConvertConst = in.read<double>();
+      const auto description = in.readString();
+      parameters[std::make_pair(key, keyComp)] =
+          boost::make_shared<XMLInstrumentParameter>(
+              logfileID, value, interpolation, formula, formulaUnit,
+              resultUnit, paramName, paramType, tie, constraint, penaltyFactor,
+              fitFunc, extractSingleValueAs, eq, comp, angleConvertConst,
+              description);
+    }
+    if (!in.atEnd())
+      throw std::runtime_error("Trailing data in the instrument cache");
+    return instrument;
+  } catch (std::exception &e) {
+    g_log.warning() << "Unable to read instrument cache " << filename << ": "
+                    << e.what() << "\n";
+  }
+  shapes.clear();
+  return nullptr;
+}
+
+} // namespace Geometry
+} // namespace Mantid
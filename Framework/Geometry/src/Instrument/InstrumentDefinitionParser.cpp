@@ -2,6 +2,7 @@
 #include <sstream>
 
 #include "MantidGeometry/Instrument/Detector.h"
+#include "MantidGeometry/Instrument/InstrumentCache.h"
 #include "MantidGeometry/Instrument/InstrumentDefinitionParser.h"
 #include "MantidGeometry/Instrument/ObjCompAssembly.h"
 #include "MantidGeometry/Instrument/RectangularDetector.h"
@@ -282,6 +283,52 @@ InstrumentDefinitionParser::parseXML(Kernel::ProgressBase *progressReporter) {
   return m_instrument;
 }
 
+//----------------------------------------------------------------------------------------------
+/** Return the instrument from its cache file if there is one for the current
+ * IDF contents, otherwise fully parse the XML and write the cache for the next
+ * load. Instruments that cannot be cached are always parsed.
+ *
+ * @param progressReporter :: Optional Progress reporter object. If NULL, no
+ * progress reporting.
+ * @return the instrument that was created
+ */
+Instrument_sptr InstrumentDefinitionParser::parseXMLOrCache(
+    Kernel::ProgressBase *progressReporter) {
+  const std::string checksum = getMangledName();
+  if (checksum.empty())
+    return parseXML(progressReporter);
+
+  IDFObject_const_sptr cacheFile =
+      boost::make_shared<const IDFObject>(createInstrumentCacheFileName());
+  IDFObject_const_sptr fallBackCache = boost::make_shared<const IDFObject>(
+      Poco::Path(ConfigService::Instance().getTempDir())
+          .append(checksum + ".idfcache")
+          .toString());
+  for (const auto &cache : {cacheFile, fallBackCache}) {
+    if (!cache->exists())
+      continue;
+    const std::string cacheFullPath = cache->getFileFullPathStr();
+    std::vector<boost::shared_ptr<Object>> shapes;
+    auto instrument =
+        InstrumentCache::read(cacheFullPath, checksum, *m_instrument, shapes);
+    if (instrument) {
+      g_log.information("Loading instrument from cache " + cacheFullPath);
+      m_instrument = instrument;
+      // The shapes are keyed by type name only for the geometry cache
+      mapTypeNameToShape.clear();
+      for (size_t i = 0; i < shapes.size(); ++i)
+        mapTypeNameToShape["shape" + std::to_string(i)] = shapes[i];
+      m_cachingOption = setupGeometryCache();
+      return m_instrument;
+    }
+  }
+
+  auto instrument = parseXML(progressReporter);
+  if (InstrumentCache::isCachable(*instrument))
+    writeInstrumentCache(checksum, cacheFile, fallBackCache);
+  return instrument;
+}
+
 /**
  * Collect some information about types for later use including:
  * - populate directory getTypeElement
@@ -2509,6 +2556,34 @@ InstrumentDefinitionParser::writeAndApplyCache(
   return cachingOption;
 }
 
+/**
+Write the instrument cache file. Failing to write the cache is not an error:
+the instrument is simply parsed again next time.
+@param checksum : Mangled name of the IDF the instrument was built from.
+@param firstChoiceCache : File location for a first choice cache.
+@param fallBackCache : File location for a fallback cache if required.
+*/
+void InstrumentDefinitionParser::writeInstrumentCache(
+    const std::string &checksum, IDFObject_const_sptr firstChoiceCache,
+    IDFObject_const_sptr fallBackCache) {
+  IDFObject_const_sptr usedCache = firstChoiceCache;
+  try {
+    Poco::File dir = usedCache->getParentDirectory();
+    if (dir.path().empty() || !dir.exists() || !dir.canWrite())
+      usedCache = fallBackCache;
+    const std::string cacheFullPath = usedCache->getFileFullPathStr();
+    g_log.information() << "Creating instrument cache in " << cacheFullPath
+                        << "\n";
+    InstrumentCache::write(*m_instrument, checksum, cacheFullPath);
+  } catch (Poco::Exception &e) {
+    g_log.warning() << "Unable to write instrument cache: " << e.displayText()
+                    << "\n";
+  } catch (std::exception &e) {
+    g_log.warning() << "Unable to write instrument cache: " << e.what()
+                    << "\n";
+  }
+}
+
 /** Reads in or creates the geometry cache ('vtp') file
 @return CachingOption selected.
 */
@@ -2967,6 +3042,23 @@ const std::string InstrumentDefinitionParser::createVTPFileName() {
   return retVal;
 }
 
+/** Generates an instrument cache filename from a xml filename
+*
+*  @return The instrument cache filename
+*
+*/
+const std::string InstrumentDefinitionParser::createInstrumentCacheFileName() {
+  std::string retVal;
+  std::string filename = getMangledName();
+  if (!filename.empty()) {
+    Poco::Path path(ConfigService::Instance().getVTPFileDirectory());
+    path.makeDirectory();
+    path.append(filename + ".idfcache");
+    retVal = path.toString();
+  }
+  return retVal;
+}
+
 /** Return a subelement of an XML element, but also checks that there exist
  *exactly one entry
  *  of this subelement.
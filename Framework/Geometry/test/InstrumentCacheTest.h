@@ -0,0 +1,157 @@
+#ifndef MANTID_GEOMETRY_INSTRUMENTCACHETEST_H_
+#define MANTID_GEOMETRY_INSTRUMENTCACHETEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidGeometry/Instrument.h"
+#include "MantidGeometry/Instrument/InstrumentCache.h"
+#include "MantidGeometry/Instrument/InstrumentDefinitionParser.h"
+#include "MantidGeometry/Instrument/ReferenceFrame.h"
+#include "MantidGeometry/Objects/Object.h"
+#include "MantidKernel/ConfigService.h"
+#include "MantidKernel/MantidVersion.h"
+#include "MantidKernel/Strings.h"
+
+#include <Poco/File.h>
+#include <Poco/Path.h>
+
+#include <boost/make_shared.hpp>
+
+#include <fstream>
+
+using namespace Mantid::Geometry;
+using Mantid::Kernel::ConfigService;
+using Mantid::detid_t;
+
+class InstrumentCacheTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static InstrumentCacheTest *createSuite() { return new InstrumentCacheTest(); }
+  static void destroySuite(InstrumentCacheTest *suite) { delete suite; }
+
+  InstrumentCacheTest()
+      : m_cacheFile(Poco::Path(ConfigService::Instance().getTempDir())
+                        .append("InstrumentCacheTest.idfcache")
+                        .toString()) {}
+
+  ~InstrumentCacheTest() override {
+    Poco::File file(m_cacheFile);
+    if (file.exists())
+      file.remove();
+  }
+
+  void test_instrument_is_rebuilt_from_cache() {
+    auto original = parse("IDF_for_UNIT_TESTING2.xml");
+    TS_ASSERT(InstrumentCache::isCachable(*original));
+    TS_ASSERT_THROWS_NOTHING(
+        InstrumentCache::write(*original, "checksum", m_cacheFile));
+
+    std::vector<boost::shared_ptr<Object>> shapes;
+    auto cached = InstrumentCache::read(m_cacheFile, "checksum",
+                                        *prototype(*original), shapes);
+    TS_ASSERT(cached);
+    if (!cached)
+      return;
+    TS_ASSERT(!shapes.empty());
+    TS_ASSERT_EQUALS(cached->getName(), original->getName());
+    TS_ASSERT_EQUALS(cached->getDefaultView(), original->getDefaultView());
+    TS_ASSERT_EQUALS(cached->getValidFromDate(), original->getValidFromDate());
+    TS_ASSERT_EQUALS(cached->getValidToDate(), original->getValidToDate());
+    TS_ASSERT_EQUALS(cached->getReferenceFrame()->pointingUp(),
+                     original->getReferenceFrame()->pointingUp());
+    TS_ASSERT_EQUALS(cached->getReferenceFrame()->pointingAlongBeam(),
+                     original->getReferenceFrame()->pointingAlongBeam());
+
+    TS_ASSERT_EQUALS(cached->getSource()->getName(),
+                     original->getSource()->getName());
+    TS_ASSERT_EQUALS(cached->getSource()->getPos(),
+                     original->getSource()->getPos());
+    TS_ASSERT_EQUALS(cached->getSample()->getPos(),
+                     original->getSample()->getPos());
+
+    const auto ids = original->getDetectorIDs();
+    TS_ASSERT_EQUALS(cached->getDetectorIDs(), ids);
+    TS_ASSERT_EQUALS(cached->getMonitors(), original->getMonitors());
+    for (const detid_t id : ids) {
+      auto cachedDet = cached->getDetector(id);
+      auto originalDet = original->getDetector(id);
+      TS_ASSERT_EQUALS(cachedDet->getName(), originalDet->getName());
+      TS_ASSERT_DELTA(cachedDet->getPos().distance(originalDet->getPos()), 0.0,
+                      1e-12);
+      TS_ASSERT_EQUALS(cachedDet->getRotation(), originalDet->getRotation());
+    }
+
+    TS_ASSERT_EQUALS(cached->getLogfileCache().size(),
+                     original->getLogfileCache().size());
+    TS_ASSERT_EQUALS(cached->getLogfileUnit(), original->getLogfileUnit());
+  }
+
+  void test_read_returns_null_if_checksum_differs() {
+    auto original = parse("IDF_for_UNIT_TESTING2.xml");
+    InstrumentCache::write(*original, "checksum", m_cacheFile);
+
+    std::vector<boost::shared_ptr<Object>> shapes;
+    TS_ASSERT(!InstrumentCache::read(m_cacheFile, "other",
+                                     *prototype(*original), shapes));
+  }
+
+  void test_read_returns_null_if_written_by_another_revision() {
+    const std::string revision =
+        Mantid::Kernel::MantidVersion::revisionFull();
+    TS_ASSERT(!revision.empty());
+    if (revision.empty())
+      return;
+    auto original = parse("IDF_for_UNIT_TESTING2.xml");
+    InstrumentCache::write(*original, "checksum", m_cacheFile);
+    // Change the first character of the revision, which follows the magic
+    // number, the version, the endian marker and the length of the string
+    {
+      std::fstream file(m_cacheFile,
+                        std::ios::in | std::ios::out | std::ios::binary);
+      file.seekp(24);
+      file.put(revision[0] == '0' ? '1' : '0');
+    }
+
+    std::vector<boost::shared_ptr<Object>> shapes;
+    TS_ASSERT(!InstrumentCache::read(m_cacheFile, "checksum",
+                                     *prototype(*original), shapes));
+  }
+
+  void test_read_returns_null_if_file_does_not_exist() {
+    auto original = parse("IDF_for_UNIT_TESTING2.xml");
+    std::vector<boost::shared_ptr<Object>> shapes;
+    TS_ASSERT(!InstrumentCache::read(m_cacheFile + ".missing", "checksum",
+                                     *prototype(*original), shapes));
+  }
+
+  void test_rectangular_detectors_are_not_cachable() {
+    auto instrument = parse("IDF_for_RECTANGULAR_UNIT_TESTING.xml");
+    TS_ASSERT(!InstrumentCache::isCachable(*instrument));
+    TS_ASSERT_THROWS(
+        InstrumentCache::write(*instrument, "checksum", m_cacheFile),
+        std::invalid_argument);
+  }
+
+private:
+  boost::shared_ptr<Instrument> parse(const std::string &name) {
+    const std::string filename =
+        ConfigService::Instance().getInstrumentDirectory() +
+        "/IDFs_for_UNIT_TESTING/" + name;
+    const std::string xmlText = Mantid::Kernel::Strings::loadFile(filename);
+    InstrumentDefinitionParser parser(filename, "For Unit Testing", xmlText);
+    return parser.parseXML(nullptr);
+  }
+
+  /// An empty instrument as created by the parser before parsing
+  boost::shared_ptr<Instrument> prototype(const Instrument &instrument) {
+    auto result = boost::make_shared<Instrument>(instrument.getName());
+    result->setFilename(instrument.getFilename());
+    result->setXmlText(instrument.getXmlText());
+    return result;
+  }
+
+  const std::string m_cacheFile;
+};
+
+#endif /* MANTID_GEOMETRY_INSTRUMENTCACHETEST_H_ */
@@ -0,0 +1,114 @@
+#ifndef MANTID_HISTOGRAMDATA_COLLECTIVES_H_
+#define MANTID_HISTOGRAMDATA_COLLECTIVES_H_
+
+#include "MantidHistogramData/HistogramE.h"
+#include "MantidHistogramData/HistogramY.h"
+#include "MantidParallel/Collectives.h"
+
+#include <stdexcept>
+
+namespace Mantid {
+namespace Parallel {
+
+/** Overloads of the collective operations of MantidParallel/Collectives.h for
+  HistogramY and HistogramE. They work directly on the underlying buffer, so
+  with MPI the data is reduced or broadcast as a plain array of doubles
+  without serialization and without intermediate copies.
+
+  Output arguments must have the same length as the input on all ranks, since
+  the length of HistogramY and HistogramE cannot be changed.
+
+  Copyright &copy; 2017 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+namespace detail {
+template <class T> int checkedSize(const T &in, const T &out) {
+  if (in.size() != out.size())
+    throw std::length_error("Parallel: Input and output of collective "
+                            "operation must have the same length.");
+  return static_cast<int>(in.size());
+}
+
+template <class T> const double *constBuffer(const T &values) {
+  return values.rawData().data();
+}
+
+template <class T> double *buffer(T &values) {
+  return values.empty() ? nullptr : &values[0];
+}
+}
+
+template <typename Op>
+void reduce(const Communicator &comm, const HistogramData::HistogramY &in,
+            HistogramData::HistogramY &out, Op op, int root) {
+  reduce(comm, detail::constBuffer(in), detail::checkedSize(in, out),
+         detail::buffer(out), op, root);
+}
+
+template <typename Op>
+void reduce(const Communicator &comm, const HistogramData::HistogramY &in,
+            Op op, int root) {
+  reduce(comm, detail::constBuffer(in), static_cast<int>(in.size()), op, root);
+}
+
+template <typename Op>
+void all_reduce(const Communicator &comm, const HistogramData::HistogramY &in,
+                HistogramData::HistogramY &out, Op op) {
+  all_reduce(comm, detail::constBuffer(in), detail::checkedSize(in, out),
+             detail::buffer(out), op);
+}
+
+inline void broadcast(const Communicator &comm,
+                      HistogramData::HistogramY &values, int root) {
+  broadcast(comm, detail::buffer(values), static_cast<int>(values.size()),
+            root);
+}
+
+template <typename Op>
+void reduce(const Communicator &comm, const HistogramData::HistogramE &in,
+            HistogramData::HistogramE &out, Op op, int root) {
+  reduce(comm, detail::constBuffer(in), detail::checkedSize(in, out),
+         detail::buffer(out), op, root);
+}
+
+template <typename Op>
+void reduce(const Communicator &comm, const HistogramData::HistogramE &in,
+            Op op, int root) {
+  reduce(comm, detail::constBuffer(in), static_cast<int>(in.size()), op, root);
+}
+
+template <typename Op>
+void all_reduce(const Communicator &comm, const HistogramData::HistogramE &in,
+                HistogramData::HistogramE &out, Op op) {
+  all_reduce(comm, detail::constBuffer(in), detail::checkedSize(in, out),
+             detail::buffer(out), op);
+}
+
+inline void broadcast(const Communicator &comm,
+                      HistogramData::HistogramE &values, int root) {
+  broadcast(comm, detail::buffer(values), static_cast<int>(values.size()),
+            root);
+}
+
+} // namespace Parallel
+} // namespace Mantid
+
+#endif /* MANTID_HISTOGRAMDATA_COLLECTIVES_H_ */
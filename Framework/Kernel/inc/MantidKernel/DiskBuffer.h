@@ -81,7 +81,7 @@ public:
   virtual ~DiskBuffer() = default;
 
   void toWrite(ISaveable *item);
-  void flushCache();
+  virtual void flushCache();
   void objectDeleted(ISaveable *item);
 
   // Free space map methods
@@ -134,6 +134,7 @@ public:
 
 protected:
   inline void writeOldObjects();
+  virtual void writesIssued(ISaveable *lastSaved);
 
   // ----------------------- To-write buffer
   // --------------------------------------
@@ -2,6 +2,7 @@
 #define MANTID_KERNEL_MULTITHREADED_H_
 
 #include "MantidKernel/DataItem.h"
+#include "MantidKernel/TaskRuntime.h"
 
 #include <atomic>
 #include <mutex>
@@ -60,7 +61,6 @@ threadSafe(const Arg &workspace, Args &&... others) {
 }
 
 /** Uses std::compare_exchange_weak to update the atomic value f = op(f, d)
- * Used to improve parallel scaling in algorithms MDNormDirectSC and MDNormSCD
  * @param f atomic variable being updated
  * @param d second element in binary operation
  * @param op binary operation on elements f and d
@@ -125,20 +125,26 @@ void AtomicOp(std::atomic<T> &f, T d, BinaryOp op) {
 
 #include <omp.h>
 
+// The number of threads of the parallel regions below follows the
+// concurrency of the TaskRuntime. It is 1 inside a task of the runtime, so
+// that nested loops do not start new threads.
+
 /** Includes code to add OpenMP commands to run the next for loop in parallel.
 *   This includes an arbirary check: condition.
 *   "condition" must evaluate to TRUE in order for the
 *   code to be executed in parallel
 */
 #define PARALLEL_FOR_IF(condition)                                             \
-    PRAGMA(omp parallel for if (condition) )
+    PRAGMA(omp parallel for if (condition)                                     \
+           num_threads(Mantid::Kernel::TaskRuntime::loopThreads()))
 
 /** Includes code to add OpenMP commands to run the next for loop in parallel.
 *   This includes no checks to see if workspaces are suitable
 *   and therefore should not be used in any loops that access workspaces.
 */
 #define PARALLEL_FOR_NO_WSP_CHECK()                                            \
-    PRAGMA(omp parallel for)
+    PRAGMA(omp parallel for                                                    \
+           num_threads(Mantid::Kernel::TaskRuntime::loopThreads()))
 
 /** Includes code to add OpenMP commands to run the next for loop in parallel.
  *  and declare the varialbes to be firstprivate.
@@ -146,10 +152,12 @@ void AtomicOp(std::atomic<T> &f, T d, BinaryOp op) {
  *  and therefore should not be used in any loops that access workspace.
  */
 #define PARALLEL_FOR_NOWS_CHECK_FIRSTPRIVATE(variable)                         \
-  PRAGMA(omp parallel for firstprivate(variable) )
+  PRAGMA(omp parallel for firstprivate(variable)                               \
+             num_threads(Mantid::Kernel::TaskRuntime::loopThreads()))
 
 #define PARALLEL_FOR_NO_WSP_CHECK_FIRSTPRIVATE2(variable1, variable2)          \
-  PRAGMA(omp parallel for firstprivate(variable1, variable2) )
+  PRAGMA(omp parallel for firstprivate(variable1, variable2)                   \
+             num_threads(Mantid::Kernel::TaskRuntime::loopThreads()))
 
 /** Ensures that the next execution line or block is only executed if
 * there are multple threads execting in this region
@@ -186,7 +194,8 @@ void AtomicOp(std::atomic<T> &f, T d, BinaryOp op) {
 
 #define PARALLEL_THREAD_NUMBER omp_get_thread_num()
 
-#define PARALLEL PRAGMA(omp parallel)
+#define PARALLEL                                                               \
+  PRAGMA(omp parallel num_threads(Mantid::Kernel::TaskRuntime::loopThreads()))
 
 #define PARALLEL_SECTIONS PRAGMA(omp sections nowait)
 
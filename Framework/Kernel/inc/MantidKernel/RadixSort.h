@@ -0,0 +1,108 @@
+#ifndef MANTID_KERNEL_RADIXSORT_H_
+#define MANTID_KERNEL_RADIXSORT_H_
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace Mantid {
+namespace Kernel {
+
+/** RadixSort : Least-significant-digit radix sort on 64 bit keys.
+
+  Values are sorted by an unsigned 64 bit key computed from each value with
+  a functor. The sort works on one byte of the key at a time, from the least
+  significant byte up, and is stable. The counts for all digits are made in a
+  single pass over the data, and passes in which all keys share the same digit
+  are skipped, so keys that only use the low bytes (e.g. times-of-flight in a
+  bounded range) cost fewer passes.
+
+  Copyright &copy; 2017 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+
+/** Map a double to an unsigned key with the same ordering. Positive values
+ * get their sign bit set, negative values have all bits flipped.
+ * @param value :: the value to map, not NaN
+ * @return the key
+ */
+inline uint64_t radixKey(const double value) {
+  uint64_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  const uint64_t signBit = uint64_t(1) << 63;
+  return (bits & signBit) ? ~bits : (bits | signBit);
+}
+
+/** Map a signed integer to an unsigned key with the same ordering.
+ * @param value :: the value to map
+ * @return the key
+ */
+inline uint64_t radixKey(const int64_t value) {
+  return static_cast<uint64_t>(value) ^ (uint64_t(1) << 63);
+}
+
+/** Sort values by the key given by a functor. The sort is stable.
+ * @param values :: the values to sort
+ * @param key :: functor returning the uint64_t key of a value
+ */
+template <typename T, typename KeyFunction>
+void radixSort(std::vector<T> &values, KeyFunction key) {
+  const size_t numValues = values.size();
+  if (numValues < 2)
+    return;
+
+  constexpr size_t numBytes = sizeof(uint64_t);
+  std::array<std::array<size_t, 256>, numBytes> counts{};
+  for (const auto &value : values) {
+    const uint64_t k = key(value);
+    for (size_t byte = 0; byte < numBytes; ++byte)
+      ++counts[byte][(k >> (8 * byte)) & 0xff];
+  }
+
+  std::vector<T> buffer;
+  for (size_t byte = 0; byte < numBytes; ++byte) {
+    auto &count = counts[byte];
+    // All keys have the same digit: this pass would not move anything
+    const uint64_t firstDigit = (key(values.front()) >> (8 * byte)) & 0xff;
+    if (count[firstDigit] == numValues)
+      continue;
+
+    // Turn the counts into the position of the first value of each digit
+    size_t offset = 0;
+    for (auto &c : count) {
+      const size_t n = c;
+      c = offset;
+      offset += n;
+    }
+
+    if (buffer.empty())
+      buffer.resize(numValues);
+    for (const auto &value : values)
+      buffer[count[(key(value) >> (8 * byte)) & 0xff]++] = value;
+    values.swap(buffer);
+  }
+}
+
+} // namespace Kernel
+} // namespace Mantid
+
+#endif /* MANTID_KERNEL_RADIXSORT_H_ */
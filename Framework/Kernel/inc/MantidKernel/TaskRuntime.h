@@ -0,0 +1,131 @@
+#ifndef MANTID_KERNEL_TASKRUNTIME_H_
+#define MANTID_KERNEL_TASKRUNTIME_H_
+
+#include "MantidKernel/DllConfig.h"
+
+#include <functional>
+#include <memory>
+
+namespace Mantid {
+namespace Kernel {
+
+/** TaskRuntime : The process-wide work-stealing runtime that runs the
+  parallel work of Mantid, built on task arenas of TBB.
+
+  - execute() runs a function in the runtime. TBB algorithms called by the
+    function, e.g., tbb::parallel_sort, use the workers of the runtime.
+  - TaskGroup runs independent tasks and waits for them.
+  - Worker runs work which blocks on other work, e.g., a consumer waiting
+    for a producer, on one of the worker threads owned by the runtime.
+    ThreadPool runs its workers on them, since tasks may only wait for tasks
+    they started themselves.
+  - loopThreads() gives the number of threads for the OpenMP loops of the
+    PARALLEL_* macros in MultiThreaded.h.
+
+  maxConcurrency() is the global cap on the number of threads. It defaults
+  to MultiThreaded.MaxCores, or the number of hardware threads if that is
+  not set. A ScopedLimit lowers the concurrency for the work started by the
+  calling thread, e.g., while an algorithm with a NumThreads limit runs.
+  Nested limits can only lower it further.
+
+  Work started from inside a task runs in the arena of that task, and the
+  worker threads are reused by all pools, so nested parallelism does not
+  create OS threads. OpenMP loops inside a task run
+  serially, since a new OpenMP team would compete with the workers.
+
+  Copyright &copy; 2017 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class MANTID_KERNEL_DLL TaskRuntime {
+public:
+  static int hardwareConcurrency();
+  static int maxConcurrency();
+  static void setMaxConcurrency(const int numThreads);
+  static int concurrency();
+  static bool insideTask();
+  static int loopThreads();
+  static void execute(const std::function<void()> &func);
+  static int numWorkerThreads();
+
+  /** Lowers the concurrency for the calling thread while in scope.
+   */
+  class MANTID_KERNEL_DLL ScopedLimit {
+  public:
+    explicit ScopedLimit(const int numThreads);
+    ~ScopedLimit();
+    ScopedLimit(const ScopedLimit &) = delete;
+    ScopedLimit &operator=(const ScopedLimit &) = delete;
+
+  private:
+    int m_previous;
+  };
+
+  /** A group of tasks run by the runtime. A group created outside the
+    runtime starts its tasks right away on the workers of the arena, if it
+    has any; at a concurrency of 1 they only run in wait(). Tasks must
+    therefore not wait for each other or for the caller, such work needs a
+    Thread. A group created inside a task starts its tasks in wait(),
+    isolated from other work of the arena, so that a waiting task cannot
+    pick up work that depends on itself.
+   */
+  class MANTID_KERNEL_DLL TaskGroup {
+  public:
+    TaskGroup();
+    ~TaskGroup();
+    TaskGroup(const TaskGroup &) = delete;
+    TaskGroup &operator=(const TaskGroup &) = delete;
+
+    void run(std::function<void()> func);
+    void wait();
+
+  private:
+    class Impl;
+    std::unique_ptr<Impl> m_impl;
+  };
+
+  /** Runs a function on one of the worker threads owned by the runtime.
+    The runtime starts at most maxConcurrency() of these threads and reuses
+    them. While all of them are busy the function waits in a queue, until a
+    thread is free or until join() or runIfQueued() run it on the calling
+    thread. The function counts as a task with the concurrency of the thread
+    which created the Worker, so parallel work it starts is nested like that
+    of a task.
+   */
+  class MANTID_KERNEL_DLL Worker {
+  public:
+    explicit Worker(std::function<void()> func);
+    ~Worker();
+    Worker(const Worker &) = delete;
+    Worker &operator=(const Worker &) = delete;
+
+    bool runIfQueued();
+    void join();
+
+  private:
+    class Impl;
+    std::unique_ptr<Impl> m_impl;
+  };
+};
+
+} // namespace Kernel
+} // namespace Mantid
+
+#endif /* MANTID_KERNEL_TASKRUNTIME_H_ */
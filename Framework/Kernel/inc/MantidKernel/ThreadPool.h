@@ -2,15 +2,11 @@
 #define THREADPOOL_H_
 
 #include "MantidKernel/DllConfig.h"
+#include "MantidKernel/TaskRuntime.h"
 #include "MantidKernel/ThreadScheduler.h"
+#include <memory>
 #include <vector>
 
-// Forward declares
-
-namespace Poco {
-class Thread;
-}
-
 namespace Mantid {
 namespace Kernel {
 class ProgressBase;
@@ -23,6 +19,13 @@ class ThreadPoolRunnable;
  *
  * This implementation will be slanted towards performing many more
  * Task's than there are available cores, so threads will be reused.
+ *
+ * The workers run as TaskRuntime::Worker's on the worker threads shared by
+ * all pools, as tasks may block waiting for each other or for the thread
+ * feeding the pool. Workers for which no thread is free run on the caller of
+ * joinAll(). A thread which waits for the tasks of its pool before calling
+ * joinAll() therefore needs a free worker thread. Parallel work started by a
+ * task runs in the arenas of the TaskRuntime.
 
   @author Janik Zikovsky, SNS
   @date Feb 7, 2011
@@ -62,6 +65,8 @@ public:
 
   void joinAll();
 
+  size_t getNumThreads() const;
+
   static size_t getNumPhysicalCores();
 
 protected:
@@ -71,11 +76,11 @@ protected:
   /// The ThreadScheduler instance taking care of task scheduling
   ThreadScheduler *m_scheduler;
 
-  /// Vector with all the threads that are started
-  std::vector<Poco::Thread *> m_threads;
+  /// The workers running the runnables
+  std::vector<std::unique_ptr<TaskRuntime::Worker>> m_workers;
 
-  /// Vector of the POCO-required classes to actually run in a thread.
-  std::vector<ThreadPoolRunnable *> m_runnables;
+  /// The runnables looking for tasks, one for each worker.
+  std::vector<std::unique_ptr<ThreadPoolRunnable>> m_runnables;
 
   /// Have the threads started?
   bool m_started;
@@ -9,8 +9,11 @@
 #include "MantidKernel/ITimeSeriesProperty.h"
 #include "MantidKernel/Property.h"
 #include "MantidKernel/Statistics.h"
+#include <atomic>
 #include <cstdint>
+#include <mutex>
 #include <utility>
+#include <vector>
 
 // Forward declare
 namespace NeXus {
@@ -90,8 +93,34 @@ public:
 };
 //========================================================================================================
 
+/**
+   A sparse index of the sorted times of a TimeSeriesProperty. The first
+   lookup after the times have changed creates it under a lock, so that
+   threads can look up values of the same log concurrently. A copy starts
+   out empty and is created again when it is first needed.
+ */
+class MANTID_KERNEL_DLL TimeSeriesIndex {
+public:
+  TimeSeriesIndex() = default;
+  TimeSeriesIndex(const TimeSeriesIndex &) {}
+  TimeSeriesIndex &operator=(const TimeSeriesIndex &);
+  /// Forget the index after the times have changed
+  void clear();
+  /// Get every step-th time, creating the index if needed
+  const std::vector<int64_t> &get(const std::vector<int64_t> &times,
+                                  const size_t step);
+
+private:
+  std::vector<int64_t> m_times;
+  std::atomic<bool> m_built{false};
+  std::mutex m_mutex;
+};
+//========================================================================================================
+
 /**
    A specialised Property class for holding a series of time-value pairs.
+   The times and the values are held in separate arrays, so that searching
+   the times and summing over ranges of values work on contiguous memory.
 
    Copyright &copy; 2007-2010 ISIS Rutherford Appleton Laboratory, NScD Oak
    Ridge National Laboratory & European Spallation Source
@@ -203,6 +232,12 @@ public:
   /// Return the series as list of times, where the time is the number of
   /// seconds since the start.
   std::vector<double> timesAsVectorSeconds() const;
+  /// Return the sorted times in nanoseconds without copying them
+  const std::vector<int64_t> &timesInNanoseconds() const;
+  /// Return the values in the order of the sorted times without copying them
+  const std::vector<TYPE> &valuesInTimeOrder() const;
+  /// Return the ranges of indices of the sorted entries which pass the filter
+  std::vector<std::pair<size_t, size_t>> filteredIndexRanges() const;
 
   /// Add a value to the map using a DateAndTime object
   void addValue(const Kernel::DateAndTime &time, const TYPE value);
@@ -308,7 +343,10 @@ public:
   /**Reserve memory for efficient adding values to existing property
     * makes sense only when you have reasonably precise estimate of the
     * total size you'll need easily available in advance.  */
-  void reserve(size_t size) { m_values.reserve(size); };
+  void reserve(size_t size) {
+    m_times.reserve(size);
+    m_values.reserve(size);
+  };
 
   /// If filtering by log, get the time intervals for splitting
   std::vector<Mantid::Kernel::SplittingInterval> getSplittingIntervals() const;
@@ -321,6 +359,8 @@ private:
   void sortIfNecessary() const;
   ///  Find the index of the entry of time t in the mP vector (sorted)
   int findIndex(Kernel::DateAndTime t) const;
+  /// Find the first entry at or after a time in nanoseconds (sorted)
+  size_t lowerBound(const int64_t t) const;
   ///  Find the upper_bound of time t in container.
   int upperBound(Kernel::DateAndTime t, int istart, int iend) const;
   /// Apply a filter
@@ -333,8 +373,12 @@ private:
   /// Find if time lies in a filtered region
   bool isTimeFiltered(const Kernel::DateAndTime &time) const;
 
-  /// Holds the time series data
-  mutable std::vector<TimeValueUnit<TYPE>> m_values;
+  /// The times of the entries in nanoseconds, in the order of m_values
+  mutable std::vector<int64_t> m_times;
+  /// The values of the entries
+  mutable std::vector<TYPE> m_values;
+  /// Every TIME_INDEX_STEP-th sorted time, created when it is needed
+  mutable TimeSeriesIndex m_timeIndex;
 
   /// The number of values (or time intervals) in the time series. It can be
   /// different from m_propertySeries.size()
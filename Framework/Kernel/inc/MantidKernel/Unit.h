@@ -5,6 +5,8 @@
 // Includes
 //----------------------------------------------------------------------
 #include "MantidKernel/UnitLabel.h"
+#include <cfloat>
+#include <cmath>
 #include <vector>
 #ifndef Q_MOC_RUN
 #include <boost/shared_ptr.hpp>
@@ -45,6 +47,50 @@ namespace Kernel {
     File change history is stored at: <https://github.com/mantidproject/mantid>.
     Code Documentation is available at: <http://doxygen.mantidproject.org>
 */
+/** A conversion of the form y = factor * (scale * x + shift)^power + offset.
+    Units describe their conversions to and from TOF in this form where they
+    can, so that arrays can be converted without a virtual call per value.
+ */
+struct MANTID_KERNEL_DLL PowerLaw {
+  double factor{1.0};
+  double scale{1.0};
+  double shift{0.0};
+  double power{1.0};
+  double offset{0.0};
+  /// If true, scale * x + shift <= 0 gives outOfRange
+  bool bounded{false};
+  /// Result outside the range if bounded
+  double outOfRange{0.0};
+  /// If true, scale * x + shift == 0 is replaced by DBL_MIN
+  bool protectZero{false};
+
+  /// @return true if the conversion is linear in x
+  bool isLinear() const {
+    return power == 1.0 && !bounded && !protectZero;
+  }
+
+  /// Convert a single value
+  double operator()(const double x) const {
+    double base = scale * x + shift;
+    if (bounded && base <= 0.0)
+      return outOfRange;
+    if (protectZero && base == 0.0)
+      base = DBL_MIN;
+    double y;
+    if (power == 1.0)
+      y = factor * base;
+    else if (power == -1.0)
+      y = factor / base;
+    else if (power == -0.5)
+      y = factor / std::sqrt(base);
+    else if (power == -2.0)
+      y = factor / (base * base);
+    else
+      y = factor * std::pow(base, power);
+    return y + offset;
+  }
+};
+
 class MANTID_KERNEL_DLL Unit {
 public:
   /// (Empty) Constructor
@@ -183,6 +229,18 @@ public:
    */
   virtual double singleFromTOF(const double tof) const = 0;
 
+  /** Get the conversion to TOF, as set up by initialize(), as a PowerLaw
+   * @param law :: set to the coefficients if the conversion has this form
+   * @return true if the conversion can be expressed as a PowerLaw
+   */
+  virtual bool toTOFLaw(PowerLaw &law) const;
+
+  /** Get the conversion from TOF, as set up by initialize(), as a PowerLaw
+   * @param law :: set to the coefficients if the conversion has this form
+   * @return true if the conversion can be expressed as a PowerLaw
+   */
+  virtual bool fromTOFLaw(PowerLaw &law) const;
+
   /// @return true if the unit was initialized and so can use singleToTOF()
   bool isInitialized() const { return initialized; }
 
@@ -303,6 +361,8 @@ public:
   void init() override;
   double singleToTOF(const double x) const override;
   double singleFromTOF(const double tof) const override;
+  bool toTOFLaw(PowerLaw &law) const override;
+  bool fromTOFLaw(PowerLaw &law) const override;
   Unit *clone() const override;
   ///@return -DBL_MAX as ToF convertible to TOF for in any time range
   double conversionTOFMin() const override;
@@ -320,6 +380,8 @@ public:
 
   double singleToTOF(const double x) const override;
   double singleFromTOF(const double tof) const override;
+  bool toTOFLaw(PowerLaw &law) const override;
+  bool fromTOFLaw(PowerLaw &law) const override;
   void init() override;
   Unit *clone() const override;
 
@@ -347,6 +409,8 @@ public:
 
   double singleToTOF(const double x) const override;
   double singleFromTOF(const double tof) const override;
+  bool toTOFLaw(PowerLaw &law) const override;
+  bool fromTOFLaw(PowerLaw &law) const override;
   void init() override;
   Unit *clone() const override;
 
@@ -394,6 +458,8 @@ public:
 
   double singleToTOF(const double x) const override;
   double singleFromTOF(const double tof) const override;
+  bool toTOFLaw(PowerLaw &law) const override;
+  bool fromTOFLaw(PowerLaw &law) const override;
   void init() override;
   Unit *clone() const override;
   double conversionTOFMin() const override;
@@ -444,6 +510,8 @@ public:
 
   double singleToTOF(const double x) const override;
   double singleFromTOF(const double tof) const override;
+  bool toTOFLaw(PowerLaw &law) const override;
+  bool fromTOFLaw(PowerLaw &law) const override;
   void init() override;
   Unit *clone() const override;
   double conversionTOFMin() const override;
@@ -466,6 +534,8 @@ public:
 
   double singleToTOF(const double x) const override;
   double singleFromTOF(const double tof) const override;
+  bool toTOFLaw(PowerLaw &law) const override;
+  bool fromTOFLaw(PowerLaw &law) const override;
   void init() override;
   Unit *clone() const override;
   double conversionTOFMin() const override;
@@ -489,6 +559,8 @@ public:
 
   double singleToTOF(const double x) const override;
   double singleFromTOF(const double tof) const override;
+  bool toTOFLaw(PowerLaw &law) const override;
+  bool fromTOFLaw(PowerLaw &law) const override;
   void init() override;
   Unit *clone() const override;
 
@@ -548,6 +620,8 @@ public:
 
   double singleToTOF(const double ki) const override;
   double singleFromTOF(const double tof) const override;
+  bool toTOFLaw(PowerLaw &law) const override;
+  bool fromTOFLaw(PowerLaw &law) const override;
   void init() override;
   Unit *clone() const override;
   double conversionTOFMin() const override;
@@ -574,6 +648,8 @@ public:
 
   double singleToTOF(const double x) const override;
   double singleFromTOF(const double tof) const override;
+  bool toTOFLaw(PowerLaw &law) const override;
+  bool fromTOFLaw(PowerLaw &law) const override;
   void init() override;
   Unit *clone() const override;
   double conversionTOFMin() const override;
@@ -593,6 +669,8 @@ public:
 
   double singleToTOF(const double x) const override;
   double singleFromTOF(const double tof) const override;
+  bool toTOFLaw(PowerLaw &law) const override;
+  bool fromTOFLaw(PowerLaw &law) const override;
   void init() override;
   Unit *clone() const override;
   double conversionTOFMin() const override;
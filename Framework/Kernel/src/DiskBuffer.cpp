@@ -110,6 +110,16 @@ void DiskBuffer::writeOldObjects() {
   size_t objectsNotWritten(0);
   size_t memoryNotWritten(0);
 
+  // Write the objects in the order of their positions in the file, so that
+  // the writes can be merged; the objects never saved go to new positions
+  m_toWriteBuffer.sort([](const ISaveable *a, const ISaveable *b) {
+    const auto posA = a->wasSaved() ? a->getFilePosition()
+                                    : std::numeric_limits<uint64_t>::max();
+    const auto posB = b->wasSaved() ? b->getFilePosition()
+                                    : std::numeric_limits<uint64_t>::max();
+    return posA < posB;
+  });
+
   // Iterate through the list
   auto it = m_toWriteBuffer.begin();
   auto it_end = m_toWriteBuffer.end();
@@ -170,13 +180,8 @@ void DiskBuffer::writeOldObjects() {
   }
 
   // use last object to clear NeXus buffer and actually write data to HDD
-  if (obj) {
-    // NXS needs to flush the writes to file by closing and re-opening the data
-    // block.
-    // For speed, it is best to do this only once per write dump, using last
-    // object saved
-    obj->flushData();
-  }
+  if (obj)
+    this->writesIssued(obj);
 
   // Exchange with the new map you built out of the not-written blocks.
   m_toWriteBuffer.swap(couldNotWrite);
@@ -184,6 +189,17 @@ void DiskBuffer::writeOldObjects() {
   m_nObjectsToWrite = objectsNotWritten;
 }
 
+//---------------------------------------------------------------------------------------------
+/** Called by writeOldObjects once it has saved the objects of the to-write
+ * buffer. NXS needs to flush the writes to file by closing and re-opening the
+ * data block. For speed, it is best to do this only once per write dump, using
+ * the last object saved. A buffer whose writes are asynchronous can override
+ * this to defer the flush.
+ *
+ * @param lastSaved :: the last object given to the writes
+ */
+void DiskBuffer::writesIssued(ISaveable *lastSaved) { lastSaved->flushData(); }
+
 //---------------------------------------------------------------------------------------------
 /** Flush out all the data in the memory; and writes out everything in the
  * to-write cache. */
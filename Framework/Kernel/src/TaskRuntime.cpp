@@ -0,0 +1,366 @@
+#include "MantidKernel/TaskRuntime.h"
+#include "MantidKernel/ConfigService.h"
+#include "MantidKernel/make_unique.h"
+
+#include "tbb/task_arena.h"
+#include "tbb/task_group.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace Mantid {
+namespace Kernel {
+
+namespace {
+/// Global cap on the number of threads, 0 until first used
+std::atomic<int> g_maxConcurrency(0);
+/// Guards the creation of arenas
+std::mutex g_arenaMutex;
+/// One arena for each concurrency in use. Arenas are never destroyed, so
+/// references to them stay valid when the cap changes.
+std::map<int, std::unique_ptr<tbb::task_arena>> g_arenas;
+
+/// Limit of the calling thread set by ScopedLimit, 0 for no limit
+thread_local int t_limit = 0;
+/// Depth of runtime tasks running on the calling thread
+thread_local int t_taskDepth = 0;
+
+/// Marks the calling thread as running a task of the runtime while in scope
+class TaskScope {
+public:
+  TaskScope() { ++t_taskDepth; }
+  ~TaskScope() { --t_taskDepth; }
+};
+
+/// A function run by the worker threads of the runtime
+struct Job {
+  enum class State { Queued, Running, Done };
+  Job(std::function<void()> f, const int l) : func(std::move(f)), limit(l) {}
+  std::function<void()> func;
+  /// Concurrency of the thread which created the job
+  int limit;
+  State state{State::Queued};
+  /// Exception thrown by the function, if any
+  std::exception_ptr error;
+};
+
+/// Run a job on the calling thread as a task with the job's concurrency
+void runJob(Job &job) {
+  TaskRuntime::ScopedLimit scopedLimit(job.limit);
+  TaskScope scope;
+  try {
+    job.func();
+  } catch (...) {
+    job.error = std::current_exception();
+  }
+}
+
+/** The worker threads owned by the runtime and the jobs waiting for them.
+ * Threads are started on demand, up to the global cap, and never stop.
+ */
+class WorkerThreads {
+public:
+  /// @return the instance. It is never destroyed, so that no thread is
+  /// joined during static destruction.
+  static WorkerThreads &instance() {
+    static auto *threads = new WorkerThreads;
+    return *threads;
+  }
+
+  /// Queue a job. A thread is started for it if none is idle and the cap
+  /// allows another one.
+  void submit(const std::shared_ptr<Job> &job) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_queue.push_back(job);
+    if (m_idle < m_queue.size() &&
+        static_cast<int>(m_threads.size()) < TaskRuntime::maxConcurrency())
+      m_threads.emplace_back(&WorkerThreads::run, this);
+    m_queued.notify_one();
+  }
+
+  /// Take a job out of the queue, so that the caller can run it
+  /// @return false if a thread has already taken the job
+  bool claim(const std::shared_ptr<Job> &job) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (job->state != Job::State::Queued)
+      return false;
+    m_queue.erase(std::find(m_queue.begin(), m_queue.end(), job));
+    job->state = Job::State::Running;
+    return true;
+  }
+
+  /// Mark a job run by a caller as done
+  void finish(const std::shared_ptr<Job> &job) {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      job->state = Job::State::Done;
+    }
+    m_done.notify_all();
+  }
+
+  /// Wait until a job taken by a thread is done
+  void wait(const std::shared_ptr<Job> &job) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_done.wait(lock, [&job]() { return job->state == Job::State::Done; });
+  }
+
+  /// @return the number of threads started so far
+  int numThreads() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return static_cast<int>(m_threads.size());
+  }
+
+private:
+  /// The loop of a worker thread
+  void run() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+      ++m_idle;
+      m_queued.wait(lock, [this]() { return !m_queue.empty(); });
+      --m_idle;
+      auto job = m_queue.front();
+      m_queue.pop_front();
+      job->state = Job::State::Running;
+      lock.unlock();
+      runJob(*job);
+      lock.lock();
+      job->state = Job::State::Done;
+      m_done.notify_all();
+    }
+  }
+
+  std::mutex m_mutex;
+  std::condition_variable m_queued;
+  std::condition_variable m_done;
+  std::deque<std::shared_ptr<Job>> m_queue;
+  std::vector<std::thread> m_threads;
+  /// Number of threads waiting for a job
+  size_t m_idle{0};
+};
+
+/// @return the arena for a concurrency, created on first use
+tbb::task_arena &arenaFor(const int concurrency) {
+  std::lock_guard<std::mutex> lock(g_arenaMutex);
+  auto &arena = g_arenas[concurrency];
+  if (!arena)
+    arena = Kernel::make_unique<tbb::task_arena>(concurrency);
+  return *arena;
+}
+
+/// @return the cap given by MultiThreaded.MaxCores or the hardware
+int defaultMaxConcurrency() {
+  const int hardware = TaskRuntime::hardwareConcurrency();
+  int maxCores(0);
+  const int retVal = ConfigService::Instance().getValue(
+      "MultiThreaded.MaxCores", maxCores);
+  if (retVal > 0 && maxCores > 0)
+    return std::min(maxCores, hardware);
+  return hardware;
+}
+} // namespace
+
+/// @return the number of threads the hardware can run concurrently
+int TaskRuntime::hardwareConcurrency() {
+  return std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+}
+
+/// @return the global cap on the number of threads
+int TaskRuntime::maxConcurrency() {
+  int cap = g_maxConcurrency.load();
+  if (cap == 0) {
+    int unset = 0;
+    g_maxConcurrency.compare_exchange_strong(unset, defaultMaxConcurrency());
+    cap = g_maxConcurrency.load();
+  }
+  return cap;
+}
+
+/** Set the global cap on the number of threads. This also sets the number of
+ * threads of OpenMP. Work that is already running keeps its arena.
+ * @param numThreads :: the cap, 0 or negative for the default
+ */
+void TaskRuntime::setMaxConcurrency(const int numThreads) {
+  const int cap = numThreads > 0 ? numThreads : defaultMaxConcurrency();
+  g_maxConcurrency = cap;
+#ifdef _OPENMP
+  omp_set_num_threads(cap);
+#endif
+}
+
+/// @return the number of threads available to work started by this thread
+int TaskRuntime::concurrency() {
+  const int cap = maxConcurrency();
+  return t_limit > 0 ? std::min(cap, t_limit) : cap;
+}
+
+/// @return true if the calling thread runs a task of the runtime, or is a
+/// worker of a TBB arena
+bool TaskRuntime::insideTask() {
+  return t_taskDepth > 0 || tbb::this_task_arena::current_thread_index() > 0;
+}
+
+/// @return the number of threads for an OpenMP loop started by this thread
+int TaskRuntime::loopThreads() {
+  if (insideTask())
+    return 1;
+#ifdef _OPENMP
+  return std::max(1, std::min(concurrency(), omp_get_max_threads()));
+#else
+  return 1;
+#endif
+}
+
+/** Run a function in the runtime and wait for it. Inside a task the function
+ * runs directly, in the arena of the task.
+ * @param func :: the function to run
+ */
+void TaskRuntime::execute(const std::function<void()> &func) {
+  if (insideTask()) {
+    TaskScope scope;
+    func();
+    return;
+  }
+  arenaFor(concurrency()).execute([&func]() {
+    TaskScope scope;
+    func();
+  });
+}
+
+/// @return the number of worker threads the runtime has started
+int TaskRuntime::numWorkerThreads() {
+  return WorkerThreads::instance().numThreads();
+}
+
+/** Constructor
+ * @param numThreads :: the limit, 0 or negative for no limit
+ */
+TaskRuntime::ScopedLimit::ScopedLimit(const int numThreads)
+    : m_previous(t_limit) {
+  if (numThreads > 0)
+    t_limit = m_previous > 0 ? std::min(m_previous, numThreads) : numThreads;
+}
+
+/// Destructor. Restores the previous limit.
+TaskRuntime::ScopedLimit::~ScopedLimit() { t_limit = m_previous; }
+
+class TaskRuntime::TaskGroup::Impl {
+public:
+  /// Arena of the tasks, null if the group was created inside a task
+  tbb::task_arena *arena{nullptr};
+  tbb::task_group group;
+  /// Tasks of a group created inside a task, started by wait()
+  std::vector<std::function<void()>> deferred;
+};
+
+/// Constructor
+TaskRuntime::TaskGroup::TaskGroup() : m_impl(Kernel::make_unique<Impl>()) {
+  if (!insideTask())
+    m_impl->arena = &arenaFor(concurrency());
+}
+
+/// Destructor. Waits for all tasks.
+TaskRuntime::TaskGroup::~TaskGroup() {
+  try {
+    wait();
+  } catch (...) {
+    // Exceptions are only reported to callers of wait()
+  }
+}
+
+/** Run a task
+ * @param func :: the task
+ */
+void TaskRuntime::TaskGroup::run(std::function<void()> func) {
+  auto task = [func]() {
+    TaskScope scope;
+    func();
+  };
+  if (!m_impl->arena) {
+    m_impl->deferred.emplace_back(std::move(task));
+    return;
+  }
+  auto &group = m_impl->group;
+  m_impl->arena->execute([&group, &task]() { group.run(task); });
+}
+
+/** Wait for all tasks. The calling thread helps to run them.
+ * @throw the first exception thrown by a task
+ */
+void TaskRuntime::TaskGroup::wait() {
+  auto &group = m_impl->group;
+  if (m_impl->arena) {
+    m_impl->arena->execute([&group]() { group.wait(); });
+    return;
+  }
+  auto deferred = std::move(m_impl->deferred);
+  m_impl->deferred.clear();
+  tbb::this_task_arena::isolate([&group, &deferred]() {
+    for (auto &task : deferred)
+      group.run(task);
+    group.wait();
+  });
+}
+
+class TaskRuntime::Worker::Impl {
+public:
+  std::shared_ptr<Job> job;
+};
+
+/** Constructor. Queues the function for a worker thread.
+ * @param func :: the function to run
+ */
+TaskRuntime::Worker::Worker(std::function<void()> func)
+    : m_impl(Kernel::make_unique<Impl>()) {
+  m_impl->job = std::make_shared<Job>(std::move(func), concurrency());
+  WorkerThreads::instance().submit(m_impl->job);
+}
+
+/// Destructor. Waits for the function, or runs it if no thread took it.
+TaskRuntime::Worker::~Worker() {
+  try {
+    join();
+  } catch (...) {
+    // Exceptions are only reported to callers of join()
+  }
+}
+
+/** Run the function on the calling thread, unless a worker thread has
+ * already taken it.
+ * @return true if the function ran on the calling thread
+ */
+bool TaskRuntime::Worker::runIfQueued() {
+  auto &threads = WorkerThreads::instance();
+  if (!threads.claim(m_impl->job))
+    return false;
+  runJob(*m_impl->job);
+  threads.finish(m_impl->job);
+  return true;
+}
+
+/** Wait for the function to finish. It runs on the calling thread if no
+ * worker thread has taken it yet.
+ * @throw the exception thrown by the function, if any
+ */
+void TaskRuntime::Worker::join() {
+  if (!runIfQueued())
+    WorkerThreads::instance().wait(m_impl->job);
+  if (m_impl->job->error) {
+    auto error = m_impl->job->error;
+    m_impl->job->error = nullptr;
+    std::rethrow_exception(error);
+  }
+}
+
+} // namespace Kernel
+} // namespace Mantid
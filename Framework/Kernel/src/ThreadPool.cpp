@@ -3,21 +3,12 @@
 //----------------------------------------------------------------------
 #include "MantidKernel/ThreadPool.h"
 
-#include "MantidKernel/ConfigService.h"
-#include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/ProgressBase.h"
 #include "MantidKernel/Task.h"
 #include "MantidKernel/ThreadPoolRunnable.h"
+#include "MantidKernel/make_unique.h"
 
-#include <Poco/Thread.h>
-
-#include <algorithm>
 #include <stdexcept>
-#include <sstream>
-// needed on windows and any place missing openmp
-#if defined(_WIN32) || !defined(_OPENMP)
-#include <Poco/Environment.h>
-#endif
 
 namespace Mantid {
 namespace Kernel {
@@ -27,9 +18,8 @@ namespace Kernel {
  *
  * @param scheduler :: an instance of a ThreadScheduler to schedule tasks.
  *        NOTE: The ThreadPool destructor will delete this ThreadScheduler.
- * @param numThreads :: number of cores to use; default = 0, meaning auto-detect
- *all
- *        available physical cores.
+ * @param numThreads :: number of workers to use; default = 0, meaning the
+ *        concurrency of the TaskRuntime for the calling thread.
  * @param prog :: optional pointer to a Progress reporter object. If passed,
  *then
  *        automatic progress reporting will be handled by the thread pool.
@@ -42,18 +32,18 @@ ThreadPool::ThreadPool(ThreadScheduler *scheduler, size_t numThreads,
     throw std::invalid_argument(
         "NULL ThreadScheduler passed to ThreadPool constructor.");
 
-  if (numThreads == 0) {
-    // Uses Poco to find how many cores there are.
-    m_numThreads = getNumPhysicalCores();
-  } else
+  if (numThreads == 0)
+    m_numThreads = static_cast<size_t>(TaskRuntime::concurrency());
+  else
     m_numThreads = numThreads;
-  // std::cout << m_numThreads << " m_numThreads \n";
 }
 
 //--------------------------------------------------------------------------------
 /** Destructor. Deletes the ThreadScheduler.
  */
 ThreadPool::~ThreadPool() {
+  // Wait for any running workers before deleting what they use
+  m_workers.clear();
   if (m_scheduler)
     delete m_scheduler;
   if (m_prog)
@@ -61,25 +51,16 @@ ThreadPool::~ThreadPool() {
 }
 
 //--------------------------------------------------------------------------------
-/** Return the number of physical cores available on the system.
- * NOTE: Uses OPENMP or Poco::Environment::processorCount() to find the number.
- * @return how many cores are present.
+/// @return the number of workers the pool runs
+size_t ThreadPool::getNumThreads() const { return m_numThreads; }
+
+//--------------------------------------------------------------------------------
+/** Return the number of cores available to Mantid.
+ * @return the global concurrency cap of the TaskRuntime, set by
+ * MultiThreaded.MaxCores.
  */
 size_t ThreadPool::getNumPhysicalCores() {
-// windows hangs with openmp for some reason
-#if defined(_WIN32) || !defined(_OPENMP)
-  int physicalCores = Poco::Environment::processorCount();
-#else
-  int physicalCores = PARALLEL_GET_MAX_THREADS;
-#endif
-
-  int maxCores(0);
-  int retVal = Kernel::ConfigService::Instance().getValue(
-      "MultiThreaded.MaxCores", maxCores);
-  if (retVal > 0 && maxCores > 0)
-    return std::min(maxCores, physicalCores);
-  else
-    return physicalCores;
+  return static_cast<size_t>(TaskRuntime::maxConcurrency());
 }
 
 //--------------------------------------------------------------------------------
@@ -97,28 +78,15 @@ void ThreadPool::start(double waitSec) {
   if (m_started)
     throw std::runtime_error("Threads have already started.");
 
-  // Delete any old threads (they should NOT be running!)
-  for (auto &thread : m_threads)
-    delete thread;
-  for (auto &runnable : m_runnables)
-    delete runnable;
-
-  // Now, launch that many threads and let them wait for new tasks.
-  m_threads.clear();
+  // Now, launch that many workers and let them wait for new tasks.
+  m_workers.clear();
   m_runnables.clear();
   for (size_t i = 0; i < m_numThreads; i++) {
-    // Make a descriptive name
-    std::ostringstream name;
-    name << "Thread" << i;
-    // Create the thread
-    Poco::Thread *thread = new Poco::Thread(name.str());
-    m_threads.push_back(thread);
-
-    // Make the runnable object and run it
-    auto runnable = new ThreadPoolRunnable(i, m_scheduler, m_prog, waitSec);
-    m_runnables.push_back(runnable);
-
-    thread->start(*runnable);
+    m_runnables.push_back(Kernel::make_unique<ThreadPoolRunnable>(
+        i, m_scheduler, m_prog, waitSec));
+    auto runnable = m_runnables.back().get();
+    m_workers.push_back(Kernel::make_unique<TaskRuntime::Worker>(
+        [runnable]() { runnable->run(); }));
   }
   // Yep, all the threads are running.
   m_started = true;
@@ -159,34 +127,29 @@ bool compareTasks(Task *lhs, Task *rhs) { return (lhs->cost() > rhs->cost()); }
  *        gets downgraded to runtime_error.
  */
 void ThreadPool::joinAll() {
-  // Are the threads REALLY started, or did they exit due to lack of tasks?
-  if (m_started) {
-    m_started = false;
-    // If any of the threads are running, then YES, it is really started.
-    for (auto &thread : m_threads)
-      m_started = m_started || thread->isRunning();
-  }
-
   // Start all the threads if they were not already.
   if (!m_started)
     this->start();
 
-  // Clear any wait times so that the threads stop waiting for new tasks.
-  for (auto &runnable : m_runnables)
-    runnable->clearWait();
-
-  // Sequentially join all the threads.
-  for (auto &thread : m_threads) {
-    thread->join();
-    delete thread;
+  while (true) {
+    // Clear any wait times so that the threads stop waiting for new tasks.
+    for (auto &runnable : m_runnables)
+      runnable->clearWait();
+    // Help with the workers no worker thread has taken yet
+    for (auto &worker : m_workers)
+      worker->runIfQueued();
+    for (auto &worker : m_workers)
+      worker->join();
+    // The workers exit when they run out of tasks. Tasks scheduled after that
+    // need another round of workers.
+    if (m_scheduler->empty() || m_scheduler->getAborted())
+      break;
+    m_started = false;
+    this->start();
   }
 
-  // Clear the vectors (the threads are deleted now).
-  m_threads.clear();
-
-  // Get rid of the runnables too
-  for (auto &runnable : m_runnables)
-    delete runnable;
+  // Get rid of the workers and runnables
+  m_workers.clear();
   m_runnables.clear();
 
   // This will make threads restart
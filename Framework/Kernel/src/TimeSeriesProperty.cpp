@@ -8,11 +8,68 @@
 
 #include <boost/regex.hpp>
 
+#include <numeric>
+
 namespace Mantid {
 namespace Kernel {
 namespace {
 /// static Logger definition
 Logger g_log("TimeSeriesProperty");
+
+/// The number of sorted times between two entries of the time index
+const size_t TIME_INDEX_STEP = 256;
+
+/** Sum values weighted by the time until the next entry
+ * @param times :: times in nanoseconds
+ * @param values :: the values at the times
+ * @param begin :: index of the first value to sum
+ * @param end :: index past the last value to sum. times[end] must exist.
+ * @return the sum of values[i] * (times[i + 1] - times[i]) in nanoseconds
+ */
+template <typename TYPE>
+double timeWeightedSum(const std::vector<int64_t> &times,
+                       const std::vector<TYPE> &values, size_t begin,
+                       size_t end) {
+  double sum = 0.0;
+  for (size_t i = begin; i < end; ++i) {
+    sum += static_cast<double>(times[i + 1] - times[i]) *
+           static_cast<double>(values[i]);
+  }
+  return sum;
+}
+}
+
+TimeSeriesIndex &TimeSeriesIndex::operator=(const TimeSeriesIndex &) {
+  clear();
+  return *this;
+}
+
+/** Forget the index. This must not run concurrently with get().
+ */
+void TimeSeriesIndex::clear() {
+  m_built.store(false, std::memory_order_release);
+  m_times.clear();
+}
+
+/** Get the index, creating it by the first call after the times changed.
+ * @param times :: the sorted times in nanoseconds
+ * @param step :: the number of times between two entries of the index
+ * @return every step-th time, starting with the first
+ */
+const std::vector<int64_t> &
+TimeSeriesIndex::get(const std::vector<int64_t> &times, const size_t step) {
+  if (!m_built.load(std::memory_order_acquire)) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_built.load(std::memory_order_relaxed)) {
+      m_times.clear();
+      m_times.reserve(times.size() / step + 1);
+      for (size_t i = 0; i < times.size(); i += step) {
+        m_times.push_back(times[i]);
+      }
+      m_built.store(true, std::memory_order_release);
+    }
+  }
+  return m_times;
 }
 
 /**
@@ -21,8 +78,9 @@ Logger g_log("TimeSeriesProperty");
  */
 template <typename TYPE>
 TimeSeriesProperty<TYPE>::TimeSeriesProperty(const std::string &name)
-    : Property(name, typeid(std::vector<TimeValueUnit<TYPE>>)), m_values(),
-      m_size(), m_propSortedFlag(), m_filterApplied() {}
+    : Property(name, typeid(std::vector<TimeValueUnit<TYPE>>)), m_times(),
+      m_values(), m_timeIndex(), m_size(), m_propSortedFlag(),
+      m_filterApplied() {}
 
 /// Virtual destructor
 template <typename TYPE> TimeSeriesProperty<TYPE>::~TimeSeriesProperty() {}
@@ -72,17 +130,15 @@ TimeSeriesProperty<TYPE>::getDerivative() const {
   }
 
   this->sortIfNecessary();
-  auto it = this->m_values.begin();
-  int64_t t0 = it->time().totalNanoseconds();
-  TYPE v0 = it->value();
+  int64_t t0 = m_times[0];
+  TYPE v0 = m_values[0];
 
-  it++;
   auto timeSeriesDeriv = Kernel::make_unique<TimeSeriesProperty<double>>(
       this->name() + "_derivative");
   timeSeriesDeriv->reserve(this->m_values.size() - 1);
-  for (; it != m_values.end(); it++) {
-    TYPE v1 = it->value();
-    int64_t t1 = it->time().totalNanoseconds();
+  for (size_t i = 1; i < m_values.size(); ++i) {
+    TYPE v1 = m_values[i];
+    int64_t t1 = m_times[i];
     if (t1 != t0) {
       double deriv = 1.e+9 * (double(v1 - v0) / double(t1 - t0));
       int64_t tm = static_cast<int64_t>((t1 + t0) / 2);
@@ -134,8 +190,10 @@ operator+=(Property const *right) {
 
   if (rhs) {
     if (this->operator!=(*rhs)) {
+      m_times.insert(m_times.end(), rhs->m_times.begin(), rhs->m_times.end());
       m_values.insert(m_values.end(), rhs->m_values.begin(),
                       rhs->m_values.end());
+      m_timeIndex.clear();
       m_propSortedFlag = TimeSeriesSortStatus::TSUNKNOWN;
     } else {
       // Do nothing if appending yourself to yourself. The net result would be
@@ -266,25 +324,23 @@ void TimeSeriesProperty<TYPE>::filterByTime(const Kernel::DateAndTime &start,
   if (m_values.size() <= 1)
     return;
 
-  typename std::vector<TimeValueUnit<TYPE>>::iterator iterhead, iterend;
-
   // 2. Determine index for start and remove  Note erase is [...)
   int istart = this->findIndex(start);
   if (istart >= 0 && static_cast<size_t>(istart) < m_values.size()) {
     // "start time" is behind time-series's starting time
-    iterhead = m_values.begin() + istart;
 
     // False - The filter time is on the mark.  Erase [begin(),  istart)
     // True - The filter time is larger than T[istart]. Erase[begin(), istart)
     // ...
     //       filter start(time) and move istart to filter startime
-    bool useprefiltertime = !(m_values[istart].time() == start);
+    bool useprefiltertime = m_times[istart] != start.totalNanoseconds();
 
     // Remove the series
-    m_values.erase(m_values.begin(), iterhead);
+    m_times.erase(m_times.begin(), m_times.begin() + istart);
+    m_values.erase(m_values.begin(), m_values.begin() + istart);
 
     if (useprefiltertime) {
-      m_values[0].setTime(start);
+      m_times[0] = start.totalNanoseconds();
     }
   } else {
     // "start time" is before/after time-series's starting time: do nothing
@@ -294,16 +350,17 @@ void TimeSeriesProperty<TYPE>::filterByTime(const Kernel::DateAndTime &start,
   // 3. Determine index for end and remove  Note erase is [...)
   int iend = this->findIndex(stop);
   if (static_cast<size_t>(iend) < m_values.size()) {
-    if (m_values[iend].time() == stop) {
-      // Filter stop is on a log.  Delete that log
-      iterend = m_values.begin() + iend;
-    } else {
+    size_t newSize = static_cast<size_t>(iend);
+    if (m_times[newSize] != stop.totalNanoseconds()) {
       // Filter stop is behind iend. Keep iend
-      iterend = m_values.begin() + iend + 1;
+      ++newSize;
     }
+    // Otherwise filter stop is on a log.  Delete that log
     // Delete from [iend to mp.end)
-    m_values.erase(iterend, m_values.end());
+    m_times.resize(newSize);
+    m_values.erase(m_values.begin() + newSize, m_values.end());
   }
+  m_timeIndex.clear();
 
   // 4. Make size consistent
   m_size = static_cast<int>(m_values.size());
@@ -326,9 +383,10 @@ void TimeSeriesProperty<TYPE>::filterByTimes(
   }
 
   // 3. Prepare a copy
-  std::vector<TimeValueUnit<TYPE>> mp_copy;
+  std::vector<int64_t> times_copy;
+  std::vector<TYPE> values_copy;
 
-  g_log.debug() << "DB541  mp_copy Size = " << mp_copy.size()
+  g_log.debug() << "DB541  mp_copy Size = " << values_copy.size()
                 << "  Original MP Size = " << m_values.size() << "\n";
 
   // 4. Create new
@@ -352,7 +410,7 @@ void TimeSeriesProperty<TYPE>::filterByTimes(
     } else if (tstopindex >= int(m_values.size())) {
       tstopindex = int(m_values.size()) - 1;
     } else {
-      if (t_stop == m_values[size_t(tstopindex)].time() &&
+      if (t_stop.totalNanoseconds() == m_times[size_t(tstopindex)] &&
           size_t(tstopindex) > 0) {
         tstopindex--;
       }
@@ -363,25 +421,23 @@ void TimeSeriesProperty<TYPE>::filterByTimes(
       g_log.warning() << "Memory Leak In SplitbyTime!\n";
     }
 
-    if (tstartindex == tstopindex) {
-      TimeValueUnit<TYPE> temp(t_start, m_values[tstartindex].value());
-      mp_copy.push_back(temp);
-    } else {
-      mp_copy.emplace_back(t_start, m_values[tstartindex].value());
-      for (size_t im = size_t(tstartindex + 1); im <= size_t(tstopindex);
-           ++im) {
-        mp_copy.emplace_back(m_values[im].time(), m_values[im].value());
-      }
+    times_copy.push_back(t_start.totalNanoseconds());
+    values_copy.push_back(m_values[tstartindex]);
+    if (tstartindex < tstopindex) {
+      times_copy.insert(times_copy.end(), m_times.begin() + tstartindex + 1,
+                        m_times.begin() + tstopindex + 1);
+      values_copy.insert(values_copy.end(), m_values.begin() + tstartindex + 1,
+                         m_values.begin() + tstopindex + 1);
     }
   } // ENDFOR
 
-  g_log.debug() << "DB530  Filtered Log Size = " << mp_copy.size()
+  g_log.debug() << "DB530  Filtered Log Size = " << values_copy.size()
                 << "  Original Log Size = " << m_values.size() << "\n";
 
-  // 5. Clear
-  m_values.clear();
-  m_values = mp_copy;
-  mp_copy.clear();
+  // 5. Replace
+  m_times.swap(times_copy);
+  m_values.swap(values_copy);
+  m_timeIndex.clear();
 
   m_size = static_cast<int>(m_values.size());
 }
@@ -421,12 +477,15 @@ void TimeSeriesProperty<TYPE>::splitByTime(
       outputs_tsp.push_back(myOutput);
       if (this->m_values.size() == 1) {
         // Special case for TSP with a single entry = just copy.
+        myOutput->m_times = this->m_times;
         myOutput->m_values = this->m_values;
         myOutput->m_size = 1;
       } else {
+        myOutput->m_times.clear();
         myOutput->m_values.clear();
         myOutput->m_size = 0;
       }
+      myOutput->m_timeIndex.clear();
     } else {
       outputs_tsp.push_back(nullptr);
     }
@@ -464,13 +523,14 @@ void TimeSeriesProperty<TYPE>::splitByTime(
     }
 
     // Skip the events before the start of the time
-    while (i_property < m_values.size() && m_values[i_property].time() < start)
+    const int64_t startNs = start.totalNanoseconds();
+    while (i_property < m_values.size() && m_times[i_property] < startNs)
       ++i_property;
 
     if (i_property == m_values.size()) {
       // i_property is out of the range. Then use the last entry
-      myOutput->addValue(m_values[i_property - 1].time(),
-                         m_values[i_property - 1].value());
+      myOutput->addValue(DateAndTime(m_times[i_property - 1]),
+                         m_values[i_property - 1]);
 
       ++itspl;
       ++counter;
@@ -478,21 +538,22 @@ void TimeSeriesProperty<TYPE>::splitByTime(
     }
 
     // The current entry is within an interval. Record them until out
-    if (m_values[i_property].time() > start && i_property > 0 && !isPeriodic) {
+    if (m_times[i_property] > startNs && i_property > 0 && !isPeriodic) {
       // Record the previous oneif this property is not exactly on start time
       //   and this entry is not recorded
       size_t i_prev = i_property - 1;
       if (myOutput->size() == 0 ||
-          m_values[i_prev].time() != myOutput->lastTime())
-        myOutput->addValue(m_values[i_prev].time(), m_values[i_prev].value());
+          DateAndTime(m_times[i_prev]) != myOutput->lastTime())
+        myOutput->addValue(DateAndTime(m_times[i_prev]), m_values[i_prev]);
     }
 
     // Loop through all the entries until out.
-    while (i_property < m_values.size() && m_values[i_property].time() < stop) {
+    const int64_t stopNs = stop.totalNanoseconds();
+    while (i_property < m_values.size() && m_times[i_property] < stopNs) {
 
       // Copy the log out to the output
-      myOutput->addValue(m_values[i_property].time(),
-                         m_values[i_property].value());
+      myOutput->addValue(DateAndTime(m_times[i_property]),
+                         m_values[i_property]);
       ++i_property;
     }
 
@@ -626,18 +687,18 @@ void TimeSeriesProperty<TYPE>::splitByTimeVector(
       if (outputs[target]->size() == 0 ||
           outputs[target]->lastTime() < tsp_time_vec[index_tsp_time]) {
         // avoid to add duplicate entry
-        outputs[target]->addValue(m_values[index_tsp_time].time(),
-                                  m_values[index_tsp_time].value());
+        outputs[target]->addValue(tsp_time_vec[index_tsp_time],
+                                  m_values[index_tsp_time]);
       }
 
       const size_t nextTspIndex = index_tsp_time + 1;
       if (nextTspIndex < tspTimeVecSize) {
         if (tsp_time_vec[nextTspIndex] > split_stop_time) {
           // next entry is out of this splitter: add the next one and quit
-          if (outputs[target]->lastTime() < m_values[nextTspIndex].time()) {
+          if (outputs[target]->lastTime() < tsp_time_vec[nextTspIndex]) {
             // avoid the duplicate cases occurred in fast frequency issue
-            outputs[target]->addValue(m_values[nextTspIndex].time(),
-                                      m_values[nextTspIndex].value());
+            outputs[target]->addValue(tsp_time_vec[nextTspIndex],
+                                      m_values[nextTspIndex]);
           }
           // FIXME - in future, need to find out WHETHER there is way to
           // skip the
@@ -728,48 +789,43 @@ void TimeSeriesProperty<TYPE>::makeFilterByValue(
   // 1. Sort
   sortIfNecessary();
 
-  // 2. Do the rest
+  // 2. Mark the good values. This loop has no branches, so that it can be
+  // vectorised.
+  const size_t n = m_values.size();
+  std::vector<char> good(n);
+  for (size_t i = 0; i < n; ++i) {
+    good[i] = (m_values[i] >= min) && (m_values[i] <= max);
+  }
+
+  // 3. Only the times where good and bad values swap are looked at
   bool lastGood(false);
   time_duration tol = DateAndTime::durationFromSeconds(TimeTolerance);
-  int numgood = 0;
-  DateAndTime t;
   DateAndTime start, stop;
 
-  for (size_t i = 0; i < m_values.size(); ++i) {
-    const DateAndTime lastTime = t;
-    // The new entry
-    t = m_values[i].time();
-    TYPE val = m_values[i].value();
-
-    // A good value?
-    const bool isGood = ((val >= min) && (val <= max));
-    if (isGood)
-      numgood++;
-
-    if (isGood != lastGood) {
-      // We switched from bad to good or good to bad
-
-      if (isGood) {
-        // Start of a good section. Subtract tolerance from the time if
-        // boundaries are centred.
-        start = centre ? t - tol : t;
-      } else {
-        // End of the good section. Add tolerance to the LAST GOOD time if
-        // boundaries are centred.
-        // Otherwise, use the first 'bad' time.
-        stop = centre ? lastTime + tol : t;
-        split.emplace_back(start, stop, 0);
-        // Reset the number of good ones, for next time
-        numgood = 0;
-      }
-      lastGood = isGood;
+  for (size_t i = 0; i < n; ++i) {
+    const bool isGood = good[i] != 0;
+    if (isGood == lastGood)
+      continue;
+    // We switched from bad to good or good to bad
+    const DateAndTime t(m_times[i]);
+    if (isGood) {
+      // Start of a good section. Subtract tolerance from the time if
+      // boundaries are centred.
+      start = centre ? t - tol : t;
+    } else {
+      // End of the good section. Add tolerance to the LAST GOOD time if
+      // boundaries are centred.
+      // Otherwise, use the first 'bad' time.
+      stop = centre ? DateAndTime(m_times[i - 1]) + tol : t;
+      split.emplace_back(start, stop, 0);
     }
+    lastGood = isGood;
   }
 
-  if (numgood > 0) {
+  if (lastGood) {
     // The log ended on "good" so we need to close it using the last time we
     // found
-    stop = t + tol;
+    stop = DateAndTime(m_times.back()) + tol;
     split.emplace_back(start, stop, 0);
   }
 }
@@ -868,38 +924,43 @@ double TimeSeriesProperty<TYPE>::averageValueInFilter(
 
   // If there's just a single value in the log, return that.
   if (realSize() == 1) {
-    return static_cast<double>(m_values.front().value());
+    return static_cast<double>(m_values.front());
   }
 
   sortIfNecessary();
 
+  // The sum of values times durations in nanoseconds
   double numerator(0.0), totalTime(0.0);
   // Loop through the filter ranges
   for (const auto &time : filter) {
     // Calculate the total time duration (in seconds) within by the filter
     totalTime += time.duration();
 
-    // Get the log value and index at the start time of the filter
+    // Get the index of the log value at the start time of the filter
     int index;
-    double value = getSingleValue(time.start(), index);
-    DateAndTime startTime = time.start();
-
-    while (index < realSize() - 1 && m_values[index + 1].time() < time.stop()) {
-      ++index;
-      numerator +=
-          DateAndTime::secondsFromDuration(m_values[index].time() - startTime) *
-          value;
-      startTime = m_values[index].time();
-      value = static_cast<double>(m_values[index].value());
+    getSingleValue(time.start(), index);
+    const size_t first = static_cast<size_t>(index);
+    // The last entry before the stop time of the filter
+    const int64_t stopTime = time.stop().totalNanoseconds();
+    size_t last = lowerBound(stopTime);
+    last = last > first + 1 ? last - 1 : first;
+
+    // The value at the start of the filter holds until the next entry. The
+    // entries up to the last one hold until the entry after them and the last
+    // one until the end of the filter.
+    int64_t startTime = time.start().totalNanoseconds();
+    if (last > first) {
+      numerator += static_cast<double>(m_times[first + 1] - startTime) *
+                   static_cast<double>(m_values[first]);
+      numerator += timeWeightedSum(m_times, m_values, first + 1, last);
+      startTime = m_times[last];
     }
-
-    // Now close off with the end of the current filter range
-    numerator +=
-        DateAndTime::secondsFromDuration(time.stop() - startTime) * value;
+    numerator += static_cast<double>(stopTime - startTime) *
+                 static_cast<double>(m_values[last]);
   }
 
   // 'Normalise' by the total time
-  return numerator / totalTime;
+  return numerator * 1e-9 / totalTime;
 }
 /** Calculates the time-weighted average of a property.
  *  @return The time-weighted average value of the log.
@@ -951,10 +1012,8 @@ TimeSeriesProperty<TYPE>::valueAsCorrectMap() const {
   // 2. Data Strcture
   std::map<DateAndTime, TYPE> asMap;
 
-  if (!m_values.empty()) {
-    for (size_t i = 0; i < m_values.size(); i++)
-      asMap[m_values[i].time()] = m_values[i].value();
-  }
+  for (size_t i = 0; i < m_values.size(); i++)
+    asMap[DateAndTime(m_times[i])] = m_values[i];
 
   return asMap;
 }
@@ -966,14 +1025,7 @@ TimeSeriesProperty<TYPE>::valueAsCorrectMap() const {
 template <typename TYPE>
 std::vector<TYPE> TimeSeriesProperty<TYPE>::valuesAsVector() const {
   sortIfNecessary();
-
-  std::vector<TYPE> out;
-  out.reserve(m_values.size());
-
-  for (size_t i = 0; i < m_values.size(); i++)
-    out.push_back(m_values[i].value());
-
-  return out;
+  return m_values;
 }
 
 /**
@@ -987,11 +1039,8 @@ std::multimap<DateAndTime, TYPE>
 TimeSeriesProperty<TYPE>::valueAsMultiMap() const {
   std::multimap<DateAndTime, TYPE> asMultiMap;
 
-  if (!m_values.empty()) {
-    for (size_t i = 0; i < m_values.size(); i++)
-      asMultiMap.insert(
-          std::make_pair(m_values[i].time(), m_values[i].value()));
-  }
+  for (size_t i = 0; i < m_values.size(); i++)
+    asMultiMap.emplace(DateAndTime(m_times[i]), m_values[i]);
 
   return asMultiMap;
 }
@@ -1004,14 +1053,7 @@ template <typename TYPE>
 std::vector<DateAndTime> TimeSeriesProperty<TYPE>::timesAsVector() const {
   sortIfNecessary();
 
-  std::vector<DateAndTime> out;
-  out.reserve(m_values.size());
-
-  for (size_t i = 0; i < m_values.size(); i++) {
-    out.push_back(m_values[i].time());
-  }
-
-  return out;
+  return std::vector<DateAndTime>(m_times.begin(), m_times.end());
 }
 
 /**
@@ -1027,14 +1069,35 @@ std::vector<double> TimeSeriesProperty<TYPE>::timesAsVectorSeconds() const {
   std::vector<double> out;
   out.reserve(m_values.size());
 
-  Kernel::DateAndTime start = m_values[0].time();
-  for (size_t i = 0; i < m_values.size(); i++) {
-    out.push_back(DateAndTime::secondsFromDuration(m_values[i].time() - start));
+  const int64_t start = m_times[0];
+  for (size_t i = 0; i < m_times.size(); i++) {
+    out.push_back(static_cast<double>(m_times[i] - start) / 1e9);
   }
 
   return out;
 }
 
+/**
+ * @return the times of the entries in nanoseconds, sorted. The reference is
+ * valid until the property is changed.
+ */
+template <typename TYPE>
+const std::vector<int64_t> &TimeSeriesProperty<TYPE>::timesInNanoseconds()
+    const {
+  sortIfNecessary();
+  return m_times;
+}
+
+/**
+ * @return the values of the entries in the order of timesInNanoseconds(). The
+ * reference is valid until the property is changed.
+ */
+template <typename TYPE>
+const std::vector<TYPE> &TimeSeriesProperty<TYPE>::valuesInTimeOrder() const {
+  sortIfNecessary();
+  return m_values;
+}
+
 /** Add a value to the series.
  *  Added values need not be sequential in time.
  *  @param time   The time
@@ -1043,9 +1106,10 @@ std::vector<double> TimeSeriesProperty<TYPE>::timesAsVectorSeconds() const {
 template <typename TYPE>
 void TimeSeriesProperty<TYPE>::addValue(const Kernel::DateAndTime &time,
                                         const TYPE value) {
-  TimeValueUnit<TYPE> newvalue(time, value);
-  // Add the value to the back of the vector
-  m_values.push_back(newvalue);
+  // Add the value to the back of the vectors
+  m_times.push_back(time.totalNanoseconds());
+  m_values.push_back(value);
+  m_timeIndex.clear();
   // Increment the separate record of the property's size
   m_size++;
 
@@ -1056,11 +1120,11 @@ void TimeSeriesProperty<TYPE>::addValue(const Kernel::DateAndTime &time,
     // First item, must be sorted.
     m_propSortedFlag = TimeSeriesSortStatus::TSSORTED;
   } else if (m_propSortedFlag == TimeSeriesSortStatus::TSUNKNOWN &&
-             m_values.back() < *(m_values.rbegin() + 1)) {
+             m_times.back() < *(m_times.rbegin() + 1)) {
     // Previously unknown and still unknown
     m_propSortedFlag = TimeSeriesSortStatus::TSUNSORTED;
   } else if (m_propSortedFlag == TimeSeriesSortStatus::TSSORTED &&
-             m_values.back() < *(m_values.rbegin() + 1)) {
+             m_times.back() < *(m_times.rbegin() + 1)) {
     // Previously sorted but last added is not in order
     m_propSortedFlag = TimeSeriesSortStatus::TSUNSORTED;
   }
@@ -1105,9 +1169,12 @@ void TimeSeriesProperty<TYPE>::addValues(
     const std::vector<TYPE> &values) {
   size_t length = std::min(times.size(), values.size());
   m_size += static_cast<int>(length);
+  m_times.reserve(m_times.size() + length);
   for (size_t i = 0; i < length; ++i) {
-    m_values.emplace_back(times[i], values[i]);
+    m_times.push_back(times[i].totalNanoseconds());
   }
+  m_values.insert(m_values.end(), values.begin(), values.begin() + length);
+  m_timeIndex.clear();
 
   if (!values.empty())
     m_propSortedFlag = TimeSeriesSortStatus::TSUNKNOWN;
@@ -1141,7 +1208,7 @@ DateAndTime TimeSeriesProperty<TYPE>::lastTime() const {
 
   sortIfNecessary();
 
-  return m_values.rbegin()->time();
+  return DateAndTime(m_times.back());
 }
 
 /** Returns the first value regardless of filter
@@ -1157,7 +1224,7 @@ template <typename TYPE> TYPE TimeSeriesProperty<TYPE>::firstValue() const {
 
   sortIfNecessary();
 
-  return m_values[0].value();
+  return m_values[0];
 }
 
 /** Returns the first time regardless of filter
@@ -1174,7 +1241,7 @@ DateAndTime TimeSeriesProperty<TYPE>::firstTime() const {
 
   sortIfNecessary();
 
-  return m_values[0].time();
+  return DateAndTime(m_times[0]);
 }
 
 /**
@@ -1191,17 +1258,15 @@ template <typename TYPE> TYPE TimeSeriesProperty<TYPE>::lastValue() const {
 
   sortIfNecessary();
 
-  return m_values.rbegin()->value();
+  return m_values.back();
 }
 
 template <typename TYPE> TYPE TimeSeriesProperty<TYPE>::minValue() const {
-  return std::min_element(m_values.begin(), m_values.end(),
-                          TimeValueUnit<TYPE>::valueCmp)->value();
+  return *std::min_element(m_values.begin(), m_values.end());
 }
 
 template <typename TYPE> TYPE TimeSeriesProperty<TYPE>::maxValue() const {
-  return std::max_element(m_values.begin(), m_values.end(),
-                          TimeValueUnit<TYPE>::valueCmp)->value();
+  return *std::max_element(m_values.begin(), m_values.end());
 }
 
 /// Returns the number of values at UNIQUE time intervals in the time series
@@ -1228,8 +1293,8 @@ template <typename TYPE> std::string TimeSeriesProperty<TYPE>::value() const {
   std::stringstream ins;
   for (size_t i = 0; i < m_values.size(); i++) {
     try {
-      ins << m_values[i].time().toSimpleString();
-      ins << "  " << m_values[i].value() << "\n";
+      ins << DateAndTime(m_times[i]).toSimpleString();
+      ins << "  " << m_values[i] << "\n";
     } catch (...) {
       // Some kind of error; for example, invalid year, can occur when
       // converting boost time.
@@ -1254,7 +1319,7 @@ std::vector<std::string> TimeSeriesProperty<TYPE>::time_tValue() const {
 
   for (size_t i = 0; i < m_values.size(); i++) {
     std::stringstream line;
-    line << m_values[i].time().toSimpleString() << " " << m_values[i].value();
+    line << DateAndTime(m_times[i]).toSimpleString() << " " << m_values[i];
     values.push_back(line.str());
   }
 
@@ -1279,14 +1344,14 @@ std::map<DateAndTime, TYPE> TimeSeriesProperty<TYPE>::valueAsMap() const {
   if (m_values.empty())
     return asMap;
 
-  TYPE d = m_values[0].value();
-  asMap[m_values[0].time()] = d;
+  TYPE d = m_values[0];
+  asMap[DateAndTime(m_times[0])] = d;
 
   for (size_t i = 1; i < m_values.size(); i++) {
-    if (m_values[i].value() != d) {
+    if (m_values[i] != d) {
       // Only put entry with different value from last entry to map
-      asMap[m_values[i].time()] = m_values[i].value();
-      d = m_values[i].value();
+      asMap[DateAndTime(m_times[i])] = m_values[i];
+      d = m_values[i];
     }
   }
   return asMap;
@@ -1320,7 +1385,9 @@ TimeSeriesProperty<TYPE>::setDataItem(const boost::shared_ptr<DataItem>) {
  */
 template <typename TYPE> void TimeSeriesProperty<TYPE>::clear() {
   m_size = 0;
+  m_times.clear();
   m_values.clear();
+  m_timeIndex.clear();
 
   m_propSortedFlag = TimeSeriesSortStatus::TSSORTED;
   m_filterApplied = false;
@@ -1335,8 +1402,10 @@ template <typename TYPE> void TimeSeriesProperty<TYPE>::clear() {
  */
 template <typename TYPE> void TimeSeriesProperty<TYPE>::clearOutdated() {
   if (realSize() > 1) {
-    auto lastValue = m_values.back();
+    const int64_t lastTime = m_times.back();
+    const TYPE lastValue = m_values.back();
     clear();
+    m_times.push_back(lastTime);
     m_values.push_back(lastValue);
     m_size = 1;
   }
@@ -1382,20 +1451,20 @@ void TimeSeriesProperty<TYPE>::create(const std::vector<DateAndTime> &new_times,
                                 "for the time and values vectors.");
 
   clear();
-  m_values.reserve(new_times.size());
+  m_times.reserve(new_times.size());
 
   std::size_t num = new_values.size();
 
   m_propSortedFlag = TimeSeriesSortStatus::TSSORTED;
   for (std::size_t i = 0; i < num; i++) {
-    TimeValueUnit<TYPE> newentry(new_times[i], new_values[i]);
-    m_values.push_back(newentry);
+    m_times.push_back(new_times[i].totalNanoseconds());
     if (m_propSortedFlag == TimeSeriesSortStatus::TSSORTED && i > 0 &&
-        new_times[i - 1] > new_times[i]) {
+        m_times[i - 1] > m_times[i]) {
       // Status gets to unsorted
       m_propSortedFlag = TimeSeriesSortStatus::TSUNSORTED;
     }
   }
+  m_values = new_values;
 
   // reset the size
   m_size = static_cast<int>(m_values.size());
@@ -1419,12 +1488,13 @@ TYPE TimeSeriesProperty<TYPE>::getSingleValue(const DateAndTime &t) const {
 
   // 2.
   TYPE value;
-  if (t < m_values[0].time()) {
+  const int64_t tNs = t.totalNanoseconds();
+  if (tNs < m_times[0]) {
     // 1. Out side of lower bound
-    value = m_values[0].value();
-  } else if (t >= m_values.back().time()) {
+    value = m_values[0];
+  } else if (tNs >= m_times.back()) {
     // 2. Out side of upper bound
-    value = m_values.back().value();
+    value = m_values.back();
   } else {
     // 3. Within boundary
     int index = this->findIndex(t);
@@ -1442,7 +1512,7 @@ TYPE TimeSeriesProperty<TYPE>::getSingleValue(const DateAndTime &t) const {
       throw std::logic_error(errss.str());
     }
 
-    value = m_values[static_cast<size_t>(index)].value();
+    value = m_values[static_cast<size_t>(index)];
   }
 
   return value;
@@ -1468,13 +1538,14 @@ TYPE TimeSeriesProperty<TYPE>::getSingleValue(const DateAndTime &t,
 
   // 2.
   TYPE value;
-  if (t < m_values[0].time()) {
+  const int64_t tNs = t.totalNanoseconds();
+  if (tNs < m_times[0]) {
     // 1. Out side of lower bound
-    value = m_values[0].value();
+    value = m_values[0];
     index = 0;
-  } else if (t >= m_values.back().time()) {
+  } else if (tNs >= m_times.back()) {
     // 2. Out side of upper bound
-    value = m_values.back().value();
+    value = m_values.back();
     index = int(m_values.size()) - 1;
   } else {
     // 3. Within boundary
@@ -1493,7 +1564,7 @@ TYPE TimeSeriesProperty<TYPE>::getSingleValue(const DateAndTime &t,
       throw std::logic_error(errss.str());
     }
 
-    value = m_values[static_cast<size_t>(index)].value();
+    value = m_values[static_cast<size_t>(index)];
   }
 
   return value;
@@ -1534,15 +1605,15 @@ TimeInterval TimeSeriesProperty<TYPE>::nthInterval(int n) const {
       ;
     } else if (n == static_cast<int>(m_values.size()) - 1) {
       // 2. Last one by making up an end time.
-      time_duration d =
-          m_values.rbegin()->time() - (m_values.rbegin() + 1)->time();
-      DateAndTime endTime = m_values.rbegin()->time() + d;
-      Kernel::TimeInterval dt(m_values.rbegin()->time(), endTime);
+      const DateAndTime lastT(m_times.back());
+      time_duration d = lastT - DateAndTime(*(m_times.rbegin() + 1));
+      DateAndTime endTime = lastT + d;
+      Kernel::TimeInterval dt(lastT, endTime);
       deltaT = dt;
     } else {
       // 3. Regular
-      DateAndTime startT = m_values[static_cast<std::size_t>(n)].time();
-      DateAndTime endT = m_values[static_cast<std::size_t>(n) + 1].time();
+      DateAndTime startT(m_times[static_cast<std::size_t>(n)]);
+      DateAndTime endT(m_times[static_cast<std::size_t>(n) + 1]);
       TimeInterval dt(startT, endT);
       deltaT = dt;
     }
@@ -1558,8 +1629,8 @@ TimeInterval TimeSeriesProperty<TYPE>::nthInterval(int n) const {
       // 2. n = size of the allowed region, duplicate the last one
       long ind_t1 = static_cast<long>(m_filterQuickRef.back().first);
       long ind_t2 = ind_t1 - 1;
-      Kernel::DateAndTime t1 = (m_values.begin() + ind_t1)->time();
-      Kernel::DateAndTime t2 = (m_values.begin() + ind_t2)->time();
+      Kernel::DateAndTime t1(m_times[ind_t1]);
+      Kernel::DateAndTime t2(m_times[ind_t2]);
       time_duration d = t1 - t2;
       Kernel::DateAndTime t3 = t1 + d;
       Kernel::TimeInterval dt(t1, t3);
@@ -1582,7 +1653,7 @@ TimeInterval TimeSeriesProperty<TYPE>::nthInterval(int n) const {
           m_filter[m_filterQuickRef[refindex].first].first;
       size_t iStartIndex =
           m_filterQuickRef[refindex + 1].first + static_cast<size_t>(diff);
-      Kernel::DateAndTime ltime0 = m_values[iStartIndex].time();
+      Kernel::DateAndTime ltime0(m_times[iStartIndex]);
       if (iStartIndex == 0 && ftime0 < ltime0) {
         // a) Special case that True-filter time starts before log time
         t0 = ltime0;
@@ -1604,7 +1675,7 @@ TimeInterval TimeSeriesProperty<TYPE>::nthInterval(int n) const {
         tf = ftimef;
       } else {
         // b) Using the earlier value of next log entry and next filter entry
-        Kernel::DateAndTime ltimef = m_values[iStopIndex].time();
+        Kernel::DateAndTime ltimef(m_times[iStopIndex]);
         Kernel::DateAndTime ftimef =
             m_filter[m_filterQuickRef[refindex + 3].first].first;
         if (ltimef < ftimef)
@@ -1644,12 +1715,9 @@ template <typename TYPE> TYPE TimeSeriesProperty<TYPE>::nthValue(int n) const {
   if (m_filter.empty()) {
     // 3. Situation 1:  No filter
     if (static_cast<size_t>(n) < m_values.size()) {
-      TimeValueUnit<TYPE> entry = m_values[static_cast<std::size_t>(n)];
-      value = entry.value();
+      value = m_values[static_cast<std::size_t>(n)];
     } else {
-      TimeValueUnit<TYPE> entry =
-          m_values[static_cast<std::size_t>(m_size) - 1];
-      value = entry.value();
+      value = m_values[static_cast<std::size_t>(m_size) - 1];
     }
   } else {
     // 4. Situation 2: There is filter
@@ -1658,7 +1726,7 @@ template <typename TYPE> TYPE TimeSeriesProperty<TYPE>::nthValue(int n) const {
     if (static_cast<size_t>(n) > m_filterQuickRef.back().second + 1) {
       // 1. n >= size of the allowed region
       size_t ilog = (m_filterQuickRef.rbegin() + 1)->first;
-      value = m_values[ilog].value();
+      value = m_values[ilog];
     } else {
       // 2. n < size
       Kernel::DateAndTime t0;
@@ -1671,7 +1739,7 @@ template <typename TYPE> TYPE TimeSeriesProperty<TYPE>::nthValue(int n) const {
       size_t ilog =
           m_filterQuickRef[refindex + 1].first +
           (static_cast<std::size_t>(n) - m_filterQuickRef[refindex].second);
-      value = m_values[ilog].value();
+      value = m_values[ilog];
     } // END-IF-ELSE Cases
   }
 
@@ -1697,7 +1765,7 @@ Kernel::DateAndTime TimeSeriesProperty<TYPE>::nthTime(int n) const {
   if (n < 0 || n >= static_cast<int>(m_values.size()))
     n = static_cast<int>(m_values.size()) - 1;
 
-  return m_values[static_cast<size_t>(n)].time();
+  return DateAndTime(m_times[static_cast<size_t>(n)]);
 }
 
 /* Divide the property into  allowed and disallowed time intervals according to
@@ -1755,12 +1823,14 @@ void TimeSeriesProperty<TYPE>::filterWith(
   // 2b) Get a clean finish
   if (filtervalues.back()) {
     DateAndTime lastTime, nextLastT;
-    if (m_values.back().time() > filtertimes.back()) {
+    const DateAndTime lastLogTime(m_times.back());
+    if (lastLogTime > filtertimes.back()) {
       const size_t nvalues(m_values.size());
       // Last log time is later than last filter time
-      lastTime = m_values.back().time();
-      if (nvalues > 1 && m_values[nvalues - 2].time() > filtertimes.back())
-        nextLastT = m_values[nvalues - 2].time();
+      lastTime = lastLogTime;
+      if (nvalues > 1 &&
+          DateAndTime(m_times[nvalues - 2]) > filtertimes.back())
+        nextLastT = DateAndTime(m_times[nvalues - 2]);
       else
         nextLastT = filtertimes.back();
     } else {
@@ -1770,11 +1840,10 @@ void TimeSeriesProperty<TYPE>::filterWith(
       // If last-but-one filter time is still later than value then previous is
       // this
       // else it is the last value time
-      if (nfilterValues > 1 &&
-          m_values.back().time() > filtertimes[nfilterValues - 2])
+      if (nfilterValues > 1 && lastLogTime > filtertimes[nfilterValues - 2])
         nextLastT = filtertimes[nfilterValues - 2];
       else
-        nextLastT = m_values.back().time();
+        nextLastT = lastLogTime;
     }
 
     time_duration dtime = lastTime - nextLastT;
@@ -1884,30 +1953,29 @@ template <typename TYPE> void TimeSeriesProperty<TYPE>::eliminateDuplicates() {
   // 1. Sort if necessary
   sortIfNecessary();
 
-  // 2. Detect and Remove Duplicated
+  // 2. Detect and Remove Duplicated. The last entry of each time is kept
+  // and moved to its place in one pass.
   size_t numremoved = 0;
-
-  typename std::vector<TimeValueUnit<TYPE>>::iterator vit;
-  vit = m_values.begin() + 1;
-  Kernel::DateAndTime prevtime = m_values.begin()->time();
-  while (vit != m_values.end()) {
-    Kernel::DateAndTime currtime = vit->time();
-    if (prevtime == currtime) {
+  size_t kept = 0;
+  const size_t n = m_values.size();
+  for (size_t i = 0; i < n; ++i) {
+    if (i + 1 < n && m_times[i + 1] == m_times[i]) {
       // Print out warning
-      g_log.debug() << "Entry @ Time = " << prevtime
+      g_log.debug() << "Entry @ Time = " << DateAndTime(m_times[i])
                     << "has duplicate time stamp.  Remove entry with Value = "
-                    << (vit - 1)->value() << "\n";
-
-      // A duplicated entry!
-      vit = m_values.erase(vit - 1);
-
+                    << m_values[i] << "\n";
       numremoved++;
+      continue;
     }
-
-    // b) progress
-    prevtime = currtime;
-    ++vit;
+    if (kept != i) {
+      m_times[kept] = m_times[i];
+      m_values[kept] = m_values[i];
+    }
+    ++kept;
   }
+  m_times.resize(kept);
+  m_values.resize(kept);
+  m_timeIndex.clear();
 
   // update m_size
   countSize();
@@ -1925,7 +1993,7 @@ template <typename TYPE>
 std::string TimeSeriesProperty<TYPE>::toString() const {
   std::stringstream ss;
   for (size_t i = 0; i < m_values.size(); ++i)
-    ss << m_values[i].time() << "\t\t" << m_values[i].value() << "\n";
+    ss << DateAndTime(m_times[i]) << "\t\t" << m_values[i] << "\n";
 
   return ss.str();
 }
@@ -1942,7 +2010,7 @@ std::string TimeSeriesProperty<TYPE>::toString() const {
 template <typename TYPE>
 void TimeSeriesProperty<TYPE>::sortIfNecessary() const {
   if (m_propSortedFlag == TimeSeriesSortStatus::TSUNKNOWN) {
-    bool sorted = is_sorted(m_values.begin(), m_values.end());
+    bool sorted = std::is_sorted(m_times.begin(), m_times.end());
     if (sorted)
       m_propSortedFlag = TimeSeriesSortStatus::TSSORTED;
     else
@@ -1952,7 +2020,23 @@ void TimeSeriesProperty<TYPE>::sortIfNecessary() const {
   if (m_propSortedFlag == TimeSeriesSortStatus::TSUNSORTED) {
     g_log.information(
         "TimeSeriesProperty is not sorted.  Sorting is operated on it. ");
-    std::stable_sort(m_values.begin(), m_values.end());
+    // Sort the order of the entries by time, then put both columns in it
+    std::vector<size_t> order(m_times.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [this](size_t a, size_t b) {
+      return m_times[a] < m_times[b];
+    });
+    std::vector<int64_t> times;
+    std::vector<TYPE> values;
+    times.reserve(order.size());
+    values.reserve(order.size());
+    for (const auto i : order) {
+      times.push_back(m_times[i]);
+      values.push_back(m_values[i]);
+    }
+    m_times.swap(times);
+    m_values.swap(values);
+    m_timeIndex.clear();
     m_propSortedFlag = TimeSeriesSortStatus::TSSORTED;
   }
 }
@@ -1973,24 +2057,48 @@ int TimeSeriesProperty<TYPE>::findIndex(Kernel::DateAndTime t) const {
   sortIfNecessary();
 
   // 2. Extreme value
-  if (t <= m_values[0].time()) {
+  const int64_t tNs = t.totalNanoseconds();
+  if (tNs <= m_times[0]) {
     return -1;
-  } else if (t >= m_values.back().time()) {
+  } else if (tNs >= m_times.back()) {
     return (int(m_values.size()));
   }
 
   // 3. Find by lower_bound()
-  typename std::vector<TimeValueUnit<TYPE>>::const_iterator fid;
-  TimeValueUnit<TYPE> temp(t, m_values[0].value());
-  fid = std::lower_bound(m_values.begin(), m_values.end(), temp);
-
-  int newindex = int(fid - m_values.begin());
-  if (fid->time() > t)
+  int newindex = static_cast<int>(lowerBound(tNs));
+  if (m_times[newindex] > tNs)
     newindex--;
 
   return newindex;
 }
 
+/** Find the first entry at or after a time using the time index. The time
+ * index holds every TIME_INDEX_STEP-th time, so that the binary search only
+ * touches a few cache lines of the times. It is created when it is first
+ * needed after the times have changed, which is safe to do from several
+ * threads at once.
+ * Requirement: the series is sorted.
+ * @param t :: a time in nanoseconds
+ * @return the index of the first entry at or after t, or realSize() if all
+ * entries are before t
+ */
+template <typename TYPE>
+size_t TimeSeriesProperty<TYPE>::lowerBound(const int64_t t) const {
+  const auto &timeIndex = m_timeIndex.get(m_times, TIME_INDEX_STEP);
+
+  // The entry is in the step after the last indexed time before t
+  const auto step = static_cast<size_t>(
+      std::lower_bound(timeIndex.begin(), timeIndex.end(), t) -
+      timeIndex.begin());
+  if (step == 0)
+    return 0;
+  const auto begin = m_times.begin() + (step - 1) * TIME_INDEX_STEP + 1;
+  const auto end =
+      m_times.begin() + std::min(step * TIME_INDEX_STEP, m_times.size());
+  return static_cast<size_t>(std::lower_bound(begin, end, t) -
+                             m_times.begin());
+}
+
 /** Find the upper_bound of time t in container.
  * Search range:  begin+istart to begin+iend
  * Return C[ir] == t or C[ir] > t and C[ir-1] < t
@@ -2012,26 +2120,25 @@ int TimeSeriesProperty<TYPE>::upperBound(Kernel::DateAndTime t, int istart,
   }
 
   // 1. Return instantly if it is out of boundary
-  if (t < (m_values.begin() + istart)->time()) {
+  const int64_t tNs = t.totalNanoseconds();
+  if (tNs < m_times[istart]) {
     return -1;
   }
-  if (t > (m_values.begin() + iend)->time()) {
+  if (tNs > m_times[iend]) {
     return static_cast<int>(m_values.size());
   }
 
   // 2. Sort
   sortIfNecessary();
 
-  // 3. Construct the pair for comparison and do lower_bound()
-  TimeValueUnit<TYPE> temppair(t, m_values[0].value());
-  typename std::vector<TimeValueUnit<TYPE>>::iterator fid;
-  fid = std::lower_bound((m_values.begin() + istart),
-                         (m_values.begin() + iend + 1), temppair);
-  if (fid == m_values.end())
+  // 3. Do lower_bound() on the times
+  auto fid = std::lower_bound((m_times.begin() + istart),
+                              (m_times.begin() + iend + 1), tNs);
+  if (fid == m_times.end())
     throw std::runtime_error("Cannot find data");
 
   // 4. Calculate return value
-  size_t index = size_t(fid - m_values.begin());
+  size_t index = size_t(fid - m_times.begin());
 
   return int(index);
 }
@@ -2090,8 +2197,8 @@ template <typename TYPE> void TimeSeriesProperty<TYPE>::applyFilter() const {
         if (!m_filterQuickRef.empty()) {
           numintervals = m_filterQuickRef.back().second;
         }
-        if (m_filter[ift].first <
-            m_values[static_cast<std::size_t>(icurlog)].time()) {
+        if (m_filter[ift].first.totalNanoseconds() <
+            m_times[static_cast<std::size_t>(icurlog)]) {
           if (icurlog == 0) {
             throw std::logic_error("In this case, icurlog won't be zero! ");
           }
@@ -2200,7 +2307,9 @@ TimeSeriesProperty<TYPE>::setValueFromProperty(const Property &right) {
   if (!prop) {
     return "Could not set value: properties have different type.";
   }
+  m_times = prop->m_times;
   m_values = prop->m_values;
+  m_timeIndex.clear();
   m_size = prop->m_size;
   m_propSortedFlag = prop->m_propSortedFlag;
   m_filter = prop->m_filter;
@@ -2318,12 +2427,12 @@ void TimeSeriesProperty<TYPE>::histogramData(
 
   double dt = (t1 - t0) / static_cast<double>(nPoints);
 
-  for (auto &ev : m_values) {
-    double time = static_cast<double>(ev.time().totalNanoseconds());
+  for (size_t i = 0; i < m_values.size(); ++i) {
+    double time = static_cast<double>(m_times[i]);
     if (time < t0 || time >= t1)
       continue;
     size_t ind = static_cast<size_t>((time - t0) / dt);
-    counts[ind] += static_cast<double>(ev.value());
+    counts[ind] += static_cast<double>(m_values[i]);
   }
 }
 
@@ -2351,21 +2460,59 @@ std::vector<TYPE> TimeSeriesProperty<TYPE>::filteredValuesAsVector() const {
   }
 
   std::vector<TYPE> filteredValues;
+  // Of entries with the same time only the last one is used
+  for (const auto &range : filteredIndexRanges()) {
+    for (size_t i = range.first; i < range.second; ++i) {
+      if (i + 1 == range.second || m_times[i + 1] != m_times[i]) {
+        filteredValues.push_back(m_values[i]);
+      }
+    }
+  }
+
+  return filteredValues;
+}
+
+/**
+ * Get the entries which pass the filter as ranges of indices into the sorted
+ * series, see timesInNanoseconds() and valuesInTimeOrder(). An entry passes if
+ * its time lies in a region where the filter is true, like in
+ * filteredValuesAsVector(). No values are copied.
+ * @returns :: The ranges [begin, end) of the entries which pass the filter
+ */
+template <typename TYPE>
+std::vector<std::pair<size_t, size_t>>
+TimeSeriesProperty<TYPE>::filteredIndexRanges() const {
+  sortIfNecessary();
+  std::vector<std::pair<size_t, size_t>> ranges;
+  const size_t n = m_times.size();
+  if (m_filter.empty()) {
+    if (n > 0)
+      ranges.emplace_back(0, n);
+    return ranges;
+  }
 
   if (!m_filterApplied) {
     applyFilter();
   }
 
-  sortIfNecessary();
-
-  const auto &valueMap = valueAsCorrectMap();
-  for (const auto &entry : valueMap) {
-    if (isTimeFiltered(entry.first)) {
-      filteredValues.push_back(entry.second);
+  // Walk through the times and the filter together. The filter entry which
+  // applies to a time is the last one before it, or the first one if there
+  // is none.
+  size_t iFilter = 0;
+  bool inRange = false;
+  for (size_t i = 0; i < n; ++i) {
+    while (iFilter < m_filter.size() &&
+           m_filter[iFilter].first.totalNanoseconds() < m_times[i])
+      ++iFilter;
+    const bool passes = m_filter[iFilter > 0 ? iFilter - 1 : 0].second;
+    if (passes && !inRange) {
+      ranges.emplace_back(i, n);
+    } else if (!passes && inRange) {
+      ranges.back().second = i;
     }
+    inRange = passes;
   }
-
-  return filteredValues;
+  return ranges;
 }
 
 /**
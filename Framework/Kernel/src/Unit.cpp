@@ -198,6 +198,18 @@ std::pair<double, double> Unit::conversionRange() const {
   return std::pair<double, double>(std::min(u1, u2), std::max(u1, u2));
 }
 
+/// The conversion of a general unit has no PowerLaw form
+bool Unit::toTOFLaw(PowerLaw &law) const {
+  UNUSED_ARG(law);
+  return false;
+}
+
+/// The conversion of a general unit has no PowerLaw form
+bool Unit::fromTOFLaw(PowerLaw &law) const {
+  UNUSED_ARG(law);
+  return false;
+}
+
 namespace Units {
 
 /* =============================================================================
@@ -287,6 +299,16 @@ double TOF::singleFromTOF(const double tof) const {
   return tof;
 }
 
+bool TOF::toTOFLaw(PowerLaw &law) const {
+  law = PowerLaw();
+  return true;
+}
+
+bool TOF::fromTOFLaw(PowerLaw &law) const {
+  law = PowerLaw();
+  return true;
+}
+
 Unit *TOF::clone() const { return new TOF(*this); }
 double TOF::conversionTOFMin() const { return -DBL_MAX; }
 ///@return DBL_MAX as ToF convetanble to TOF for in any time range
@@ -395,6 +417,22 @@ double Wavelength::singleFromTOF(const double tof) const {
   x *= factorFrom;
   return x;
 }
+
+bool Wavelength::toTOFLaw(PowerLaw &law) const {
+  law = PowerLaw();
+  law.factor = factorTo;
+  if (emode == 1 || emode == 2)
+    law.offset = sfpTo;
+  return true;
+}
+
+bool Wavelength::fromTOFLaw(PowerLaw &law) const {
+  law = PowerLaw();
+  law.factor = factorFrom;
+  if (do_sfpFrom)
+    law.shift = -sfpFrom;
+  return true;
+}
 ///@return  Minimal time of flight, which can be reversively converted into
 /// wavelength
 double Wavelength::conversionTOFMin() const {
@@ -471,6 +509,22 @@ double Energy::singleFromTOF(const double tof) const {
   return factorFrom / (temp * temp);
 }
 
+bool Energy::toTOFLaw(PowerLaw &law) const {
+  law = PowerLaw();
+  law.factor = factorTo;
+  law.power = -0.5;
+  law.protectZero = true;
+  return true;
+}
+
+bool Energy::fromTOFLaw(PowerLaw &law) const {
+  law = PowerLaw();
+  law.factor = factorFrom;
+  law.power = -2.0;
+  law.protectZero = true;
+  return true;
+}
+
 Unit *Energy::clone() const { return new Energy(*this); }
 
 // ============================================================================================
@@ -577,6 +631,18 @@ double dSpacing::singleToTOF(const double x) const { return x * factorTo; }
 double dSpacing::singleFromTOF(const double tof) const {
   return tof / factorFrom;
 }
+
+bool dSpacing::toTOFLaw(PowerLaw &law) const {
+  law = PowerLaw();
+  law.factor = factorTo;
+  return true;
+}
+
+bool dSpacing::fromTOFLaw(PowerLaw &law) const {
+  law = PowerLaw();
+  law.factor = 1.0 / factorFrom;
+  return true;
+}
 double dSpacing::conversionTOFMin() const { return 0; }
 double dSpacing::conversionTOFMax() const { return DBL_MAX / factorTo; }
 
@@ -688,6 +754,22 @@ double MomentumTransfer::singleFromTOF(const double tof) const {
   return factorFrom / temp;
 }
 
+bool MomentumTransfer::toTOFLaw(PowerLaw &law) const {
+  law = PowerLaw();
+  law.factor = factorTo;
+  law.power = -1.0;
+  law.protectZero = true;
+  return true;
+}
+
+bool MomentumTransfer::fromTOFLaw(PowerLaw &law) const {
+  law = PowerLaw();
+  law.factor = factorFrom;
+  law.power = -1.0;
+  law.protectZero = true;
+  return true;
+}
+
 double MomentumTransfer::conversionTOFMin() const {
   return factorFrom / DBL_MAX;
 }
@@ -741,6 +823,22 @@ double QSquared::singleFromTOF(const double tof) const {
   return factorFrom / (temp * temp);
 }
 
+bool QSquared::toTOFLaw(PowerLaw &law) const {
+  law = PowerLaw();
+  law.factor = factorTo;
+  law.power = -0.5;
+  law.protectZero = true;
+  return true;
+}
+
+bool QSquared::fromTOFLaw(PowerLaw &law) const {
+  law = PowerLaw();
+  law.factor = factorFrom;
+  law.power = -2.0;
+  law.protectZero = true;
+  return true;
+}
+
 double QSquared::conversionTOFMin() const {
   if (factorTo > 0)
     return factorTo / sqrt(DBL_MAX);
@@ -861,6 +959,36 @@ double DeltaE::singleFromTOF(const double tof) const {
     return DBL_MAX;
 }
 
+bool DeltaE::toTOFLaw(PowerLaw &law) const {
+  if (emode != 1 && emode != 2)
+    return false;
+  law = PowerLaw();
+  law.factor = factorTo;
+  law.scale = emode == 1 ? -1.0 / unitScaling : 1.0 / unitScaling;
+  law.shift = efixed;
+  law.power = -0.5;
+  law.offset = t_other;
+  law.bounded = true;
+  law.outOfRange = DeltaE::conversionTOFMax();
+  return true;
+}
+
+bool DeltaE::fromTOFLaw(PowerLaw &law) const {
+  if (emode != 1 && emode != 2)
+    return false;
+  law = PowerLaw();
+  // (efixed - e2) * unitScaling for direct, (e1 - efixed) * unitScaling for
+  // indirect geometry, with e = factorFrom / (tof - t_otherFrom)^2
+  const double sign = emode == 1 ? -1.0 : 1.0;
+  law.factor = sign * factorFrom * unitScaling;
+  law.shift = -t_otherFrom;
+  law.power = -2.0;
+  law.offset = -sign * efixed * unitScaling;
+  law.bounded = true;
+  law.outOfRange = emode == 1 ? -DBL_MAX : DBL_MAX;
+  return true;
+}
+
 double DeltaE::conversionTOFMin() const {
   double time(
       DBL_MAX); // impossible for elastic, this units do not work for elastic
@@ -1063,6 +1191,25 @@ double Momentum::singleFromTOF(const double tof) const {
   return factorFrom / x;
 }
 
+bool Momentum::toTOFLaw(PowerLaw &law) const {
+  law = PowerLaw();
+  law.factor = factorTo;
+  law.power = -1.0;
+  if (emode == 1 || emode == 2)
+    law.offset = sfpTo;
+  return true;
+}
+
+bool Momentum::fromTOFLaw(PowerLaw &law) const {
+  law = PowerLaw();
+  law.factor = factorFrom;
+  if (do_sfpFrom)
+    law.shift = -sfpFrom;
+  law.power = -1.0;
+  law.protectZero = true;
+  return true;
+}
+
 Unit *Momentum::clone() const { return new Momentum(*this); }
 
 // ============================================================================================
@@ -1114,6 +1261,18 @@ double SpinEchoLength::singleFromTOF(const double tof) const {
   return x;
 }
 
+/// Not a PowerLaw, unlike the Wavelength it derives from
+bool SpinEchoLength::toTOFLaw(PowerLaw &law) const {
+  UNUSED_ARG(law);
+  return false;
+}
+
+/// Not a PowerLaw, unlike the Wavelength it derives from
+bool SpinEchoLength::fromTOFLaw(PowerLaw &law) const {
+  UNUSED_ARG(law);
+  return false;
+}
+
 Unit *SpinEchoLength::clone() const { return new SpinEchoLength(*this); }
 
 // ============================================================================================
@@ -1159,6 +1318,18 @@ double SpinEchoTime::singleFromTOF(const double tof) const {
   return x;
 }
 
+/// Not a PowerLaw, unlike the Wavelength it derives from
+bool SpinEchoTime::toTOFLaw(PowerLaw &law) const {
+  UNUSED_ARG(law);
+  return false;
+}
+
+/// Not a PowerLaw, unlike the Wavelength it derives from
+bool SpinEchoTime::fromTOFLaw(PowerLaw &law) const {
+  UNUSED_ARG(law);
+  return false;
+}
+
 Unit *SpinEchoTime::clone() const { return new SpinEchoTime(*this); }
 
 // ================================================================================
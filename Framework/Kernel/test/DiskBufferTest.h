@@ -14,6 +14,8 @@
 #include <boost/multi_index/sequenced_index.hpp>
 #include <cxxtest/TestSuite.h>
 
+#include <memory>
+
 using namespace Mantid;
 using namespace Mantid::Kernel;
 using Mantid::Kernel::CPUTimer;
@@ -98,6 +100,29 @@ public:
 std::string SaveableTesterWithFile::fakeFile;
 std::mutex SaveableTesterWithFile::streamMutex;
 
+/** An ISaveable that records the order in which the objects are saved */
+class SaveableTesterRecordingOrder : public SaveableTesterWithFile {
+public:
+  using SaveableTesterWithFile::SaveableTesterWithFile;
+  void save() const override {
+    saveOrder += m_ch;
+    SaveableTesterWithFile::save();
+  }
+  static std::string saveOrder;
+};
+std::string SaveableTesterRecordingOrder::saveOrder;
+
+/** A DiskBuffer that counts the write dumps */
+class DiskBufferCountingWrites : public DiskBuffer {
+public:
+  DiskBufferCountingWrites(uint64_t writeBufferSize)
+      : DiskBuffer(writeBufferSize), nWritesIssued(0) {}
+  size_t nWritesIssued;
+
+protected:
+  void writesIssued(ISaveable *) override { ++nWritesIssued; }
+};
+
 //====================================================================================
 class DiskBufferTest : public CxxTest::TestSuite {
 public:
@@ -198,6 +223,29 @@ public:
     TS_ASSERT_EQUALS(SaveableTesterWithFile::fakeFile, "  BBCCDDEEFF      JJ");
   }
 
+  /** The objects are saved in the order of their positions in the file, the
+   * objects which were never saved last */
+  void test_objects_are_saved_in_file_order() {
+    std::vector<std::unique_ptr<SaveableTesterRecordingOrder>> objects;
+    for (char ch : {'C', 'A', 'D', 'B'}) {
+      objects.emplace_back(
+          new SaveableTesterRecordingOrder(uint64_t(2 * (ch - 'A')), 2, ch));
+    }
+    objects.emplace_back(new SaveableTesterRecordingOrder(0, 2, 'E', false));
+
+    DiskBufferCountingWrites dbuf(100);
+    dbuf.setFileLength(8);
+    for (auto &object : objects) {
+      object->setDataChanged();
+      dbuf.toWrite(object.get());
+    }
+    SaveableTesterRecordingOrder::saveOrder.clear();
+    dbuf.flushCache();
+    TS_ASSERT_EQUALS(SaveableTesterRecordingOrder::saveOrder, "ABCDE");
+    TS_ASSERT_EQUALS(dbuf.nWritesIssued, 1);
+    TS_ASSERT_EQUALS(objects.back()->getFilePosition(), 8);
+  }
+
   //--------------------------------------------------------------------------------
   /** If a block will get deleted it needs to be taken
    * out of the caches */
@@ -0,0 +1,78 @@
+#ifndef MANTID_KERNEL_RADIXSORTTEST_H_
+#define MANTID_KERNEL_RADIXSORTTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidKernel/RadixSort.h"
+
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <utility>
+
+using namespace Mantid::Kernel;
+
+class RadixSortTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static RadixSortTest *createSuite() { return new RadixSortTest(); }
+  static void destroySuite(RadixSortTest *suite) { delete suite; }
+
+  void test_double_keys_keep_order() {
+    const std::vector<double> values{-1e300, -2.5, -1.0, -0.0,
+                                     0.0,    1e-300, 1.0, 2.5,
+                                     1e300,  std::numeric_limits<double>::max()};
+    for (size_t i = 1; i < values.size(); ++i)
+      TS_ASSERT_LESS_THAN_EQUALS(radixKey(values[i - 1]), radixKey(values[i]));
+  }
+
+  void test_integer_keys_keep_order() {
+    TS_ASSERT_LESS_THAN(radixKey(std::numeric_limits<int64_t>::min()),
+                        radixKey(int64_t(-1)));
+    TS_ASSERT_LESS_THAN(radixKey(int64_t(-1)), radixKey(int64_t(0)));
+    TS_ASSERT_LESS_THAN(radixKey(int64_t(0)),
+                        radixKey(std::numeric_limits<int64_t>::max()));
+  }
+
+  void test_sort_doubles_matches_std_sort() {
+    std::mt19937 generator(12345);
+    std::uniform_real_distribution<double> distribution(-1000., 20000.);
+    std::vector<double> values(10000);
+    for (auto &value : values)
+      value = distribution(generator);
+    auto expected = values;
+    std::sort(expected.begin(), expected.end());
+
+    radixSort(values, [](double value) { return radixKey(value); });
+    TS_ASSERT_EQUALS(values, expected);
+  }
+
+  void test_sort_is_stable() {
+    std::vector<std::pair<int64_t, int>> values{
+        {3, 0}, {1, 1}, {3, 2}, {-7, 3}, {1, 4}, {3, 5}};
+    radixSort(values, [](const std::pair<int64_t, int> &value) {
+      return radixKey(value.first);
+    });
+    const std::vector<std::pair<int64_t, int>> expected{
+        {-7, 3}, {1, 1}, {1, 4}, {3, 0}, {3, 2}, {3, 5}};
+    TS_ASSERT_EQUALS(values, expected);
+  }
+
+  void test_equal_keys_are_untouched() {
+    std::vector<double> values(100, 42.);
+    radixSort(values, [](double value) { return radixKey(value); });
+    TS_ASSERT_EQUALS(values, std::vector<double>(100, 42.));
+  }
+
+  void test_empty_and_single() {
+    std::vector<double> empty;
+    radixSort(empty, [](double value) { return radixKey(value); });
+    TS_ASSERT(empty.empty());
+    std::vector<double> single{1.5};
+    radixSort(single, [](double value) { return radixKey(value); });
+    TS_ASSERT_EQUALS(single, std::vector<double>{1.5});
+  }
+};
+
+#endif /* MANTID_KERNEL_RADIXSORTTEST_H_ */
@@ -0,0 +1,141 @@
+#ifndef MANTID_KERNEL_TASKRUNTIMETEST_H_
+#define MANTID_KERNEL_TASKRUNTIMETEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidKernel/TaskRuntime.h"
+
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+using Mantid::Kernel::TaskRuntime;
+
+class TaskRuntimeTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static TaskRuntimeTest *createSuite() { return new TaskRuntimeTest(); }
+  static void destroySuite(TaskRuntimeTest *suite) { delete suite; }
+
+  void test_maxConcurrency_is_positive() {
+    TS_ASSERT_LESS_THAN(0, TaskRuntime::hardwareConcurrency());
+    TS_ASSERT_LESS_THAN(0, TaskRuntime::maxConcurrency());
+    TS_ASSERT_EQUALS(TaskRuntime::concurrency(), TaskRuntime::maxConcurrency());
+  }
+
+  void test_ScopedLimit_lowers_concurrency() {
+    const int cap = TaskRuntime::maxConcurrency();
+    {
+      TaskRuntime::ScopedLimit limit(1);
+      TS_ASSERT_EQUALS(TaskRuntime::concurrency(), 1);
+      TS_ASSERT_EQUALS(TaskRuntime::loopThreads(), 1);
+    }
+    TS_ASSERT_EQUALS(TaskRuntime::concurrency(), cap);
+  }
+
+  void test_nested_ScopedLimit_cannot_raise_concurrency() {
+    TaskRuntime::ScopedLimit outer(1);
+    {
+      TaskRuntime::ScopedLimit inner(4);
+      TS_ASSERT_EQUALS(TaskRuntime::concurrency(), 1);
+    }
+    TS_ASSERT_EQUALS(TaskRuntime::concurrency(), 1);
+  }
+
+  void test_ScopedLimit_of_zero_keeps_concurrency() {
+    const int cap = TaskRuntime::maxConcurrency();
+    TaskRuntime::ScopedLimit limit(0);
+    TS_ASSERT_EQUALS(TaskRuntime::concurrency(), cap);
+  }
+
+  void test_execute_runs_inside_a_task() {
+    TS_ASSERT(!TaskRuntime::insideTask());
+    bool inside(false);
+    int loopThreads(0);
+    TaskRuntime::execute([&inside, &loopThreads]() {
+      inside = TaskRuntime::insideTask();
+      loopThreads = TaskRuntime::loopThreads();
+    });
+    TS_ASSERT(inside);
+    TS_ASSERT_EQUALS(loopThreads, 1);
+    TS_ASSERT(!TaskRuntime::insideTask());
+  }
+
+  void test_execute_propagates_exceptions() {
+    TS_ASSERT_THROWS(
+        TaskRuntime::execute([]() { throw std::runtime_error("failed"); }),
+        std::runtime_error);
+    TS_ASSERT(!TaskRuntime::insideTask());
+  }
+
+  void test_TaskGroup_runs_all_tasks() {
+    std::atomic<int> count(0);
+    TaskRuntime::TaskGroup group;
+    for (int i = 0; i < 100; ++i)
+      group.run([&count]() { ++count; });
+    TS_ASSERT_THROWS_NOTHING(group.wait());
+    TS_ASSERT_EQUALS(count.load(), 100);
+  }
+
+  void test_nested_TaskGroup_inside_a_task() {
+    std::atomic<int> count(0);
+    TaskRuntime::TaskGroup outer;
+    for (int i = 0; i < 8; ++i) {
+      outer.run([&count]() {
+        TaskRuntime::TaskGroup inner;
+        for (int j = 0; j < 8; ++j)
+          inner.run([&count]() { ++count; });
+        inner.wait();
+      });
+    }
+    outer.wait();
+    TS_ASSERT_EQUALS(count.load(), 64);
+  }
+
+  void test_Worker_counts_as_a_task_with_the_creators_concurrency() {
+    TaskRuntime::ScopedLimit limit(1);
+    bool inside(false);
+    int concurrency(0);
+    TaskRuntime::Worker worker([&inside, &concurrency]() {
+      inside = TaskRuntime::insideTask();
+      concurrency = TaskRuntime::concurrency();
+    });
+    worker.join();
+    TS_ASSERT(inside);
+    TS_ASSERT_EQUALS(concurrency, 1);
+  }
+
+  void test_Worker_join_rethrows() {
+    TaskRuntime::Worker worker([]() { throw std::runtime_error("failed"); });
+    TS_ASSERT_THROWS(worker.join(), std::runtime_error);
+  }
+
+  void test_Workers_reuse_a_bounded_set_of_threads() {
+    std::atomic<int> count(0);
+    for (int round = 0; round < 4; ++round) {
+      std::vector<std::unique_ptr<TaskRuntime::Worker>> workers;
+      for (int i = 0; i < 16; ++i) {
+        workers.push_back(std::unique_ptr<TaskRuntime::Worker>(
+            new TaskRuntime::Worker([&count]() {
+              TaskRuntime::Worker nested([&count]() { ++count; });
+              nested.join();
+            })));
+      }
+      for (auto &worker : workers)
+        worker->join();
+    }
+    TS_ASSERT_EQUALS(count.load(), 64);
+    TS_ASSERT_LESS_THAN_EQUALS(TaskRuntime::numWorkerThreads(),
+                               TaskRuntime::maxConcurrency());
+  }
+
+  void test_TaskGroup_wait_rethrows() {
+    TaskRuntime::TaskGroup group;
+    group.run([]() { throw std::runtime_error("failed"); });
+    TS_ASSERT_THROWS(group.wait(), std::runtime_error);
+  }
+};
+
+#endif /* MANTID_KERNEL_TASKRUNTIMETEST_H_ */
@@ -14,7 +14,10 @@
 
 #include <boost/bind.hpp>
 #include <boost/make_shared.hpp>
+#include <atomic>
+#include <chrono>
 #include <cstdlib>
+#include <future>
 
 using namespace Mantid::Kernel;
 
@@ -430,6 +433,65 @@ public:
     // And only one of the tasks actually ran (since we're on one core)
     TS_ASSERT_EQUALS(ThreadPoolTest_TaskThatThrows_counter, 1);
   }
+
+  //--------------------------------------------------------------------
+  void test_task_waiting_for_another_task_at_concurrency_1() {
+    TaskRuntime::ScopedLimit limit(1);
+    std::promise<void> signal;
+    auto signalled = signal.get_future();
+    std::atomic<bool> received(false);
+    ThreadPool p(new ThreadSchedulerFIFO(), 2);
+    p.schedule(new FunctionTask([&signalled, &received]() {
+      received = signalled.wait_for(std::chrono::seconds(10)) ==
+                 std::future_status::ready;
+    }));
+    p.schedule(new FunctionTask([&signal]() { signal.set_value(); }));
+    TS_ASSERT_THROWS_NOTHING(p.joinAll());
+    TS_ASSERT(received);
+  }
+
+  /** The thread feeding a pool, e.g., the read stage of LoadEventNexus, may
+   * wait for its tasks, also when it is a task itself */
+  void test_thread_waiting_for_its_task_at_concurrency_1() {
+    TaskRuntime::ScopedLimit limit(1);
+    auto waitForTask = []() {
+      std::promise<void> signal;
+      auto signalled = signal.get_future();
+      ThreadPool p;
+      p.start(10.0);
+      p.schedule(new FunctionTask([&signal]() { signal.set_value(); }));
+      const bool received = signalled.wait_for(std::chrono::seconds(10)) ==
+                            std::future_status::ready;
+      p.joinAll();
+      return received;
+    };
+    TS_ASSERT(waitForTask());
+    bool receivedInTask(false);
+    TaskRuntime::execute(
+        [&receivedInTask, &waitForTask]() { receivedInTask = waitForTask(); });
+    TS_ASSERT(receivedInTask);
+  }
+
+  /** Pools share the worker threads of the TaskRuntime instead of starting
+   * their own */
+  void test_pools_reuse_the_worker_threads_of_the_runtime() {
+    std::atomic<int> count(0);
+    for (int i = 0; i < 8; ++i) {
+      ThreadPool p(new ThreadSchedulerFIFO(), 8);
+      TS_ASSERT_EQUALS(p.getNumThreads(), 8);
+      for (int j = 0; j < 8; ++j) {
+        p.schedule(new FunctionTask([&count]() {
+          ThreadPool nested(new ThreadSchedulerFIFO(), 4);
+          nested.schedule(new FunctionTask([&count]() { ++count; }));
+          nested.joinAll();
+        }));
+      }
+      TS_ASSERT_THROWS_NOTHING(p.joinAll());
+    }
+    TS_ASSERT_EQUALS(count.load(), 64);
+    TS_ASSERT_LESS_THAN_EQUALS(TaskRuntime::numWorkerThreads(),
+                               TaskRuntime::maxConcurrency());
+  }
 };
 
 #endif
@@ -5,6 +5,7 @@
 #include "MantidKernel/TimeSeriesProperty.h"
 #include "MantidKernel/Exception.h"
 #include "MantidKernel/make_unique.h"
+#include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/PropertyWithValue.h"
 #include "MantidKernel/TimeSplitter.h"
 
@@ -2248,6 +2249,89 @@ public:
     TS_ASSERT_EQUALS(filteredValues.size(), 9);
   }
 
+  void test_filteredIndexRanges() {
+    const auto &log = getFilteredTestLog();
+    const auto &ranges = log->filteredIndexRanges();
+    TS_ASSERT_EQUALS(ranges.size(), 2);
+    if (ranges.size() == 2) {
+      TS_ASSERT_EQUALS(ranges[0], std::make_pair(size_t(0), size_t(2)));
+      TS_ASSERT_EQUALS(ranges[1], std::make_pair(size_t(3), size_t(10)));
+    }
+    const auto &unfiltered = getTestLog()->filteredIndexRanges();
+    TS_ASSERT_EQUALS(unfiltered.size(), 1);
+    TS_ASSERT_EQUALS(unfiltered.front(), std::make_pair(size_t(0), size_t(11)));
+  }
+
+  void test_columns_are_sorted_by_time() {
+    TimeSeriesProperty<int> log("IntLog");
+    const DateAndTime start("2007-11-30T16:17:00");
+    log.addValue(start + 20.0, 3);
+    log.addValue(start, 1);
+    log.addValue(start + 10.0, 2);
+
+    const auto &times = log.timesInNanoseconds();
+    const auto &values = log.valuesInTimeOrder();
+    TS_ASSERT_EQUALS(values, std::vector<int>({1, 2, 3}));
+    TS_ASSERT_EQUALS(times.size(), 3);
+    const auto asDates = log.timesAsVector();
+    for (size_t i = 0; i < times.size(); ++i) {
+      TS_ASSERT_EQUALS(times[i], asDates[i].totalNanoseconds());
+    }
+  }
+
+  void test_lookups_in_long_series() {
+    // Longer than several steps of the time index, added in reverse order
+    TimeSeriesProperty<double> log("DoubleLog");
+    const DateAndTime start("2007-11-30T16:17:00");
+    const int n = 1000;
+    for (int i = n - 1; i >= 0; --i) {
+      log.addValue(start + 10.0 * i, static_cast<double>(i));
+    }
+
+    for (int i = 0; i < n; i += 7) {
+      TS_ASSERT_EQUALS(log.getSingleValue(start + 10.0 * i), i);
+      int index = -1;
+      TS_ASSERT_EQUALS(log.getSingleValue(start + (10.0 * i + 5.0), index), i);
+      TS_ASSERT_EQUALS(index, i);
+    }
+    TS_ASSERT_EQUALS(log.getSingleValue(start - 5.0), 0.0);
+    TS_ASSERT_EQUALS(log.getSingleValue(start + 20000.0), n - 1);
+
+    // The value i holds from 10i to 10(i + 1) seconds
+    const double from = 1234.5;
+    const double to = 7654.5;
+    double expected = (1240.0 - from) * 123 + (to - 7650.0) * 765;
+    for (int i = 124; i < 765; ++i) {
+      expected += 10.0 * i;
+    }
+    expected /= to - from;
+    std::vector<SplittingInterval> filter;
+    filter.emplace_back(start + from, start + to);
+    TS_ASSERT_DELTA(log.averageValueInFilter(filter), expected, 1e-9);
+  }
+
+  void test_concurrent_lookups_after_change() {
+    TimeSeriesProperty<int> log("IntLog");
+    const DateAndTime start("2007-11-30T16:17:00");
+    const int n = 5000;
+    for (int i = 0; i < n; ++i) {
+      log.addValue(start + 10.0 * i, i);
+    }
+    log.getSingleValue(start);
+    // Adding a value discards the time index, the lookups create it again
+    log.addValue(start + 10.0 * n, n);
+
+    int wrong = 0;
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int i = 0; i <= n; ++i) {
+      if (log.getSingleValue(start + (10.0 * i + 5.0)) != i) {
+        PARALLEL_ATOMIC
+        ++wrong;
+      }
+    }
+    TS_ASSERT_EQUALS(wrong, 0);
+  }
+
   void test_getSplittingIntervals_noFilter() {
     const auto &log = getTestLog(); // no filter
     const auto &intervals = log->getSplittingIntervals();
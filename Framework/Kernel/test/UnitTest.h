@@ -9,6 +9,7 @@
 #include <boost/lexical_cast.hpp>
 #include <cfloat>
 #include <limits>
+#include <memory>
 
 using namespace Mantid::Kernel;
 using namespace Mantid::Kernel::Units;
@@ -198,6 +199,50 @@ public:
     TS_ASSERT(!t.quickConversion(tof, factor, power));
   }
 
+  void testUnit_no_PowerLaw_by_default() {
+    UnitTester t;
+    PowerLaw law;
+    TS_ASSERT(!t.toTOFLaw(law));
+    TS_ASSERT(!t.fromTOFLaw(law));
+    TS_ASSERT(!Energy_inWavenumber().toTOFLaw(law));
+    TS_ASSERT(!SpinEchoLength().toTOFLaw(law));
+    TS_ASSERT(!SpinEchoTime().fromTOFLaw(law));
+  }
+
+  void testUnit_PowerLaw_matches_single_conversions() {
+    std::vector<std::unique_ptr<Unit>> units;
+    units.emplace_back(new TOF);
+    units.emplace_back(new Wavelength);
+    units.emplace_back(new Energy);
+    units.emplace_back(new dSpacing);
+    units.emplace_back(new MomentumTransfer);
+    units.emplace_back(new QSquared);
+    units.emplace_back(new Momentum);
+    units.emplace_back(new DeltaE);
+    units.emplace_back(new DeltaE_inWavenumber);
+    units.emplace_back(new DeltaE_inFrequency);
+    const std::vector<double> tofs{0.0, 10.0, 1000.0, 20000.0};
+    for (const int emode : {0, 1, 2}) {
+      for (auto &unit : units) {
+        if (emode == 0 && unit->unitID().find("DeltaE") == 0)
+          continue;
+        unit->initialize(10.0, 1.5, 0.7, emode, 25.0, 0.0);
+        PowerLaw toTOF;
+        PowerLaw fromTOF;
+        TS_ASSERT(unit->toTOFLaw(toTOF));
+        TS_ASSERT(unit->fromTOFLaw(fromTOF));
+        for (const double tof : tofs) {
+          const double x = unit->singleFromTOF(tof);
+          TSM_ASSERT_DELTA(unit->unitID(), fromTOF(tof), x,
+                           1e-12 * std::abs(x));
+          const double back = unit->singleToTOF(x);
+          TSM_ASSERT_DELTA(unit->unitID(), toTOF(x), back,
+                           1e-12 * std::abs(back));
+        }
+      }
+    }
+  }
+
   void test_clone() {
     auto unit = Empty().clone();
     TS_ASSERT(dynamic_cast<Empty *>(unit));
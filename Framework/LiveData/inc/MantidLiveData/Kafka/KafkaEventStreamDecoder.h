@@ -1,7 +1,6 @@
 #ifndef MANTID_LIVEDATA_ISISKAFKAEVENTSTREAMDECODER_H_
 #define MANTID_LIVEDATA_ISISKAFKAEVENTSTREAMDECODER_H_
 
-#include "MantidAPI/SpectraDetectorTypes.h"
 #include "MantidDataObjects/EventWorkspace.h"
 #include "MantidLiveData/Kafka/IKafkaBroker.h"
 #include "MantidLiveData/Kafka/IKafkaStreamSubscriber.h"
@@ -21,6 +20,11 @@ namespace LiveData {
   A call to capture() starts the process of capturing the stream on a separate
   thread.
 
+  The events of each message are sorted into blocks of spectra before the
+  buffers are locked, and the blocks are then filled in parallel. The buffers
+  are double buffered: extractData() swaps the filled buffers with a set of
+  empty ones and prepares the next set after the decoder has resumed.
+
   Copyright &copy; 2016 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
   National Laboratory & European Spallation Source
 
@@ -97,7 +101,13 @@ private:
   void loadInstrument(const std::string &name,
                       DataObjects::EventWorkspace_sptr workspace);
 
-  API::Workspace_sptr extractDataImpl();
+  std::vector<DataObjects::EventWorkspace_sptr> swapBuffers();
+  API::Workspace_sptr
+  extractDataImpl(std::vector<DataObjects::EventWorkspace_sptr> filled);
+
+  void sortEvents(const int32_t *spec, const uint32_t nevents);
+  void addEvents(DataObjects::EventWorkspace &buffer, const float *tof,
+                 const Kernel::DateAndTime &pulseTime) const;
 
   /// Broker to use to subscribe to topics
   std::shared_ptr<IKafkaBroker> m_broker;
@@ -111,8 +121,18 @@ private:
   std::unique_ptr<IKafkaStreamSubscriber> m_eventStream;
   /// Local event workspace buffers
   std::vector<DataObjects::EventWorkspace_sptr> m_localEvents;
-  /// Mapping of spectrum number to workspace index.
-  spec2index_map m_specToIdx;
+  /// Empty buffers swapped in by the next extraction
+  std::vector<DataObjects::EventWorkspace_sptr> m_spareEvents;
+  /// Workspace index of each spectrum number, offset by m_specNoOffset
+  std::vector<size_t> m_specToIdx;
+  /// The smallest spectrum number
+  int64_t m_specNoOffset;
+  /// Workspace index of each event of the current message
+  std::vector<size_t> m_eventIdx;
+  /// Events of the current message ordered by block of spectra
+  std::vector<uint32_t> m_eventOrder;
+  /// Start of each block of spectra in m_eventOrder
+  std::vector<size_t> m_blockStart;
   /// Start time of the run
   Kernel::DateAndTime m_runStart;
   /// Subscriber for the run info stream
@@ -126,6 +146,8 @@ private:
   std::thread m_thread;
   /// Mutex protecting event buffers
   mutable std::mutex m_mutex;
+  /// Mutex serializing the extractions and protecting the spare buffers
+  std::mutex m_extractMutex;
   /// Mutex protecting the wait flag
   mutable std::mutex m_waitMutex;
   /// Mutex protecting the runStatusSeen flag
@@ -2,6 +2,7 @@
 #define MANTID_LIVEDATA_LOADLIVEDATA_H_
 
 #include "MantidAPI/Algorithm.h"
+#include "MantidAPI/MatrixWorkspace_fwd.h"
 #include "MantidAPI/Workspace_fwd.h"
 #include "MantidKernel/System.h"
 #include "MantidLiveData/LiveDataAlgorithm.h"
@@ -53,15 +54,19 @@ private:
   void init() override;
 
   Mantid::API::Workspace_sptr runProcessing(Mantid::API::Workspace_sptr inputWS,
-                                            bool PostProcess);
+                                            bool PostProcess,
+                                            bool TouchedOnly = false);
   Mantid::API::Workspace_sptr processChunk(Mantid::API::Workspace_sptr chunkWS);
-  void runPostProcessing();
+  void runPostProcessing(Mantid::API::Workspace_sptr chunkWS);
+  bool postProcessTouchedSpectra(Mantid::API::Workspace_sptr chunkWS);
 
   void replaceChunk(Mantid::API::Workspace_sptr chunkWS);
   void addChunk(Mantid::API::Workspace_sptr chunkWS);
-  void addMatrixWSChunk(const std::string &algoName,
+  bool addMatrixWSChunk(const std::string &algoName,
                         API::Workspace_sptr accumWS,
                         API::Workspace_sptr chunkWS);
+  bool addMatrixWSChunkInPlace(API::MatrixWorkspace &accumWS,
+                               const API::MatrixWorkspace &chunkWS);
   void appendChunk(Mantid::API::Workspace_sptr chunkWS);
   API::Workspace_sptr appendMatrixWSChunk(API::Workspace_sptr accumWS,
                                           Mantid::API::Workspace_sptr chunkWS);
@@ -71,6 +76,11 @@ private:
 
   /// The final output = the post-processed accumulation workspace
   Mantid::API::Workspace_sptr m_outputWS;
+
+  /// Workspace indices of the spectra changed by the last in-place addition
+  std::vector<size_t> m_touchedSpectra;
+  /// True if m_touchedSpectra lists all the changes to m_accumWS
+  bool m_touchedSpectraKnown = false;
 };
 
 } // namespace LiveData
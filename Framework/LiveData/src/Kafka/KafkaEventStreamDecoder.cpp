@@ -6,6 +6,7 @@
 #include "MantidAPI/WorkspaceGroup.h"
 #include "MantidKernel/DateAndTime.h"
 #include "MantidKernel/Logger.h"
+#include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/OptionalBool.h"
 #include "MantidKernel/TimeSeriesProperty.h"
 #include "MantidKernel/UnitFactory.h"
@@ -20,9 +21,12 @@ GCC_DIAG_ON(conversion)
 
 #include <boost/make_shared.hpp>
 
+#include <algorithm>
 #include <cassert>
 #include <functional>
+#include <limits>
 #include <map>
+#include <numeric>
 
 namespace {
 /// Logger
@@ -32,6 +36,11 @@ std::string PROTON_CHARGE_PROPERTY = "proton_charge";
 std::string RUN_NUMBER_PROPERTY = "run_number";
 std::string RUN_START_PROPERTY = "run_start";
 
+/// Number of consecutive spectra whose events are added by the same thread
+const size_t SPECTRA_PER_BLOCK = 64;
+/// Smallest number of events in a message for them to be added in parallel
+const size_t MIN_EVENTS_PARALLEL = 10000;
+
 /**
  * Append sample log data to existing log or create a new log if one with
  * specified name does not already exist
@@ -100,6 +109,8 @@ void addSampleEnvLogs(
 
 namespace Mantid {
 namespace LiveData {
+using DataObjects::EventWorkspace;
+using DataObjects::EventWorkspace_sptr;
 using DataObjects::TofEvent;
 using Kernel::DateAndTime;
 
@@ -118,7 +129,8 @@ KafkaEventStreamDecoder::KafkaEventStreamDecoder(
     const std::string &runInfoTopic, const std::string &spDetTopic)
     : m_broker(broker), m_eventTopic(eventTopic), m_runInfoTopic(runInfoTopic),
       m_spDetTopic(spDetTopic), m_interrupt(false), m_localEvents(),
-      m_specToIdx(), m_runStart(), m_runNumber(-1), m_thread(),
+      m_spareEvents(), m_specToIdx(), m_specNoOffset(0), m_eventIdx(),
+      m_eventOrder(), m_blockStart(), m_runStart(), m_runNumber(-1), m_thread(),
       m_capturing(false), m_exception(), m_extractWaiting(false),
       m_cbIterationEnd([] {}), m_cbError([] {}) {}
 
@@ -205,7 +217,8 @@ bool KafkaEventStreamDecoder::hasReachedEndOfRun() noexcept {
 /**
  * Check for an exception thrown by the background thread and rethrow
  * it if necessary. If no error occurred swap the current internal buffer
- * for a fresh one and return the old buffer.
+ * for a fresh one and return the old buffer. The decoder resumes as soon as
+ * the buffers have been swapped.
  * @return A pointer to the data collected since the last call to this
  * method
  */
@@ -214,39 +227,77 @@ API::Workspace_sptr KafkaEventStreamDecoder::extractData() {
     throw * m_exception;
   }
 
+  std::lock_guard<std::mutex> extractLock(m_extractMutex);
   m_extractWaiting = true;
   m_cv.notify_one();
 
-  auto workspace_ptr = extractDataImpl();
+  auto filled = swapBuffers();
 
   m_extractWaiting = false;
   m_cv.notify_one();
 
-  return workspace_ptr;
+  return extractDataImpl(std::move(filled));
 }
 
 // -----------------------------------------------------------------------------
 // Private members
 // -----------------------------------------------------------------------------
 
-API::Workspace_sptr KafkaEventStreamDecoder::extractDataImpl() {
+/**
+ * Swap the filled buffers for the spare ones. The most recent value of each
+ * log is carried over to the buffers receiving the next events.
+ * @return The filled buffers, or nothing if the buffers are not initialized
+ */
+std::vector<EventWorkspace_sptr> KafkaEventStreamDecoder::swapBuffers() {
+  std::vector<EventWorkspace_sptr> filled;
   std::lock_guard<std::mutex> lock(m_mutex);
-  if (m_localEvents.size() == 1) {
-    auto temp = createBufferWorkspace(m_localEvents.front());
-    std::swap(m_localEvents.front(), temp);
-    return temp;
-  } else if (m_localEvents.size() > 1) {
-    auto group = boost::make_shared<API::WorkspaceGroup>();
-    size_t index(0);
-    for (auto &filledBuffer : m_localEvents) {
-      auto temp = createBufferWorkspace(filledBuffer);
-      std::swap(m_localEvents[index++], temp);
-      group->addWorkspace(temp);
-    }
-    return group;
-  } else {
+  if (m_localEvents.empty())
+    return filled;
+  // Only missing if preparing them failed during the previous extraction
+  if (m_spareEvents.size() != m_localEvents.size()) {
+    m_spareEvents.clear();
+    for (const auto &buffer : m_localEvents)
+      m_spareEvents.push_back(createBufferWorkspace(buffer));
+  }
+  filled.swap(m_localEvents);
+  m_localEvents.swap(m_spareEvents);
+  for (size_t i = 0; i < filled.size(); ++i) {
+    auto &mutableRun = m_localEvents[i]->mutableRun();
+    mutableRun = filled[i]->run();
+    mutableRun.clearOutdatedTimeSeriesLogValues();
+  }
+  return filled;
+}
+
+/**
+ * Prepare the spare buffers for the next extraction and return the filled
+ * buffers. The decoder carries on filling the other buffers meanwhile.
+ * @param filled The buffers swapped out by swapBuffers()
+ * @return The buffer of a single period or a group with one per period
+ */
+API::Workspace_sptr KafkaEventStreamDecoder::extractDataImpl(
+    std::vector<EventWorkspace_sptr> filled) {
+  if (filled.empty()) {
     throw Exception::NotYet("Local buffers not initialized.");
   }
+  std::vector<EventWorkspace_sptr> spares;
+  spares.reserve(filled.size());
+  for (const auto &filledBuffer : filled) {
+    spares.push_back(createBufferWorkspace(filledBuffer));
+  }
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_spareEvents = std::move(spares);
+  }
+
+  if (filled.size() == 1) {
+    return filled.front();
+  }
+  auto group = boost::make_shared<API::WorkspaceGroup>();
+  for (auto &filledBuffer : filled) {
+    group->addWorkspace(filledBuffer);
+  }
+  return group;
 }
 
 /**
@@ -302,6 +353,8 @@ void KafkaEventStreamDecoder::captureImplExcept() {
       const auto &specData = *(eventData->spec());
       auto nevents = tofData.size();
       auto nSEEvents = seData.size();
+      // Sort the events before locking the buffers
+      sortEvents(specData.data(), nevents);
 
       std::lock_guard<std::mutex> lock(m_mutex);
       if (frameData->period() < 0)
@@ -314,10 +367,7 @@ void KafkaEventStreamDecoder::captureImplExcept() {
       auto &mutableRunInfo = periodBuffer.mutableRun();
       mutableRunInfo.getTimeSeriesProperty<double>(PROTON_CHARGE_PROPERTY)
           ->addValue(pulseTime, frameData->proton_charge());
-      for (decltype(nevents) i = 0; i < nevents; ++i) {
-        auto &spectrum = periodBuffer.getSpectrum(m_specToIdx[specData[i]]);
-        spectrum.addEventQuickly(TofEvent(tofData[i], pulseTime));
-      }
+      addEvents(periodBuffer, tofData.data(), pulseTime);
       addSampleEnvLogs(seData, nSEEvents, mutableRunInfo);
 
       m_endRun = frameData->end_of_run();
@@ -424,8 +474,25 @@ void KafkaEventStreamDecoder::initLocalCaches() {
   mutableRun.addProperty(
       new Kernel::TimeSeriesProperty<double>(PROTON_CHARGE_PROPERTY));
 
-  // Cache spec->index mapping. We assume it is the same across all periods
-  m_specToIdx = eventBuffer->getSpectrumToWorkspaceIndexMap();
+  // Cache spec->index mapping as a table indexed by spectrum number. We
+  // assume it is the same across all periods
+  const auto specToIdx = eventBuffer->getSpectrumToWorkspaceIndexMap();
+  int64_t minSpecNo(std::numeric_limits<int64_t>::max()), maxSpecNo(-1);
+  for (const auto &entry : specToIdx) {
+    minSpecNo = std::min(minSpecNo, static_cast<int64_t>(entry.first));
+    maxSpecNo = std::max(maxSpecNo, static_cast<int64_t>(entry.first));
+  }
+  m_specNoOffset = specToIdx.empty() ? 0 : minSpecNo;
+  m_specToIdx.assign(
+      specToIdx.empty() ? 0 : static_cast<size_t>(maxSpecNo - minSpecNo + 1),
+      0);
+  for (const auto &entry : specToIdx) {
+    m_specToIdx[static_cast<size_t>(entry.first - m_specNoOffset)] =
+        entry.second;
+  }
+  const auto nspectra = eventBuffer->getNumberHistograms();
+  m_blockStart.assign(
+      (nspectra + SPECTRA_PER_BLOCK - 1) / SPECTRA_PER_BLOCK + 1, 0);
 
   // Buffers for each period
   const size_t nperiods(static_cast<size_t>(runMsg->n_periods()));
@@ -441,6 +508,73 @@ void KafkaEventStreamDecoder::initLocalCaches() {
     // A clone should be cheap here as there are no events yet
     m_localEvents[i] = eventBuffer->clone();
   }
+  // The first extraction swaps these in
+  m_spareEvents.resize(nperiods);
+  for (size_t i = 0; i < nperiods; ++i) {
+    m_spareEvents[i] = eventBuffer->clone();
+  }
+}
+
+/**
+ * Sort the events of a message by block of SPECTRA_PER_BLOCK workspace
+ * indices, keeping their order within each block. This does not touch the
+ * buffers so it runs before they are locked.
+ * @param spec An array of length nevents with the spectrum number of each
+ * event
+ * @param nevents The number of events in the message
+ */
+void KafkaEventStreamDecoder::sortEvents(const int32_t *spec,
+                                         const uint32_t nevents) {
+  if (nevents > 0 && m_specToIdx.empty()) {
+    throw std::runtime_error("KafkaEventStreamDecoder::sortEvents() - "
+                             "Events received for a buffer without spectra. "
+                             "Unable to continue");
+  }
+  m_eventIdx.resize(nevents);
+  m_eventOrder.resize(nevents);
+  std::fill(m_blockStart.begin(), m_blockStart.end(), 0);
+  const auto tableSize = static_cast<int64_t>(m_specToIdx.size());
+  for (uint32_t i = 0; i < nevents; ++i) {
+    // Unknown spectrum numbers go to the first workspace index, as they did
+    // with the default-constructed entries of the spectrum number map
+    const auto offset = static_cast<int64_t>(spec[i]) - m_specNoOffset;
+    const auto idx = (offset >= 0 && offset < tableSize)
+                         ? m_specToIdx[static_cast<size_t>(offset)]
+                         : 0;
+    m_eventIdx[i] = idx;
+    ++m_blockStart[idx / SPECTRA_PER_BLOCK + 1];
+  }
+  std::partial_sum(m_blockStart.begin(), m_blockStart.end(),
+                   m_blockStart.begin());
+  for (uint32_t i = 0; i < nevents; ++i) {
+    m_eventOrder[m_blockStart[m_eventIdx[i] / SPECTRA_PER_BLOCK]++] = i;
+  }
+  // The counters now hold the end of each block, shift them back to the start
+  std::copy_backward(m_blockStart.begin(), m_blockStart.end() - 1,
+                     m_blockStart.end());
+  m_blockStart.front() = 0;
+}
+
+/**
+ * Add the events sorted by sortEvents() to a buffer. The blocks of spectra are
+ * filled in parallel, each spectrum receiving its events in message order.
+ * @param buffer The buffer of the period of the message
+ * @param tof An array with the time-of-flight of each event
+ * @param pulseTime The pulse time of the events
+ */
+void KafkaEventStreamDecoder::addEvents(EventWorkspace &buffer,
+                                        const float *tof,
+                                        const DateAndTime &pulseTime) const {
+  const auto nblocks = static_cast<int64_t>(m_blockStart.size()) - 1;
+  PARALLEL_FOR_IF(m_eventOrder.size() >= MIN_EVENTS_PARALLEL)
+  for (int64_t block = 0; block < nblocks; ++block) {
+    const auto end = m_blockStart[block + 1];
+    for (auto k = m_blockStart[block]; k < end; ++k) {
+      const auto i = m_eventOrder[k];
+      buffer.getSpectrum(m_eventIdx[i])
+          .addEventQuickly(TofEvent(tof[i], pulseTime));
+    }
+  }
 }
 
 /**
@@ -134,6 +134,15 @@ void LiveDataAlgorithm::initProps() {
                                 FileProperty::OptionalLoad, "py"),
       " Python script that will be run to process the accumulated data.");
 
+  declareProperty(
+      "IncrementalPostProcessing", false,
+      "Only post-process the spectra that received data since the last "
+      "update, and copy them into the previous output workspace.\n"
+      "This requires AccumulationMethod=Add and a post-processing step "
+      "that processes each spectrum independently of the others, e.g. "
+      "Rebin or ConvertUnits. Otherwise the whole accumulation workspace is "
+      "post-processed.");
+
   std::vector<std::string> runOptions{"Restart", "Stop", "Rename"};
   declareProperty("RunTransitionBehavior", "Restart",
                   boost::make_shared<StringListValidator>(runOptions),
@@ -1,10 +1,16 @@
 #include "MantidLiveData/LoadLiveData.h"
 #include "MantidAPI/AlgorithmManager.h"
+#include "MantidAPI/Axis.h"
+#include "MantidAPI/Run.h"
+#include "MantidAPI/SpectrumInfo.h"
 #include "MantidAPI/Workspace.h"
 #include "MantidAPI/WorkspaceGroup.h"
 #include "MantidDataObjects/EventWorkspace.h"
 #include "MantidKernel/CPUTimer.h"
+#include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/ReadLock.h"
+#include "MantidKernel/Unit.h"
+#include "MantidKernel/VectorHelper.h"
 #include "MantidKernel/WriteLock.h"
 #include "MantidLiveData/Exception.h"
 
@@ -45,12 +51,14 @@ void LoadLiveData::init() { this->initProps(); }
  *
  * @param inputWS :: workspace being processed
  * @param PostProcess :: flag, TRUE if doing the post-processing
+ * @param TouchedOnly :: flag, TRUE if post-processing the spectra touched by
+ *the last in-place addition. The workspaces then get anonymous names.
  * @return the processed workspace. Will point to inputWS if no processing is to
  *do
  */
 Mantid::API::Workspace_sptr
 LoadLiveData::runProcessing(Mantid::API::Workspace_sptr inputWS,
-                            bool PostProcess) {
+                            bool PostProcess, bool TouchedOnly) {
   if (!inputWS)
     throw std::runtime_error(
         "LoadLiveData::runProcessing() called for an empty input workspace.");
@@ -69,13 +77,15 @@ LoadLiveData::runProcessing(Mantid::API::Workspace_sptr inputWS,
     // Run the processing algorithm
 
     // Make a unique anonymous names for the workspace, to put in ADS
-    std::string inputName = "__anonymous_livedata_input_" +
-                            this->getPropertyValue("OutputWorkspace");
+    std::string inputName =
+        (TouchedOnly ? "__anonymous_livedata_touched_"
+                     : "__anonymous_livedata_input_") +
+        this->getPropertyValue("OutputWorkspace");
     // Transform the chunk in-place
     std::string outputName = inputName;
 
     // Except, no need for anonymous names with the post-processing
-    if (PostProcess) {
+    if (PostProcess && !TouchedOnly) {
       inputName = this->getPropertyValue("AccumulationWorkspace");
       outputName = this->getPropertyValue("OutputWorkspace");
     }
@@ -126,7 +136,7 @@ LoadLiveData::runProcessing(Mantid::API::Workspace_sptr inputWS,
           " Algorithm's OutputWorkspace property is not a WorkspaceProperty!");
     Workspace_sptr temp = wsProp->getWorkspace();
 
-    if (!PostProcess) {
+    if (!PostProcess || TouchedOnly) {
       if (!temp) {
         // a group workspace cannot be returned by wsProp
         temp = AnalysisDataService::Instance().retrieve(inputName);
@@ -166,9 +176,17 @@ LoadLiveData::processChunk(Mantid::API::Workspace_sptr chunkWS) {
 /** Perform the PostProcessing steps on the accumulated workspace.
  * Uses the m_accumWS member in a (hopefully) read-only manner.
  * Sets the m_outputWS member to the processed result.
+ * With IncrementalPostProcessing, only the spectra touched by the last
+ * in-place addition are processed if possible.
+ *
+ * @param chunkWS :: processed live data chunk workspace
  */
-void LoadLiveData::runPostProcessing() {
+void LoadLiveData::runPostProcessing(Mantid::API::Workspace_sptr chunkWS) {
   try {
+    const bool incremental = this->getProperty("IncrementalPostProcessing");
+    if (incremental && m_touchedSpectraKnown &&
+        postProcessTouchedSpectra(chunkWS))
+      return;
     m_outputWS = runProcessing(m_accumWS, true);
   } catch (...) {
     g_log.error("While post processing:");
@@ -176,9 +194,67 @@ void LoadLiveData::runPostProcessing() {
   }
 }
 
+//----------------------------------------------------------------------------------------------
+/** Post-process the spectra touched by the last in-place addition and copy
+ * them into the previous output workspace. This assumes that the
+ * post-processing turns each spectrum into the spectrum with the same index
+ * in its output, independently of the other spectra.
+ *
+ * @param chunkWS :: processed live data chunk workspace
+ * @return false if the whole accumulation workspace must be post-processed
+ */
+bool LoadLiveData::postProcessTouchedSpectra(
+    Mantid::API::Workspace_sptr chunkWS) {
+  auto accumMW = boost::dynamic_pointer_cast<MatrixWorkspace>(m_accumWS);
+  auto outputMW = boost::dynamic_pointer_cast<MatrixWorkspace>(m_outputWS);
+  auto chunkMW = boost::dynamic_pointer_cast<MatrixWorkspace>(chunkWS);
+  if (!accumMW || !outputMW || !chunkMW || outputMW == accumMW ||
+      outputMW->getNumberHistograms() != accumMW->getNumberHistograms() ||
+      m_touchedSpectra.size() == accumMW->getNumberHistograms())
+    return false;
+
+  MatrixWorkspace_sptr touchedWS;
+  if (!m_touchedSpectra.empty()) {
+    auto extract = this->createChildAlgorithm("ExtractSpectra");
+    extract->setProperty("InputWorkspace", accumMW);
+    extract->setProperty("WorkspaceIndexList", m_touchedSpectra);
+    extract->executeAsChildAlg();
+    MatrixWorkspace_sptr extracted = extract->getProperty("OutputWorkspace");
+    touchedWS = boost::dynamic_pointer_cast<MatrixWorkspace>(
+        runProcessing(extracted, true, true));
+    if (!touchedWS ||
+        touchedWS->getNumberHistograms() != m_touchedSpectra.size() ||
+        touchedWS->id() != outputMW->id())
+      return false;
+  }
+  g_log.notice() << "Post-processed " << m_touchedSpectra.size()
+                 << " touched spectra.\n";
+
+  WriteLock _lock(*outputMW);
+  auto outputEvents = boost::dynamic_pointer_cast<EventWorkspace>(outputMW);
+  auto touchedEvents = boost::dynamic_pointer_cast<EventWorkspace>(touchedWS);
+  const auto numTouched = static_cast<int64_t>(m_touchedSpectra.size());
+  PARALLEL_FOR_IF(Kernel::threadSafe(*outputMW))
+  for (int64_t i = 0; i < numTouched; ++i) {
+    PARALLEL_START_INTERUPT_REGION
+    const auto index = m_touchedSpectra[i];
+    if (outputEvents)
+      outputEvents->getSpectrum(index) = touchedEvents->getSpectrum(i);
+    else
+      outputMW->setHistogram(index, touchedWS->histogram(i));
+    PARALLEL_END_INTERUPT_REGION
+  }
+  PARALLEL_CHECK_INTERUPT_REGION
+  if (outputEvents)
+    outputEvents->clearMRU();
+  outputMW->mutableRun() += chunkMW->run();
+  return true;
+}
+
 //----------------------------------------------------------------------------------------------
 /** Accumulate the data by adding (summing) to the output workspace.
- * Calls the Plus algorithm
+ * Matching matrix workspaces are added in place, others with the Plus or
+ * PlusMD algorithm.
  * Sets m_accumWS.
  *
  * @param chunkWS :: processed live data chunk workspace
@@ -187,6 +263,7 @@ void LoadLiveData::addChunk(Mantid::API::Workspace_sptr chunkWS) {
   // Acquire locks on the workspaces we use
   WriteLock _lock1(*m_accumWS);
   ReadLock _lock2(*chunkWS);
+  m_touchedSpectraKnown = false;
 
   // Choose the appropriate algorithm to add chunks
   std::string algoName = "PlusMD";
@@ -216,7 +293,7 @@ void LoadLiveData::addChunk(Mantid::API::Workspace_sptr chunkWS) {
     }
   } else {
     // just add the chunk
-    addMatrixWSChunk(algoName, m_accumWS, chunkWS);
+    m_touchedSpectraKnown = addMatrixWSChunk(algoName, m_accumWS, chunkWS);
   }
 }
 
@@ -227,8 +304,9 @@ void LoadLiveData::addChunk(Mantid::API::Workspace_sptr chunkWS) {
  * @param algoName :: Name of algorithm which will be adding the workspaces.
  * @param accumWS :: accumulation matrix workspace
  * @param chunkWS :: processed live data chunk matrix workspace
+ * @return true if the chunk was added in place, setting m_touchedSpectra
  */
-void LoadLiveData::addMatrixWSChunk(const std::string &algoName,
+bool LoadLiveData::addMatrixWSChunk(const std::string &algoName,
                                     Workspace_sptr accumWS,
                                     Workspace_sptr chunkWS) {
   // Handle the addition of the internal monitor workspace, if present
@@ -240,6 +318,9 @@ void LoadLiveData::addMatrixWSChunk(const std::string &algoName,
 
     if (accumMon && chunkMon)
       accumMon += chunkMon;
+
+    if (addMatrixWSChunkInPlace(*accumMW, *chunkMW))
+      return true;
   }
 
   // Now do the main workspace
@@ -264,6 +345,88 @@ void LoadLiveData::addMatrixWSChunk(const std::string &algoName,
     Workspace_sptr temp = wsProp->getWorkspace();
     accumWS = temp;
   }
+  return false;
+}
+
+//----------------------------------------------------------------------------------------------
+/**
+ * Add a chunk to a matching accumulation workspace in place. The events of
+ * each spectrum are appended to the accumulated event list, or the counts are
+ * added to the accumulated histogram, as Plus would do. The logs of the
+ * accumulation workspace are not copied, so the cost does not grow with the
+ * length of the run.
+ * Sets m_touchedSpectra to the spectra of the chunk holding data.
+ *
+ * @param accumWS :: accumulation matrix workspace
+ * @param chunkWS :: processed live data chunk matrix workspace
+ * @return false, leaving the workspaces unchanged, if they do not match or
+ * are masked. Plus must then be used.
+ */
+bool LoadLiveData::addMatrixWSChunkInPlace(MatrixWorkspace &accumWS,
+                                           const MatrixWorkspace &chunkWS) {
+  auto accumEvents = dynamic_cast<EventWorkspace *>(&accumWS);
+  auto chunkEvents = dynamic_cast<const EventWorkspace *>(&chunkWS);
+  const MatrixWorkspace &accum = accumWS;
+  const size_t numHists = accum.getNumberHistograms();
+  if (bool(accumEvents) != bool(chunkEvents) ||
+      chunkWS.getNumberHistograms() != numHists ||
+      (!accumEvents && chunkWS.blocksize() != accum.blocksize()) ||
+      accum.YUnit() != chunkWS.YUnit() ||
+      accum.isDistribution() != chunkWS.isDistribution() ||
+      accum.getAxis(0)->unit()->unitID() !=
+          chunkWS.getAxis(0)->unit()->unitID())
+    return false;
+
+  const auto &accumInfo = accum.spectrumInfo();
+  const auto &chunkInfo = chunkWS.spectrumInfo();
+  for (size_t i = 0; i < numHists; ++i) {
+    if (accum.getSpectrum(i).getSpectrumNo() !=
+            chunkWS.getSpectrum(i).getSpectrumNo() ||
+        chunkWS.hasMaskedBins(i) ||
+        (accumInfo.hasDetectors(i) && accumInfo.isMasked(i)) ||
+        (chunkInfo.hasDetectors(i) && chunkInfo.isMasked(i)))
+      return false;
+    if (!accumEvents && accum.sharedX(i) != chunkWS.sharedX(i) &&
+        accum.x(i).rawData() != chunkWS.x(i).rawData())
+      return false;
+  }
+
+  std::vector<char> touched(numHists, false);
+  auto notZero = [](const double value) { return value != 0.0; };
+  PARALLEL_FOR_IF(Kernel::threadSafe(accumWS, chunkWS))
+  for (int64_t i = 0; i < static_cast<int64_t>(numHists); ++i) {
+    PARALLEL_START_INTERUPT_REGION
+    if (accumEvents) {
+      const auto &chunkList = chunkEvents->getSpectrum(i);
+      touched[i] = chunkList.getNumberEvents() > 0;
+      accumEvents->getSpectrum(i) += chunkList;
+    } else {
+      const auto &chunkY = chunkWS.y(i);
+      const auto &chunkE = chunkWS.e(i);
+      touched[i] = std::any_of(chunkY.begin(), chunkY.end(), notZero) ||
+                   std::any_of(chunkE.begin(), chunkE.end(), notZero);
+      // Adding zeros would leave the spectrum as it is
+      if (touched[i]) {
+        accumWS.mutableY(i) += chunkY;
+        auto &accumE = accumWS.mutableE(i);
+        std::transform(accumE.cbegin(), accumE.cend(), chunkE.begin(),
+                       accumE.begin(), VectorHelper::SumGaussError<double>());
+      }
+    }
+    PARALLEL_END_INTERUPT_REGION
+  }
+  PARALLEL_CHECK_INTERUPT_REGION
+
+  if (accumEvents)
+    accumEvents->clearMRU();
+  accumWS.mutableRun() += chunkWS.run();
+
+  m_touchedSpectra.clear();
+  for (size_t i = 0; i < numHists; ++i) {
+    if (touched[i])
+      m_touchedSpectra.push_back(i);
+  }
+  return true;
 }
 
 //----------------------------------------------------------------------------------------------
@@ -358,6 +521,7 @@ Workspace_sptr LoadLiveData::appendMatrixWSChunk(Workspace_sptr accumWS,
 void LoadLiveData::exec() {
   // The full, post-processed output workspace
   m_outputWS = this->getProperty("OutputWorkspace");
+  m_touchedSpectraKnown = false;
 
   // Validate inputs
   if (this->hasPostProcessing()) {
@@ -465,7 +629,7 @@ void LoadLiveData::exec() {
 
   if (this->hasPostProcessing()) {
     // ----------- Run post-processing -------------
-    this->runPostProcessing();
+    this->runPostProcessing(processed);
     // Set both output workspaces
     this->setProperty("AccumulationWorkspace", m_accumWS);
     this->setProperty("OutputWorkspace", m_outputWS);
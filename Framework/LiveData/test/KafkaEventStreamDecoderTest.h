@@ -9,6 +9,7 @@
 #include "MantidGeometry/Instrument.h"
 #include "MantidKernel/ConfigService.h"
 #include "MantidKernel/TimeSeriesProperty.h"
+#include "MantidKernel/Timer.h"
 #include "MantidKernel/make_unique.h"
 #include "MantidLiveData/Kafka/KafkaEventStreamDecoder.h"
 
@@ -150,6 +151,62 @@ public:
     TS_ASSERT(!decoder->isCapturing());
   }
 
+  void test_Large_Messages_Fill_Spectra_In_Message_Order() {
+    using namespace ISISKafkaTesting;
+    using Mantid::DataObjects::EventWorkspace;
+    using Mantid::DataObjects::EventWorkspace_sptr;
+    using namespace Mantid::LiveData;
+
+    const int32_t nspectra(1000), eventsPerMessage(20000);
+    auto broker = std::make_shared<SyntheticKafkaBroker>(
+        "events", "runInfo", nspectra, eventsPerMessage);
+    auto decoder = Mantid::Kernel::make_unique<KafkaEventStreamDecoder>(
+        broker, "events", "runInfo", "spDet");
+    startCapturing(*decoder, 2);
+
+    // Time-of-flight of the events of each spectrum in one message
+    std::vector<std::vector<double>> messageTofs(nspectra);
+    for (int32_t i = 0; i < eventsPerMessage; ++i) {
+      auto spectrum =
+          SyntheticISISEventSubscriber::spectrumOfEvent(i, nspectra) - 1;
+      messageTofs[spectrum].push_back(static_cast<double>(i));
+    }
+
+    // The second extraction returns the buffers swapped in by the first
+    for (size_t extraction = 0; extraction < 2; ++extraction) {
+      EventWorkspace_sptr eventWksp;
+      TS_ASSERT_THROWS_NOTHING(
+          eventWksp = boost::dynamic_pointer_cast<EventWorkspace>(
+              decoder->extractData()));
+      TS_ASSERT(eventWksp);
+      if (!eventWksp)
+        break;
+      TS_ASSERT_EQUALS(nspectra, eventWksp->getNumberHistograms());
+      TS_ASSERT_EQUALS(
+          "2016-08-31T12:07:42",
+          eventWksp->run().getPropertyValueAsType<std::string>("run_start"));
+      const auto nevents = eventWksp->getNumberEvents();
+      TS_ASSERT_EQUALS(0, nevents % eventsPerMessage);
+      const auto nmessages = nevents / eventsPerMessage;
+      size_t misplaced(0);
+      for (size_t j = 0; j < eventWksp->getNumberHistograms(); ++j) {
+        const auto &events = eventWksp->getSpectrum(j).getEvents();
+        const auto &expected = messageTofs[j];
+        if (events.size() != nmessages * expected.size()) {
+          ++misplaced;
+          continue;
+        }
+        for (size_t k = 0; k < events.size(); ++k) {
+          if (events[k].tof() != expected[k % expected.size()])
+            ++misplaced;
+        }
+      }
+      TS_ASSERT_EQUALS(0, misplaced);
+    }
+    TS_ASSERT_THROWS_NOTHING(decoder->stopCapture());
+    TS_ASSERT(!decoder->isCapturing());
+  }
+
   //----------------------------------------------------------------------------
   // Failure tests
   //----------------------------------------------------------------------------
@@ -274,4 +331,51 @@ private:
   uint8_t m_niterations = 0;
 };
 
+class KafkaEventStreamDecoderTestPerformance : public CxxTest::TestSuite {
+public:
+  static KafkaEventStreamDecoderTestPerformance *createSuite() {
+    return new KafkaEventStreamDecoderTestPerformance();
+  }
+  static void destroySuite(KafkaEventStreamDecoderTestPerformance *suite) {
+    delete suite;
+  }
+
+  void test_Sustained_Decoding_Rate() {
+    using namespace ISISKafkaTesting;
+    using Mantid::DataObjects::EventWorkspace;
+    using namespace Mantid::LiveData;
+
+    const int32_t nspectra(100000), eventsPerMessage(200000);
+    auto broker = std::make_shared<SyntheticKafkaBroker>(
+        "events", "runInfo", nspectra, eventsPerMessage);
+    KafkaEventStreamDecoder decoder(broker, "events", "runInfo", "spDet");
+    decoder.startCapture();
+    for (int i = 0; i < 1000 && !decoder.hasData(); ++i) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    // Discard what was decoded while starting up
+    TS_ASSERT_THROWS_NOTHING(decoder.extractData());
+
+    // Extract regularly, as MonitorLiveData would
+    Mantid::Kernel::Timer timer;
+    size_t nevents(0);
+    while (timer.elapsed_no_reset() < 5.f) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+      auto eventWksp =
+          boost::dynamic_pointer_cast<EventWorkspace>(decoder.extractData());
+      TS_ASSERT(eventWksp);
+      if (eventWksp)
+        nevents += eventWksp->getNumberEvents();
+    }
+    const double seconds = timer.elapsed_no_reset();
+    decoder.stopCapture();
+
+    std::cout << static_cast<double>(nevents) / seconds
+              << " events per second decoded over " << seconds << " s from "
+              << eventsPerMessage << " events per message on " << nspectra
+              << " spectra.\n";
+    TS_ASSERT(nevents > 0);
+  }
+};
+
 #endif /* MANTID_LIVEDATA_ISISKAFKAEVENTSTREAMDECODERTEST_H_ */
@@ -3,6 +3,7 @@
 
 #include "MantidKernel/DateAndTime.h"
 #include "MantidKernel/WarningSuppressions.h"
+#include "MantidKernel/make_unique.h"
 #include "MantidLiveData/Kafka/IKafkaBroker.h"
 #include <gmock/gmock.h>
 
@@ -186,6 +187,119 @@ private:
   // These match the detector numbers in HRPDTEST_Definition.xml
   std::vector<int32_t> m_detid = {1001, 1002, 1100, 901000, 10100};
 };
+
+// -----------------------------------------------------------------------------
+// Synthetic ISIS event stream scattering large messages over many spectra.
+// Every message is the same so that consuming one only costs a copy
+// -----------------------------------------------------------------------------
+class SyntheticISISEventSubscriber
+    : public Mantid::LiveData::IKafkaStreamSubscriber {
+public:
+  SyntheticISISEventSubscriber(int32_t nspectra, int32_t eventsPerMessage) {
+    flatbuffers::FlatBufferBuilder builder;
+    std::vector<int32_t> spec(eventsPerMessage);
+    std::vector<float> tof(eventsPerMessage);
+    for (int32_t i = 0; i < eventsPerMessage; ++i) {
+      spec[i] = spectrumOfEvent(i, nspectra);
+      tof[i] = static_cast<float>(i);
+    }
+    auto messageNEvents = ISISStream::CreateNEvents(
+        builder, builder.CreateVector(tof), builder.CreateVector(spec));
+    std::vector<flatbuffers::Offset<ISISStream::SEEvent>> sEEventsVector;
+    auto messageFramePart = ISISStream::CreateFramePart(
+        builder, 1, 1.f, ISISStream::RunState_RUNNING, 0.5f, 0, false, false,
+        messageNEvents, builder.CreateVector(sEEventsVector));
+    auto messageFlatbuf = ISISStream::CreateEventMessage(
+        builder, ISISStream::MessageTypes_FramePart, messageFramePart.Union());
+    builder.Finish(messageFlatbuf);
+    m_message.assign(reinterpret_cast<const char *>(builder.GetBufferPointer()),
+                     builder.GetSize());
+  }
+  void subscribe() override {}
+  void subscribe(int64_t offset) override { UNUSED_ARG(offset) }
+  void consumeMessage(std::string *buffer) override {
+    assert(buffer);
+    *buffer = m_message;
+  }
+
+  /// Spectrum number of the i-th event of each message. Consecutive events
+  /// go to distant spectra
+  static int32_t spectrumOfEvent(int32_t i, int32_t nspectra) {
+    return 1 + static_cast<int32_t>((7919 * static_cast<int64_t>(i)) %
+                                    nspectra);
+  }
+
+private:
+  std::string m_message;
+};
+
+// -----------------------------------------------------------------------------
+// Synthetic ISIS spectra-detector stream mapping spectrum i to detector i
+// -----------------------------------------------------------------------------
+class SyntheticISISSpDetStreamSubscriber
+    : public Mantid::LiveData::IKafkaStreamSubscriber {
+public:
+  SyntheticISISSpDetStreamSubscriber(int32_t nspectra) : m_nspectra(nspectra) {}
+  void subscribe() override {}
+  void subscribe(int64_t offset) override { UNUSED_ARG(offset) }
+  void consumeMessage(std::string *buffer) override {
+    assert(buffer);
+
+    std::vector<int32_t> spec(m_nspectra);
+    for (int32_t i = 0; i < m_nspectra; ++i) {
+      spec[i] = i + 1;
+    }
+    flatbuffers::FlatBufferBuilder builder;
+    auto specVector = builder.CreateVector(spec);
+    auto detIdsVector = builder.CreateVector(spec);
+    auto spdet = ISISStream::CreateSpectraDetectorMapping(
+        builder, specVector, detIdsVector, m_nspectra);
+    builder.Finish(spdet);
+    buffer->assign(reinterpret_cast<const char *>(builder.GetBufferPointer()),
+                   builder.GetSize());
+  }
+
+private:
+  const int32_t m_nspectra;
+};
+
+// -----------------------------------------------------------------------------
+// Local stand-in for a broker, serving synthetic streams by topic name
+// -----------------------------------------------------------------------------
+class SyntheticKafkaBroker : public Mantid::LiveData::IKafkaBroker {
+public:
+  using IKafkaStreamSubscriber_uptr =
+      std::unique_ptr<Mantid::LiveData::IKafkaStreamSubscriber>;
+
+  SyntheticKafkaBroker(const std::string &eventTopic,
+                       const std::string &runInfoTopic, int32_t nspectra,
+                       int32_t eventsPerMessage)
+      : m_eventTopic(eventTopic), m_runInfoTopic(runInfoTopic),
+        m_nspectra(nspectra), m_eventsPerMessage(eventsPerMessage) {}
+  IKafkaStreamSubscriber_uptr
+  subscribe(const std::string &topic) const override {
+    using Mantid::Kernel::make_unique;
+    if (topic == m_eventTopic) {
+      return make_unique<SyntheticISISEventSubscriber>(m_nspectra,
+                                                       m_eventsPerMessage);
+    } else if (topic == m_runInfoTopic) {
+      return make_unique<FakeISISRunInfoStreamSubscriber>(1);
+    } else {
+      return make_unique<SyntheticISISSpDetStreamSubscriber>(m_nspectra);
+    }
+  }
+  IKafkaStreamSubscriber_uptr subscribe(const std::string &topic,
+                                        int64_t offset) const override {
+    UNUSED_ARG(offset)
+    return subscribe(topic);
+  }
+
+private:
+  const std::string m_eventTopic;
+  const std::string m_runInfoTopic;
+  const int32_t m_nspectra;
+  const int32_t m_eventsPerMessage;
+};
 }
 
 #endif // MANTID_LIVEDATA_ISISKAFKAEVENTSTREAMDECODERTESTMOCKS_H_
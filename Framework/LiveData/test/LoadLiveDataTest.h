@@ -10,6 +10,7 @@
 #include "MantidKernel/Timer.h"
 #include "MantidLiveData/LoadLiveData.h"
 #include "MantidTestHelpers/FacilityHelper.h"
+#include "TestDataListener.h"
 #include "TestGroupDataListener.h"
 #include <cxxtest/TestSuite.h>
 #include <numeric>
@@ -20,6 +21,17 @@ using namespace Mantid::DataObjects;
 using namespace Mantid::API;
 using namespace Mantid::Kernel;
 
+/// TestDataListener whose chunks only have events in the first spectrum
+class FirstSpectrumDataListener : public TestDataListener {
+public:
+  boost::shared_ptr<Workspace> extractData() override {
+    auto chunk = boost::dynamic_pointer_cast<EventWorkspace>(
+        TestDataListener::extractData());
+    chunk->getSpectrum(1).clear(false);
+    return chunk;
+  }
+};
+
 class LoadLiveDataTest : public CxxTest::TestSuite {
 public:
   // This pair of boilerplate methods prevent the suite being created statically
@@ -52,7 +64,7 @@ public:
          std::string PostProcessingAlgorithm = "",
          std::string PostProcessingProperties = "", bool PreserveEvents = true,
          ILiveListener_sptr listener = ILiveListener_sptr(),
-         bool makeThrow = false) {
+         bool makeThrow = false, bool IncrementalPostProcessing = false) {
     FacilityHelper::ScopedFacilities loadTESTFacility(
         "IDFs_for_UNIT_TESTING/UnitTestFacilities.xml", "TEST");
 
@@ -72,6 +84,8 @@ public:
     TS_ASSERT_THROWS_NOTHING(alg.setPropertyValue("PostProcessingProperties",
                                                   PostProcessingProperties));
     TS_ASSERT_THROWS_NOTHING(alg.setProperty("PreserveEvents", PreserveEvents));
+    TS_ASSERT_THROWS_NOTHING(alg.setProperty("IncrementalPostProcessing",
+                                             IncrementalPostProcessing));
     if (!PostProcessingAlgorithm.empty())
       TS_ASSERT_THROWS_NOTHING(
           alg.setPropertyValue("AccumulationWorkspace", "fake_accum"));
@@ -263,6 +277,34 @@ public:
     TS_ASSERT_EQUALS(AnalysisDataService::Instance().size(), 2);
   }
 
+  //--------------------------------------------------------------------------------------------
+  /** Post-process only the spectra touched by the chunk */
+  void test_add_IncrementalPostProcessing() {
+    auto listener = boost::make_shared<FirstSpectrumDataListener>();
+    EventWorkspace_sptr ws1 =
+        doExec<EventWorkspace>("Add", "", "", "Rebin", "Params=40e3, 1e3, 60e3",
+                               true, listener, false, true);
+    TS_ASSERT_EQUALS(ws1->getSpectrum(0).getNumberEvents(), 100);
+    TS_ASSERT_EQUALS(ws1->getSpectrum(1).getNumberEvents(), 0);
+
+    EventWorkspace_sptr ws2 =
+        doExec<EventWorkspace>("Add", "", "", "Rebin", "Params=40e3, 1e3, 60e3",
+                               true, listener, false, true);
+    EventWorkspace_sptr ws_accum =
+        AnalysisDataService::Instance().retrieveWS<EventWorkspace>(
+            "fake_accum");
+    TS_ASSERT_EQUALS(ws_accum->getNumberEvents(), 200);
+
+    // The touched spectrum was copied into the previous output
+    TSM_ASSERT("Output workspace stayed the same pointer", ws1 == ws2);
+    TS_ASSERT_EQUALS(ws2->getNumberHistograms(), 2);
+    TS_ASSERT_EQUALS(ws2->getSpectrum(0).getNumberEvents(), 200);
+    TS_ASSERT_EQUALS(ws2->getSpectrum(1).getNumberEvents(), 0);
+    TS_ASSERT_EQUALS(ws2->blocksize(), 20);
+    TS_ASSERT_DELTA(ws2->x(0)[0], 40e3, 1e-4);
+    TS_ASSERT_EQUALS(AnalysisDataService::Instance().size(), 2);
+  }
+
   //--------------------------------------------------------------------------------------------
   /** Do some processing that converts to a different type of workspace */
   void test_ProcessToMDWorkspace_and_Add() {
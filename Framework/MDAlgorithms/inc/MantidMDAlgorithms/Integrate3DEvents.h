@@ -84,6 +84,13 @@ public:
   addEvents(std::vector<std::pair<double, Mantid::Kernel::V3D>> const &event_qs,
             bool hkl_integ);
 
+  /// Make objects for the same peaks, with no events, to add events to in
+  /// parallel
+  std::vector<Integrate3DEvents> makeShards(size_t numShards) const;
+
+  /// Move the events of the shards into the lists of events near peaks
+  void mergeEvents(std::vector<Integrate3DEvents> &shards);
+
   /// Find the net integrated intensity of a peak, using ellipsoidal volumes
   boost::shared_ptr<const Mantid::Geometry::PeakShape> ellipseIntegrateEvents(
       std::vector<Kernel::V3D> E1Vec, Mantid::Kernel::V3D const &peak_q,
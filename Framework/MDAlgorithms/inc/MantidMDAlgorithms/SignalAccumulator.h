@@ -0,0 +1,96 @@
+#ifndef MANTID_MDALGORITHMS_SIGNALACCUMULATOR_H_
+#define MANTID_MDALGORITHMS_SIGNALACCUMULATOR_H_
+
+#include "MantidGeometry/MDGeometry/MDTypes.h"
+#include "MantidMDAlgorithms/DllConfig.h"
+
+#include <memory>
+#include <vector>
+
+namespace Mantid {
+namespace MDAlgorithms {
+
+/** SignalAccumulator : Sums contributions to the signal array of an MD
+  histogram workspace from several threads without atomic operations.
+
+  Every thread adds into its own buffer, and the buffers are summed once at
+  the end. The buffers are split into tiles of TILE_SIZE bins. In Dense mode
+  all tiles are allocated up front. In Sparse mode a tile is only allocated
+  when a thread first adds to one of its bins, so threads that touch a small
+  part of a large grid use little memory. selectMode picks Dense when a full
+  copy of the grid per thread fits into DENSE_MEMORY_LIMIT.
+
+  Used by MDNormSCD and MDNormDirectSC.
+
+  Copyright &copy; 2017 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class MANTID_MDALGORITHMS_DLL SignalAccumulator {
+public:
+  enum class Mode { Dense, Sparse };
+
+  /// Number of bins in a tile
+  static constexpr size_t TILE_SIZE = 4096;
+  /// Bytes of thread buffers above which Sparse mode is used
+  static constexpr size_t DENSE_MEMORY_LIMIT = 256 * 1024 * 1024;
+
+  static Mode selectMode(const size_t size, const int numThreads);
+
+  SignalAccumulator(const size_t size, const int numThreads);
+  SignalAccumulator(const size_t size, const int numThreads, const Mode mode);
+
+  /// Number of bins
+  size_t size() const { return m_size; }
+  /// Number of thread buffers
+  int numThreads() const { return static_cast<int>(m_tiles.size()); }
+  /// Allocation strategy of the thread buffers
+  Mode mode() const { return m_mode; }
+
+  /** Add to a bin in the buffer of a thread. Different threads may call this
+   * concurrently, each with its own thread number.
+   * @param thread :: thread number, smaller than numThreads()
+   * @param index :: linear index of the bin
+   * @param value :: value to add
+   */
+  void add(const int thread, const size_t index, const signal_t value) {
+    auto &tile = m_tiles[thread][index / TILE_SIZE];
+    if (!tile)
+      tile = allocateTile();
+    tile[index % TILE_SIZE] += value;
+  }
+
+  void addTo(signal_t *out) const;
+  void copyTo(signal_t *out) const;
+
+private:
+  using Tile = std::unique_ptr<signal_t[]>;
+  static Tile allocateTile();
+
+  size_t m_size;
+  Mode m_mode;
+  /// Tiles of each thread, null if not allocated
+  std::vector<std::vector<Tile>> m_tiles;
+};
+
+} // namespace MDAlgorithms
+} // namespace Mantid
+
+#endif /* MANTID_MDALGORITHMS_SIGNALACCUMULATOR_H_ */
@@ -1,4 +1,5 @@
 #include "MantidMDAlgorithms/BinMD.h"
+#include "MantidAPI/IBoxControllerIO.h"
 #include "MantidAPI/ImplicitFunctionFactory.h"
 #include "MantidDataObjects/CoordTransformAffine.h"
 #include "MantidDataObjects/CoordTransformAffineParser.h"
@@ -12,6 +13,7 @@
 #include "MantidGeometry/MDGeometry/MDHistoDimension.h"
 #include "MantidKernel/CPUTimer.h"
 #include "MantidKernel/EnabledWhenProperty.h"
+#include "MantidKernel/ISaveable.h"
 #include "MantidKernel/Strings.h"
 #include "MantidKernel/System.h"
 #include "MantidKernel/Utils.h"
@@ -31,6 +33,15 @@ using namespace Mantid::API;
 using namespace Mantid::Geometry;
 using namespace Mantid::DataObjects;
 
+namespace {
+/// Ask the file back end to read the events of a box which are not in memory
+void prefetchBox(const IBoxControllerIO &fileIO, const IMDNode &box) {
+  const ISaveable *saveable = box.getISaveable();
+  if (saveable && saveable->wasSaved() && !saveable->isLoaded())
+    fileIO.prefetchBlock(saveable->getFilePosition(), saveable->getFileSize());
+}
+} // namespace
+
 //----------------------------------------------------------------------------------------------
 /** Constructor
  */
@@ -333,8 +344,13 @@ void BinMD::binByIterating(typename MDEventWorkspace<MDE, nd>::sptr ws) {
       }
 
       // Go through every box for this chunk.
-      for (auto &boxe : boxes) {
-        MDBox<MDE, nd> *box = dynamic_cast<MDBox<MDE, nd> *>(boxe);
+      const IBoxControllerIO *fileIO =
+          bc->isFileBacked() ? bc->getFileIO() : nullptr;
+      for (size_t i = 0; i < boxes.size(); ++i) {
+        // Read the next box from the file while this one is binned
+        if (fileIO && i + 1 < boxes.size())
+          prefetchBox(*fileIO, *boxes[i + 1]);
+        MDBox<MDE, nd> *box = dynamic_cast<MDBox<MDE, nd> *>(boxes[i]);
         // Perform the binning in this separate method.
         if (box && !box->getIsMasked())
           this->binMDBox(box, chunkMin.data(), chunkMax.data());
@@ -74,6 +74,47 @@ void Integrate3DEvents::addEvents(
   }
 }
 
+/**
+ * Make objects for the same peaks, UB matrix and radius as this one, with no
+ * events. Events can be added to each of them on a different thread, without
+ * locking, and then moved here with mergeEvents.
+ *
+ * @param numShards  The number of objects to make.
+ * @return The objects.
+ */
+std::vector<Integrate3DEvents>
+Integrate3DEvents::makeShards(size_t numShards) const {
+  std::vector<Integrate3DEvents> shards;
+  shards.reserve(numShards);
+  for (size_t i = 0; i < numShards; ++i) {
+    shards.emplace_back(std::vector<std::pair<double, V3D>>(), m_UBinv,
+                        m_radius, m_useOnePercentBackgroundCorrection);
+    shards.back().m_peak_qs = m_peak_qs;
+  }
+  return shards;
+}
+
+/**
+ * Move the events of objects made by makeShards to the lists of events near
+ * the peaks of this one. The events of each peak are appended in the order of
+ * the shards, and the shards are left with no events.
+ *
+ * @param shards  The objects with the events to move.
+ */
+void Integrate3DEvents::mergeEvents(std::vector<Integrate3DEvents> &shards) {
+  for (auto &shard : shards) {
+    for (auto &shard_list : shard.m_event_lists) {
+      auto &event_list = m_event_lists[shard_list.first];
+      if (event_list.empty())
+        event_list.swap(shard_list.second);
+      else
+        event_list.insert(event_list.end(), shard_list.second.cbegin(),
+                          shard_list.second.cend());
+    }
+    shard.m_event_lists.clear();
+  }
+}
+
 std::pair<boost::shared_ptr<const Geometry::PeakShape>,
           std::tuple<double, double, double>>
 Integrate3DEvents::integrateStrongPeak(const IntegrationParameters &params,
@@ -59,6 +59,10 @@ void IntegrateEllipsoids::qListFromEventWS(Integrate3DEvents &integrator,
                                            bool hkl_integ) {
   // loop through the eventlists
 
+  // Each thread adds its events to its own shard of the integrator, without
+  // locking, and the shards are merged after the loop
+  auto shards = integrator.makeShards(
+      static_cast<size_t>(Kernel::TaskRuntime::loopThreads()));
   int numSpectra = static_cast<int>(wksp->getNumberHistograms());
   PARALLEL_FOR_IF(Kernel::threadSafe(*wksp))
   for (int i = 0; i < numSpectra; ++i) {
@@ -107,12 +111,13 @@ void IntegrateEllipsoids::qListFromEventWS(Integrate3DEvents &integrator,
         qVec = UBinv * qVec;
       qList.emplace_back(raw_event.m_weight, qVec);
     } // end of loop over events in list
-    PARALLEL_CRITICAL(addEvents) { integrator.addEvents(qList, hkl_integ); }
+    shards[PARALLEL_THREAD_NUMBER].addEvents(qList, hkl_integ);
 
     prog.report();
     PARALLEL_END_INTERUPT_REGION
   } // end of loop over spectra
   PARALLEL_CHECK_INTERUPT_REGION
+  integrator.mergeEvents(shards);
 }
 
 /**
@@ -132,6 +137,10 @@ void IntegrateEllipsoids::qListFromHistoWS(Integrate3DEvents &integrator,
 
   // loop through the eventlists
 
+  // Each thread adds its events to its own shard of the integrator, without
+  // locking, and the shards are merged after the loop
+  auto shards = integrator.makeShards(
+      static_cast<size_t>(Kernel::TaskRuntime::loopThreads()));
   int numSpectra = static_cast<int>(wksp->getNumberHistograms());
   PARALLEL_FOR_IF(Kernel::threadSafe(*wksp))
   for (int i = 0; i < numSpectra; ++i) {
@@ -183,11 +192,12 @@ void IntegrateEllipsoids::qListFromHistoWS(Integrate3DEvents &integrator,
         qList.emplace_back(yVal, qVec);
       }
     }
-    PARALLEL_CRITICAL(addHisto) { integrator.addEvents(qList, hkl_integ); }
+    shards[PARALLEL_THREAD_NUMBER].addEvents(qList, hkl_integ);
     prog.report();
     PARALLEL_END_INTERUPT_REGION
   } // end of loop over spectra
   PARALLEL_CHECK_INTERUPT_REGION
+  integrator.mergeEvents(shards);
 }
 
 /** NOTE: This has been adapted from the SaveIsawQvector algorithm.
@@ -428,14 +438,16 @@ void IntegrateEllipsoids::exec() {
     qListFromHistoWS(integrator, prog, histoWS, UBinv, hkl_integ);
   }
 
-  double inti;
-  double sigi;
   std::vector<double> principalaxis1, principalaxis2, principalaxis3;
-  V3D peak_q;
-  for (size_t i = 0; i < n_peaks; i++) {
+  // The peaks are integrated in parallel; the axes of the ellipsoids kept
+  // for the statistics are gathered in the order of the peaks afterwards
+  std::vector<std::vector<double>> peakAxesRadii(n_peaks);
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int i = 0; i < static_cast<int>(n_peaks); i++) {
+    PARALLEL_START_INTERUPT_REGION
     V3D hkl(peaks[i].getH(), peaks[i].getK(), peaks[i].getL());
     if (Geometry::IndexingUtils::ValidIndex(hkl, 1.0)) {
-      peak_q = peaks[i].getQLabFrame();
+      const V3D peak_q = peaks[i].getQLabFrame();
       std::vector<double> axes_radii;
       // modulus of Q
       double lenQpeak = 0.0;
@@ -464,6 +476,8 @@ void IntegrateEllipsoids::exec() {
       PeakRadiusVector[i] = adaptiveRadius;
       BackgroundInnerRadiusVector[i] = adaptiveBack_inner_radius;
       BackgroundOuterRadiusVector[i] = adaptiveBack_outer_radius;
+      double inti;
+      double sigi;
       Mantid::Geometry::PeakShape_const_sptr shape =
           integrator.ellipseIntegrateEvents(
               E1Vec, peak_q, specify_size, adaptiveRadius,
@@ -474,15 +488,22 @@ void IntegrateEllipsoids::exec() {
       peaks[i].setPeakShape(shape);
       if (axes_radii.size() == 3) {
         if (inti / sigi > cutoffIsigI || cutoffIsigI == EMPTY_DBL()) {
-          principalaxis1.push_back(axes_radii[0]);
-          principalaxis2.push_back(axes_radii[1]);
-          principalaxis3.push_back(axes_radii[2]);
+          peakAxesRadii[i] = std::move(axes_radii);
         }
       }
     } else {
       peaks[i].setIntensity(0.0);
       peaks[i].setSigmaIntensity(0.0);
     }
+    PARALLEL_END_INTERUPT_REGION
+  }
+  PARALLEL_CHECK_INTERUPT_REGION
+  for (const auto &axes_radii : peakAxesRadii) {
+    if (axes_radii.size() == 3) {
+      principalaxis1.push_back(axes_radii[0]);
+      principalaxis2.push_back(axes_radii[1]);
+      principalaxis3.push_back(axes_radii[2]);
+    }
   }
   if (principalaxis1.size() > 1) {
     Statistics stats1 = getStatistics(principalaxis1);
@@ -530,26 +551,33 @@ void IntegrateEllipsoids::exec() {
       back_outer_radius = peak_radius * 1.25992105; // A factor of 2 ^ (1/3)
                                                     // will make the background
       // shell volume equal to the peak region volume.
-      V3D peak_q;
-      for (size_t i = 0; i < n_peaks; i++) {
+      PARALLEL_FOR_NO_WSP_CHECK()
+      for (int i = 0; i < static_cast<int>(n_peaks); i++) {
+        PARALLEL_START_INTERUPT_REGION
         V3D hkl(peaks[i].getH(), peaks[i].getK(), peaks[i].getL());
+        peakAxesRadii[i].clear();
         if (Geometry::IndexingUtils::ValidIndex(hkl, 1.0)) {
-          peak_q = peaks[i].getQLabFrame();
-          std::vector<double> axes_radii;
+          const V3D peak_q = peaks[i].getQLabFrame();
+          double inti;
+          double sigi;
           integrator.ellipseIntegrateEvents(
               E1Vec, peak_q, specify_size, peak_radius, back_inner_radius,
-              back_outer_radius, axes_radii, inti, sigi);
+              back_outer_radius, peakAxesRadii[i], inti, sigi);
           peaks[i].setIntensity(inti);
           peaks[i].setSigmaIntensity(sigi);
-          if (axes_radii.size() == 3) {
-            principalaxis1.push_back(axes_radii[0]);
-            principalaxis2.push_back(axes_radii[1]);
-            principalaxis3.push_back(axes_radii[2]);
-          }
         } else {
           peaks[i].setIntensity(0.0);
           peaks[i].setSigmaIntensity(0.0);
         }
+        PARALLEL_END_INTERUPT_REGION
+      }
+      PARALLEL_CHECK_INTERUPT_REGION
+      for (const auto &axes_radii : peakAxesRadii) {
+        if (axes_radii.size() == 3) {
+          principalaxis1.push_back(axes_radii[0]);
+          principalaxis2.push_back(axes_radii[1]);
+          principalaxis3.push_back(axes_radii[2]);
+        }
       }
       if (principalaxis1.size() > 1) {
         size_t histogramNumber = 3;
@@ -368,6 +368,10 @@ void IntegrateEllipsoidsTwoStep::qListFromEventWS(Integrate3DEvents &integrator,
 
   m_targWSDescr.m_PreprDetTable = table;
 
+  // Each thread adds its events to its own shard of the integrator, without
+  // locking, and the shards are merged after the loop
+  auto shards = integrator.makeShards(
+      static_cast<size_t>(Kernel::TaskRuntime::loopThreads()));
   int numSpectra = static_cast<int>(wksp->getNumberHistograms());
   PARALLEL_FOR_IF(Kernel::threadSafe(*wksp))
   for (int i = 0; i < numSpectra; ++i) {
@@ -416,12 +420,13 @@ void IntegrateEllipsoidsTwoStep::qListFromEventWS(Integrate3DEvents &integrator,
         qVec = UBinv * qVec;
       qList.emplace_back(raw_event.m_weight, qVec);
     } // end of loop over events in list
-    PARALLEL_CRITICAL(addEvents) { integrator.addEvents(qList, hkl_integ); }
+    shards[PARALLEL_THREAD_NUMBER].addEvents(qList, hkl_integ);
 
     prog.report();
     PARALLEL_END_INTERUPT_REGION
   } // end of loop over spectra
   PARALLEL_CHECK_INTERUPT_REGION
+  integrator.mergeEvents(shards);
 }
 
 /**
@@ -466,6 +471,10 @@ void IntegrateEllipsoidsTwoStep::qListFromHistoWS(Integrate3DEvents &integrator,
   else
     m_targWSDescr.m_PreprDetTable = table;
 
+  // Each thread adds its events to its own shard of the integrator, without
+  // locking, and the shards are merged after the loop
+  auto shards = integrator.makeShards(
+      static_cast<size_t>(Kernel::TaskRuntime::loopThreads()));
   int numSpectra = static_cast<int>(wksp->getNumberHistograms());
   PARALLEL_FOR_IF(Kernel::threadSafe(*wksp))
   for (int i = 0; i < numSpectra; ++i) {
@@ -511,11 +520,12 @@ void IntegrateEllipsoidsTwoStep::qListFromHistoWS(Integrate3DEvents &integrator,
         qList.emplace_back(yVal, qVec);
       }
     }
-    PARALLEL_CRITICAL(addHisto) { integrator.addEvents(qList, hkl_integ); }
+    shards[PARALLEL_THREAD_NUMBER].addEvents(qList, hkl_integ);
     prog.report();
     PARALLEL_END_INTERUPT_REGION
   } // end of loop over spectra
   PARALLEL_CHECK_INTERUPT_REGION
+  integrator.mergeEvents(shards);
 }
 
 /*
@@ -289,6 +289,72 @@ void IntegratePeaksMD2::integrate(typename MDEventWorkspace<MDE, nd>::sptr ws) {
   // Initialize progress reporting
   int nPeaks = peakWS->getNumberPeaks();
   Progress progress(this, 0., 1., nPeaks);
+
+  // The center of each peak as a position in the dimensions of the workspace,
+  // and its distance to the edge of the detector
+  std::vector<V3D> positions(nPeaks);
+  std::vector<double> edges(nPeaks);
+  for (int i = 0; i < nPeaks; ++i) {
+    IPeak &p = peakWS->getPeak(i);
+    if (CoordinatesToUse == Mantid::Kernel::QLab) //"Q (lab frame)"
+      positions[i] = p.getQLabFrame();
+    else if (CoordinatesToUse == Mantid::Kernel::QSample) //"Q (sample frame)"
+      positions[i] = p.getQSampleFrame();
+    else if (CoordinatesToUse == Mantid::Kernel::HKL) //"HKL"
+      positions[i] = p.getHKL();
+    edges[i] = detectorQ(p.getQLabFrame(),
+                         std::max(BackgroundOuterRadius, PeakRadius));
+  }
+
+  // Integrate the spheres of all the peaks in one pass over the boxes, rather
+  // than going down the boxes from the top for each peak
+  std::vector<std::unique_ptr<CoordTransformDistance>> sphereTransforms(nPeaks);
+  std::vector<IntegrationSphere> peakSpheres(nPeaks);
+  std::vector<IntegrationSphere> backgroundSpheres(nPeaks);
+  if (!cylinderBool) {
+    std::vector<IntegrationSphere *> spheres;
+    for (int i = 0; i < nPeaks; ++i) {
+      if (edges[i] < std::max(BackgroundOuterRadius, PeakRadius) &&
+          !integrateEdge)
+        continue;
+      bool dimensionsUsed[nd];
+      coord_t center[nd];
+      for (size_t d = 0; d < nd; ++d) {
+        dimensionsUsed[d] = true; // Use all dimensions
+        center[d] = static_cast<coord_t>(positions[i][d]);
+      }
+      // modulus of Q
+      coord_t lenQpeak = 0.0;
+      if (adaptiveQMultiplier != 0.0) {
+        for (size_t d = 0; d < nd; d++) {
+          lenQpeak += center[d] * center[d];
+        }
+        lenQpeak = std::sqrt(lenQpeak);
+      }
+      double adaptiveRadius = adaptiveQMultiplier * lenQpeak + PeakRadius;
+      if (adaptiveRadius <= 0.0)
+        continue;
+      sphereTransforms[i] = Kernel::make_unique<CoordTransformDistance>(
+          nd, center, dimensionsUsed);
+      peakSpheres[i] = {sphereTransforms[i].get(),
+                        static_cast<coord_t>(adaptiveRadius * adaptiveRadius),
+                        0.0 /* innerRadiusSquared */, 0.0, 0.0};
+      spheres.push_back(&peakSpheres[i]);
+      if (BackgroundOuterRadius > PeakRadius) {
+        double outerRadius =
+            adaptiveQBackgroundMultiplier * lenQpeak + BackgroundOuterRadius;
+        double innerRadius =
+            adaptiveQBackgroundMultiplier * lenQpeak + BackgroundInnerRadius;
+        backgroundSpheres[i] = {sphereTransforms[i].get(),
+                                static_cast<coord_t>(outerRadius * outerRadius),
+                                static_cast<coord_t>(innerRadius * innerRadius),
+                                0.0, 0.0};
+        spheres.push_back(&backgroundSpheres[i]);
+      }
+    }
+    ws->getBox()->integrateSpheres(spheres, useOnePercentBackgroundCorrection);
+  }
+
   for (int i = 0; i < nPeaks; ++i) {
     if (this->getCancel())
       break; // User cancellation
@@ -296,20 +362,10 @@ void IntegratePeaksMD2::integrate(typename MDEventWorkspace<MDE, nd>::sptr ws) {
 
     // Get a direct ref to that peak.
     IPeak &p = peakWS->getPeak(i);
-
-    // Get the peak center as a position in the dimensions of the workspace
-    V3D pos;
-    if (CoordinatesToUse == Mantid::Kernel::QLab) //"Q (lab frame)"
-      pos = p.getQLabFrame();
-    else if (CoordinatesToUse == Mantid::Kernel::QSample) //"Q (sample frame)"
-      pos = p.getQSampleFrame();
-    else if (CoordinatesToUse == Mantid::Kernel::HKL) //"HKL"
-      pos = p.getHKL();
+    const V3D &pos = positions[i];
 
     // Do not integrate if sphere is off edge of detector
-
-    double edge = detectorQ(p.getQLabFrame(),
-                            std::max(BackgroundOuterRadius, PeakRadius));
+    double edge = edges[i];
     if (edge < std::max(BackgroundOuterRadius, PeakRadius)) {
       g_log.warning() << "Warning: sphere/cylinder for integration is off edge "
                          "of detector for peak " << i
@@ -362,7 +418,6 @@ void IntegratePeaksMD2::integrate(typename MDEventWorkspace<MDE, nd>::sptr ws) {
           adaptiveQBackgroundMultiplier * lenQpeak + BackgroundInnerRadius;
       BackgroundOuterRadiusVector[i] =
           adaptiveQBackgroundMultiplier * lenQpeak + BackgroundOuterRadius;
-      CoordTransformDistance sphere(nd, center, dimensionsUsed);
 
       if (Peak *shapeablePeak = dynamic_cast<Peak *>(&p)) {
 
@@ -373,28 +428,16 @@ void IntegratePeaksMD2::integrate(typename MDEventWorkspace<MDE, nd>::sptr ws) {
         shapeablePeak->setPeakShape(sphere);
       }
 
-      // Perform the integration into whatever box is contained within.
-      ws->getBox()->integrateSphere(
-          sphere, static_cast<coord_t>(adaptiveRadius * adaptiveRadius), signal,
-          errorSquared, 0.0 /* innerRadiusSquared */,
-          useOnePercentBackgroundCorrection);
+      // The integration into whatever box is contained within, done above.
+      signal = peakSpheres[i].signal;
+      errorSquared = peakSpheres[i].errorSquared;
 
       // Integrate around the background radius
 
       if (BackgroundOuterRadius > PeakRadius) {
         // Get the total signal inside "BackgroundOuterRadius"
-        ws->getBox()->integrateSphere(
-            sphere,
-            static_cast<coord_t>((adaptiveQBackgroundMultiplier * lenQpeak +
-                                  BackgroundOuterRadius) *
-                                 (adaptiveQBackgroundMultiplier * lenQpeak +
-                                  BackgroundOuterRadius)),
-            bgSignal, bgErrorSquared,
-            static_cast<coord_t>((adaptiveQBackgroundMultiplier * lenQpeak +
-                                  BackgroundInnerRadius) *
-                                 (adaptiveQBackgroundMultiplier * lenQpeak +
-                                  BackgroundInnerRadius)),
-            useOnePercentBackgroundCorrection);
+        bgSignal = backgroundSpheres[i].signal;
+        bgErrorSquared = backgroundSpheres[i].errorSquared;
 
         // Relative volume of peak vs the BackgroundOuterRadius sphere
         double ratio = (PeakRadius / BackgroundOuterRadius);
@@ -15,6 +15,7 @@
 #include "MantidKernel/Strings.h"
 #include "MantidKernel/TimeSeriesProperty.h"
 #include "MantidKernel/VectorHelper.h"
+#include "MantidMDAlgorithms/SignalAccumulator.h"
 
 namespace Mantid {
 namespace MDAlgorithms {
@@ -31,6 +32,25 @@ bool compareMomentum(const std::array<double, 4> &v1,
                      const std::array<double, 4> &v2) {
   return (v1[3] < v2[3]);
 }
+
+/** Find the sorted bin boundaries that lie strictly between start and end
+ * and inside [min, max], by bisection instead of testing every boundary.
+ * @return the range of indices of these boundaries in x
+ */
+std::pair<size_t, size_t> boundariesBetween(const std::vector<double> &x,
+                                            const double start,
+                                            const double end, const double min,
+                                            const double max) {
+  const auto first =
+      std::max(std::upper_bound(x.begin(), x.end(), std::min(start, end)),
+               std::lower_bound(x.begin(), x.end(), min));
+  const auto last =
+      std::min(std::lower_bound(x.begin(), x.end(), std::max(start, end)),
+               std::upper_bound(x.begin(), x.end(), max));
+  const auto firstIndex = static_cast<size_t>(first - x.begin());
+  const auto lastIndex = static_cast<size_t>(last - x.begin());
+  return {firstIndex, std::max(firstIndex, lastIndex)};
+}
 }
 
 // Register the algorithm into the AlgorithmFactory
@@ -428,7 +448,8 @@ void MDNormSCD::calculateNormalization(
       solidAngleWS->getDetectorIDToWorkspaceIndexMap();
 
   const size_t vmdDims = 4;
-  std::vector<std::atomic<signal_t>> signalArray(m_normWS->getNPoints());
+  SignalAccumulator signalArray(m_normWS->getNPoints(),
+                                PARALLEL_GET_MAX_THREADS);
   std::vector<std::array<double, 4>> intersections;
   std::vector<double> xValues, yValues;
   std::vector<coord_t> pos, posNew;
@@ -437,6 +458,7 @@ void MDNormSCD::calculateNormalization(
 PRAGMA_OMP(parallel for private(intersections, xValues, yValues, pos, posNew) if (Kernel::threadSafe(*integrFlux)))
 for (int64_t i = 0; i < ndets; i++) {
   PARALLEL_START_INTERUPT_REGION
+  const int thread = PARALLEL_THREAD_NUMBER;
 
   if (!spectrumInfo.hasDetectors(i) || spectrumInfo.isMonitor(i) ||
       spectrumInfo.isMasked(i)) {
@@ -501,8 +523,7 @@ for (int64_t i = 0; i < ndets; i++) {
     size_t k = static_cast<size_t>(std::distance(intersectionsBegin, it));
     // signal = integral between two consecutive intersections
     signal_t signal = (yValues[k] - yValues[k - 1]) * solid;
-    Mantid::Kernel::AtomicOp(signalArray[linIndex], signal,
-                             std::plus<signal_t>());
+    signalArray.add(thread, linIndex, signal);
   }
   prog->report();
 
@@ -510,13 +531,9 @@ for (int64_t i = 0; i < ndets; i++) {
 }
 PARALLEL_CHECK_INTERUPT_REGION
 if (m_accumulate) {
-  std::transform(
-      signalArray.cbegin(), signalArray.cend(), m_normWS->getSignalArray(),
-      m_normWS->getSignalArray(),
-      [](const std::atomic<signal_t> &a, const signal_t &b) { return a + b; });
+  signalArray.addTo(m_normWS->getSignalArray());
 } else {
-  std::copy(signalArray.cbegin(), signalArray.cend(),
-            m_normWS->getSignalArray());
+  signalArray.copyTo(m_normWS->getSignalArray());
 }
 }
 
@@ -631,20 +648,18 @@ void MDNormSCD::calculateIntersections(
     double fk = (kEnd - kStart) / (hEnd - hStart);
     double fl = (lEnd - lStart) / (hEnd - hStart);
     if (!m_hIntegrated) {
-      for (size_t i = 0; i < hNBins; i++) {
+      const auto range = boundariesBetween(m_hX, hStart, hEnd, m_hmin, m_hmax);
+      for (size_t i = range.first; i < range.second; i++) {
         double hi = m_hX[i];
-        if ((hi >= m_hmin) && (hi <= m_hmax) &&
-            ((hStart - hi) * (hEnd - hi) < 0)) {
-          // if hi is between hStart and hEnd, then ki and li will be between
-          // kStart, kEnd and lStart, lEnd and momi will be between m_kiMin and
-          // KnincidemtmMax
-          double ki = fk * (hi - hStart) + kStart;
-          double li = fl * (hi - hStart) + lStart;
-          if ((ki >= m_kmin) && (ki <= m_kmax) && (li >= m_lmin) &&
-              (li <= m_lmax)) {
-            double momi = fmom * (hi - hStart) + m_kiMin;
-            intersections.push_back({{hi, ki, li, momi}});
-          }
+        // if hi is between hStart and hEnd, then ki and li will be between
+        // kStart, kEnd and lStart, lEnd and momi will be between m_kiMin and
+        // KnincidemtmMax
+        double ki = fk * (hi - hStart) + kStart;
+        double li = fl * (hi - hStart) + lStart;
+        if ((ki >= m_kmin) && (ki <= m_kmax) && (li >= m_lmin) &&
+            (li <= m_lmax)) {
+          double momi = fmom * (hi - hStart) + m_kiMin;
+          intersections.push_back({{hi, ki, li, momi}});
         }
       }
     }
@@ -677,19 +692,17 @@ void MDNormSCD::calculateIntersections(
     double fh = (hEnd - hStart) / (kEnd - kStart);
     double fl = (lEnd - lStart) / (kEnd - kStart);
     if (!m_kIntegrated) {
-      for (size_t i = 0; i < kNBins; i++) {
+      const auto range = boundariesBetween(m_kX, kStart, kEnd, m_kmin, m_kmax);
+      for (size_t i = range.first; i < range.second; i++) {
         double ki = m_kX[i];
-        if ((ki >= m_kmin) && (ki <= m_kmax) &&
-            ((kStart - ki) * (kEnd - ki) < 0)) {
-          // if ki is between kStart and kEnd, then hi and li will be between
-          // hStart, hEnd and lStart, lEnd
-          double hi = fh * (ki - kStart) + hStart;
-          double li = fl * (ki - kStart) + lStart;
-          if ((hi >= m_hmin) && (hi <= m_hmax) && (li >= m_lmin) &&
-              (li <= m_lmax)) {
-            double momi = fmom * (ki - kStart) + m_kiMin;
-            intersections.push_back({{hi, ki, li, momi}});
-          }
+        // if ki is between kStart and kEnd, then hi and li will be between
+        // hStart, hEnd and lStart, lEnd
+        double hi = fh * (ki - kStart) + hStart;
+        double li = fl * (ki - kStart) + lStart;
+        if ((hi >= m_hmin) && (hi <= m_hmax) && (li >= m_lmin) &&
+            (li <= m_lmax)) {
+          double momi = fmom * (ki - kStart) + m_kiMin;
+          intersections.push_back({{hi, ki, li, momi}});
         }
       }
     }
@@ -722,19 +735,17 @@ void MDNormSCD::calculateIntersections(
     double fh = (hEnd - hStart) / (lEnd - lStart);
     double fk = (kEnd - kStart) / (lEnd - lStart);
     if (!m_lIntegrated) {
-      for (size_t i = 0; i < lNBins; i++) {
+      const auto range = boundariesBetween(m_lX, lStart, lEnd, m_lmin, m_lmax);
+      for (size_t i = range.first; i < range.second; i++) {
         double li = m_lX[i];
-        if ((li >= m_lmin) && (li <= m_lmax) &&
-            ((lStart - li) * (lEnd - li) < 0)) {
-          // if li is between lStart and lEnd, then hi and ki will be between
-          // hStart, hEnd and kStart, kEnd
-          double hi = fh * (li - lStart) + hStart;
-          double ki = fk * (li - lStart) + kStart;
-          if ((hi >= m_hmin) && (hi <= m_hmax) && (ki >= m_kmin) &&
-              (ki <= m_kmax)) {
-            double momi = fmom * (li - lStart) + m_kiMin;
-            intersections.push_back({{hi, ki, li, momi}});
-          }
+        // if li is between lStart and lEnd, then hi and ki will be between
+        // hStart, hEnd and kStart, kEnd
+        double hi = fh * (li - lStart) + hStart;
+        double ki = fk * (li - lStart) + kStart;
+        if ((hi >= m_hmin) && (hi <= m_hmax) && (ki >= m_kmin) &&
+            (ki <= m_kmax)) {
+          double momi = fmom * (li - lStart) + m_kiMin;
+          intersections.push_back({{hi, ki, li, momi}});
         }
       }
     }
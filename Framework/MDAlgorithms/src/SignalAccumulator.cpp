@@ -0,0 +1,89 @@
+#include "MantidMDAlgorithms/SignalAccumulator.h"
+#include "MantidKernel/MultiThreaded.h"
+
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+
+namespace Mantid {
+namespace MDAlgorithms {
+
+constexpr size_t SignalAccumulator::TILE_SIZE;
+constexpr size_t SignalAccumulator::DENSE_MEMORY_LIMIT;
+
+/** Choose how to allocate the thread buffers
+ * @param size :: number of bins
+ * @param numThreads :: number of threads adding contributions
+ * @return Dense if a full buffer for every thread fits into
+ * DENSE_MEMORY_LIMIT, Sparse otherwise
+ */
+SignalAccumulator::Mode
+SignalAccumulator::selectMode(const size_t size, const int numThreads) {
+  const size_t bytes =
+      size * sizeof(signal_t) * static_cast<size_t>(std::max(numThreads, 1));
+  return bytes <= DENSE_MEMORY_LIMIT ? Mode::Dense : Mode::Sparse;
+}
+
+/** Constructor. The mode is chosen by selectMode.
+ * @param size :: number of bins
+ * @param numThreads :: number of threads adding contributions
+ */
+SignalAccumulator::SignalAccumulator(const size_t size, const int numThreads)
+    : SignalAccumulator(size, numThreads, selectMode(size, numThreads)) {}
+
+/** Constructor
+ * @param size :: number of bins
+ * @param numThreads :: number of threads adding contributions
+ * @param mode :: allocation strategy of the thread buffers
+ * @throw std::invalid_argument if numThreads is not positive
+ */
+SignalAccumulator::SignalAccumulator(const size_t size, const int numThreads,
+                                     const Mode mode)
+    : m_size(size), m_mode(mode) {
+  if (numThreads < 1)
+    throw std::invalid_argument(
+        "SignalAccumulator: the number of threads must be positive.");
+  const size_t numTiles = (size + TILE_SIZE - 1) / TILE_SIZE;
+  m_tiles.resize(numThreads);
+  for (auto &tiles : m_tiles) {
+    tiles.resize(numTiles);
+    if (mode == Mode::Dense)
+      std::generate(tiles.begin(), tiles.end(), allocateTile);
+  }
+}
+
+/** Add the sum of all thread buffers to an array
+ * @param out :: array of size() values
+ */
+void SignalAccumulator::addTo(signal_t *out) const {
+  const int64_t numTiles = static_cast<int64_t>(m_tiles.front().size());
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int64_t i = 0; i < numTiles; ++i) {
+    const size_t tileIndex = static_cast<size_t>(i);
+    const size_t begin = tileIndex * TILE_SIZE;
+    const size_t length = std::min(TILE_SIZE, m_size - begin);
+    for (const auto &tiles : m_tiles) {
+      const auto &tile = tiles[tileIndex];
+      if (!tile)
+        continue;
+      std::transform(tile.get(), tile.get() + length, out + begin, out + begin,
+                     std::plus<signal_t>());
+    }
+  }
+}
+
+/** Overwrite an array with the sum of all thread buffers
+ * @param out :: array of size() values
+ */
+void SignalAccumulator::copyTo(signal_t *out) const {
+  std::fill(out, out + m_size, 0.0);
+  addTo(out);
+}
+
+/// @return a new tile with all bins set to zero
+SignalAccumulator::Tile SignalAccumulator::allocateTile() {
+  return Tile(new signal_t[TILE_SIZE]());
+}
+
+} // namespace MDAlgorithms
+} // namespace Mantid
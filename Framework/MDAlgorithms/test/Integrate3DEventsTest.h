@@ -296,6 +296,55 @@ public:
     doTestSignalToNoiseRatio(false, 160.33, 1.088, 0.094);
   }
 
+  void test_events_added_to_shards_give_the_same_intensities() {
+    const V3D peak_1(20, 0, 0);
+    const V3D peak_2(0, 20, 0);
+    std::vector<std::pair<double, V3D>> peak_q_list{{1., peak_1},
+                                                    {1., peak_2}};
+    // synthesize a UB-inverse to map
+    DblMatrix UBinv(3, 3, false); // Q to h,k,l
+    UBinv.setRow(0, V3D(.1, 0, 0));
+    UBinv.setRow(1, V3D(0, .2, 0));
+    UBinv.setRow(2, V3D(0, 0, .25));
+
+    std::vector<std::pair<double, V3D>> event_Qs;
+    generatePeak(event_Qs, peak_1, 0.1, 1000, 1);
+    generatePeak(event_Qs, peak_2, 0.1, 200, 2);
+    generateUniformBackground(event_Qs, 10, -2, 22);
+
+    Integrate3DEvents integrator(peak_q_list, UBinv, 0.8);
+    integrator.addEvents(event_Qs, false);
+
+    // Add consecutive parts of the events to each shard
+    Integrate3DEvents sharded(peak_q_list, UBinv, 0.8);
+    auto shards = sharded.makeShards(3);
+    const size_t partSize = event_Qs.size() / shards.size() + 1;
+    for (size_t i = 0; i < shards.size(); ++i) {
+      const auto begin = event_Qs.cbegin() + std::min(i * partSize,
+                                                      event_Qs.size());
+      const auto end = event_Qs.cbegin() + std::min((i + 1) * partSize,
+                                                    event_Qs.size());
+      shards[i].addEvents(std::vector<std::pair<double, V3D>>(begin, end),
+                          false);
+    }
+    sharded.mergeEvents(shards);
+
+    std::vector<Kernel::V3D> E1Vec;
+    for (const auto &peak : peak_q_list) {
+      std::vector<double> axes, shardedAxes;
+      double inti, sigi, shardedInti, shardedSigi;
+      integrator.ellipseIntegrateEvents(E1Vec, peak.second, false, 0.5, 0.5,
+                                        0.8, axes, inti, sigi);
+      sharded.ellipseIntegrateEvents(E1Vec, peak.second, false, 0.5, 0.5,
+                                     0.8, shardedAxes, shardedInti,
+                                     shardedSigi);
+      TS_ASSERT_DIFFERS(inti, 0.0);
+      TS_ASSERT_EQUALS(shardedInti, inti);
+      TS_ASSERT_EQUALS(shardedSigi, sigi);
+      TS_ASSERT_EQUALS(shardedAxes, axes);
+    }
+  }
+
 private:
   void doTestSignalToNoiseRatio(const bool useOnePercentBackgroundCorrection,
                                 const double expectedRatio1,
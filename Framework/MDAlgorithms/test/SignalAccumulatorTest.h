@@ -0,0 +1,92 @@
+#ifndef MANTID_MDALGORITHMS_SIGNALACCUMULATORTEST_H_
+#define MANTID_MDALGORITHMS_SIGNALACCUMULATORTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidKernel/MultiThreaded.h"
+#include "MantidMDAlgorithms/SignalAccumulator.h"
+
+#include <vector>
+
+using Mantid::MDAlgorithms::SignalAccumulator;
+using Mantid::signal_t;
+
+class SignalAccumulatorTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static SignalAccumulatorTest *createSuite() {
+    return new SignalAccumulatorTest();
+  }
+  static void destroySuite(SignalAccumulatorTest *suite) { delete suite; }
+
+  void test_constructor_throws_without_threads() {
+    TS_ASSERT_THROWS(SignalAccumulator(10, 0), std::invalid_argument);
+  }
+
+  void test_selectMode() {
+    const size_t limit =
+        SignalAccumulator::DENSE_MEMORY_LIMIT / sizeof(signal_t);
+    TS_ASSERT_EQUALS(SignalAccumulator::selectMode(limit / 4, 4),
+                     SignalAccumulator::Mode::Dense);
+    TS_ASSERT_EQUALS(SignalAccumulator::selectMode(limit / 4 + 1, 4),
+                     SignalAccumulator::Mode::Sparse);
+    TS_ASSERT_EQUALS(SignalAccumulator(100, 4).mode(),
+                     SignalAccumulator::Mode::Dense);
+  }
+
+  void test_dense() { checkSums(SignalAccumulator::Mode::Dense); }
+
+  void test_sparse() { checkSums(SignalAccumulator::Mode::Sparse); }
+
+  void test_addTo_keeps_existing_values() {
+    SignalAccumulator accumulator(3, 2);
+    accumulator.add(0, 1, 1.0);
+    accumulator.add(1, 1, 2.0);
+    std::vector<signal_t> out{1.0, 1.0, 1.0};
+    accumulator.addTo(out.data());
+    TS_ASSERT_EQUALS(out, (std::vector<signal_t>{1.0, 4.0, 1.0}));
+    accumulator.copyTo(out.data());
+    TS_ASSERT_EQUALS(out, (std::vector<signal_t>{0.0, 3.0, 0.0}));
+  }
+
+  void test_concurrent_adds() {
+    const int numThreads = PARALLEL_GET_MAX_THREADS;
+    const size_t size = 3 * SignalAccumulator::TILE_SIZE + 7;
+    SignalAccumulator accumulator(size, numThreads,
+                                  SignalAccumulator::Mode::Sparse);
+    const int64_t numAdds = 100000;
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int64_t i = 0; i < numAdds; ++i)
+      accumulator.add(PARALLEL_THREAD_NUMBER, static_cast<size_t>(i) % size,
+                      1.0);
+    std::vector<signal_t> out(size);
+    accumulator.copyTo(out.data());
+    double total = 0.0;
+    for (const auto value : out)
+      total += value;
+    TS_ASSERT_EQUALS(total, static_cast<double>(numAdds));
+    TS_ASSERT_EQUALS(out[size - 1], static_cast<double>(numAdds / size));
+  }
+
+private:
+  void checkSums(const SignalAccumulator::Mode mode) {
+    const size_t size = 2 * SignalAccumulator::TILE_SIZE + 1;
+    SignalAccumulator accumulator(size, 3, mode);
+    TS_ASSERT_EQUALS(accumulator.mode(), mode);
+    TS_ASSERT_EQUALS(accumulator.size(), size);
+    TS_ASSERT_EQUALS(accumulator.numThreads(), 3);
+    accumulator.add(0, 0, 1.0);
+    accumulator.add(1, 0, 2.0);
+    accumulator.add(2, size - 1, 3.0);
+    accumulator.add(2, size - 1, 4.0);
+    std::vector<signal_t> out(size, 0.0);
+    accumulator.addTo(out.data());
+    TS_ASSERT_EQUALS(out[0], 3.0);
+    TS_ASSERT_EQUALS(out[1], 0.0);
+    TS_ASSERT_EQUALS(out[SignalAccumulator::TILE_SIZE], 0.0);
+    TS_ASSERT_EQUALS(out[size - 1], 7.0);
+  }
+};
+
+#endif /* MANTID_MDALGORITHMS_SIGNALACCUMULATORTEST_H_ */
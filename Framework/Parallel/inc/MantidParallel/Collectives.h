@@ -4,6 +4,12 @@
 #include "MantidParallel/Communicator.h"
 #include "MantidParallel/DllConfig.h"
 
+#include <boost/serialization/array.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
 #ifdef MPI_EXPERIMENTAL
 #include <boost/mpi/collectives.hpp>
 #endif
@@ -13,7 +19,8 @@ namespace Parallel {
 
 /** Wrapper for boost::mpi::gather and other collective communication. For
   non-MPI builds an equivalent implementation with reduced functionality is
-  provided.
+  provided. It uses binomial trees for broadcast and reduce, which also form
+  all_reduce and all_gather, and a ring exchange for all_to_all.
 
   @author Simon Heybrock
   @date 2017
@@ -41,6 +48,17 @@ namespace Parallel {
 */
 
 namespace detail {
+/// Position of a rank in a binomial tree rooted at root
+inline int treeRank(const Communicator &comm, const int root) {
+  return (comm.rank() - root + comm.size()) % comm.size();
+}
+
+/// Rank of the given position in a binomial tree rooted at root
+inline int fromTreeRank(const Communicator &comm, const int treeRank,
+                        const int root) {
+  return (treeRank + root) % comm.size();
+}
+
 template <typename T>
 void gather(const Communicator &comm, const T &in_value,
             std::vector<T> &out_values, int root) {
@@ -68,6 +86,173 @@ void gather(const Communicator &comm, const T &in_value, int root) {
         "Parallel::gather on root rank without output argument.");
   }
 }
+
+/// Binomial tree broadcast. Send and recv are passed the payload, i.e., a
+/// value or an array wrapper.
+template <typename T>
+void broadcastTree(const Communicator &comm, T &&payload, int root) {
+  int tag{0};
+  const int size = comm.size();
+  const int rank = treeRank(comm, root);
+  int mask = 1;
+  while (mask < size) {
+    if (rank & mask) {
+      comm.recv(fromTreeRank(comm, rank - mask, root), tag, payload);
+      break;
+    }
+    mask <<= 1;
+  }
+  mask >>= 1;
+  while (mask > 0) {
+    if (rank + mask < size)
+      comm.send(fromTreeRank(comm, rank + mask, root), tag, payload);
+    mask >>= 1;
+  }
+}
+
+template <typename T>
+void broadcast(const Communicator &comm, T &value, int root) {
+  detail::broadcastTree(comm, value, root);
+}
+
+template <typename T>
+void broadcast(const Communicator &comm, T *values, int n, int root) {
+  detail::broadcastTree(comm, boost::serialization::make_array(values, n),
+                        root);
+}
+
+/** Binomial tree reduction of an array. Each rank combines the partial
+ * results of its subtree and sends them to its parent, root ends up with the
+ * result. The operation must be associative and commutative. */
+template <typename T, typename Op>
+void reduceTree(const Communicator &comm, const T *in_values, int n,
+                T *out_values, Op op, int root) {
+  int tag{0};
+  const int size = comm.size();
+  const int rank = treeRank(comm, root);
+  std::vector<T> result(in_values, in_values + n);
+  std::vector<T> other(n);
+  for (int mask = 1; mask < size; mask <<= 1) {
+    if (rank & mask) {
+      comm.send(fromTreeRank(comm, rank - mask, root), tag,
+                boost::serialization::make_array(result.data(), n));
+      return;
+    }
+    if (rank + mask < size) {
+      comm.recv(fromTreeRank(comm, rank + mask, root), tag,
+                boost::serialization::make_array(other.data(), n));
+      std::transform(result.begin(), result.end(), other.begin(),
+                     result.begin(), op);
+    }
+  }
+  std::copy(result.begin(), result.end(), out_values);
+}
+
+template <typename T, typename Op>
+void reduce(const Communicator &comm, const T &in_value, T &out_value, Op op,
+            int root) {
+  if (comm.rank() != root)
+    throw std::logic_error(
+        "Parallel::reduce on non-root rank with output argument.");
+  detail::reduceTree(comm, &in_value, 1, &out_value, op, root);
+}
+
+template <typename T, typename Op>
+void reduce(const Communicator &comm, const T &in_value, Op op, int root) {
+  if (comm.rank() == root)
+    throw std::logic_error(
+        "Parallel::reduce on root rank without output argument.");
+  detail::reduceTree(comm, &in_value, 1, static_cast<T *>(nullptr), op,
+                     root);
+}
+
+template <typename T, typename Op>
+void reduce(const Communicator &comm, const T *in_values, int n,
+            T *out_values, Op op, int root) {
+  if (comm.rank() != root)
+    throw std::logic_error(
+        "Parallel::reduce on non-root rank with output argument.");
+  detail::reduceTree(comm, in_values, n, out_values, op, root);
+}
+
+template <typename T, typename Op>
+void reduce(const Communicator &comm, const T *in_values, int n, Op op,
+            int root) {
+  if (comm.rank() == root)
+    throw std::logic_error(
+        "Parallel::reduce on root rank without output argument.");
+  detail::reduceTree(comm, in_values, n, static_cast<T *>(nullptr), op, root);
+}
+
+template <typename T, typename Op>
+void all_reduce(const Communicator &comm, const T *in_values, int n,
+                T *out_values, Op op) {
+  detail::reduceTree(comm, in_values, n, out_values, op, 0);
+  detail::broadcast(comm, out_values, n, 0);
+}
+
+template <typename T, typename Op>
+void all_reduce(const Communicator &comm, const T &in_value, T &out_value,
+                Op op) {
+  detail::all_reduce(comm, &in_value, 1, &out_value, op);
+}
+
+template <typename T>
+void all_gather(const Communicator &comm, const T &in_value,
+                std::vector<T> &out_values) {
+  if (comm.rank() == 0)
+    detail::gather(comm, in_value, out_values, 0);
+  else
+    detail::gather(comm, in_value, 0);
+  out_values.resize(comm.size());
+  detail::broadcast(comm, out_values.data(), comm.size(), 0);
+}
+
+template <typename T>
+void scatter(const Communicator &comm, const std::vector<T> &in_values,
+             T &out_value, int root) {
+  int tag{0};
+  if (comm.rank() != root)
+    throw std::logic_error(
+        "Parallel::scatter on non-root rank with input values.");
+  if (in_values.size() != static_cast<size_t>(comm.size()))
+    throw std::invalid_argument(
+        "Parallel::scatter requires one input value per rank.");
+  for (int rank = 0; rank < comm.size(); ++rank) {
+    if (rank != root)
+      comm.send(rank, tag, in_values[rank]);
+  }
+  out_value = in_values[root];
+}
+
+template <typename T>
+void scatter(const Communicator &comm, T &out_value, int root) {
+  int tag{0};
+  if (comm.rank() == root)
+    throw std::logic_error(
+        "Parallel::scatter on root rank without input values.");
+  comm.recv(root, tag, out_value);
+}
+
+/// Ring exchange: in step i every rank sends to the rank i ahead of it and
+/// receives from the rank i behind it.
+template <typename T>
+void all_to_all(const Communicator &comm, const std::vector<T> &in_values,
+                std::vector<T> &out_values) {
+  int tag{0};
+  const int size = comm.size();
+  if (in_values.size() != static_cast<size_t>(size))
+    throw std::invalid_argument(
+        "Parallel::all_to_all requires one input value per rank.");
+  out_values.resize(size);
+  out_values[comm.rank()] = in_values[comm.rank()];
+  for (int step = 1; step < size; ++step) {
+    const int dest = (comm.rank() + step) % size;
+    const int source = (comm.rank() - step + size) % size;
+    comm.send(dest, tag, in_values[dest]);
+    comm.recv(source, tag, out_values[source]);
+  }
+}
 }
 
 template <typename... T> void gather(const Communicator &comm, T &&... args) {
@@ -78,6 +263,136 @@ template <typename... T> void gather(const Communicator &comm, T &&... args) {
   detail::gather(comm, std::forward<T>(args)...);
 }
 
+/// Send value from root to all ranks.
+template <typename T>
+void broadcast(const Communicator &comm, T &value, int root) {
+#ifdef MPI_EXPERIMENTAL
+  if (!comm.hasBackend())
+    return boost::mpi::broadcast(comm, value, root);
+#endif
+  detail::broadcast(comm, value, root);
+}
+
+/// Send n values from root to all ranks, without serialization in MPI builds.
+template <typename T>
+void broadcast(const Communicator &comm, T *values, int n, int root) {
+#ifdef MPI_EXPERIMENTAL
+  if (!comm.hasBackend())
+    return boost::mpi::broadcast(comm, values, n, root);
+#endif
+  detail::broadcast(comm, values, n, root);
+}
+
+/// Combine the values of all ranks with op, root gets the result.
+template <typename T, typename Op>
+void reduce(const Communicator &comm, const T &in_value, T &out_value, Op op,
+            int root) {
+#ifdef MPI_EXPERIMENTAL
+  if (!comm.hasBackend())
+    return boost::mpi::reduce(comm, in_value, out_value, op, root);
+#endif
+  detail::reduce(comm, in_value, out_value, op, root);
+}
+
+/// Variant of reduce for ranks other than root.
+template <typename T, typename Op>
+void reduce(const Communicator &comm, const T &in_value, Op op, int root) {
+#ifdef MPI_EXPERIMENTAL
+  if (!comm.hasBackend())
+    return boost::mpi::reduce(comm, in_value, op, root);
+#endif
+  detail::reduce(comm, in_value, op, root);
+}
+
+/// Element-wise reduce of n values. In MPI builds arrays of MPI datatypes with
+/// standard operations such as std::plus are reduced in place by MPI, without
+/// serialization.
+template <typename T, typename Op>
+void reduce(const Communicator &comm, const T *in_values, int n,
+            T *out_values, Op op, int root) {
+#ifdef MPI_EXPERIMENTAL
+  if (!comm.hasBackend())
+    return boost::mpi::reduce(comm, in_values, n, out_values, op, root);
+#endif
+  detail::reduce(comm, in_values, n, out_values, op, root);
+}
+
+/// Variant of the element-wise reduce for ranks other than root.
+template <typename T, typename Op>
+void reduce(const Communicator &comm, const T *in_values, int n, Op op,
+            int root) {
+#ifdef MPI_EXPERIMENTAL
+  if (!comm.hasBackend())
+    return boost::mpi::reduce(comm, in_values, n, op, root);
+#endif
+  detail::reduce(comm, in_values, n, op, root);
+}
+
+/// Combine the values of all ranks with op, all ranks get the result.
+template <typename T, typename Op>
+void all_reduce(const Communicator &comm, const T &in_value, T &out_value,
+                Op op) {
+#ifdef MPI_EXPERIMENTAL
+  if (!comm.hasBackend())
+    return boost::mpi::all_reduce(comm, in_value, out_value, op);
+#endif
+  detail::all_reduce(comm, in_value, out_value, op);
+}
+
+/// Element-wise all_reduce of n values, see reduce.
+template <typename T, typename Op>
+void all_reduce(const Communicator &comm, const T *in_values, int n,
+                T *out_values, Op op) {
+#ifdef MPI_EXPERIMENTAL
+  if (!comm.hasBackend())
+    return boost::mpi::all_reduce(comm, in_values, n, out_values, op);
+#endif
+  detail::all_reduce(comm, in_values, n, out_values, op);
+}
+
+/// Collect the values of all ranks on all ranks, indexed by rank.
+template <typename T>
+void all_gather(const Communicator &comm, const T &in_value,
+                std::vector<T> &out_values) {
+#ifdef MPI_EXPERIMENTAL
+  if (!comm.hasBackend())
+    return boost::mpi::all_gather(comm, in_value, out_values);
+#endif
+  detail::all_gather(comm, in_value, out_values);
+}
+
+/// Send in_values[i] from root to rank i.
+template <typename T>
+void scatter(const Communicator &comm, const std::vector<T> &in_values,
+             T &out_value, int root) {
+#ifdef MPI_EXPERIMENTAL
+  if (!comm.hasBackend())
+    return boost::mpi::scatter(comm, in_values, out_value, root);
+#endif
+  detail::scatter(comm, in_values, out_value, root);
+}
+
+/// Variant of scatter for ranks other than root.
+template <typename T>
+void scatter(const Communicator &comm, T &out_value, int root) {
+#ifdef MPI_EXPERIMENTAL
+  if (!comm.hasBackend())
+    return boost::mpi::scatter(comm, out_value, root);
+#endif
+  detail::scatter(comm, out_value, root);
+}
+
+/// Send in_values[i] to rank i, out_values[i] is received from rank i.
+template <typename T>
+void all_to_all(const Communicator &comm, const std::vector<T> &in_values,
+                std::vector<T> &out_values) {
+#ifdef MPI_EXPERIMENTAL
+  if (!comm.hasBackend())
+    return boost::mpi::all_to_all(comm, in_values, out_values);
+#endif
+  detail::all_to_all(comm, in_values, out_values);
+}
+
 } // namespace Parallel
 } // namespace Mantid
 
@@ -6,6 +6,11 @@
 #include "MantidParallel/Collectives.h"
 #include "MantidTestHelpers/ParallelRunner.h"
 
+#include <boost/serialization/string.hpp>
+
+#include <numeric>
+#include <string>
+
 using namespace Mantid;
 using namespace Parallel;
 
@@ -39,6 +44,107 @@ void run_gather_short_version(const Communicator &comm) {
     TS_ASSERT_THROWS_NOTHING(Parallel::gather(comm, value, root));
   }
 }
+
+void run_broadcast(const Communicator &comm) {
+  for (int root = 0; root < comm.size(); ++root) {
+    std::string value;
+    if (comm.rank() == root)
+      value = "root " + std::to_string(root);
+    TS_ASSERT_THROWS_NOTHING(Parallel::broadcast(comm, value, root));
+    TS_ASSERT_EQUALS(value, "root " + std::to_string(root));
+  }
+}
+
+void run_broadcast_array(const Communicator &comm) {
+  int root = comm.size() - 1;
+  std::vector<double> values(5, -1.0);
+  if (comm.rank() == root)
+    std::iota(values.begin(), values.end(), 0.5);
+  TS_ASSERT_THROWS_NOTHING(Parallel::broadcast(comm, values.data(), 5, root));
+  TS_ASSERT_EQUALS(values, (std::vector<double>{0.5, 1.5, 2.5, 3.5, 4.5}));
+}
+
+void run_reduce(const Communicator &comm) {
+  int expected = comm.size() * (comm.size() - 1) / 2;
+  for (int root = 0; root < comm.size(); ++root) {
+    int value = comm.rank();
+    if (comm.rank() == root) {
+      int result = -1;
+      TS_ASSERT_THROWS_NOTHING(
+          Parallel::reduce(comm, value, result, std::plus<int>(), root));
+      TS_ASSERT_EQUALS(result, expected);
+    } else {
+      TS_ASSERT_THROWS_NOTHING(
+          Parallel::reduce(comm, value, std::plus<int>(), root));
+    }
+  }
+}
+
+void run_reduce_array(const Communicator &comm) {
+  int root = 1 % comm.size();
+  std::vector<double> values{1.0, static_cast<double>(comm.rank())};
+  if (comm.rank() == root) {
+    std::vector<double> result(2);
+    TS_ASSERT_THROWS_NOTHING(Parallel::reduce(comm, values.data(), 2,
+                                              result.data(),
+                                              std::plus<double>(), root));
+    TS_ASSERT_EQUALS(result[0], comm.size());
+    TS_ASSERT_EQUALS(result[1], comm.size() * (comm.size() - 1) / 2);
+  } else {
+    TS_ASSERT_THROWS_NOTHING(Parallel::reduce(comm, values.data(), 2,
+                                              std::plus<double>(), root));
+  }
+}
+
+void run_all_reduce(const Communicator &comm) {
+  int value = comm.rank();
+  int result = -1;
+  TS_ASSERT_THROWS_NOTHING(Parallel::all_reduce(
+      comm, value, result, [](int a, int b) { return std::max(a, b); }));
+  TS_ASSERT_EQUALS(result, comm.size() - 1);
+}
+
+void run_all_reduce_array(const Communicator &comm) {
+  std::vector<double> values{1.0, static_cast<double>(comm.rank())};
+  std::vector<double> result(2);
+  TS_ASSERT_THROWS_NOTHING(Parallel::all_reduce(
+      comm, values.data(), 2, result.data(), std::plus<double>()));
+  TS_ASSERT_EQUALS(result[0], comm.size());
+  TS_ASSERT_EQUALS(result[1], comm.size() * (comm.size() - 1) / 2);
+}
+
+void run_all_gather(const Communicator &comm) {
+  int value = 123 * comm.rank();
+  std::vector<int> result;
+  TS_ASSERT_THROWS_NOTHING(Parallel::all_gather(comm, value, result));
+  TS_ASSERT_EQUALS(result.size(), comm.size());
+  for (int i = 0; i < static_cast<int>(result.size()); ++i)
+    TS_ASSERT_EQUALS(result[i], 123 * i);
+}
+
+void run_scatter(const Communicator &comm) {
+  int root = comm.size() / 2;
+  int result = -1;
+  if (comm.rank() == root) {
+    std::vector<int> values(comm.size());
+    std::iota(values.begin(), values.end(), 10);
+    TS_ASSERT_THROWS_NOTHING(Parallel::scatter(comm, values, result, root));
+  } else {
+    TS_ASSERT_THROWS_NOTHING(Parallel::scatter(comm, result, root));
+  }
+  TS_ASSERT_EQUALS(result, 10 + comm.rank());
+}
+
+void run_all_to_all(const Communicator &comm) {
+  std::vector<int> values;
+  for (int rank = 0; rank < comm.size(); ++rank)
+    values.push_back(100 * comm.rank() + rank);
+  std::vector<int> result;
+  TS_ASSERT_THROWS_NOTHING(Parallel::all_to_all(comm, values, result));
+  TS_ASSERT_EQUALS(result.size(), comm.size());
+  for (int rank = 0; rank < static_cast<int>(result.size()); ++rank)
+    TS_ASSERT_EQUALS(result[rank], 100 * rank + comm.rank());
+}
 }
 
 class CollectivesTest : public CxxTest::TestSuite {
@@ -53,6 +159,30 @@ public:
   void test_gather_short_version() {
     ParallelTestHelpers::runParallel(run_gather_short_version);
   }
+
+  void test_broadcast() { ParallelTestHelpers::runParallel(run_broadcast); }
+
+  void test_broadcast_array() {
+    ParallelTestHelpers::runParallel(run_broadcast_array);
+  }
+
+  void test_reduce() { ParallelTestHelpers::runParallel(run_reduce); }
+
+  void test_reduce_array() {
+    ParallelTestHelpers::runParallel(run_reduce_array);
+  }
+
+  void test_all_reduce() { ParallelTestHelpers::runParallel(run_all_reduce); }
+
+  void test_all_reduce_array() {
+    ParallelTestHelpers::runParallel(run_all_reduce_array);
+  }
+
+  void test_all_gather() { ParallelTestHelpers::runParallel(run_all_gather); }
+
+  void test_scatter() { ParallelTestHelpers::runParallel(run_scatter); }
+
+  void test_all_to_all() { ParallelTestHelpers::runParallel(run_all_to_all); }
 };
 
 #endif /* MANTID_PARALLEL_COLLECTIVESTEST_H_ */
@@ -0,0 +1,56 @@
+#ifndef MANTID_PYTHONINTERFACE_RELEASEGLOBALINTERPRETERLOCK_H_
+#define MANTID_PYTHONINTERFACE_RELEASEGLOBALINTERPRETERLOCK_H_
+/**
+    Defines an RAII class for releasing the Python GIL while a thread which
+    holds it runs C++ code that does not touch Python objects
+
+    Copyright &copy; 2017 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+   National Laboratory & European Spallation Source
+
+    This file is part of Mantid.
+
+    Mantid is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 3 of the License, or
+    (at your option) any later version.
+
+    Mantid is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+    File change history is stored at: <https://github.com/mantidproject/mantid>
+    Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+#include "MantidPythonInterface/kernel/DllConfig.h"
+#include <boost/python/detail/wrap_python.hpp>
+
+namespace Mantid {
+namespace PythonInterface {
+namespace Environment {
+
+/**
+ * Releases the Python GIL held by the current thread for the lifetime of
+ * the object and reacquires it on destruction. Other Python threads can run
+ * in the meantime, so no Python objects may be used while it exists.
+ */
+class PYTHON_KERNEL_DLL ReleaseGlobalInterpreterLock {
+public:
+  /// Default constructor
+  ReleaseGlobalInterpreterLock();
+  /// Destructor
+  ~ReleaseGlobalInterpreterLock();
+
+private:
+  ReleaseGlobalInterpreterLock(const ReleaseGlobalInterpreterLock &);
+  /// The thread state saved when the GIL was released
+  PyThreadState *m_saved;
+};
+}
+}
+}
+
+#endif /* MANTID_PYTHONINTERFACE_RELEASEGLOBALINTERPRETERLOCK_H_ */
@@ -2,7 +2,9 @@
 // Includes
 //-----------------------------------------------------------------------------
 #include "MantidPythonInterface/api/CloneMatrixWorkspace.h"
+#include "MantidPythonInterface/kernel/Environment/ReleaseGlobalInterpreterLock.h"
 #include "MantidAPI/MatrixWorkspace.h"
+#include "MantidKernel/MultiThreaded.h"
 
 #include <boost/python/extract.hpp>
 
@@ -31,6 +33,8 @@ enum DataField { XValues = 0, YValues = 1, EValues = 2, DxValues = 3 };
  * @param endp1 :: One past the end index in the workspace to finish at when
  *reading the data (similar to .end() for STL)
  *
+ * The spectra are copied in parallel with the GIL released, so other Python
+ * threads can run during the copy.
  */
 PyArrayObject *cloneArray(MatrixWorkspace &workspace, DataField field,
                           const size_t start, const size_t endp1) {
@@ -66,10 +70,14 @@ PyArrayObject *cloneArray(MatrixWorkspace &workspace, DataField field,
                            nullptr, nullptr, 0, nullptr));
   double *dest = reinterpret_cast<double *>(
       PyArray_DATA(nparray)); // HEAD of the contiguous numpy data array
-  for (size_t i = start; i < endp1; ++i) {
-    const MantidVec &src = (workspace.*(dataAccesor))(i);
-    std::copy(src.begin(), src.end(), dest);
-    dest += stride; // Move the ptr to the start of the next 1D array
+  Environment::ReleaseGlobalInterpreterLock releaseGIL;
+  const auto nhist = static_cast<int64_t>(numHist);
+  PARALLEL_FOR_IF(Kernel::threadSafe(workspace))
+  for (int64_t i = 0; i < nhist; ++i) {
+    const MantidVec &src =
+        (workspace.*(dataAccesor))(start + static_cast<size_t>(i));
+    // Each 1D array starts a stride after the previous one
+    std::copy(src.begin(), src.end(), dest + i * stride);
   }
   return nparray;
 }
@@ -415,6 +415,12 @@ void export_ialgorithm() {
            (arg("self"), arg("rethrow")), "To query whether an algorithm "
                                           "should rethrow exceptions when "
                                           "executing.")
+      .def("setNumThreads", &IAlgorithm::setNumThreads,
+           (arg("self"), arg("numThreads")),
+           "Limit the number of threads used while the algorithm and its "
+           "child algorithms execute. 0 removes the limit.")
+      .def("getNumThreads", &IAlgorithm::getNumThreads, arg("self"),
+           "Returns the limit on the number of threads, 0 if there is none.")
       .def("initialize", &IAlgorithm::initialize, arg("self"),
            "Initializes the algorithm")
       .def("validateInputs", &validateInputs, arg("self"),
@@ -1,12 +1,25 @@
 #include "MantidAPI/IEventWorkspace.h"
 #include "MantidAPI/IEventList.h"
+#include "MantidKernel/MultiThreaded.h"
+#include "MantidPythonInterface/kernel/Environment/ReleaseGlobalInterpreterLock.h"
 #include "MantidPythonInterface/kernel/GetPointer.h"
 #include "MantidPythonInterface/kernel/Registry/RegisterWorkspacePtrToPython.h"
 
 #include <boost/python/class.hpp>
+#include <boost/python/dict.hpp>
+#include <boost/python/extract.hpp>
+#include <boost/python/handle.hpp>
 #include <boost/python/object.hpp>
 
+#define PY_ARRAY_UNIQUE_SYMBOL API_ARRAY_API
+#define NO_IMPORT_ARRAY
+#include <numpy/arrayobject.h>
+
+#include <algorithm>
+#include <stdexcept>
+
 using namespace Mantid::API;
+using Mantid::PythonInterface::Environment::ReleaseGlobalInterpreterLock;
 using Mantid::PythonInterface::Registry::RegisterWorkspacePtrToPython;
 using namespace boost::python;
 
@@ -23,6 +36,98 @@ IEventList &deprecatedGetEventList(IEventWorkspace &self, const size_t index) {
              "'getEventList' is deprecated, use 'getSpectrum' instead.");
   return self.getSpectrum(index);
 }
+
+/**
+ * Create a new 1D numpy array
+ * @param size The number of elements
+ * @param type The numpy type of the elements
+ * @returns A python object owning the array
+ */
+object newArray(const size_t size, const int type) {
+  npy_intp dims[1] = {static_cast<npy_intp>(size)};
+  return object(handle<>(PyArray_SimpleNew(1, dims, type)));
+}
+
+/// The data of a numpy array created by newArray
+template <typename T> T *arrayData(const object &array) {
+  return static_cast<T *>(
+      PyArray_DATA(reinterpret_cast<PyArrayObject *>(array.ptr())));
+}
+
+/**
+ * Returns the events of some spectra as flat numpy arrays, without creating
+ * a python object per event. The events of the i-th requested spectrum are
+ * those between offsets[i] and offsets[i+1] of the other arrays.
+ * @param self A reference to calling object
+ * @param workspaceIndices A sequence of workspace indices, or None for all
+ * spectra
+ * @returns A dict with the arrays offsets, tof, pulse_time (nanoseconds since
+ * 1990-01-01) and weight
+ */
+dict extractEvents(const IEventWorkspace &self,
+                   const object &workspaceIndices) {
+  const size_t nhist = self.getNumberHistograms();
+  std::vector<size_t> indices;
+  if (workspaceIndices.is_none()) {
+    indices.resize(nhist);
+    for (size_t i = 0; i < nhist; ++i)
+      indices[i] = i;
+  } else {
+    const auto count = len(workspaceIndices);
+    indices.reserve(count);
+    for (Py_ssize_t i = 0; i < count; ++i) {
+      const size_t index = extract<size_t>(workspaceIndices[i]);
+      if (index >= nhist)
+        throw std::out_of_range("extractEvents: workspace index " +
+                                std::to_string(index) + " is out of range");
+      indices.push_back(index);
+    }
+  }
+
+  const size_t nspec = indices.size();
+  object offsets = newArray(nspec + 1, NPY_INT64);
+  auto offsetData = arrayData<npy_int64>(offsets);
+  offsetData[0] = 0;
+  for (size_t i = 0; i < nspec; ++i) {
+    offsetData[i + 1] = offsetData[i] + static_cast<npy_int64>(
+                                            self.getSpectrum(indices[i])
+                                                .getNumberEvents());
+  }
+  const auto nevents = static_cast<size_t>(offsetData[nspec]);
+  object tofs = newArray(nevents, NPY_DOUBLE);
+  object pulseTimes = newArray(nevents, NPY_INT64);
+  object weights = newArray(nevents, NPY_DOUBLE);
+  auto tofData = arrayData<double>(tofs);
+  auto pulseTimeData = arrayData<npy_int64>(pulseTimes);
+  auto weightData = arrayData<double>(weights);
+
+  {
+    ReleaseGlobalInterpreterLock releaseGIL;
+    const auto n = static_cast<int64_t>(nspec);
+    PARALLEL_FOR_IF(Mantid::Kernel::threadSafe(self))
+    for (int64_t i = 0; i < n; ++i) {
+      const auto &eventList = self.getSpectrum(indices[static_cast<size_t>(i)]);
+      const auto start = offsetData[i];
+      std::vector<double> values;
+      eventList.getTofs(values);
+      std::copy(values.begin(), values.end(), tofData + start);
+      eventList.getWeights(values);
+      std::copy(values.begin(), values.end(), weightData + start);
+      const auto times = eventList.getPulseTimes();
+      std::transform(times.begin(), times.end(), pulseTimeData + start,
+                     [](const Mantid::Kernel::DateAndTime &time) {
+                       return time.totalNanoseconds();
+                     });
+    }
+  }
+
+  dict result;
+  result["offsets"] = offsets;
+  result["tof"] = tofs;
+  result["pulse_time"] = pulseTimes;
+  result["weight"] = weights;
+  return result;
+}
 }
 
 /**
@@ -44,6 +149,12 @@ void export_IEventWorkspace() {
            "Return the :class:`~mantid.api.IEventList` managing the events at "
            "the given :class:`~mantid.api.Workspace` "
            "index")
+      .def("extractEvents", &extractEvents,
+           (arg("self"), arg("workspaceIndices") = object()),
+           "Return the events of the given workspace indices, or of all "
+           "spectra, as a dict of flat numpy arrays: 'tof', 'pulse_time' "
+           "(nanoseconds since 1990-01-01), 'weight' and 'offsets', where the "
+           "events of the i-th spectrum are in [offsets[i], offsets[i+1])")
       .def("clearMRU", &IEventWorkspace::clearMRU, args("self"),
            "Clear the most-recently-used lists");
 
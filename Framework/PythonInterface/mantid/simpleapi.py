@@ -44,6 +44,8 @@ __SPECIALIZED_FUNCTIONS__ = ["Load", "StartLiveData", "CutMD", "RenameWorkspace"
 __MDCOORD_FUNCTIONS__ = ["PeakIntensityVsRadius", "CentroidPeaksMD", "IntegratePeaksMD"]
 # The "magic" keyword to enable/disable logging
 __LOGGING_KEYWORD__ = "EnableLogging"
+# The "magic" keyword to limit the number of threads
+__NUM_THREADS_KEYWORD__ = "NumThreads"
 
 
 def specialization_exists(name):
@@ -155,6 +157,7 @@ def Load(*args, **kwargs):
     algm = _create_algorithm_object('Load', startProgress=_startProgress,
                                     endProgress=_endProgress)
     _set_logging_option(algm, kwargs)
+    _set_num_threads_option(algm, kwargs)
     try:
         algm.setProperty('Filename', filename)  # Must be set first
     except ValueError as ve:
@@ -258,6 +261,7 @@ def StartLiveData(*args, **kwargs):
                                     startProgress=_startProgress,
                                     endProgress=_endProgress)
     _set_logging_option(algm, kwargs)
+    _set_num_threads_option(algm, kwargs)
     try:
         algm.setProperty('Instrument', instrument)  # Must be set first
     except ValueError as ve:
@@ -317,6 +321,7 @@ def fitting_algorithm(f):
         # Create and execute
         algm = _create_algorithm_object(function_name)
         _set_logging_option(algm, kwargs)
+        _set_num_threads_option(algm, kwargs)
         if 'EvaluationType' in kwargs:
             algm.setProperty('EvaluationType', kwargs['EvaluationType'])
             del kwargs['EvaluationType']
@@ -494,6 +499,7 @@ def CutMD(*args, **kwargs):
     algm = _create_algorithm_object('CutMD', startProgress=_startProgress,
                                     endProgress=_endProgress)
     _set_logging_option(algm, kwargs)
+    _set_num_threads_option(algm, kwargs)
 
     # Now check that all the kwargs we've got are correct
     for key in kwargs.keys():
@@ -579,6 +585,7 @@ def RenameWorkspace(*args, **kwargs):
     algm = _create_algorithm_object('RenameWorkspace', startProgress=_startProgress,
                                     endProgress=_endProgress)
     _set_logging_option(algm, kwargs)
+    _set_num_threads_option(algm, kwargs)
     for key, val in arguments.items():
         algm.setProperty(key, val)
 
@@ -903,6 +910,21 @@ def _set_logging_option(algm_obj, kwargs):
         del kwargs[__LOGGING_KEYWORD__]
 
 
+def _set_num_threads_option(algm_obj, kwargs):
+    """
+        Checks the keyword arguments for the _NUM_THREADS keyword, limits the number
+        of threads the algorithm uses accordingly and removes the value from the dictionary.
+        If the keyword does not exist, or the algorithm has a property of that name,
+        then it does nothing.
+
+        :param algm_obj: An initialised algorithm object
+        :param **kwargs: A dictionary of the keyword arguments passed to the simple function call
+    """
+    if __NUM_THREADS_KEYWORD__ in kwargs and not algm_obj.existsProperty(__NUM_THREADS_KEYWORD__):
+        algm_obj.setNumThreads(kwargs[__NUM_THREADS_KEYWORD__])
+        del kwargs[__NUM_THREADS_KEYWORD__]
+
+
 def set_properties(alg_object, *args, **kwargs):
     """
         Set all of the properties of the algorithm. There is no guarantee of
@@ -970,6 +992,7 @@ def _create_algorithm_function(name, version, algm_object):
 
         algm = _create_algorithm_object(name, _version, _startProgress, _endProgress)
         _set_logging_option(algm, kwargs)
+        _set_num_threads_option(algm, kwargs)
 
         # Temporary removal of unneeded parameter from user's python scripts
         if "CoordinatesToUse" in kwargs and name in __MDCOORD_FUNCTIONS__:
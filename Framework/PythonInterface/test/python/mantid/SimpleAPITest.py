@@ -70,6 +70,13 @@ IgnoreBinErrors(Input) *boolean*       Ignore errors related to zero/negative bi
         data = [1.0,2.0,3.0,4.0,5.0]
         simpleapi.CreateWorkspace(data,data,OutputWorkspace=wsname,NSpec=1,UnitX='Wavelength',EnableLogging=False)
         self.assertTrue( wsname in mtd )
+
+    def test_function_accepts_NumThreads_keyword(self):
+        # The test here is that the algorithm runs without falling over about the NumThreads keyword being a property
+        wsname = 'test_function_accepts_NumThreads_keyword'
+        data = [1.0,2.0,3.0,4.0,5.0]
+        simpleapi.CreateWorkspace(data,data,OutputWorkspace=wsname,NSpec=1,UnitX='Wavelength',NumThreads=1)
+        self.assertTrue( wsname in mtd )
     
     def test_function_call_raises_ValueError_when_passed_args_with_invalid_values(self):
         # lhs code bug means we can't do this "self.assertRaises(simpleapi.LoadNexus, 'DoesNotExist')" --> ticket #4186
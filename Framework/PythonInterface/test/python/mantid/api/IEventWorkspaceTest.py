@@ -62,6 +62,35 @@ class IEventWorkspaceTest(unittest.TestCase):
         self.assertAlmostEquals(weightErrorList[0], 1.0) #first value
         self.assertAlmostEquals(weightErrorList[len(weightErrorList)-1], 1.0) #last value
 
+    def test_extractEvents_returns_all_events_in_spectrum_order(self):
+        events = self._test_ws.extractEvents()
+        offsets = events['offsets']
+        self.assertEquals(len(offsets), self._npixels + 1)
+        self.assertEquals(offsets[-1], self._test_ws.getNumberEvents())
+        for name in ('tof', 'pulse_time', 'weight'):
+            self.assertEquals(len(events[name]), offsets[-1])
+        for i in range(self._npixels):
+            el = self._test_ws.getSpectrum(i)
+            self.assertEquals(offsets[i + 1] - offsets[i], el.getNumberEvents())
+            tofs = el.getTofs()
+            weights = el.getWeights()
+            pulse_times = el.getPulseTimes()
+            for j in (0, el.getNumberEvents() - 1):
+                self.assertEquals(events['tof'][offsets[i] + j], tofs[j])
+                self.assertEquals(events['weight'][offsets[i] + j], weights[j])
+                self.assertEquals(events['pulse_time'][offsets[i] + j],
+                                  pulse_times[j].totalNanoseconds())
+
+    def test_extractEvents_of_selected_spectra(self):
+        events = self._test_ws.extractEvents([3, 1])
+        self.assertEquals(len(events['offsets']), 3)
+        self.assertEquals(events['offsets'][1],
+                          self._test_ws.getSpectrum(3).getNumberEvents())
+        self.assertAlmostEquals(events['tof'][0],
+                                self._test_ws.getSpectrum(3).getTofs()[0])
+        self.assertRaises(IndexError, self._test_ws.extractEvents,
+                          [self._npixels])
+
     def test_deprecated_getEventList(self):
         el = self._test_ws.getEventList(0)
         self.assertTrue(isinstance(el, IEventList))